@@ -2,6 +2,8 @@
 #include "NeuralNet/NeuralNetwork.h"
 #include "NeuralNet/secondary.h"
 #include "Protocols/PhaseConfig.h"
+#include "Protocols/PreprocessingProducer.h"
+#include "Protocols/PreprocessingPlan.h"
 #include "NeuralNet/globals.h"
 
 using namespace hmmpc;
@@ -16,14 +18,38 @@ int partyNum;
 // test_data_size = argv[6]
 // mini_batch = argv[6]
 // trueOffline = argv[7]
-// offline_arg = argv[8]
+//      0: generate the randomness on demand
+//      1: generate the randomness listed in offline_arg before the online phase
+//      2: offline job: generate the randomness listed in offline_arg into the persistent store, without the online phase
+//      3: online phase with the randomness of one run loaded from the persistent store (prepared by 2)
+//      4: generate the randomness on demand by a background producer over a second channel (ports base+1000)
+//      5: planner: write the randomness required by the network into the offline file offline_arg, without the network
+// offline_arg = argv[8]: the offline file, or "plan" to generate the randomness tallied by planTest() in 1 and 2
 // CORES = argv[9]
-int main(int argc, char** argv)
+// prime = argv[10] (optional) {PR31, PR61}: the field of the run, PR31 by default
+// store_dir = argv[11] (optional) directory of the persistent store, Preprocessing by default
+// low_water = argv[12] (optional) tuples of each kind the producer keeps ahead in mode 4
+template<class Field>
+int run(int argc, char** argv)
 {
     int cores = atoi(argv[9]);
     Eigen::setNbThreads(cores);
     // cout<<"#threads: "<<Eigen::nbThreads()<<endl;
 
+    int true_offline = atoi(argv[7]);
+    string offline_arg = argv[8];
+    if(true_offline == 5){// Planner
+        NeuralNetConfig * config = new NeuralNetConfig(NUM_ITERATIONS);
+        loadData(argv[4], argv[5], atoi(argv[6]));
+        selectNetwork(argv[4], argv[5], config);
+        NeuralNetwork<Field> *net = new NeuralNetwork<Field>(config);
+        PreprocessingPlan<Field> plan;
+        planTest(net, plan);
+        plan.write(offline_arg);
+        plan.print(cout);
+        return 0;
+    }
+
     // Build Communication Channels
     partyNum = atoi(argv[1]);
     int portnum_base = 6000;
@@ -32,7 +58,7 @@ int main(int argc, char** argv)
     ThreadPlayer P(player_name, "");
     int threshold = atoi(argv[3]);
 
-    PhaseConfig phase;
+    PhaseConfig<Field> phase;
     phase.init(P.num_players(), threshold, &P);
 
     // Select Network
@@ -44,25 +70,51 @@ int main(int argc, char** argv)
     loadData(network, dataset, atoi(argv[6]));
     
     selectNetwork(network, dataset, config);
-    NeuralNetwork *net = new NeuralNetwork(config);
+    NeuralNetwork<Field> *net = new NeuralNetwork<Field>(config);
     preload_netwok(true, network, net);
 
-    if(atoi(argv[7])){// Set true offline.
+    string store_dir = argc > 11 ? argv[11] : "Preprocessing";
+    if(true_offline == 1 || true_offline == 2){// Set true offline.
         phase.setTrueOffline();
         phase.start_offline();
-        string offline_arg = argv[8];
-        phase.generate_random(offline_arg);
+        if(offline_arg == "plan"){
+            PreprocessingPlan<Field> plan;
+            planTest(net, plan);
+            phase.generate_random(plan);
+        }else{
+            phase.generate_random(offline_arg);
+        }
         phase.end_offline();
     }
+    if(true_offline == 2){// Offline job
+        phase.store_random(store_dir);
+        phase.print_offline_communication();
+        return 0;
+    }
+    if(true_offline == 3){// Online from the persistent store
+        phase.setTrueOffline();
+        phase.load_random(store_dir);
+    }
+    ThreadPlayer *producer_P = nullptr;
+    if(true_offline == 4){// Background producer
+        size_t low_water = argc > 12 ? atol(argv[12]) : DEFAULT_LOW_WATER;
+        producer_P = new ThreadPlayer(Names(partyNum, portnum_base + 1000, filename), "");
+        phase.start_producer(producer_P, low_water);
+    }
 
     phase.start_online();
     // train(net);
     test(net);
     phase.end_online();
 
+    if(producer_P){
+        phase.stop_producer();
+        delete producer_P;
+    }
+
     // phase.print_simple();
 
-    if(!atoi(argv[7])){// True offline
+    if(!true_offline || true_offline == 4){// True offline
         // The randomness are generated on demand.
         // It prints the communication costs of each party in the terminal. 
         phase.print_offline_communication();
@@ -72,5 +124,16 @@ int main(int argc, char** argv)
         // The communication size printed here is the average of the communicaiton bytes sent by all parties.
         phase.print_communication_oneline();
     }
-    
-}
\ No newline at end of file
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    string prime = argc > 10 ? argv[10] : PR31::NAME;
+    if(prime == PR31::NAME)
+        return run<PR31>(argc, argv);
+    if(prime == PR61::NAME)
+        return run<PR61>(argc, argv);
+    cerr<<"Unknown field "<<prime<<", expected "<<PR31::NAME<<" or "<<PR61::NAME<<"."<<endl;
+    return 1;
+}
@@ -1,16 +1,20 @@
 #include "Math/UnitTest.h"
+#include "Math/gfpGemm.h"
+#include "Math/gfpKernels.h"
+#include "Tools/time-func.h"
 
 using namespace std;
 namespace hmmpc
 {
+template<class Field>
 void testGfp()
 {
-    cout<<"[UnitTest for Gfp]:"<<endl;
+    cout<<"[UnitTest for Gfp]: "<<Field::NAME<<endl;
 
-    gfpScalar x=2;
+    gfpScalar<Field> x=2;
     cout<<"x = "<<x<<endl;
-    gfpScalar minus_x = -x;
-    gfpScalar inverse_x = multiplicative_inverse((TYPE)(2));
+    gfpScalar<Field> minus_x = -x;
+    gfpScalar<Field> inverse_x = multiplicative_inverse<Field>(2);
 
     cout<<"-x = "<<minus_x<<endl;
     cout<<"x^{-1} = "<<inverse_x<<endl;
@@ -23,25 +27,215 @@ void debugGfpDivision()
     // Not Used
 }
 
+// Compare the lazy-reduction GEMM with Eigen's generic product.
+template<class Field>
+void debugGfpMatMul()
+{
+    cout<<"[UnitTest for Gfp MatMul]: "<<Field::NAME<<endl;
+    size_t m = 128, k = 784, n = 128;
+    gfpMatrix<Field> A(m, k), B(k, n), Bt(n, k), At(k, m);
+    fill_uniform(A);
+    fill_uniform(B);
+    Bt = B.transpose();
+    At = A.transpose();
+
+    Timer timer;
+    timer.start();
+    gfpMatrix<Field> expected = A * B;
+    cout<<"Eigen product: "<<timer.elapsed()<<"s"<<endl;
+    timer.reset();
+    gfpMatrix<Field> res = gfp_matmul(A, B);
+    cout<<"gfp_matmul: "<<timer.elapsed()<<"s"<<endl;
+
+    cout<<"A * B: "<<(res == expected)<<endl;
+    cout<<"A * Bt^T: "<<(gfp_matmul(A, Bt, false, true) == expected)<<endl;
+    cout<<"At^T * B: "<<(gfp_matmul(At, B, true, false) == expected)<<endl;
+    cout<<"At^T * Bt^T: "<<(gfp_matmul(At, Bt, true, true) == expected)<<endl;
+
+    // The entries are close to Field::PR (worst case of the lazy reduction).
+    A.setConstant(Field::PR-1);
+    B.setConstant(Field::PR-1);
+    cout<<"(Field::PR-1) * (Field::PR-1): "<<(gfp_matmul(A, B) == gfpMatrix<Field>(A * B))<<endl;
+}
+
+template<class Field>
+void debugFillUniform()
+{
+    cout<<"[UnitTest for fill_uniform]: "<<Field::NAME<<endl;
+    octet seed[SEED_SIZE] = {0};
+    PRNG prng0, prng1;
+    prng0.SetSeed(seed);
+    prng1.SetSeed(seed);
+    size_t n = 3*FILL_UNIFORM_CHUNK + 7;
+    gfpMatrix<Field> A(1, n), B(1, n);
+    fill_uniform(A, prng0);
+    fill_uniform(B, prng1);
+    cout<<"same seed, same elements: "<<(A == B)<<endl;
+
+    bool in_range = true;
+    double mean = 0;
+    for(size_t i = 0; i < n; i++){
+        in_range &= (A(i).get_value() < Field::PR);
+        mean += (double)A(i).get_value() / Field::PR;
+    }
+    cout<<"in range: "<<in_range<<endl;
+    cout<<"mean/Field::PR (~0.5): "<<mean/n<<endl;
+}
+
+// The counter-addressed access matches the sequential stream, at any offset.
+void debugSeekablePRNG()
+{
+    cout<<"[UnitTest for Seekable PRNG]: "<<PRNG::ctr_name()<<endl;
+    octet seed[SEED_SIZE] = {1};
+    PRNG prng;
+    prng.SetSeed(seed);
+    size_t len = 1<<24;
+    vector<octet> sequential(len), seekable(len);
+
+    Timer timer;
+    timer.start();
+    prng.get_octets(sequential.data(), len);
+    cout<<"get_octets: "<<timer.elapsed()<<"s"<<endl;
+    timer.reset();
+    prng.get_octets_at(seekable.data(), len, 0, 0);
+    cout<<"get_octets_at: "<<timer.elapsed()<<"s"<<endl;
+    cout<<"stream 0 == sequential: "<<(sequential == seekable)<<endl;
+
+    bool match = true;
+    size_t offsets[] = {1, 15, 16, 17, 100, 1000+7};
+    for(size_t offset : offsets){
+        vector<octet> part(333);
+        prng.get_octets_at(part.data(), part.size(), 0, offset);
+        match &= equal(part.begin(), part.end(), sequential.begin() + offset);
+    }
+    cout<<"unaligned offsets: "<<match<<endl;
+
+    prng.get_octets_at(seekable.data(), 64, 1, 0);
+    cout<<"stream 1 != stream 0: "<<!equal(seekable.begin(), seekable.begin()+64, sequential.begin())<<endl;
+}
+
+// Compare the element-wise kernels with the gfpScalar<Field> operations.
+template<class Field>
+void debugGfpKernels()
+{
+    cout<<"[UnitTest for Gfp Kernels]: "<<Field::NAME<<" "<<gfp_kernels<Field>().name<<endl;
+    size_t n = 1000 + 13;// Cover the scalar tail.
+    gfpMatrix<Field> A(1, n), B(1, n), res;
+    fill_uniform(A);
+    fill_uniform(B);
+    // Edge values
+    A(0) = 0; B(0) = 0;
+    A(1) = Field::PR-1; B(1) = Field::PR-1;
+    A(2) = 0; B(2) = Field::PR-1;
+    gfpScalar<Field> c = Field::PR-1;
+
+    gfpMatrix<Field> expected = A.array() + B.array();
+    cwise_add(A, B, res);
+    cout<<"add: "<<(res == expected)<<endl;
+
+    expected = A.array() - B.array();
+    cwise_sub(A, B, res);
+    cout<<"sub: "<<(res == expected)<<endl;
+
+    expected = A.array() * B.array();
+    cwise_mul(A, B, res);
+    cout<<"mul: "<<(res == expected)<<endl;
+
+    expected = -A.array();
+    cwise_neg(A, res);
+    cout<<"neg: "<<(res == expected)<<endl;
+
+    expected = A.array() + c;
+    cwise_add_const(A, c, res);
+    cout<<"add_const: "<<(res == expected)<<endl;
+
+    expected = c * A.array();
+    cwise_mul_const(A, c, res);
+    cout<<"mul_const: "<<(res == expected)<<endl;
+
+    expected = c - A.array();
+    cwise_sub(c, A, res);
+    cout<<"const_sub: "<<(res == expected)<<endl;
+}
+
+// Compare the sqrt and inverse by addition chains with the gfpScalar<Field> pow, and time them on bit generation sizes.
+template<class Field>
+void debugGfpPow()
+{
+    cout<<"[UnitTest for Gfp Pow]: "<<Field::NAME<<" "<<Eigen::nbThreads()<<" threads"<<endl;
+    size_t n = (1<<20) + 13;
+    gfpMatrix<Field> A(1, n), squares, res, expected(1, n);
+    fill_uniform(A);
+    A(0) = 1; A(1) = Field::PR-1;
+    squares = A.array() * A.array();
+
+    Timer timer;
+    timer.start();
+    cwise_sqrt(squares, res);
+    cout<<"cwise_sqrt: "<<timer.elapsed()<<"s"<<endl;
+    timer.reset();
+    for(size_t i = 0; i < n; i++){expected(i) = sqrt(squares(i));}
+    cout<<"pow sqrt: "<<timer.elapsed()<<"s"<<endl;
+    cout<<"sqrt: "<<(res == expected)<<endl;
+
+    timer.reset();
+    cwise_inverse(A, res);
+    cout<<"cwise_inverse: "<<timer.elapsed()<<"s"<<endl;
+    timer.reset();
+    for(size_t i = 0; i < n; i++){expected(i) = multiplicative_inverse<Field>(A(i).get_value());}
+    cout<<"extend_gcd inverse: "<<timer.elapsed()<<"s"<<endl;
+    cout<<"inverse: "<<(res == expected)<<endl;
+
+    res.resize(1, n);
+    timer.reset();
+    batch_inversion(A, res);
+    cout<<"batch_inversion: "<<timer.elapsed()<<"s"<<endl;
+    cout<<"batch inverse: "<<(res == expected)<<endl;
+
+    cwise_rsqrt(squares, res);
+    cwise_mul(res, A, res);
+    bool ok = true;
+    for(size_t i = 0; i < n; i++){ok &= (res(i) == 1 || res(i) == Field::PR-1);}
+    cout<<"rsqrt: "<<ok<<endl;
+}
+
+template<class Field>
 void debugCNNExtend()
 {
-    gfpMatrix A(1,9*2);
+    gfpMatrix<Field> A(1,9*2);
     A<<1,2,3,4,5,6,7,8,9,
     11,12,13,14,15,16,17,18,19;
-    cout<<A.reshaped<RowMajor>(6, 3)<<endl;
-    gfpMatrix B(4, 8);
+    cout<<A.template reshaped<RowMajor>(6, 3)<<endl;
+    gfpMatrix<Field> B(4, 8);
     convolExtend(A, B, 3, 3, 2, 2, 2, 1, 2, 1);
     cout<<B<<endl;
 }
+template<class Field>
 void debugMaxpoolExtend()
 {
-    gfpMatrix A(1,9*2);
+    gfpMatrix<Field> A(1,9*2);
     A<<1,2,3,4,5,6,7,8,9,
     11,12,13,14,15,16,17,18,19;
-    cout<<A.reshaped<RowMajor>(6, 3)<<endl;
+    cout<<A.template reshaped<RowMajor>(6, 3)<<endl;
     
-    gfpMatrix C(8, 4);
+    gfpMatrix<Field> C(8, 4);
     maxpoolExtend(A, C, 3, 3, 2, 2, 2, 1, 2, 1);
     cout<<C<<endl;
 }
+
+template void testGfp<PR31>();
+template void debugGfpMatMul<PR31>();
+template void debugFillUniform<PR31>();
+template void debugGfpKernels<PR31>();
+template void debugGfpPow<PR31>();
+template void debugCNNExtend<PR31>();
+template void debugMaxpoolExtend<PR31>();
+
+template void testGfp<PR61>();
+template void debugGfpMatMul<PR61>();
+template void debugFillUniform<PR61>();
+template void debugGfpKernels<PR61>();
+template void debugGfpPow<PR61>();
+template void debugCNNExtend<PR61>();
+template void debugMaxpoolExtend<PR61>();
 }
\ No newline at end of file
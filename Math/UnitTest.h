@@ -3,9 +3,21 @@
 
 namespace hmmpc
 {
+template<class Field>
 void testGfp();
 
 void debugGfpDivision();
+template<class Field>
+void debugGfpMatMul();
+template<class Field>
+void debugGfpKernels();
+template<class Field>
+void debugGfpPow();
+template<class Field>
+void debugFillUniform();
+void debugSeekablePRNG();
+template<class Field>
 void debugCNNExtend();
+template<class Field>
 void debugMaxpoolExtend();
 }
\ No newline at end of file
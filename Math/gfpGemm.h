@@ -0,0 +1,145 @@
+#ifndef MATH_GFP_GEMM_H_
+#define MATH_GFP_GEMM_H_
+
+#include "Math/gfpKernels.h"
+#include <vector>
+#include <algorithm>
+
+namespace hmmpc
+{
+
+/**
+ * @brief Lazy reduction in the field product.
+ * Every entry is less than PR = 2^EXP - 1, so each raw product is less than 2^(2*EXP).
+ * We accumulate the raw products in DTYPE, and only fold the accumulator
+ *      acc = (acc & PR) + (acc >> EXP)
+ * once per block of Field::GEMM_LAZY_BLOCK terms. The folded value is congruent to acc,
+ * and it is small enough to absorb another block without overflowing DTYPE.
+ * - PR31: 4 * (2^31-1)^2 + 2^31 + 2^33 < 2^64
+ * - PR61: 64 * (2^61-1)^2 + 2^61 + 2^67 < 2^128
+ * The full reduction (modPrime) is only applied once per output entry.
+ */
+// Number of output columns handled at a time, such that the accumulators stay in L1.
+const static size_t GEMM_COL_BLOCK = 512;
+// Products smaller than this (m*n*k) are computed in a single thread.
+const static size_t GEMM_PARALLEL_THRESHOLD = 1<<16;
+
+template<class Field>
+inline typename Field::DTYPE fold_mod(typename Field::DTYPE x)
+{
+    return (x & Field::pr) + (x >> Field::MERSENNE_PRIME_EXP);
+}
+
+/**
+ * @brief res(m, n) = A(m, k) * B(k, n) over the raw field elements.
+ * A(i, l) is a[i*lda + l], or a[l*lda + i] if a_transpose.
+ * B(l, j) is b[l*ldb + j], or b[j*ldb + l] if b_transpose.
+ * The output is stored in row-major order, and must not alias a or b.
+ *
+ * @param a [in]
+ * @param lda leading dimension of a
+ * @param a_transpose
+ * @param b [in]
+ * @param ldb leading dimension of b
+ * @param b_transpose
+ * @param res [out] m*n entries
+ * @param m
+ * @param n
+ * @param k
+ */
+template<class Field>
+inline void gfp_gemm(const typename Field::TYPE *a, size_t lda, bool a_transpose,
+                    const typename Field::TYPE *b, size_t ldb, bool b_transpose,
+                    typename Field::TYPE *res, size_t m, size_t n, size_t k)
+{
+    typedef typename Field::TYPE TYPE;
+    typedef typename Field::DTYPE DTYPE;
+    const size_t GEMM_LAZY_BLOCK = Field::GEMM_LAZY_BLOCK;
+    // Keep each row of B contiguous in the inner loop.
+    std::vector<TYPE> b_buffer;
+    if(b_transpose){
+        b_buffer.resize(k*n);
+        for(size_t j = 0; j < n; j++)
+            for(size_t l = 0; l < k; l++){
+                b_buffer[l*n + j] = b[j*ldb + l];
+            }
+        b = b_buffer.data();
+        ldb = n;
+    }
+    size_t a_row = a_transpose ? 1 : lda;
+    size_t a_col = a_transpose ? lda : 1;
+
+    #pragma omp parallel num_threads(Eigen::nbThreads()) if(m*n*k >= GEMM_PARALLEL_THRESHOLD)
+    {
+        std::vector<DTYPE> acc(std::min(n, GEMM_COL_BLOCK));
+        #pragma omp for schedule(static)
+        for(size_t i = 0; i < m; i++){
+            const TYPE *a_i = a + i*a_row;
+            for(size_t j0 = 0; j0 < n; j0 += GEMM_COL_BLOCK){
+                size_t nj = std::min(GEMM_COL_BLOCK, n-j0);
+                DTYPE *c = acc.data();
+                std::fill(c, c+nj, 0);
+                for(size_t l0 = 0; l0 < k; l0 += GEMM_LAZY_BLOCK){
+                    size_t l_end = std::min(k, l0+GEMM_LAZY_BLOCK);
+                    for(size_t l = l0; l < l_end; l++){
+                        DTYPE a_il = a_i[l*a_col];
+                        const TYPE *b_l = b + l*ldb + j0;
+                        for(size_t j = 0; j < nj; j++){
+                            c[j] += a_il * b_l[j];
+                        }
+                    }
+                    for(size_t j = 0; j < nj; j++){
+                        c[j] = fold_mod<Field>(c[j]);
+                    }
+                }
+                TYPE *res_i = res + i*n + j0;
+                for(size_t j = 0; j < nj; j++){
+                    res_i[j] = (TYPE)modPrime<Field>(c[j]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief res = op(a) * op(b) with the lazy-reduction GEMM, where op() is the optional transpose.
+ * It is the replacement of Eigen's generic product on gfpMatrix, e.g.
+ *      gfp_matmul(a, b, res, false, true) <=> res = a * b.transpose()
+ *
+ * @param a [in]
+ * @param b [in]
+ * @param res [out] It is resized if necessary, and it could be the same as a or b.
+ * @param a_transpose
+ * @param b_transpose
+ */
+template<class Field>
+inline void gfp_matmul(const gfpMatrix<Field> &a, const gfpMatrix<Field> &b, gfpMatrix<Field> &res, bool a_transpose=false, bool b_transpose=false)
+{
+    size_t m = a_transpose ? a.cols() : a.rows();
+    size_t k = a_transpose ? a.rows() : a.cols();
+    size_t n = b_transpose ? b.rows() : b.cols();
+    assert((Eigen::Index)k == (b_transpose ? b.cols() : b.rows()));
+
+    if(&res == &a || &res == &b){
+        gfpMatrix<Field> tmp(m, n);
+        gfp_matmul(a, b, tmp, a_transpose, b_transpose);
+        res.swap(tmp);
+        return;
+    }
+
+    res.resize(m, n);
+    if(k==0){res.setConstant(0); return;}
+    gfp_gemm<Field>(gfp_data(a), a.cols(), a_transpose, gfp_data(b), b.cols(), b_transpose,
+                    gfp_data(res), m, n, k);
+}
+
+template<class Field>
+inline gfpMatrix<Field> gfp_matmul(const gfpMatrix<Field> &a, const gfpMatrix<Field> &b, bool a_transpose=false, bool b_transpose=false)
+{
+    gfpMatrix<Field> res;
+    gfp_matmul(a, b, res, a_transpose, b_transpose);
+    return res;
+}
+
+}
+#endif
@@ -0,0 +1,469 @@
+#include "Math/gfpKernels.h"
+#include <algorithm>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace hmmpc
+{
+
+/*************************************************
+ *
+ *       Scalar fallback
+ *
+ * ***********************************************/
+template<class Field>
+static void add_scalar(typename Field::TYPE *res, const typename Field::TYPE *a, const typename Field::TYPE *b, size_t n)
+{
+    for(size_t i = 0; i < n; i++){res[i] = add_mod<Field>(a[i], b[i]);}
+}
+
+template<class Field>
+static void sub_scalar(typename Field::TYPE *res, const typename Field::TYPE *a, const typename Field::TYPE *b, size_t n)
+{
+    for(size_t i = 0; i < n; i++){res[i] = add_mod<Field>(a[i], additive_inverse<Field>(b[i]));}
+}
+
+template<class Field>
+static void mul_scalar(typename Field::TYPE *res, const typename Field::TYPE *a, const typename Field::TYPE *b, size_t n)
+{
+    for(size_t i = 0; i < n; i++){res[i] = mult_mod<Field>(a[i], b[i]);}
+}
+
+template<class Field>
+static void neg_scalar(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n)
+{
+    for(size_t i = 0; i < n; i++){res[i] = additive_inverse<Field>(a[i]);}
+}
+
+template<class Field>
+static void add_const_scalar(typename Field::TYPE *res, const typename Field::TYPE *a, typename Field::TYPE c, size_t n)
+{
+    for(size_t i = 0; i < n; i++){res[i] = add_mod<Field>(a[i], c);}
+}
+
+template<class Field>
+static void mul_const_scalar(typename Field::TYPE *res, const typename Field::TYPE *a, typename Field::TYPE c, size_t n)
+{
+    for(size_t i = 0; i < n; i++){res[i] = mult_mod<Field>(a[i], c);}
+}
+
+template<class Field>
+struct ScalarKernels
+{
+    static const gfpKernels<Field> kernels;
+};
+
+template<class Field>
+const gfpKernels<Field> ScalarKernels<Field>::kernels = {"scalar", add_scalar<Field>, sub_scalar<Field>, mul_scalar<Field>,
+                                                         neg_scalar<Field>, add_const_scalar<Field>, mul_const_scalar<Field>};
+
+#if defined(__x86_64__) && !defined(SCALAR_KERNELS)
+
+/*************************************************
+ *
+ *       SIMD kernels
+ * Each vector op only requires its inputs in [0, 2PR) to reduce to [0, PR).
+ * The vector ops of each field are in its own namespace, where Field, TYPE, PR and MERSENNE_PRIME_EXP are those of the field.
+ * - PR31: 32-bit lanes. The 32x32 products are computed on the even and odd lanes separately.
+ * - PR61: 64-bit lanes. The 61x61 product is composed of four 32x32 products,
+ *          a*b = hh*2^64 + (hl+lh)*2^32 + ll, where 2^64 = 2^3 and 2^61 = 1 (mod PR).
+ *
+ * ***********************************************/
+
+// Apply the vector op to the main part, and the scalar op to the tail.
+#define GFP_BINARY_KERNEL(ISA, VEC, LOAD, STORE, OP)                                    \
+    static void OP##_##ISA(TYPE *res, const TYPE *a, const TYPE *b, size_t n)           \
+    {                                                                                   \
+        const size_t step = sizeof(VEC)/sizeof(TYPE);                                   \
+        size_t i = 0;                                                                   \
+        for(; i + step <= n; i += step){                                                \
+            STORE((VEC*)(res+i), OP##_##ISA##_vec(LOAD((const VEC*)(a+i)), LOAD((const VEC*)(b+i)))); \
+        }                                                                               \
+        OP##_scalar<Field>(res+i, a+i, b+i, n-i);                                       \
+    }
+
+#define GFP_CONST_KERNEL(ISA, VEC, LOAD, STORE, SET1, OP)                               \
+    static void OP##_const_##ISA(TYPE *res, const TYPE *a, TYPE c, size_t n)            \
+    {                                                                                   \
+        const size_t step = sizeof(VEC)/sizeof(TYPE);                                   \
+        const VEC vc = SET1(c);                                                         \
+        size_t i = 0;                                                                   \
+        for(; i + step <= n; i += step){                                                \
+            STORE((VEC*)(res+i), OP##_##ISA##_vec(LOAD((const VEC*)(a+i)), vc));         \
+        }                                                                               \
+        OP##_const_scalar<Field>(res+i, a+i, c, n-i);                                   \
+    }
+
+#define GFP_NEG_KERNEL(ISA, VEC, LOAD, STORE)                                           \
+    static void neg_##ISA(TYPE *res, const TYPE *a, size_t n)                           \
+    {                                                                                   \
+        const size_t step = sizeof(VEC)/sizeof(TYPE);                                   \
+        size_t i = 0;                                                                   \
+        for(; i + step <= n; i += step){                                                \
+            STORE((VEC*)(res+i), neg_##ISA##_vec(LOAD((const VEC*)(a+i))));             \
+        }                                                                               \
+        neg_scalar<Field>(res+i, a+i, n-i);                                             \
+    }
+
+#define GFP_FIELD_CONSTANTS(FIELD)                                                      \
+    typedef FIELD Field;                                                                \
+    typedef Field::TYPE TYPE;                                                           \
+    const TYPE PR = Field::PR;                                                          \
+    const int MERSENNE_PRIME_EXP = Field::MERSENNE_PRIME_EXP;
+
+#define GFP_KERNELS_FOR(ISA, VEC, LOAD, STORE, SET1)                                    \
+    GFP_BINARY_KERNEL(ISA, VEC, LOAD, STORE, add)                                       \
+    GFP_BINARY_KERNEL(ISA, VEC, LOAD, STORE, sub)                                       \
+    GFP_BINARY_KERNEL(ISA, VEC, LOAD, STORE, mul)                                       \
+    GFP_NEG_KERNEL(ISA, VEC, LOAD, STORE)                                               \
+    GFP_CONST_KERNEL(ISA, VEC, LOAD, STORE, SET1, add)                                  \
+    GFP_CONST_KERNEL(ISA, VEC, LOAD, STORE, SET1, mul)
+
+// The kernels and their tables in the namespace of the field.
+// GCC reports the _mm512_undefined_epi32() inside the masked intrinsics as uninitialized.
+#define GFP_SIMD_KERNELS(SET1_AVX2, SET1_AVX512)                                        \
+    _Pragma("GCC push_options")                                                         \
+    _Pragma("GCC target(\"avx2\")")                                                     \
+    GFP_KERNELS_FOR(avx2, __m256i, _mm256_loadu_si256, _mm256_storeu_si256, SET1_AVX2)  \
+    _Pragma("GCC pop_options")                                                          \
+    _Pragma("GCC diagnostic push")                                                      \
+    _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")                         \
+    _Pragma("GCC push_options")                                                         \
+    _Pragma("GCC target(\"avx512f\")")                                                  \
+    GFP_KERNELS_FOR(avx512, __m512i, _mm512_loadu_si512, _mm512_storeu_si512, SET1_AVX512) \
+    _Pragma("GCC pop_options")                                                          \
+    _Pragma("GCC diagnostic pop")                                                       \
+    static const gfpKernels<Field> kernels_avx2 = {"avx2", add_avx2, sub_avx2, mul_avx2,       \
+                                                   neg_avx2, add_const_avx2, mul_const_avx2};  \
+    static const gfpKernels<Field> kernels_avx512 = {"avx512", add_avx512, sub_avx512, mul_avx512, \
+                                                     neg_avx512, add_const_avx512, mul_const_avx512};
+
+namespace pr31
+{
+GFP_FIELD_CONSTANTS(PR31)
+
+// ---------------- AVX2 (PR31) ----------------
+__attribute__((target("avx2")))
+static inline __m256i reduce_avx2_vec(__m256i x)
+{
+    // x in [0, 2PR): min(x, x-PR) as unsigned
+    return _mm256_min_epu32(x, _mm256_sub_epi32(x, _mm256_set1_epi32(PR)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i add_avx2_vec(__m256i a, __m256i b)
+{
+    return reduce_avx2_vec(_mm256_add_epi32(a, b));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i sub_avx2_vec(__m256i a, __m256i b)
+{
+    return reduce_avx2_vec(_mm256_add_epi32(a, _mm256_sub_epi32(_mm256_set1_epi32(PR), b)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i neg_avx2_vec(__m256i a)
+{
+    return reduce_avx2_vec(_mm256_sub_epi32(_mm256_set1_epi32(PR), a));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i mul_avx2_vec(__m256i a, __m256i b)
+{
+    const __m256i p = _mm256_set1_epi64x(PR);
+    __m256i even = _mm256_mul_epu32(a, b);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    // Fold the 62-bit products into 32 bits
+    even = _mm256_add_epi64(_mm256_and_si256(even, p), _mm256_srli_epi64(even, MERSENNE_PRIME_EXP));
+    odd = _mm256_add_epi64(_mm256_and_si256(odd, p), _mm256_srli_epi64(odd, MERSENNE_PRIME_EXP));
+    return reduce_avx2_vec(_mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA));
+}
+
+// ---------------- AVX-512 (PR31) ----------------
+__attribute__((target("avx512f")))
+static inline __m512i reduce_avx512_vec(__m512i x)
+{
+    return _mm512_min_epu32(x, _mm512_sub_epi32(x, _mm512_set1_epi32(PR)));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i add_avx512_vec(__m512i a, __m512i b)
+{
+    return reduce_avx512_vec(_mm512_add_epi32(a, b));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i sub_avx512_vec(__m512i a, __m512i b)
+{
+    return reduce_avx512_vec(_mm512_add_epi32(a, _mm512_sub_epi32(_mm512_set1_epi32(PR), b)));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i neg_avx512_vec(__m512i a)
+{
+    return reduce_avx512_vec(_mm512_sub_epi32(_mm512_set1_epi32(PR), a));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i mul_avx512_vec(__m512i a, __m512i b)
+{
+    const __m512i p = _mm512_set1_epi64(PR);
+    __m512i even = _mm512_mul_epu32(a, b);
+    __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+    even = _mm512_add_epi64(_mm512_and_si512(even, p), _mm512_srli_epi64(even, MERSENNE_PRIME_EXP));
+    odd = _mm512_add_epi64(_mm512_and_si512(odd, p), _mm512_srli_epi64(odd, MERSENNE_PRIME_EXP));
+    return reduce_avx512_vec(_mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32)));
+}
+
+GFP_SIMD_KERNELS(_mm256_set1_epi32, _mm512_set1_epi32)
+}
+
+namespace pr61
+{
+GFP_FIELD_CONSTANTS(PR61)
+
+// ---------------- AVX2 (PR61) ----------------
+__attribute__((target("avx2")))
+static inline __m256i reduce_avx2_vec(__m256i x)
+{
+    // x in [0, 2PR): x - (x >= PR ? PR : 0)
+    const __m256i p = _mm256_set1_epi64x(PR);
+    return _mm256_sub_epi64(x, _mm256_andnot_si256(_mm256_cmpgt_epi64(p, x), p));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i add_avx2_vec(__m256i a, __m256i b)
+{
+    return reduce_avx2_vec(_mm256_add_epi64(a, b));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i sub_avx2_vec(__m256i a, __m256i b)
+{
+    return reduce_avx2_vec(_mm256_add_epi64(a, _mm256_sub_epi64(_mm256_set1_epi64x(PR), b)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i neg_avx2_vec(__m256i a)
+{
+    return reduce_avx2_vec(_mm256_sub_epi64(_mm256_set1_epi64x(PR), a));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i mul_avx2_vec(__m256i a, __m256i b)
+{
+    const __m256i p = _mm256_set1_epi64x(PR);
+    const __m256i low29 = _mm256_set1_epi64x((1ULL<<29)-1);
+    __m256i a_hi = _mm256_srli_epi64(a, 32);
+    __m256i b_hi = _mm256_srli_epi64(b, 32);
+    __m256i ll = _mm256_mul_epu32(a, b);
+    __m256i mid = _mm256_add_epi64(_mm256_mul_epu32(a, b_hi), _mm256_mul_epu32(a_hi, b));
+    __m256i hh = _mm256_mul_epu32(a_hi, b_hi);
+
+    __m256i s = _mm256_add_epi64(_mm256_and_si256(ll, p), _mm256_srli_epi64(ll, MERSENNE_PRIME_EXP));
+    s = _mm256_add_epi64(s, _mm256_slli_epi64(hh, 3));
+    s = _mm256_add_epi64(s, _mm256_srli_epi64(mid, 29));
+    s = _mm256_add_epi64(s, _mm256_slli_epi64(_mm256_and_si256(mid, low29), 32));
+    s = _mm256_add_epi64(_mm256_and_si256(s, p), _mm256_srli_epi64(s, MERSENNE_PRIME_EXP));
+    return reduce_avx2_vec(s);
+}
+
+// ---------------- AVX-512 (PR61) ----------------
+__attribute__((target("avx512f")))
+static inline __m512i reduce_avx512_vec(__m512i x)
+{
+    return _mm512_min_epu64(x, _mm512_sub_epi64(x, _mm512_set1_epi64(PR)));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i add_avx512_vec(__m512i a, __m512i b)
+{
+    return reduce_avx512_vec(_mm512_add_epi64(a, b));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i sub_avx512_vec(__m512i a, __m512i b)
+{
+    return reduce_avx512_vec(_mm512_add_epi64(a, _mm512_sub_epi64(_mm512_set1_epi64(PR), b)));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i neg_avx512_vec(__m512i a)
+{
+    return reduce_avx512_vec(_mm512_sub_epi64(_mm512_set1_epi64(PR), a));
+}
+
+__attribute__((target("avx512f")))
+static inline __m512i mul_avx512_vec(__m512i a, __m512i b)
+{
+    const __m512i p = _mm512_set1_epi64(PR);
+    const __m512i low29 = _mm512_set1_epi64((1ULL<<29)-1);
+    __m512i a_hi = _mm512_srli_epi64(a, 32);
+    __m512i b_hi = _mm512_srli_epi64(b, 32);
+    __m512i ll = _mm512_mul_epu32(a, b);
+    __m512i mid = _mm512_add_epi64(_mm512_mul_epu32(a, b_hi), _mm512_mul_epu32(a_hi, b));
+    __m512i hh = _mm512_mul_epu32(a_hi, b_hi);
+
+    __m512i s = _mm512_add_epi64(_mm512_and_si512(ll, p), _mm512_srli_epi64(ll, MERSENNE_PRIME_EXP));
+    s = _mm512_add_epi64(s, _mm512_slli_epi64(hh, 3));
+    s = _mm512_add_epi64(s, _mm512_srli_epi64(mid, 29));
+    s = _mm512_add_epi64(s, _mm512_slli_epi64(_mm512_and_si512(mid, low29), 32));
+    s = _mm512_add_epi64(_mm512_and_si512(s, p), _mm512_srli_epi64(s, MERSENNE_PRIME_EXP));
+    return reduce_avx512_vec(s);
+}
+
+GFP_SIMD_KERNELS(_mm256_set1_epi64x, _mm512_set1_epi64)
+}
+
+// The vector kernels of each field
+template<class Field> struct SimdKernels;
+template<> struct SimdKernels<PR31>
+{
+    static const gfpKernels<PR31>& avx2(){return pr31::kernels_avx2;}
+    static const gfpKernels<PR31>& avx512(){return pr31::kernels_avx512;}
+};
+template<> struct SimdKernels<PR61>
+{
+    static const gfpKernels<PR61>& avx2(){return pr61::kernels_avx2;}
+    static const gfpKernels<PR61>& avx512(){return pr61::kernels_avx512;}
+};
+#endif
+
+template<class Field>
+static const gfpKernels<Field>& select_kernels()
+{
+#if defined(__x86_64__) && !defined(SCALAR_KERNELS)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")){return SimdKernels<Field>::avx512();}
+    if(__builtin_cpu_supports("avx2")){return SimdKernels<Field>::avx2();}
+#endif
+    return ScalarKernels<Field>::kernels;
+}
+
+template<class Field>
+const gfpKernels<Field>& gfp_kernels()
+{
+    static const gfpKernels<Field> &kernels = select_kernels<Field>();
+    return kernels;
+}
+
+/*************************************************
+ *
+ *       Exponentiation by fixed addition chains
+ * PR = 2^E-1 with E = MERSENNE_PRIME_EXP, hence
+ * - SQRT_EXP = 2^(E-2): E-2 squarings.
+ * - INVERSE_CONST = 2^E-3 = 4*(2^(E-2)-1)+1, where x^(2^m-1) is built along the bits of m = E-2 by
+ *   x^(2^(2m)-1) = (x^(2^m-1))^(2^m) * x^(2^m-1) and x^(2^(m+1)-1) = (x^(2^m-1))^2 * x,
+ *   i.e. E-1 squarings and O(log E) multiplications, instead of E-2 multiplications by the square-and-multiply.
+ * The buffers are processed by the vector mul kernel in blocks fitting in L1,
+ * and the blocks are distributed over the threads.
+ *
+ * ***********************************************/
+// Number of elements of a block.
+const static size_t POW_BLOCK = 512;
+// Buffers smaller than this are processed in a single thread.
+const static size_t POW_PARALLEL_THRESHOLD = 1<<14;
+// Number of elements of an independent batch inversion.
+const static size_t BATCH_INVERSE_CHUNK = 1<<12;
+
+// x = x^(2^times)
+template<class Field>
+static inline void square_times(typename Field::TYPE *x, size_t n, int times)
+{
+    const gfpKernels<Field> &kernels = gfp_kernels<Field>();
+    for(int i = 0; i < times; i++){kernels.mul(x, x, x, n);}
+}
+
+template<class Field>
+static void sqrt_block(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n)
+{
+    typedef typename Field::TYPE TYPE;
+    static_assert(Field::SQRT_EXP == ((TYPE)1<<(Field::MERSENNE_PRIME_EXP-2)), "SQRT_EXP of a Mersenne prime");
+    if(res != a){std::copy(a, a+n, res);}
+    square_times<Field>(res, n, Field::MERSENNE_PRIME_EXP-2);
+    // The root in [0, MID_PR)
+    for(size_t i = 0; i < n; i++){res[i] = res[i] < Field::MID_PR ? res[i] : Field::PR - res[i];}
+}
+
+template<class Field>
+static void inverse_block(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n)
+{
+    typedef typename Field::TYPE TYPE;
+    static_assert(Field::INVERSE_CONST == ((TYPE)1<<Field::MERSENNE_PRIME_EXP)-3, "INVERSE_CONST of a Mersenne prime");
+    const gfpKernels<Field> &kernels = gfp_kernels<Field>();
+    const int target = Field::MERSENNE_PRIME_EXP-2;
+    TYPE t[POW_BLOCK], u[POW_BLOCK];
+    std::copy(a, a+n, t); // t = x^(2^m-1), m = 1
+    int m = 1;
+    for(int bit = 31-__builtin_clz(target)-1; bit >= 0; bit--){
+        std::copy(t, t+n, u);
+        square_times<Field>(u, n, m);
+        kernels.mul(t, t, u, n);
+        m <<= 1;
+        if((target>>bit)&1){
+            kernels.mul(t, t, t, n);
+            kernels.mul(t, t, a, n);
+            m++;
+        }
+    }
+    square_times<Field>(t, n, 2);
+    kernels.mul(res, t, a, n);
+}
+
+// Montgomery's trick on a chunk: 3(n-1) multiplications and a single inversion.
+template<class Field>
+static void batch_inverse_chunk(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n)
+{
+    // res_i = a_0 * ... * a_i
+    res[0] = a[0];
+    for(size_t i = 1; i < n; i++){res[i] = mult_mod<Field>(res[i-1], a[i]);}
+    // inv = 1/(a_0 * ... * a_i)
+    typename Field::TYPE inv = multiplicative_inverse<Field>(res[n-1]);
+    for(size_t i = n-1; i >= 1; i--){
+        res[i] = mult_mod<Field>(inv, res[i-1]);
+        inv = mult_mod<Field>(inv, a[i]);
+    }
+    res[0] = inv;
+}
+
+template<typename F>
+static void for_each_block(size_t n, size_t block, F f)
+{
+    #pragma omp parallel for num_threads(Eigen::nbThreads()) schedule(static) if(n >= POW_PARALLEL_THRESHOLD)
+    for(size_t i = 0; i < n; i += block){
+        f(i, std::min(block, n-i));
+    }
+}
+
+template<class Field>
+void gfp_sqrt(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n)
+{
+    for_each_block(n, POW_BLOCK, [=](size_t i, size_t len){sqrt_block<Field>(res+i, a+i, len);});
+}
+
+template<class Field>
+void gfp_inverse(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n)
+{
+    for_each_block(n, POW_BLOCK, [=](size_t i, size_t len){inverse_block<Field>(res+i, a+i, len);});
+}
+
+template<class Field>
+void gfp_batch_inverse(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n)
+{
+    assert(res != a);
+    for_each_block(n, BATCH_INVERSE_CHUNK, [=](size_t i, size_t len){batch_inverse_chunk<Field>(res+i, a+i, len);});
+}
+
+template const gfpKernels<PR31>& gfp_kernels<PR31>();
+template void gfp_sqrt<PR31>(PR31::TYPE *res, const PR31::TYPE *a, size_t n);
+template void gfp_inverse<PR31>(PR31::TYPE *res, const PR31::TYPE *a, size_t n);
+template void gfp_batch_inverse<PR31>(PR31::TYPE *res, const PR31::TYPE *a, size_t n);
+
+template const gfpKernels<PR61>& gfp_kernels<PR61>();
+template void gfp_sqrt<PR61>(PR61::TYPE *res, const PR61::TYPE *a, size_t n);
+template void gfp_inverse<PR61>(PR61::TYPE *res, const PR61::TYPE *a, size_t n);
+template void gfp_batch_inverse<PR61>(PR61::TYPE *res, const PR61::TYPE *a, size_t n);
+
+}
@@ -0,0 +1,146 @@
+#ifndef MATH_GFP_KERNELS_H_
+#define MATH_GFP_KERNELS_H_
+
+#include "Math/gfpScalar.h"
+
+namespace hmmpc
+{
+
+/**
+ * @brief Element-wise kernels over the raw buffers of field elements.
+ * All entries are in [0, PR), and res could be the same buffer as a or b.
+ * The implementation (AVX-512, AVX2 or scalar) of each field is selected once at runtime according to the CPU.
+ * They are instantiated for PR31 and PR61 in gfpKernels.cpp.
+ * Define SCALAR_KERNELS to always use the scalar fallback.
+ */
+template<class Field>
+struct gfpKernels
+{
+    typedef typename Field::TYPE TYPE;
+    const char *name;
+    void (*add)(TYPE *res, const TYPE *a, const TYPE *b, size_t n);
+    void (*sub)(TYPE *res, const TYPE *a, const TYPE *b, size_t n);
+    void (*mul)(TYPE *res, const TYPE *a, const TYPE *b, size_t n);
+    void (*neg)(TYPE *res, const TYPE *a, size_t n);
+    void (*add_const)(TYPE *res, const TYPE *a, TYPE c, size_t n);
+    void (*mul_const)(TYPE *res, const TYPE *a, TYPE c, size_t n);
+};
+
+template<class Field>
+const gfpKernels<Field>& gfp_kernels();
+
+/**
+ * @brief Field exponentiations over the raw buffers, by fixed addition chains of the Mersenne prime.
+ * Multi-threaded over blocks (Eigen::nbThreads()), each evaluated by the vector kernels.
+ * - gfp_sqrt: the square root in [0, MID_PR) of each quadratic residue.
+ * - gfp_inverse: the inverse of each element (0 to 0).
+ * - gfp_batch_inverse: the inverse of each non-zero element, by Montgomery's trick on independent chunks.
+ *   res must not be the same buffer as a.
+ */
+template<class Field>
+void gfp_sqrt(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n);
+template<class Field>
+void gfp_inverse(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n);
+template<class Field>
+void gfp_batch_inverse(typename Field::TYPE *res, const typename Field::TYPE *a, size_t n);
+
+template<class Field>
+inline typename Field::TYPE* gfp_data(gfpMatrix<Field> &matrix){return (typename Field::TYPE*)matrix.data();}
+template<class Field>
+inline const typename Field::TYPE* gfp_data(const gfpMatrix<Field> &matrix){return (const typename Field::TYPE*)matrix.data();}
+
+/*************************************************
+ *
+ *       Element-wise operations on gfpMatrix
+ * res is resized to the shape of a if necessary.
+ * The field is deduced from the matrices, so the constant c could be an integer.
+ *
+ * ***********************************************/
+// res = a + b
+template<class Field>
+inline void cwise_add(const gfpMatrix<Field> &a, const gfpMatrix<Field> &b, gfpMatrix<Field> &res)
+{
+    assert(a.rows()==b.rows() && a.cols()==b.cols());
+    res.resize(a.rows(), a.cols());
+    gfp_kernels<Field>().add(gfp_data(res), gfp_data(a), gfp_data(b), a.size());
+}
+
+// res = a - b
+template<class Field>
+inline void cwise_sub(const gfpMatrix<Field> &a, const gfpMatrix<Field> &b, gfpMatrix<Field> &res)
+{
+    assert(a.rows()==b.rows() && a.cols()==b.cols());
+    res.resize(a.rows(), a.cols());
+    gfp_kernels<Field>().sub(gfp_data(res), gfp_data(a), gfp_data(b), a.size());
+}
+
+// res = c - a
+template<class Field>
+inline void cwise_sub(const typename gfpMatrix<Field>::Scalar &c, const gfpMatrix<Field> &a, gfpMatrix<Field> &res)
+{
+    res.resize(a.rows(), a.cols());
+    gfp_kernels<Field>().neg(gfp_data(res), gfp_data(a), a.size());
+    gfp_kernels<Field>().add_const(gfp_data(res), gfp_data(res), c.get_value(), a.size());
+}
+
+// res = a * b
+template<class Field>
+inline void cwise_mul(const gfpMatrix<Field> &a, const gfpMatrix<Field> &b, gfpMatrix<Field> &res)
+{
+    assert(a.rows()==b.rows() && a.cols()==b.cols());
+    res.resize(a.rows(), a.cols());
+    gfp_kernels<Field>().mul(gfp_data(res), gfp_data(a), gfp_data(b), a.size());
+}
+
+// res = -a
+template<class Field>
+inline void cwise_neg(const gfpMatrix<Field> &a, gfpMatrix<Field> &res)
+{
+    res.resize(a.rows(), a.cols());
+    gfp_kernels<Field>().neg(gfp_data(res), gfp_data(a), a.size());
+}
+
+// res = a + c
+template<class Field>
+inline void cwise_add_const(const gfpMatrix<Field> &a, const typename gfpMatrix<Field>::Scalar &c, gfpMatrix<Field> &res)
+{
+    res.resize(a.rows(), a.cols());
+    gfp_kernels<Field>().add_const(gfp_data(res), gfp_data(a), c.get_value(), a.size());
+}
+
+// res = c * a
+template<class Field>
+inline void cwise_mul_const(const gfpMatrix<Field> &a, const typename gfpMatrix<Field>::Scalar &c, gfpMatrix<Field> &res)
+{
+    res.resize(a.rows(), a.cols());
+    gfp_kernels<Field>().mul_const(gfp_data(res), gfp_data(a), c.get_value(), a.size());
+}
+
+// res = sqrt(a)
+template<class Field>
+inline void cwise_sqrt(const gfpMatrix<Field> &a, gfpMatrix<Field> &res)
+{
+    res.resize(a.rows(), a.cols());
+    gfp_sqrt<Field>(gfp_data(res), gfp_data(a), a.size());
+}
+
+// res = 1/a
+template<class Field>
+inline void cwise_inverse(const gfpMatrix<Field> &a, gfpMatrix<Field> &res)
+{
+    res.resize(a.rows(), a.cols());
+    gfp_inverse<Field>(gfp_data(res), gfp_data(a), a.size());
+}
+
+// res = 1/sqrt(a), where a has no 0.
+template<class Field>
+inline void cwise_rsqrt(const gfpMatrix<Field> &a, gfpMatrix<Field> &res)
+{
+    gfpMatrix<Field> a_sqrt;
+    cwise_sqrt(a, a_sqrt);
+    res.resize(a.rows(), a.cols());
+    gfp_batch_inverse<Field>(gfp_data(res), gfp_data(a_sqrt), a.size());
+}
+
+}
+#endif
@@ -2,6 +2,7 @@
 #define MATH_GFP_MATRIX_H_
 
 #include "Math/gfpScalar.h"
+#include "Math/gfpKernels.h"
 #include "Tools/octetStream.h"
 #include "Tools/random.h"
 #include <immintrin.h>
@@ -9,93 +10,85 @@ using Eigen::MatrixBase, Eigen::RowMajor;
 namespace hmmpc
 {
 
-// using block = __m128i;
-
-// #ifdef __x86_64__
-// __attribute__((target("sse2")))
-// inline block makeBlock(uint64_t high, uint64_t low) {
-// 	return _mm_set_epi64x(high, low);
-// }
-// #elif __aarch64__
-// inline block makeBlock(uint64_t high, uint64_t low) {
-// 	return (block)vcombine_u64((uint64x1_t)low, (uint64x1_t)high);
-// }
-// #endif
-
-// const static block prs = makeBlock(2305843009213693951ULL, 2305843009213693951ULL);
-
-typedef Eigen::Matrix<TYPE, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMatrixXi64;
-typedef Eigen::Matrix<TYPE, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> ColMatrixXi64;
-typedef Eigen::Matrix<TYPE, 1, Eigen::Dynamic, Eigen::RowMajor> RowVectorXi64;
-typedef Eigen::Matrix<TYPE, Eigen::Dynamic, 1, Eigen::ColMajor> ColVectorXi64;
-typedef Eigen::Matrix<STYPE, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> SignedRowMatrixXi64;
-typedef Eigen::Matrix<STYPE, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> SignedColMatrixXi64;
 typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMatrixXd;
 typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> ColMatrixXd;
 typedef Eigen::Matrix<double, 1, Eigen::Dynamic, Eigen::RowMajor> RowVectorXd;
 typedef Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor> ColVectorXd;
-/**
- * @brief Mod the matrix using SIMD.
- * 
- * @tparam Derived 
- * @param matrix 
- */
-// template<typename Derived>
-// void mod_matrix(Eigen::PlainObjectBase<Derived> &matrix)
-// {
-//     block *ptr = (block*)matrix.data();
-//     for(size_t i = 0; i < matrix.size()/2; i++){
-//         // 2-64bit (x & PR) + (x >> MERSENNE_PRIME_EXP);
-//         ptr[i] = _mm_add_epi64(((block)ptr[i] & prs), _mm_srli_epi64(ptr[i], MERSENNE_PRIME_EXP));
-//         // 2-64bit (i >= pv) ? i - pv : i;
-//         ptr[i] = _mm_sub_epi64(ptr[i], _mm_andnot_si128(_mm_cmpgt_epi64(prs,ptr[i]), prs));
-//     }
-
-//     if(matrix.size() % 2){
-//         size_t id_last = matrix.size() - 1;
-//         matrix(id_last) = modPrime(matrix(id_last).get_value());
-//     }
-// }
 
+// Number of field elements drawn from one PRNG stream in fill_uniform().
+const static size_t FILL_UNIFORM_CHUNK = 4096;
+// Fills smaller than this are generated in a single thread.
+const static size_t FILL_UNIFORM_PARALLEL_THRESHOLD = 1<<16;
 
 /**
- * @brief There are two ways to generate a random matrix.
- * One is to call the modPrime() on each entry of the matrix.
- * The other is to generate the random memory directly, and mod them.
- * TODO [Test] For now, the performance is close.
- * @tparam Derived 
- * @param matrix 
+ * @brief Fill n uniformly random field elements from a single stream of the PRNG.
+ * The random octets are drawn in bulk, and each word is masked to its lower MERSENNE_PRIME_EXP bits,
+ * which is uniform in [0, 2^EXP-1]. The only out-of-range value is 2^EXP-1 = PR, which is rejected
+ * and redrawn from the rest of the stream, so the output is exactly uniform in [0, PR)
+ * (unlike modPrime() on a full word). The masking loop is branch-free and vectorized by the compiler.
+ *
+ * @param ptr [out] n field elements
+ * @param n
+ * @param prng
+ * @param stream_id
  */
-template<typename Derived>
-void random_matrix(Eigen::PlainObjectBase<Derived> &matrix)
-{   
-    // * The first way: Generate random element one by one
-    for(size_t i = 0; i < matrix.size(); i++){
-        #if defined(PR_31) 
-            matrix(i) = modPrime((unsigned int)secure_prng.get_uint());
-        #elif defined(PR_61)
-            matrix(i) = modPrime(secure_prng.get_word());
-        #endif
+template<class Field>
+inline void fill_uniform_stream(typename Field::TYPE *ptr, size_t n, const PRNG &prng, word stream_id)
+{
+    typedef typename Field::TYPE TYPE;
+    const TYPE PR = Field::PR;
+    word offset = 0;
+    while(n){
+        size_t len = n;
+        prng.get_octets_at((octet*)ptr, len*sizeof(TYPE), stream_id, offset);
+        offset += len*sizeof(TYPE);
+        size_t n_rejected = 0;
+        for(size_t i = 0; i < len; i++){
+            ptr[i] &= PR;
+            n_rejected += (ptr[i] == PR);
+        }
+        // Rare case (probability 2^-EXP per element): drop the rejected ones and redraw them.
+        if(n_rejected){
+            size_t j = 0;
+            for(size_t i = 0; i < len; i++){
+                if(ptr[i] != PR){ptr[j++] = ptr[i];}
+            }
+            len = j;
+        }
+        ptr += len;
+        n -= len;
     }
+}
 
-    // * The second way
-    // size_t len = matrix.size()*sizeof(gfpScalar);
-    // const auto *ptr = matrix.data();
-    // secure_prng.get_octets((octet*)ptr, len);
-    // mod_matrix(matrix);
+/**
+ * @brief Fill n uniformly random field elements from the PRNG.
+ * The elements are split into chunks of FILL_UNIFORM_CHUNK, and each chunk is drawn from its own
+ * stream of the counter-addressed PRNG, so the chunks are generated in parallel.
+ * The split does not depend on the number of threads, and the streams are reserved in the order
+ * of the calls, so parties sharing the same PRNG seed obtain the same elements.
+ *
+ * @param data [out] n field elements
+ * @param n
+ * @param prng
+ */
+template<class Field>
+inline void fill_uniform(gfpScalar<Field> *data, size_t n, PRNG &prng)
+{
+    typename Field::TYPE *ptr = (typename Field::TYPE*)data;
+    size_t n_chunks = (n + FILL_UNIFORM_CHUNK - 1) / FILL_UNIFORM_CHUNK;
+    word first_stream = prng.new_streams(n_chunks);
+
+    #pragma omp parallel for num_threads(Eigen::nbThreads()) schedule(static) if(n >= FILL_UNIFORM_PARALLEL_THRESHOLD)
+    for(size_t i = 0; i < n_chunks; i++){
+        size_t start = i * FILL_UNIFORM_CHUNK;
+        fill_uniform_stream<Field>(ptr + start, std::min(FILL_UNIFORM_CHUNK, n - start), prng, first_stream + i);
+    }
 }
 
 template<typename Derived>
-void random_matrix(Eigen::PlainObjectBase<Derived> &matrix, PRNG &prng)
-{   
-    // * The first way: Generate random element one by one
-    for(size_t i = 0; i < matrix.size(); i++){
-        #if defined(PR_31) 
-            matrix(i) = modPrime((unsigned int)prng.get_uint());
-        #elif defined(PR_61)
-            matrix(i) = modPrime(prng.get_word());
-        #endif
-    }
+void fill_uniform(Eigen::PlainObjectBase<Derived> &matrix, PRNG &prng=secure_prng)
+{
+    fill_uniform(matrix.data(), matrix.size(), prng);
 }
 
 /**
@@ -105,7 +98,7 @@ void random_matrix(Eigen::PlainObjectBase<Derived> &matrix, PRNG &prng)
  * @param matrix 
  */
 template<typename Derived>
-void truncate_matrix(Eigen::MatrixBase<Derived> &matrix, size_t precision=FIXED_PRECISION)
+void truncate_matrix(Eigen::MatrixBase<Derived> &matrix, size_t precision=Derived::Scalar::field_type::FIXED_PRECISION)
 {
     for(size_t i = 0; i < matrix.size(); i++){
         matrix(i).truncate(precision);
@@ -123,7 +116,7 @@ void pack_row(Eigen::PlainObjectBase<Derived> &matrix, octetStreams &os)
 {
     assert(matrix.rows()==os.size());
     const auto *ptr = matrix.data();
-    size_t size_row = matrix.cols() * sizeof(gfpScalar);
+    size_t size_row = matrix.cols() * sizeof(typename Derived::Scalar);
     for(size_t i = 0; i < matrix.rows(); i++){
         os[i].append((octet*)ptr, size_row);
         ptr += matrix.cols();
@@ -142,7 +135,7 @@ void unpack_row(Eigen::PlainObjectBase<Derived> &matrix, octetStreams &os)
 {
     assert(matrix.rows()==os.size());
     const auto *ptr = matrix.data();
-    size_t size_row = matrix.cols() * sizeof(gfpScalar);
+    size_t size_row = matrix.cols() * sizeof(typename Derived::Scalar);
     for(size_t i = 0; i < matrix.rows(); i++){
         // In the reconstruction, os[P] is empty to avoid loopback.
         if(os[i].get_length()){
@@ -166,7 +159,7 @@ void pack_rows(Eigen::PlainObjectBase<Derived> &matrix, const size_t &startRow,
 {
     const auto *ptr = matrix.data();
     ptr += startRow * matrix.cols();
-    o.append((octet*)ptr, nRows * matrix.cols() * sizeof(gfpScalar));
+    o.append((octet*)ptr, nRows * matrix.cols() * sizeof(typename Derived::Scalar));
 }
 
 /**
@@ -183,7 +176,7 @@ void unpack_rows(Eigen::PlainObjectBase<Derived> &matrix, const size_t &startRow
 {
     const auto *ptr = matrix.data();
     ptr += startRow * matrix.cols();
-    o.consume((octet*)ptr, nRows * matrix.cols() * sizeof(gfpScalar));
+    o.consume((octet*)ptr, nRows * matrix.cols() * sizeof(typename Derived::Scalar));
 }
 
 /**
@@ -204,10 +197,10 @@ void pack_rows(Eigen::PlainObjectBase<Derived> &matrix, octetStreams&os)
     // Pack the corresponding block into the octetStream.
     size_t first_n_gfp = first_n_rows * matrix.cols();
     size_t n_gfp = n_rows * matrix.cols();
-    os[0].append((octet*)ptr, first_n_gfp * sizeof(gfpScalar));
+    os[0].append((octet*)ptr, first_n_gfp * sizeof(typename Derived::Scalar));
     ptr += first_n_gfp;
     for(size_t i = 1; i < os.size(); i++){
-        os[i].append((octet*)ptr, n_gfp * sizeof(gfpScalar));
+        os[i].append((octet*)ptr, n_gfp * sizeof(typename Derived::Scalar));
         ptr += n_gfp;
     }
 }
@@ -226,18 +219,131 @@ void unpack_rows(Eigen::PlainObjectBase<Derived>&matrix, octetStreams&os)
     size_t n_gfp = n_rows * matrix.cols();
     
     if(os[0].get_length()){
-        os[0].consume((octet*)ptr, first_n_gfp*sizeof(gfpScalar));
+        os[0].consume((octet*)ptr, first_n_gfp*sizeof(typename Derived::Scalar));
     }
     ptr += first_n_gfp;
 
     for(size_t i = 1; i < os.size(); i++){
         if(os[i].get_length()){
-            os[i].consume((octet*)ptr, n_gfp*sizeof(gfpScalar));
+            os[i].consume((octet*)ptr, n_gfp*sizeof(typename Derived::Scalar));
         }
         ptr += n_gfp;
     }
 }
 
+/**
+ * @brief View the block of rows in the octetViews, without copying it.
+ * The matrix must stay unchanged until the send is waited.
+ *
+ * @tparam Derived
+ * @param matrix [in]
+ * @param startRow start row of the block
+ * @param nRows number of rows in the block.
+ * @param views [out]
+ */
+template<typename Derived>
+void view_rows(const Eigen::PlainObjectBase<Derived> &matrix, const size_t &startRow, const size_t &nRows, octetViews &views)
+{
+    views.append(matrix.data() + startRow * matrix.cols(), nRows * matrix.cols() * sizeof(typename Derived::Scalar));
+}
+
+// View several rows in views[i], with the same partition as pack_rows(matrix, os).
+template<typename Derived>
+void view_rows(const Eigen::PlainObjectBase<Derived> &matrix, vector<octetViews> &views)
+{
+    assert(views.size());
+    size_t n_rows = matrix.rows() / views.size();
+    size_t first_n_rows = matrix.rows() - n_rows * (views.size() - 1);
+    view_rows(matrix, 0, first_n_rows, views[0]);
+    for(size_t i = 1, startRow = first_n_rows; i < views.size(); i++, startRow += n_rows){
+        view_rows(matrix, startRow, n_rows, views[i]);
+    }
+}
+
+/**
+ * @brief Partition n_elements elements to n_parts blocks of consecutive elements.
+ * Without weights, the sizes of the blocks differ by at most one, and the first (n_elements % n_parts) blocks contain one more element.
+ * With weights, the i-th block ends at the element n_elements * (weights[0] + ... + weights[i]) / (sum of weights) (rounded down),
+ * so that the layout only depends on the weights and is the same at every party given the same weights.
+ *
+ * @param n_elements
+ * @param n_parts
+ * @param i index of the block
+ * @param start [out] first element of the block
+ * @param n [out] number of elements in the block
+ * @param weights positive weights of the blocks, or empty for equal blocks
+ */
+inline void partition_elements(size_t n_elements, size_t n_parts, size_t i, size_t &start, size_t &n, const vector<double> &weights = vector<double>())
+{
+    if(weights.empty()){
+        size_t q = n_elements / n_parts, r = n_elements % n_parts;
+        start = i * q + min(i, r);
+        n = q + (i < r);
+        return;
+    }
+    assert(weights.size() == n_parts);
+    double total = 0;
+    for(double w: weights){
+        total += w;
+    }
+    auto bound = [&](size_t k)->size_t{
+        if(k == n_parts){
+            return n_elements;
+        }
+        double sum = 0;
+        for(size_t j = 0; j < k; j++){
+            sum += weights[j];
+        }
+        return min(n_elements, (size_t)(n_elements * (sum / total)));
+    };
+    start = bound(i);
+    n = bound(i + 1) - start;
+}
+
+// Number of chunks of at most chunk elements in a block of n elements (a single chunk if chunk is 0 or the block is empty).
+inline size_t n_chunks(size_t n, size_t chunk)
+{
+    return (chunk == 0 || n == 0) ? 1 : (n + chunk - 1) / chunk;
+}
+
+// The c-th chunk of the block of n elements from start, which starts from the element cs containing cn elements.
+inline void chunk_elements(size_t start, size_t n, size_t chunk, size_t c, size_t &cs, size_t &cn)
+{
+    if(chunk == 0){
+        cs = start;
+        cn = n;
+        return;
+    }
+    cs = start + c * chunk;
+    cn = min(chunk, start + n - cs);
+}
+
+/**
+ * @brief View the block of elements (in row-major order) in the octetViews, without copying it.
+ *
+ * @tparam Derived
+ * @param matrix [in]
+ * @param start first element of the block
+ * @param n number of elements in the block
+ * @param views [out]
+ */
+template<typename Derived>
+void view_elements(const Eigen::PlainObjectBase<Derived> &matrix, const size_t &start, const size_t &n, octetViews &views)
+{
+    views.append(matrix.data() + start, n * sizeof(typename Derived::Scalar));
+}
+
+// View the i-th block of partition_elements() in views[i].
+template<typename Derived>
+void view_elements(const Eigen::PlainObjectBase<Derived> &matrix, vector<octetViews> &views, const vector<double> &weights = vector<double>())
+{
+    for(size_t i = 0; i < views.size(); i++){
+        size_t start, n;
+        partition_elements(matrix.size(), views.size(), i, start, n, weights);
+        view_elements(matrix, start, n, views[i]);
+    }
+}
+
 /**
  * @brief Pack the whole matrix into the octetStream o
  * 
@@ -247,7 +353,7 @@ void unpack_rows(Eigen::PlainObjectBase<Derived>&matrix, octetStreams&os)
 template<typename Derived>
 void pack_matrix(Eigen::PlainObjectBase<Derived> &matrix, octetStream &o)
 {
-    o.append((octet*)matrix.data(), matrix.size()*sizeof(gfpScalar));
+    o.append((octet*)matrix.data(), matrix.size()*sizeof(typename Derived::Scalar));
 }
 
 /**
@@ -259,18 +365,19 @@ void pack_matrix(Eigen::PlainObjectBase<Derived> &matrix, octetStream &o)
 template<typename Derived>
 void unpack_matrix(Eigen::PlainObjectBase<Derived> &matrix, octetStream &o)
 {
-    o.consume((octet*)matrix.data(), matrix.size()*sizeof(gfpScalar));
+    o.consume((octet*)matrix.data(), matrix.size()*sizeof(typename Derived::Scalar));
 }
 
-inline void getMSB_matrix(const gfpMatrix &input, gfpMatrix &res)
+template<class Field>
+inline void getMSB_matrix(const gfpMatrix<Field> &input, gfpMatrix<Field> &res)
 {
     for(size_t i = 0; i < input.size(); i++){
         res(i) = input(i).msb();
     }
 }
 
-template<typename Derived>
-void decompose_bits(gfpScalar x, const size_t &bit_length, Eigen::MatrixBase<Derived>&res)
+template<class Field, typename Derived>
+void decompose_bits(gfpScalar<Field> x, const size_t &bit_length, Eigen::MatrixBase<Derived>&res)
 {
     assert(res.cols() == bit_length);
     assert(res.rows() == 1);
@@ -283,9 +390,10 @@ void decompose_bits(gfpScalar x, const size_t &bit_length, Eigen::MatrixBase<Der
     }
 }
 
-template<typename Derived>
-void decompose_bits(gfpVector x, const size_t &bit_length, Eigen::MatrixBase<Derived>&res)
+template<typename DerivedX, typename Derived>
+void decompose_bits(const Eigen::MatrixBase<DerivedX> &input, const size_t &bit_length, Eigen::MatrixBase<Derived>&res)
 {
+    Eigen::Matrix<typename DerivedX::Scalar, Eigen::Dynamic, 1> x = input;
     assert(res.cols() == bit_length);
     assert(res.rows() == x.size());
     res.setConstant(0);
@@ -300,41 +408,13 @@ void decompose_bits(gfpVector x, const size_t &bit_length, Eigen::MatrixBase<Der
     
 }
 
-// Evaluate the prefix-products. (for batch inversion)
-template<typename Derived>
-void prefixMult(const Eigen::MatrixBase<Derived>&a, Eigen::MatrixBase<Derived>&res)
-{
-    assert(a.size() == res.size());
-    res(0) = a(0);
-    for(size_t i = 1; i < a.size(); i++){
-        res(i) = res(i-1) * a(i);
-    }
-}
-
-// Batch Inversion: Compute n inverse by 3(n-1) multiplications and a single inversion
-inline void batch_inversion(const gfpMatrix&a, gfpMatrix&a_inv)
+// Batch Inversion: Compute n inverse by 3(n-1) multiplications and a single inversion (per chunk in parallel)
+template<class Field>
+inline void batch_inversion(const gfpMatrix<Field>&a, gfpMatrix<Field>&a_inv)
 {
     assert(a.rows() == a_inv.rows());
     assert(a.cols() == a_inv.cols());
-    gfpMatrix a_prefix_mult(a.rows(), a.cols());
-    // p_i = p_i-1 * a_i
-    prefixMult(a, a_prefix_mult);
-
-    gfpMatrix a_prefix_inv(a.rows(), a.cols());
-    gfpScalar inv_all = a_prefix_mult(Eigen::last);
-    inv_all.inverse();
-    // q_n = 1/p_n
-    // q_i-1 = q_i * a_i
-    a_prefix_inv(a.size()-1) = inv_all;
-    for(size_t i = a.size()-1; i >=1; i--){
-        a_prefix_inv(i-1) = a_prefix_inv(i) * a(i);
-    }
-
-    // a_inv_0 = q_0
-    // a_inv_i = p_i-1 * q_i
-    a_inv(0) = a_prefix_inv(0);
-    a_inv.reshaped<Eigen::RowMajor>()(Eigen::seqN(1, a.size()-1)) = a_prefix_mult.reshaped<Eigen::RowMajor>()(Eigen::seqN(0, a.size()-1)).array() * 
-                                                            a_prefix_inv.reshaped<Eigen::RowMajor>()(Eigen::seqN(1, a.size()-1)).array();
+    gfp_batch_inverse<Field>(gfp_data(a_inv), gfp_data(a), a.size());
 }
 
 template<typename Derived>
@@ -367,7 +447,8 @@ void zeroPad(const Eigen::MatrixBase<Derived>&a, Eigen::MatrixBase<Derived>&b,
 // Extend a to b for convolution.
 //imageWidth, imageHeight, outputWeight, outpuHeight, inputFilters, stepStride, filterSize, batchSize
 // For image 2*2 with two features, the storage is feature1(2*2) feature2(2*2)
-inline void convolExtend(const gfpMatrix &a, gfpMatrix&b,
+template<class Field>
+inline void convolExtend(const gfpMatrix<Field> &a, gfpMatrix<Field>&b,
                 size_t iw, size_t ih, size_t ow, size_t oh,
                 size_t Din, size_t S, size_t f, size_t B)
 {
@@ -375,18 +456,19 @@ inline void convolExtend(const gfpMatrix &a, gfpMatrix&b,
     assert(b.cols() == f*f*Din);
     for(size_t i = 0; i < B; i++){
         // auto img = reshape_helper(a.row(i), ih, iw*Din);
-        const gfpMatrix &img = a.row(i).reshaped<RowMajor>(ih*Din, iw);
+        const gfpMatrix<Field> &img = a.row(i).template reshaped<RowMajor>(ih*Din, iw);
         for(size_t j = 0; j < oh; j++)
             for(size_t k = 0; k < ow; k++){
                 // for each feature
                 for(size_t w = 0; w < Din; w++){
-                    b.row(i*ow*oh + j*ow + k).segment(w*f*f, f*f) = img.block(w*ih+j*S, k*S, f, f).reshaped<RowMajor>(1, f*f);
+                    b.row(i*ow*oh + j*ow + k).segment(w*f*f, f*f) = img.block(w*ih+j*S, k*S, f, f).template reshaped<RowMajor>(1, f*f);
                 }
             }
     }
 }
 
-inline void maxpoolExtend(const gfpMatrix &a, gfpMatrix&b,
+template<class Field>
+inline void maxpoolExtend(const gfpMatrix<Field> &a, gfpMatrix<Field>&b,
                 size_t iw, size_t ih, size_t ow, size_t oh,
                 size_t Din, size_t S, size_t f, size_t B)
 {
@@ -394,12 +476,12 @@ inline void maxpoolExtend(const gfpMatrix &a, gfpMatrix&b,
     assert(b.cols() == f*f);
     for(size_t i = 0; i < B; i++){
         // auto img = reshape_helper(a.row(i), ih, iw*Din);
-        const gfpMatrix &img = a.row(i).reshaped<RowMajor>(ih*Din, iw);
+        const gfpMatrix<Field> &img = a.row(i).template reshaped<RowMajor>(ih*Din, iw);
         for(size_t w = 0; w < Din; w++)// for each feature
             for(size_t j = 0; j < oh; j++)
                 for(size_t k = 0; k < ow; k++){
-                    // b.row(i*ow*oh + j*ow + k).segment(w*f*f, f*f) = img.block(w*ih+j*S, k*S, f, f).reshaped<RowMajor>(1, f*f);
-                    b.row(i*ow*oh*Din + w*ow*oh + j*ow + k) = img.block(w*ih+j*S, k*S, f, f).reshaped<RowMajor>(1, f*f);
+                    // b.row(i*ow*oh + j*ow + k).segment(w*f*f, f*f) = img.block(w*ih+j*S, k*S, f, f).template reshaped<RowMajor>(1, f*f);
+                    b.row(i*ow*oh*Din + w*ow*oh + j*ow + k) = img.block(w*ih+j*S, k*S, f, f).template reshaped<RowMajor>(1, f*f);
                 }
             
     }
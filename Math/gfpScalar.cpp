@@ -0,0 +1,13 @@
+#include "Math/gfpScalar.h"
+
+namespace hmmpc
+{
+
+// Definitions of the constants of each field, in case they are bound to a reference.
+constexpr const char *PR31::NAME;
+constexpr size_t PR31::GEMM_LAZY_BLOCK;
+
+constexpr const char *PR61::NAME;
+constexpr size_t PR61::GEMM_LAZY_BLOCK;
+
+}
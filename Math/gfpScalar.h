@@ -1,8 +1,8 @@
 #ifndef MATH_GFP_SCALAR_H_
 #define MATH_GFP_SCALAR_H_
 
-// TYPE = {PR_31, PR_61}
-#define PR_31
+// Field = {PR31, PR61}
+// Every field-dependent class and function is a template of the Field, which is instantiated for both fields.
 
 #include <iostream>
 #include <Eigen/Core>
@@ -11,145 +11,7 @@
 namespace hmmpc
 {
 
-#if defined(PR_31) && !defined(PR_61)
-using TYPE = unsigned int;//{unsigned int, uint64_t}
-using DTYPE = uint64_t;//{uint64_t, __uint128_t}
-using STYPE = int;//{int, int64_t}
-using u64 = uint64_t;
-// {31, 61, 127}
-const int MERSENNE_PRIME_EXP=31;
-const int PRIME_LENGTH = MERSENNE_PRIME_EXP;
-const static TYPE PR = 2147483647;
-const static DTYPE pr = 2147483647;
-
-const static TYPE RSQRT_CONST = 1610612734; // rsqrt = x^{RSQRT_CONST} = 1/sqrt(x)
-
-// Bit
-const static size_t BITS_LENGTH = 31; // {31, 61}
-const static size_t n_BITS_LENGTH = 5; // {5, 6}6 = log(61)+1
-const static size_t FIXED_PRECISION =12; // 11 bits for fixed point part
-
-const static TYPE ConstTwoInverse = 1073741824;
-
-#elif defined(PR_61) && !defined(PR_31)
-using TYPE = uint64_t;//{unsigned int, uint64_t}
-using DTYPE = __uint128_t;//{uint64_t, __uint128_t}
-using STYPE = int64_t;//{int, int64_t}
-using u64 = uint64_t;
-const int MERSENNE_PRIME_EXP=61;
-const int PRIME_LENGTH = MERSENNE_PRIME_EXP;
-const static TYPE PR = 2305843009213693951;
-const static DTYPE pr = 2305843009213693951;
-
-const static TYPE RSQRT_CONST = 1729382256910270462; // rsqrt = x^{RSQRT_CONST} = 1/sqrt(x)
-
-// Bit
-const static size_t BITS_LENGTH = 61; // {31, 61}
-const static size_t n_BITS_LENGTH = 6; // {5, 6}6 = log(61)+1
-const static size_t FIXED_PRECISION = 13; // 21 bits for fixed point part
-
-const static TYPE ConstTwoInverse = 1152921504606846976;
-#endif
-
-static SeededPRNG secure_prng; // PRNG
-const static TYPE MID_PR = ((PR-1)>>1) +1; // Middle point
-
-const static TYPE SQRT_EXP = (PR+1)>>2; // sqrt(x) = x^{SQRT_EXP}
-const static TYPE INVERSE_CONST = PR-2; // inv = x^{PR-2}
-
-const static size_t INT_PRECISION = BITS_LENGTH - FIXED_PRECISION; // 40 bits for integer part
-const static TYPE MAX_POSITIVE = PR >>1;
-
-const static TYPE ConstGapInTruncation = ((TYPE)1<<INT_PRECISION) - 1;
-const static TYPE ConstEncode = (TYPE)1 << (BITS_LENGTH - 2);
-const static TYPE ConstDecode = (TYPE)1 << (BITS_LENGTH - 2 - FIXED_PRECISION);
-
-template<typename T> T additive_inverse(const T x);
-template<typename T> T multiplicative_inverse(const T x);
-template<typename T> bool test_inverse(T a, T b);
-template<typename T> T add_mod(T a, T b);
-template<typename T> T mult_mod(T a, T b);
-template<typename T> T modPrime(T x);
-template<typename T> void extend_gcd(const T, const T, T &x, T &y);
-class gfpScalar;
-template<typename T>
-using eMatrix=Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
-using gfpMatrix=Eigen::Matrix<gfpScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
-using gfpVector= Eigen::Matrix<gfpScalar, Eigen::Dynamic, 1>;
-
-
-class gfpScalar
-{
-    // Operations between gfpScalars
-    friend istream& operator>>(istream &is, gfpScalar &it);
-    friend ostream& operator<<(ostream &os,const gfpScalar &it);
-    friend bool operator<(const gfpScalar &a, const gfpScalar &b);
-    friend bool operator==(const gfpScalar &a, const gfpScalar &b);
-    friend bool operator!=(const gfpScalar &a, const gfpScalar &b);
-    friend bool operator<=(const gfpScalar &a, const gfpScalar &b);
-    friend bool operator>(const gfpScalar &a, const gfpScalar &b);
-    friend bool operator>=(const gfpScalar &a, const gfpScalar &b);
-    friend gfpScalar operator+(const gfpScalar &a, const gfpScalar &b);
-    friend gfpScalar operator-(const gfpScalar &a, const gfpScalar &b);
-    friend gfpScalar operator*(const gfpScalar &a, const gfpScalar &b);
-    friend gfpScalar operator/(const gfpScalar &a, const gfpScalar &b);
-    friend gfpScalar operator&(const gfpScalar &a,const gfpScalar &b);
-    friend gfpScalar operator<<(const gfpScalar &a, const gfpScalar &x); // left shift bits
-    friend gfpScalar operator>>(const gfpScalar &a, const gfpScalar &x);
-
-    friend gfpScalar sqrt(const gfpScalar &x);
-    friend gfpScalar rsqrt(const gfpScalar &x);
-    friend gfpScalar square(const gfpScalar &x);
-    template<typename T>
-    friend gfpScalar pow(const gfpScalar &x,T exp);
-    friend gfpScalar inverse(const gfpScalar &x);
-    friend gfpScalar truncate(const gfpScalar &x, size_t d);
-
-protected:
-    TYPE value;
-public:
-    gfpScalar()=default;
-    gfpScalar(TYPE _value):value(_value){}
-    TYPE get_value()const{return value;}
-    void set_value(TYPE &_v){value=_v;}
-
-    gfpScalar operator-()const;
-    gfpScalar& operator+=(const gfpScalar &other);
-    gfpScalar& operator-=(const gfpScalar &other);
-    gfpScalar& operator*=(const gfpScalar &other);
-    gfpScalar& operator/=(const gfpScalar &other);
-    gfpScalar& operator&=(const gfpScalar &other); // bitwise &
-    gfpScalar& operator<<=(const gfpScalar &other); // left shitf
-    gfpScalar& operator>>=(const gfpScalar &other); // right shift
-    
-
-    // Basic Math Methods
-    gfpScalar& square(); // a^2
-    gfpScalar& sqrt(); // sqrt(a)
-    gfpScalar& inverse(); // 1/a
-    gfpScalar& rsqrt(); // 1/sqrt(a)
-    template<typename T>
-    gfpScalar& pow(T exp);
-
-    // Get Bit
-
-    // Random Methods
-    void random();
-    void random_bit();
-
-    // Pack/Unpack Methods into/from the octetStream
-    void pack(octetStream &o);
-    void unpack(octetStream &o);
-
-    // For sint and sfix
-    bool is_zero()const {return value == 0;}
-    bool is_negative()const {return value > MAX_POSITIVE;}
-    gfpScalar& truncate(size_t d = FIXED_PRECISION); // Right shift bits with sign bit.
-    gfpScalar& magnify(); // Left shift bits with sign bit
-    gfpScalar msb()const{return (TYPE)is_negative();}
-
-};
-
+static thread_local SeededPRNG secure_prng; // PRNG of each thread
 
 #if defined(__x86_64__) && defined(__BMI2__)
 inline uint64_t mul64(uint64_t a, uint64_t b, uint64_t *c)
@@ -183,185 +45,253 @@ inline unsigned int mul32(unsigned int a, unsigned int b, unsigned int *c)
 }
 // #endif
 
+/**
+ * @brief Constants of the field modulo the Mersenne prime PR = 2^EXP-1.
+ * The elements are stored in T, their products in D and the signed (fixed-point) values in S.
+ * The fixed-point numbers have PRECISION fractional bits.
+ * Every constant is a compile-time constant of the field, so the kernels of each field are constant-folded.
+ */
+template<typename T, typename D, typename S, int EXP, size_t PRECISION>
+struct MersenneField
+{
+    typedef T TYPE;
+    typedef D DTYPE;
+    typedef S STYPE;
+    static constexpr int MERSENNE_PRIME_EXP = EXP;
+    static constexpr TYPE PR = ((TYPE)1 << EXP) - 1;
+    static constexpr DTYPE pr = PR;
+
+    static constexpr TYPE MID_PR = ((PR-1)>>1) +1; // Middle point
+    static constexpr TYPE SQRT_EXP = (PR+1)>>2; // sqrt(x) = x^{SQRT_EXP}
+    static constexpr TYPE INVERSE_CONST = PR-2; // inv = x^{PR-2}
+    static constexpr TYPE RSQRT_CONST = PR-1-SQRT_EXP; // rsqrt = x^{RSQRT_CONST} = 1/sqrt(x)
+    static constexpr TYPE ConstTwoInverse = MID_PR; // 1/2 = 2^{EXP-1}
+
+    // Bit
+    static constexpr size_t BITS_LENGTH = EXP;
+    static constexpr size_t FIXED_PRECISION = PRECISION;
+    static constexpr size_t INT_PRECISION = BITS_LENGTH - FIXED_PRECISION;
+    static constexpr TYPE MAX_POSITIVE = PR >>1;
+
+    static constexpr TYPE ConstGapInTruncation = ((TYPE)1<<INT_PRECISION) - 1;
+    static constexpr TYPE ConstEncode = (TYPE)1 << (BITS_LENGTH - 2);
+    static constexpr TYPE ConstDecode = (TYPE)1 << (BITS_LENGTH - 2 - FIXED_PRECISION);
+    static constexpr TYPE FACTOR = (TYPE)1 << FIXED_PRECISION;
+};
 
-template<typename T>
-inline T add_mod(T a, T b)
+#define MERSENNE_FIELD_CONSTANT(TYPE, NAME) \
+    template<typename T, typename D, typename S, int EXP, size_t PRECISION> \
+    constexpr TYPE MersenneField<T, D, S, EXP, PRECISION>::NAME;
+MERSENNE_FIELD_CONSTANT(int, MERSENNE_PRIME_EXP)
+MERSENNE_FIELD_CONSTANT(T, PR)
+MERSENNE_FIELD_CONSTANT(D, pr)
+MERSENNE_FIELD_CONSTANT(T, MID_PR)
+MERSENNE_FIELD_CONSTANT(T, SQRT_EXP)
+MERSENNE_FIELD_CONSTANT(T, INVERSE_CONST)
+MERSENNE_FIELD_CONSTANT(T, RSQRT_CONST)
+MERSENNE_FIELD_CONSTANT(T, ConstTwoInverse)
+MERSENNE_FIELD_CONSTANT(size_t, BITS_LENGTH)
+MERSENNE_FIELD_CONSTANT(size_t, FIXED_PRECISION)
+MERSENNE_FIELD_CONSTANT(size_t, INT_PRECISION)
+MERSENNE_FIELD_CONSTANT(T, MAX_POSITIVE)
+MERSENNE_FIELD_CONSTANT(T, ConstGapInTruncation)
+MERSENNE_FIELD_CONSTANT(T, ConstEncode)
+MERSENNE_FIELD_CONSTANT(T, ConstDecode)
+MERSENNE_FIELD_CONSTANT(T, FACTOR)
+#undef MERSENNE_FIELD_CONSTANT
+
+//* PR = 2^{31}-1
+struct PR31: MersenneField<unsigned int, uint64_t, int, 31, 12> // 12 bits for fixed point part
+{
+    static constexpr const char *NAME = "PR31";
+    static constexpr size_t GEMM_LAZY_BLOCK = 4; // See gfp_gemm()
+
+    // Low bits of a*b, and the high bits in c
+    static TYPE mul(TYPE a, TYPE b, TYPE *c){return mul32(a, b, c);}
+    static TYPE random_word(PRNG &prng){return prng.get_uint();}
+};
+
+//* PR = 2^{61}-1
+struct PR61: MersenneField<uint64_t, __uint128_t, int64_t, 61, 13> // 13 bits for fixed point part
 {
-    T ret = a+b;
-    return (ret >= PR) ? (ret - PR) : ret;
-}
+    static constexpr const char *NAME = "PR61";
+    static constexpr size_t GEMM_LAZY_BLOCK = 64;
 
+    static TYPE mul(TYPE a, TYPE b, TYPE *c){return mul64(a, b, c);}
+    static TYPE random_word(PRNG &prng){return prng.get_word();}
+};
 
+template<class Field> class gfpScalar;
 template<typename T>
-inline T mult_mod(T a, T b)
+using eMatrix=Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+template<class Field>
+using gfpMatrix=Eigen::Matrix<gfpScalar<Field>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+template<class Field>
+using gfpVector= Eigen::Matrix<gfpScalar<Field>, Eigen::Dynamic, 1>;
+
+/*************************************************
+ *
+ *       Arithmetic over the raw elements
+ * The field is given explicitly, e.g. add_mod<Field>(a, b).
+ *
+ * ***********************************************/
+template<class Field>
+inline typename Field::TYPE add_mod(typename Field::TYPE a, typename Field::TYPE b)
+{
+    typename Field::TYPE ret = a+b;
+    return (ret >= Field::PR) ? (ret - Field::PR) : ret;
+}
+
+template<class Field>
+inline typename Field::TYPE mult_mod(typename Field::TYPE a, typename Field::TYPE b)
 {
+    typedef typename Field::TYPE T;
     T c = 0;
-    T e, ret;
-#if defined(PR_31) 
-    e = mul32((unsigned int)a, (unsigned int)b, (unsigned int*)&c);
-    ret = (e & PR) + ( (e>>MERSENNE_PRIME_EXP) ^ ((T)c<< (32-MERSENNE_PRIME_EXP)));
-#elif defined(PR_61)
-    e = mul64((uint64_t)a, (uint64_t)b, (uint64_t*)&c);
-    ret = (e & PR) + ( (e>>MERSENNE_PRIME_EXP) ^ (c<< (64-MERSENNE_PRIME_EXP)));
-#endif
+    T e = Field::mul(a, b, &c);
     // c is most significant bits
     // e is low significant bits
-    return (ret >= PR) ? (ret-PR) : ret;
+    T ret = (e & Field::PR) + ( (e>>Field::MERSENNE_PRIME_EXP) ^ (c<< (8*sizeof(T)-Field::MERSENNE_PRIME_EXP)));
+    return (ret >= Field::PR) ? (ret-Field::PR) : ret;
 }
 
-template<typename T>
+// x could be wider than an element, e.g. the accumulator of gfp_gemm in DTYPE
+template<class Field, typename T>
 inline T modPrime(T x)
 {
-    T i = (x & PR) + (x >> MERSENNE_PRIME_EXP);
-    return (i>=PR) ? i - PR: i;
+    T i = (x & Field::PR) + (x >> Field::MERSENNE_PRIME_EXP);
+    return (i>=Field::PR) ? i - Field::PR: i;
 }
 
-template<typename T>
-inline void extend_gcd(const T a, const T b, T& x, T& y)
+template<class Field>
+inline typename Field::TYPE additive_inverse(const typename Field::TYPE x)
+{
+    if(x==0){return 0;}// BUG LOG
+    return Field::PR^x;
+}
+
+template<class Field>
+inline void extend_gcd(const typename Field::TYPE a, const typename Field::TYPE b, typename Field::TYPE& x, typename Field::TYPE& y)
 {
     if(b==0){
         x = 1;
         y = 0;
         return;
     }
-    extend_gcd(b, a%b, y, x);
+    extend_gcd<Field>(b, a%b, y, x);
     // a/b * x  execeed TYPE
-    T tmp = mult_mod((T)(a/b), x);
-    y = add_mod(y, additive_inverse(tmp));
+    typename Field::TYPE tmp = mult_mod<Field>(a/b, x);
+    y = add_mod<Field>(y, additive_inverse<Field>(tmp));
     return;
 }
 
-template<typename T>
-inline T additive_inverse(const T x)
+template<class Field>
+inline typename Field::TYPE multiplicative_inverse(const typename Field::TYPE it)
 {
-    if(x==0){return 0;}// BUG LOG
-    return PR^x;
-}
-
-template<typename T>
-inline T multiplicative_inverse(const T it)
-{
-    T x, y;
-    extend_gcd((const T)PR, (const T)it, x, y);
+    typename Field::TYPE x, y;
+    extend_gcd<Field>(Field::PR, it, x, y);
     return y;
 }
 
-template<typename T>
-inline bool test_inverse(T a, T b)
+template<class Field>
+inline bool test_inverse(typename Field::TYPE a, typename Field::TYPE b)
 {
-    return mult_mod(a, b)==1;
+    return mult_mod<Field>(a, b)==1;
 }
 
-inline istream& operator>>(istream &is, gfpScalar &it)
-{
-    is>>it.value;
-    return is;
-}
-
-inline ostream& operator<<(ostream &os, const gfpScalar &it)
-{
-    os<<it.value;
-    return os;
-}
-
-inline gfpScalar operator+(const gfpScalar &a, const gfpScalar &b)
-{
-    return gfpScalar(add_mod(a.value, b.value));
-}
-
-inline gfpScalar gfpScalar::operator-()const
-{
-    return gfpScalar(additive_inverse(value));
-}
-
-inline gfpScalar& gfpScalar::operator+=(const gfpScalar &other)
-{
-    value = add_mod(value, other.value);
-    return *this;
-}
-
-inline gfpScalar operator-(const gfpScalar &a, const gfpScalar &b)
-{
-    return gfpScalar(add_mod(a.value, additive_inverse(b.value)));
-}
-
-inline gfpScalar& gfpScalar::operator-=(const gfpScalar &other)
-{
-    value = add_mod(value, additive_inverse(other.value));
-    return *this;
-}
-
-inline gfpScalar operator*(const gfpScalar &a, const gfpScalar &b)
+/**
+ * @brief Element of the field.
+ * The operators are the friends defined in the class, such that the integers are converted implicitly, e.g. x + 1.
+ */
+template<class Field>
+class gfpScalar
 {
-    return gfpScalar(mult_mod(a.value, b.value));
-}
+public:
+    typedef Field field_type;
+    typedef typename Field::TYPE TYPE;
 
-inline gfpScalar& gfpScalar::operator*=(const gfpScalar &other)
-{
-    value = mult_mod(value, other.value);
-    return *this;
-}
+protected:
+    TYPE value;
+public:
+    gfpScalar()=default;
+    gfpScalar(TYPE _value):value(_value){}
+    TYPE get_value()const{return value;}
+    void set_value(TYPE &_v){value=_v;}
 
-inline gfpScalar operator/(const gfpScalar &a, const gfpScalar &b)
-{
-    return gfpScalar(mult_mod(a.value, multiplicative_inverse(b.value)));
-}
+    gfpScalar operator-()const{return gfpScalar(additive_inverse<Field>(value));}
+    gfpScalar& operator+=(const gfpScalar &other){value = add_mod<Field>(value, other.value); return *this;}
+    gfpScalar& operator-=(const gfpScalar &other){value = add_mod<Field>(value, additive_inverse<Field>(other.value)); return *this;}
+    gfpScalar& operator*=(const gfpScalar &other){value = mult_mod<Field>(value, other.value); return *this;}
+    gfpScalar& operator/=(const gfpScalar &other){value = mult_mod<Field>(value, multiplicative_inverse<Field>(other.value)); return *this;}
+    gfpScalar& operator&=(const gfpScalar &other){value &= other.value; return *this;} // bitwise &
+    gfpScalar& operator<<=(const gfpScalar &other){value <<= other.value; return *this;} // left shitf
+    gfpScalar& operator>>=(const gfpScalar &other){value >>= other.value; return *this;} // right shift
 
-inline gfpScalar& gfpScalar::operator/=(const gfpScalar &other)
-{
-    value = mult_mod(value, multiplicative_inverse(other.value));
-    return *this;
-}
 
-inline bool operator==(const gfpScalar &a, const gfpScalar &b)
-{
-    return a.value == b.value;
-}
+    // Basic Math Methods
+    gfpScalar& square(); // a^2
+    gfpScalar& sqrt(); // sqrt(a)
+    gfpScalar& inverse(); // 1/a
+    gfpScalar& rsqrt(); // 1/sqrt(a)
+    template<typename T>
+    gfpScalar& pow(T exp);
 
-inline bool operator!=(const gfpScalar &a, const gfpScalar &b)
-{
-    return a.value != b.value;
-}
+    // Get Bit
 
-inline bool operator<(const gfpScalar &a, const gfpScalar &b)
-{
-    return a.value < b.value;
-}
+    // Random Methods
+    void random();
+    void random_bit();
 
-inline bool operator<=(const gfpScalar &a, const gfpScalar &b)
-{
-    return (a.value < b.value)||(a.value == b.value);
-}
+    // Pack/Unpack Methods into/from the octetStream
+    void pack(octetStream &o);
+    void unpack(octetStream &o);
 
-inline bool operator>(const gfpScalar &a, const gfpScalar &b)
-{
-    return (a.value > b.value);
-}
+    // For sint and sfix
+    bool is_zero()const {return value == 0;}
+    bool is_negative()const {return value > Field::MAX_POSITIVE;}
+    gfpScalar& truncate(size_t d = Field::FIXED_PRECISION); // Right shift bits with sign bit.
+    gfpScalar& magnify(); // Left shift bits with sign bit
+    gfpScalar msb()const{return (TYPE)is_negative();}
 
-inline bool operator>=(const gfpScalar &a, const gfpScalar &b)
-{
-    return !(a.value < b.value);
-}
+    // Operations between gfpScalars
+    friend istream& operator>>(istream &is, gfpScalar &it){is>>it.value; return is;}
+    friend ostream& operator<<(ostream &os,const gfpScalar &it){os<<it.value; return os;}
+    friend bool operator<(const gfpScalar &a, const gfpScalar &b){return a.value < b.value;}
+    friend bool operator==(const gfpScalar &a, const gfpScalar &b){return a.value == b.value;}
+    friend bool operator!=(const gfpScalar &a, const gfpScalar &b){return a.value != b.value;}
+    friend bool operator<=(const gfpScalar &a, const gfpScalar &b){return (a.value < b.value)||(a.value == b.value);}
+    friend bool operator>(const gfpScalar &a, const gfpScalar &b){return (a.value > b.value);}
+    friend bool operator>=(const gfpScalar &a, const gfpScalar &b){return !(a.value < b.value);}
+    friend gfpScalar operator+(const gfpScalar &a, const gfpScalar &b){return gfpScalar(add_mod<Field>(a.value, b.value));}
+    friend gfpScalar operator-(const gfpScalar &a, const gfpScalar &b){return gfpScalar(add_mod<Field>(a.value, additive_inverse<Field>(b.value)));}
+    friend gfpScalar operator*(const gfpScalar &a, const gfpScalar &b){return gfpScalar(mult_mod<Field>(a.value, b.value));}
+    friend gfpScalar operator/(const gfpScalar &a, const gfpScalar &b){return gfpScalar(mult_mod<Field>(a.value, multiplicative_inverse<Field>(b.value)));}
+    friend gfpScalar operator&(const gfpScalar &a,const gfpScalar &b){return gfpScalar(a.value & b.value);}
+    friend gfpScalar operator<<(const gfpScalar &a, const gfpScalar &x){return gfpScalar(a.value<<x.value);} // left shift bits
+    friend gfpScalar operator>>(const gfpScalar &a, const gfpScalar &x){return gfpScalar(a.value>>x.value);}
+
+    friend gfpScalar sqrt(const gfpScalar &x){gfpScalar res(x); return res.sqrt();}
+    friend gfpScalar rsqrt(const gfpScalar &x){gfpScalar res(x); return res.rsqrt();}
+    friend gfpScalar square(const gfpScalar &x){return gfpScalar(mult_mod<Field>(x.value, x.value));}
+    template<typename T>
+    friend gfpScalar pow(const gfpScalar &x,T exp){gfpScalar res(x); return res.pow(exp);}
+    friend gfpScalar truncate(const gfpScalar &x, size_t d = Field::FIXED_PRECISION){gfpScalar res(x); return res.truncate(d);}
+};
 
 /*************************************************
- * 
+ *
  *       Basic Math Methods
- * 
+ *
  * ***********************************************/
-inline gfpScalar& gfpScalar::square()
+template<class Field>
+inline gfpScalar<Field>& gfpScalar<Field>::square()
 {
-    value = mult_mod(value, value);
+    value = mult_mod<Field>(value, value);
     return *this;
 }
 
-inline gfpScalar square(const gfpScalar &x)
-{
-    return gfpScalar(mult_mod(x.value, x.value));
-}
-
-
+template<class Field>
 template<typename T>
-inline gfpScalar& gfpScalar::pow(T exp)
+inline gfpScalar<Field>& gfpScalar<Field>::pow(T exp)
 {
     gfpScalar res(1);
     gfpScalar v_pow = *this;
@@ -374,42 +304,21 @@ inline gfpScalar& gfpScalar::pow(T exp)
     return *this;
 }
 
-template<typename T>
-inline gfpScalar pow(const gfpScalar &x, T exp)
-{
-    gfpScalar res(1);
-    gfpScalar v_pow = x;
-    while(exp){
-        if(exp&1){res *= v_pow;}
-        exp >>=1;
-        v_pow.square();
-    }
-    return res;
-}
-
-inline gfpScalar& gfpScalar::sqrt()
+template<class Field>
+inline gfpScalar<Field>& gfpScalar<Field>::sqrt()
 {
     assert(value>0);
-    pow((TYPE)SQRT_EXP);
-    if(value>=1 && value<MID_PR){return *this;}
+    pow((TYPE)Field::SQRT_EXP);
+    if(value>=1 && value<Field::MID_PR){return *this;}
     else{
-        value = additive_inverse(value);
+        value = additive_inverse<Field>(value);
         return *this;
     }
 }
 
-inline gfpScalar sqrt(const gfpScalar &x)
-{
-    assert(x.value>0);
-    gfpScalar res = pow(x, (TYPE)SQRT_EXP);
-    if(res.value>=1 && res.value<MID_PR){return res;}
-    else{
-        return -res;
-    }
-}
-
 // BUG LOG: Need to invoke sqrt to ensure the rang is [1, (p-1)/2]
-inline gfpScalar& gfpScalar::rsqrt()
+template<class Field>
+inline gfpScalar<Field>& gfpScalar<Field>::rsqrt()
 {
     if(value==0){return *this;} // For simplicity.
 
@@ -420,140 +329,96 @@ inline gfpScalar& gfpScalar::rsqrt()
     return *this;
 }
 
-
-inline gfpScalar rsqrt(const gfpScalar &x)
+template<class Field>
+inline gfpScalar<Field>& gfpScalar<Field>::inverse()
 {
-    if(x.value==0){return x;} // For simplicity.
-
-    gfpScalar res = x;
-    res.sqrt();
-    res.inverse();
-    return res;
-    // return pow(x, RSQRT_CONST);
-}
-
-inline gfpScalar& gfpScalar::inverse()
-{
-    value = multiplicative_inverse(value);
+    value = multiplicative_inverse<Field>(value);
     return *this;
 }
 
-inline gfpScalar operator&(const gfpScalar &a,const gfpScalar &b)
-{
-    return gfpScalar(a.value & b.value);
-}
-
-inline gfpScalar& gfpScalar::operator&=(const gfpScalar &other)
-{
-    value &= other.value;
-    return *this;
-}
-
-inline gfpScalar operator<<(const gfpScalar &a, const gfpScalar &x)
-{
-    return gfpScalar(a.value<<x.value);
-}
-
-inline gfpScalar operator>>(const gfpScalar &a, const gfpScalar &x)
-{
-    return gfpScalar(a.value>>x.value);
-}
-
-inline gfpScalar& gfpScalar::operator<<=(const gfpScalar &other)
-{
-    value <<=other.value;
-    return *this;
-}
-
-inline gfpScalar& gfpScalar::operator>>=(const gfpScalar &other)
-{
-    value >>=other.value;
-    return *this;
-}
 /*************************************************
- * 
+ *
  *       Custom Methods
 
  * ***********************************************/
-inline void gfpScalar::random()
+template<class Field>
+inline void gfpScalar<Field>::random()
 {
-#if defined(PR_31) 
-    value = modPrime((unsigned int)secure_prng.get_uint());
-#elif defined(PR_61)
-    value = modPrime(secure_prng.get_word());
-#endif
+    value = modPrime<Field>(Field::random_word(secure_prng));
 }
 
-inline void gfpScalar::random_bit()
+template<class Field>
+inline void gfpScalar<Field>::random_bit()
 {
     value = secure_prng.get_bit();
 }
 
-inline void gfpScalar::pack(octetStream &o)
+template<class Field>
+inline void gfpScalar<Field>::pack(octetStream &o)
 {
     o.append((octet*)&value, sizeof(value));
 }
 
-inline void gfpScalar::unpack(octetStream &o)
+template<class Field>
+inline void gfpScalar<Field>::unpack(octetStream &o)
 {
     o.consume((octet*)&value, sizeof(value));
 }
 
 // Truncate d bits if there is a sign bit.
-inline gfpScalar& gfpScalar::truncate(size_t d)
+template<class Field>
+inline gfpScalar<Field>& gfpScalar<Field>::truncate(size_t d)
 {
     if(is_negative()){
-        value = additive_inverse(value);
+        value = additive_inverse<Field>(value);
         value >>= d;
-        value = additive_inverse(value);
+        value = additive_inverse<Field>(value);
     }else{
         value >>= d;
     }
     return *this;
 }
 
-inline gfpScalar truncate(const gfpScalar &x, size_t d = FIXED_PRECISION)
-{
-    gfpScalar res(x);
-    return res.truncate(d);
-}
-
-inline gfpScalar& gfpScalar::magnify()
+template<class Field>
+inline gfpScalar<Field>& gfpScalar<Field>::magnify()
 {
     if(is_negative()){
-        value = additive_inverse(value);
-        value <<= FIXED_PRECISION;
-        value = additive_inverse(value);
+        value = additive_inverse<Field>(value);
+        value <<= Field::FIXED_PRECISION;
+        value = additive_inverse<Field>(value);
     }else{
-        value <<= FIXED_PRECISION;
+        value <<= Field::FIXED_PRECISION;
     }
     return *this;
 }
 
-inline gfpScalar map_int_to_gfp(const STYPE &x)
+template<class Field>
+inline gfpScalar<Field> map_int_to_gfp(const typename Field::STYPE &x)
 {
-    if(x<0) { return gfpScalar(x + (STYPE)PR);}
-    return gfpScalar((TYPE)x);
+    typedef typename Field::STYPE STYPE;
+    if(x<0) { return gfpScalar<Field>(x + (STYPE)Field::PR);}
+    return gfpScalar<Field>((typename Field::TYPE)x);
 }
 
-inline STYPE map_gfp_to_int(const gfpScalar &x)
+template<class Field>
+inline typename Field::STYPE map_gfp_to_int(const gfpScalar<Field> &x)
 {
+    typedef typename Field::STYPE STYPE;
     STYPE res = x.get_value();
-    if(res > MAX_POSITIVE){ res -= (STYPE)PR;}
+    if(res > (STYPE)Field::MAX_POSITIVE){ res -= (STYPE)Field::PR;}
     return res;
 }
 
-
-const static TYPE FACTOR = 1<<FIXED_PRECISION;
-
-inline gfpScalar map_float_to_gfp(const double &x)
+template<class Field>
+inline gfpScalar<Field> map_float_to_gfp(const double &x)
 {
-    return map_int_to_gfp((STYPE)floor(x * FACTOR));
+    return map_int_to_gfp<Field>((typename Field::STYPE)floor(x * Field::FACTOR));
 }
 
-inline double map_gfp_to_float(const gfpScalar &x)
+template<class Field>
+inline double map_gfp_to_float(const gfpScalar<Field> &x)
 {
-    return ((double)map_gfp_to_int(x)) / (float)FACTOR;
+    return ((double)map_gfp_to_int(x)) / (float)Field::FACTOR;
 }
 
 
@@ -561,12 +426,12 @@ inline double map_gfp_to_float(const gfpScalar &x)
 } // namespace gfp_base
 
 namespace Eigen{
-template<> struct NumTraits<hmmpc::gfpScalar>
+template<class Field> struct NumTraits<hmmpc::gfpScalar<Field>>
 : NumTraits<unsigned int>
 {
-    typedef hmmpc::gfpScalar Real;
-    typedef hmmpc::gfpScalar NonInteger;
-    typedef hmmpc::gfpScalar Nested;
+    typedef hmmpc::gfpScalar<Field> Real;
+    typedef hmmpc::gfpScalar<Field> NonInteger;
+    typedef hmmpc::gfpScalar<Field> Nested;
 
     enum {
     IsComplex = 0,
@@ -578,22 +443,27 @@ template<> struct NumTraits<hmmpc::gfpScalar>
     MulCost = 3
   };
 };
-    template<typename BinaryOp>
-    struct ScalarBinaryOpTraits<hmmpc::gfpScalar, hmmpc::TYPE, BinaryOp> { typedef hmmpc::gfpScalar ReturnType;  };
-    template<typename BinaryOp>
-    struct ScalarBinaryOpTraits<hmmpc::TYPE, hmmpc::gfpScalar, BinaryOp> { typedef hmmpc::gfpScalar ReturnType;  };
+    template<class Field, typename BinaryOp>
+    struct ScalarBinaryOpTraits<hmmpc::gfpScalar<Field>, unsigned int, BinaryOp> { typedef hmmpc::gfpScalar<Field> ReturnType;  };
+    template<class Field, typename BinaryOp>
+    struct ScalarBinaryOpTraits<unsigned int, hmmpc::gfpScalar<Field>, BinaryOp> { typedef hmmpc::gfpScalar<Field> ReturnType;  };
+
+    template<class Field, typename BinaryOp>
+    struct ScalarBinaryOpTraits<hmmpc::gfpScalar<Field>, uint64_t, BinaryOp> { typedef hmmpc::gfpScalar<Field> ReturnType;  };
+    template<class Field, typename BinaryOp>
+    struct ScalarBinaryOpTraits<uint64_t, hmmpc::gfpScalar<Field>, BinaryOp> { typedef hmmpc::gfpScalar<Field> ReturnType;  };
 
-    template<typename BinaryOp>
-    struct ScalarBinaryOpTraits<hmmpc::gfpScalar, int, BinaryOp> { typedef hmmpc::gfpScalar ReturnType;  };
-    template<typename BinaryOp>
-    struct ScalarBinaryOpTraits<int, hmmpc::gfpScalar, BinaryOp> { typedef hmmpc::gfpScalar ReturnType;  };
+    template<class Field, typename BinaryOp>
+    struct ScalarBinaryOpTraits<hmmpc::gfpScalar<Field>, int, BinaryOp> { typedef hmmpc::gfpScalar<Field> ReturnType;  };
+    template<class Field, typename BinaryOp>
+    struct ScalarBinaryOpTraits<int, hmmpc::gfpScalar<Field>, BinaryOp> { typedef hmmpc::gfpScalar<Field> ReturnType;  };
 
-    template<typename BinaryOp>
-    struct ScalarBinaryOpTraits<hmmpc::gfpScalar, int64_t, BinaryOp> { typedef hmmpc::gfpScalar ReturnType;  };
-    template<typename BinaryOp>
-    struct ScalarBinaryOpTraits<int64_t, hmmpc::gfpScalar, BinaryOp> { typedef hmmpc::gfpScalar ReturnType;  };
+    template<class Field, typename BinaryOp>
+    struct ScalarBinaryOpTraits<hmmpc::gfpScalar<Field>, int64_t, BinaryOp> { typedef hmmpc::gfpScalar<Field> ReturnType;  };
+    template<class Field, typename BinaryOp>
+    struct ScalarBinaryOpTraits<int64_t, hmmpc::gfpScalar<Field>, BinaryOp> { typedef hmmpc::gfpScalar<Field> ReturnType;  };
 
 }
 
 
-#endif
\ No newline at end of file
+#endif
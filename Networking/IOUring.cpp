@@ -0,0 +1,335 @@
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+
+#include "Networking/IOUring.h"
+#include "Networking/sockets.h"
+#include "Tools/Exceptions.h"
+
+using namespace std;
+
+/*************************************************
+ *
+ *       Raw io_uring system calls (without liburing)
+ *
+ * ***********************************************/
+static int io_uring_setup(unsigned entries, io_uring_params *params)
+{
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nr_args)
+{
+    return syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+// user_data of an entry: the player and the direction.
+static inline uint64_t encode_user_data(int i, bool is_receive){return ((uint64_t)i<<1) | is_receive;}
+
+IOUring::Peer::Peer(int send_socket, int receive_socket):
+    send_socket(send_socket), receive_socket(receive_socket), send_done(0), receive_done(0)
+{
+    memset(&send_msg, 0, sizeof(send_msg));
+    memset(&receive_msg, 0, sizeof(receive_msg));
+}
+
+bool IOUring::available()
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = io_uring_setup(1, &params);
+    if(fd < 0){return false;}
+    close(fd);
+    return true;
+}
+
+/**
+ * @brief Set up a ring with an entry for a send and a receive of each party, and map its queues.
+ * The socket to send and the socket to receive from a party are the same, except for myself.
+ *
+ * @param send_sockets
+ * @param receive_sockets
+ */
+IOUring::IOUring(const vector<int> &send_sockets, const vector<int> &receive_sockets):
+    sq_local_tail(0), fixed_files(false)
+{
+    assert(send_sockets.size() == receive_sockets.size());
+    size_t n = send_sockets.size();
+    unsigned entries = 8;
+    while(entries < 2*n){entries <<= 1;}
+
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd = io_uring_setup(entries, &params);
+    if(ring_fd < 0){
+        error("IOUring: io_uring_setup");
+    }
+    sq_entries = params.sq_entries;
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if(single_mmap){
+        sq_ring_size = cq_ring_size = max(sq_ring_size, cq_ring_size);
+    }
+    sq_ring = mmap(0, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+    if(sq_ring == MAP_FAILED){error("IOUring: mmap");}
+    if(single_mmap){
+        cq_ring = sq_ring;
+    }
+    else{
+        cq_ring = mmap(0, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+        if(cq_ring == MAP_FAILED){error("IOUring: mmap");}
+    }
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = (io_uring_sqe*)mmap(0, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+    if(sqes == MAP_FAILED){error("IOUring: mmap");}
+
+    char *sq = (char*)sq_ring, *cq = (char*)cq_ring;
+    sq_head = (unsigned*)(sq + params.sq_off.head);
+    sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+    sq_array = (unsigned*)(sq + params.sq_off.array);
+    cq_head = (unsigned*)(cq + params.cq_off.head);
+    cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+    cqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+    sq_local_tail = *sq_tail;
+
+    // Register the sockets: send_sockets[i] as the file i, and receive_sockets[i] as the file n+i.
+    vector<int> files(send_sockets);
+    files.insert(files.end(), receive_sockets.begin(), receive_sockets.end());
+    fixed_files = io_uring_register(ring_fd, IORING_REGISTER_FILES, files.data(), files.size()) == 0;
+    for(size_t i = 0; i < n; i++){
+        if(fixed_files){peers.push_back(new Peer(i, n+i));}
+        else{peers.push_back(new Peer(send_sockets[i], receive_sockets[i]));}
+    }
+}
+
+/**
+ * @brief Unmap and close the ring. The pending requests are dropped.
+ *
+ */
+IOUring::~IOUring()
+{
+    munmap(sqes, sqes_size);
+    if(cq_ring != sq_ring){munmap(cq_ring, cq_ring_size);}
+    munmap(sq_ring, sq_ring_size);
+    close(ring_fd);
+    for(auto peer: peers){
+        delete peer;
+    }
+}
+
+/**
+ * @brief Get a free submission entry, submitting the prepared ones if the queue is full.
+ *
+ * @return io_uring_sqe*
+ */
+io_uring_sqe* IOUring::get_sqe()
+{
+    if(sq_local_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) == sq_entries){
+        enter(0);
+    }
+    unsigned index = sq_local_tail & *sq_mask;
+    io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sq_array[index] = index;
+    sq_local_tail++;
+    if(fixed_files){sqe->flags |= IOSQE_FIXED_FILE;}
+    return sqe;
+}
+
+/**
+ * @brief Submit the prepared entries, and wait for min_complete completions.
+ *
+ * @param min_complete
+ */
+void IOUring::enter(unsigned min_complete)
+{
+    unsigned to_submit = sq_local_tail - *sq_tail;
+    __atomic_store_n(sq_tail, sq_local_tail, __ATOMIC_RELEASE);
+    while(to_submit || min_complete){
+        int res = io_uring_enter(ring_fd, to_submit, min_complete, min_complete ? IORING_ENTER_GETEVENTS : 0);
+        if(res < 0){
+            if(errno == EINTR || errno == EAGAIN || errno == EBUSY){continue;}
+            error("IOUring: io_uring_enter");
+        }
+        to_submit -= min((unsigned)res, to_submit);
+        min_complete = 0;
+    }
+}
+
+// Send the rest of the front package with its length field by a sendmsg gathering the views.
+void IOUring::prepare_send(int i)
+{
+    Peer &peer = *peers[i];
+    const octetViews &views = peer.to_send.front().second;
+    if(peer.send_done == 0){encode_length(peer.send_header, views.get_length(), LENGTH_SIZE);}
+    peer.send_iov.resize(min(views.size() + 1, (size_t)IOV_MAX));
+    peer.send_msg.msg_iov = peer.send_iov.data();
+    peer.send_msg.msg_iovlen = views.get_iov(peer.send_header, peer.send_done, peer.send_iov.data(), peer.send_iov.size());
+    io_uring_sqe *sqe = get_sqe();
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = peer.send_socket;
+    sqe->addr = (uint64_t)&peer.send_msg;
+    sqe->len = 1;
+    sqe->user_data = encode_user_data(i, false);
+}
+
+// Receive the rest of the length field, or the rest of the data.
+// A package into views is scattered by a recvmsg with its length field.
+void IOUring::prepare_receive(int i)
+{
+    Peer &peer = *peers[i];
+    const ReceiveTarget &target = peer.to_receive.front();
+    io_uring_sqe *sqe = get_sqe();
+    sqe->fd = peer.receive_socket;
+    if(!target.os){
+        peer.receive_iov.resize(min(target.views.size() + 1, (size_t)IOV_MAX));
+        peer.receive_msg.msg_iov = peer.receive_iov.data();
+        peer.receive_msg.msg_iovlen = target.views.get_iov(peer.receive_header, peer.receive_done, peer.receive_iov.data(), peer.receive_iov.size());
+        sqe->opcode = IORING_OP_RECVMSG;
+        sqe->addr = (uint64_t)&peer.receive_msg;
+        sqe->len = 1;
+    }
+    else if(peer.receive_done < LENGTH_SIZE){
+        sqe->opcode = IORING_OP_RECV;
+        sqe->addr = (uint64_t)(peer.receive_header + peer.receive_done);
+        sqe->len = LENGTH_SIZE - peer.receive_done;
+    }
+    else{
+        size_t offset = peer.receive_done - LENGTH_SIZE;
+        sqe->opcode = IORING_OP_RECV;
+        sqe->addr = (uint64_t)(target.os->get_data() + offset);
+        sqe->len = target.os->get_length() - offset;
+    }
+    sqe->user_data = encode_user_data(i, true);
+}
+
+void IOUring::complete_send(int i, int res)
+{
+    Peer &peer = *peers[i];
+    if(res < 0){
+        if(res != -EAGAIN && res != -EINTR){
+            errno = -res;
+            error("IOUring: send error");
+        }
+        res = 0;
+    }
+    peer.send_done += res;
+    if(peer.send_done < LENGTH_SIZE + peer.to_send.front().second.get_length()){
+        prepare_send(i);
+        return;
+    }
+    peer.send_done = 0;
+    peer.sent.push_back(peer.to_send.front().first);
+    peer.to_send.pop_front();
+    if(!peer.to_send.empty()){prepare_send(i);}
+}
+
+void IOUring::complete_receive(int i, int res)
+{
+    Peer &peer = *peers[i];
+    if(res == 0){throw closed_connection();}
+    if(res < 0){
+        if(res != -EAGAIN && res != -EINTR){
+            errno = -res;
+            error("IOUring: receiving error");
+        }
+        res = 0;
+    }
+    const ReceiveTarget &target = peer.to_receive.front();
+    octetStream *os = target.os;
+    size_t previous = peer.receive_done;
+    peer.receive_done += res;
+    if(previous < LENGTH_SIZE && peer.receive_done >= LENGTH_SIZE){
+        // Length field completed
+        if(os){os->append(decode_length(peer.receive_header, LENGTH_SIZE));}
+        else{target.views.check_length(peer.receive_header);}
+    }
+    size_t len = os ? os->get_length() : target.views.get_length();
+    if(peer.receive_done < LENGTH_SIZE + len){
+        prepare_receive(i);
+        return;
+    }
+    if(os){os->reset_read_head();}
+    peer.receive_done = 0;
+    peer.received.push_back(target.id);
+    peer.to_receive.pop_front();
+    if(!peer.to_receive.empty()){prepare_receive(i);}
+}
+
+/**
+ * @brief Submit all prepared entries (one system call for the whole round),
+ * wait for at least one completion, and handle all available completions.
+ * A partial transfer prepares an entry for the rest, which is submitted by the next reap.
+ *
+ */
+void IOUring::reap()
+{
+    enter(1);
+    unsigned head = *cq_head;
+    unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    for(; head != tail; head++){
+        io_uring_cqe &cqe = cqes[head & *cq_mask];
+        int i = cqe.user_data >> 1;
+        if(cqe.user_data & 1){complete_receive(i, cqe.res);}
+        else{complete_send(i, cqe.res);}
+    }
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+}
+
+void IOUring::request_send(int i, const octetViews& views, const void *id)
+{
+    Peer &peer = *peers[i];
+    peer.to_send.push_back({id, views});
+    if(peer.to_send.size() == 1){prepare_send(i);}
+}
+
+void IOUring::wait_send(int i, const void *id)
+{
+    Peer &peer = *peers[i];
+    while(peer.sent.empty()){reap();}
+    if(peer.sent.front() != id){
+        throw not_implemented();
+    }
+    peer.sent.pop_front();
+}
+
+void IOUring::request_receive(int i, const ReceiveTarget& target)
+{
+    Peer &peer = *peers[i];
+    if(target.os){target.os->reset_write_head();}
+    peer.to_receive.push_back(target);
+    if(peer.to_receive.size() == 1){prepare_receive(i);}
+}
+
+void IOUring::wait_receive(int i, const void *id)
+{
+    Peer &peer = *peers[i];
+    while(peer.received.empty()){reap();}
+    if(peer.received.front() != id){
+        throw not_implemented();
+    }
+    peer.received.pop_front();
+}
+
+size_t IOUring::wait_receive_any(const vector<int>& players, const vector<const void*>& ids)
+{
+    while(true){
+        for(size_t k = 0; k < players.size(); k++){
+            if(!peers[players[k]]->received.empty()){
+                wait_receive(players[k], ids[k]);
+                return k;
+            }
+        }
+        reap();
+    }
+}
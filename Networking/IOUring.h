@@ -0,0 +1,82 @@
+#ifndef NETWORKING_IOURING_H_
+#define NETWORKING_IOURING_H_
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#include <deque>
+#include <vector>
+
+#include "Networking/Transport.h"
+
+/**
+ * @brief I/O of all parties by an io_uring, driven by the thread calling it (no I/O threads).
+ * The requests only prepare the submission entries, and the first wait of a round
+ * submits all of them by a single io_uring_enter and reaps the completions.
+ * At most one send and one receive are in flight for each party, and the partial ones are resubmitted,
+ * so that the packages are not interleaved on a connection.
+ * The sockets are registered to the ring if the kernel supports it.
+ */
+class IOUring: public Transport
+{
+    struct Peer
+    {
+        int send_socket, receive_socket; // File descriptors or the indices of the registered files.
+
+        deque<pair<const void*, octetViews>> to_send; // id and views, the front is in flight.
+        size_t send_done; // Bytes of the front package sent, including the length field.
+        octet send_header[LENGTH_SIZE];
+        msghdr send_msg;
+        vector<iovec> send_iov;
+
+        deque<ReceiveTarget> to_receive; // The front is in flight.
+        size_t receive_done; // Bytes of the front package received, including the length field.
+        octet receive_header[LENGTH_SIZE];
+        msghdr receive_msg;
+        vector<iovec> receive_iov;
+
+        deque<const void*> sent;
+        deque<const void*> received;
+
+        Peer(int send_socket, int receive_socket);
+    };
+
+    int ring_fd;
+    unsigned sq_entries;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    io_uring_sqe *sqes;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    io_uring_cqe *cqes;
+    void *sq_ring, *cq_ring;
+    size_t sq_ring_size, cq_ring_size, sqes_size;
+
+    unsigned sq_local_tail; // Entries prepared but not yet submitted are in [*sq_tail, sq_local_tail).
+    bool fixed_files;
+    vector<Peer*> peers;
+
+    io_uring_sqe* get_sqe();
+    void prepare_send(int i);
+    void prepare_receive(int i);
+    void complete_send(int i, int res);
+    void complete_receive(int i, int res);
+    void enter(unsigned min_complete);
+    void reap(); // Submit the prepared entries and handle at least one completion.
+
+    // prevent copying
+    IOUring(const IOUring& other);
+
+public:
+    // Whether the kernel supports io_uring.
+    static bool available();
+
+    IOUring(const vector<int> &send_sockets, const vector<int> &receive_sockets);
+    ~IOUring();
+
+    void request_send(int i, const octetViews& views, const void *id)override;
+    void wait_send(int i, const void *id)override;
+    void request_receive(int i, const ReceiveTarget& target)override;
+    void wait_receive(int i, const void *id)override;
+    size_t wait_receive_any(const vector<int>& players, const vector<const void*>& ids)override;
+};
+
+#endif
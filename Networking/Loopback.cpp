@@ -0,0 +1,187 @@
+#include <thread>
+#include <cstring>
+
+#include "Networking/Loopback.h"
+#include "Networking/Player.h"
+#include "Tools/Exceptions.h"
+
+using namespace std;
+
+LoopbackNetwork::LoopbackNetwork(int n, const LinkModel& model, unsigned seed): n(n)
+{
+    assert(n > 0);
+    for(int i = 0; i < n; i++){
+        names.push_back(new Names(i, n));
+        arrivals.push_back(new EventCount);
+    }
+    for(int i = 0; i < n; i++){
+        for(int j = 0; j < n; j++){
+            Link *l = new Link;
+            pthread_mutex_init(&l->mutex, 0);
+            l->packages.set_event(arrivals[j]);
+            l->model = i == j ? LinkModel() : model;
+            seed_seq seeds = {seed, (unsigned)i, (unsigned)j};
+            l->prng.seed(seeds);
+            links.push_back(l);
+        }
+    }
+}
+
+LoopbackNetwork::~LoopbackNetwork()
+{
+    for(auto l: links){
+        // Drop the packages never received.
+        Package *package;
+        l->packages.stop();
+        while(l->packages.pop_dont_stop(package)){
+            delete package;
+        }
+        pthread_mutex_destroy(&l->mutex);
+        delete l;
+    }
+    for(auto names_i: names){
+        delete names_i;
+    }
+    for(auto event: arrivals){
+        delete event;
+    }
+}
+
+void LoopbackNetwork::set_link(int from, int to, const LinkModel& model)
+{
+    link(from, to).model = model;
+}
+
+LoopbackNetwork::Endpoint* LoopbackNetwork::open(int player)
+{
+    assert(player >= 0 and player < n);
+    return new Endpoint(*this, player);
+}
+
+LoopbackNetwork::Endpoint::Endpoint(LoopbackNetwork &network, int player):
+    network(network), player(player), sent(network.n), posted(network.n)
+{
+}
+
+/**
+ * @brief Copy the package into the link to party i, and schedule its serialization and arrival by the link model.
+ *
+ * @param i
+ * @param views
+ * @param id
+ */
+void LoopbackNetwork::Endpoint::request_send(int i, const octetViews& views, const void *id)
+{
+    Package *package = new Package;
+    octet *data = package->data.append(views.get_length());
+    vector<iovec> iov(views.size());
+    iov.resize(views.get_iov(0, LENGTH_SIZE, iov.data(), iov.size()));
+    for(auto &view: iov){
+        memcpy(data, view.iov_base, view.iov_len);
+        data += view.iov_len;
+    }
+
+    Link &l = network.link(player, i);
+    pthread_mutex_lock(&l.mutex);
+    const LinkModel &model = l.model;
+    Clock::time_point now = Clock::now();
+    double seconds = model.bandwidth > 0 ? (LENGTH_SIZE + views.get_length()) / model.bandwidth : 0;
+    l.free = max(now, l.free) + chrono::duration_cast<Clock::duration>(chrono::duration<double>(seconds));
+    double delay = model.latency;
+    if(model.jitter > 0){
+        delay += uniform_real_distribution<double>(0, model.jitter)(l.prng);
+    }
+    l.last_arrival = max(l.last_arrival, l.free + chrono::duration_cast<Clock::duration>(chrono::duration<double>(delay)));
+    package->arrival = l.last_arrival;
+    Clock::time_point serialized = l.free;
+    pthread_mutex_unlock(&l.mutex);
+
+    l.packages.push(package);
+    sent[i].push_back({id, serialized});
+}
+
+void LoopbackNetwork::Endpoint::wait_send(int i, const void *id)
+{
+    assert(!sent[i].empty());
+    auto front = sent[i].front();
+    sent[i].pop_front();
+    if(front.first != id){
+        throw not_implemented();
+    }
+    this_thread::sleep_until(front.second);
+}
+
+void LoopbackNetwork::Endpoint::request_receive(int i, const ReceiveTarget& target)
+{
+    if(target.os){target.os->reset_write_head();}
+    posted[i].push_back(target);
+}
+
+/**
+ * @brief Wait for the next package from party i to arrive, and move it to the target of the receive.
+ *
+ * @param i
+ * @param id
+ */
+void LoopbackNetwork::Endpoint::wait_receive(int i, const void *id)
+{
+    assert(!posted[i].empty());
+    ReceiveTarget target = posted[i].front();
+    posted[i].pop_front();
+    if(target.id != id){
+        throw not_implemented();
+    }
+
+    Package *package = 0;
+    if(!network.link(i, player).packages.pop(package)){
+        throw closed_connection();
+    }
+    this_thread::sleep_until(package->arrival);
+    if(target.os){
+        target.os->swap(package->data);
+        target.os->reset_read_head();
+    }
+    else{
+        target.views.unpack(package->data);
+    }
+    delete package;
+}
+
+/**
+ * @brief Wait for the first package to arrive from any of the players.
+ * It sleeps until the earliest arrival among the packages already sent by these players,
+ * or until the next package is sent if none is, and then takes the earliest one arrived.
+ * (A package sent during the sleep is only taken first if it arrived earlier by the time of the wakeup.)
+ *
+ * @param players
+ * @param ids
+ * @return size_t
+ */
+size_t LoopbackNetwork::Endpoint::wait_receive_any(const vector<int>& players, const vector<const void*>& ids)
+{
+    EventCount &event = *network.arrivals[player];
+    while(true){
+        uint32_t key = event.prepare();
+        size_t first = players.size();
+        Clock::time_point arrival;
+        for(size_t k = 0; k < players.size(); k++){
+            Package *package;
+            if(network.link(players[k], player).packages.try_front(package)){
+                if(first == players.size() or package->arrival < arrival){
+                    first = k;
+                    arrival = package->arrival;
+                }
+            }
+        }
+        if(first == players.size()){
+            event.wait(key);
+        }
+        else if(arrival > Clock::now()){
+            this_thread::sleep_until(arrival);
+        }
+        else{
+            wait_receive(players[first], ids[first]);
+            return first;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef NETWORKING_LOOPBACK_H_
+#define NETWORKING_LOOPBACK_H_
+
+#include <pthread.h>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "Networking/Transport.h"
+#include "Tools/WaitQueue.h"
+
+class Names;
+
+/**
+ * @brief Model of a one-way link.
+ * The packages of a link are serialized one at a time at the bandwidth,
+ * and each one arrives latency + U[0, jitter) seconds after its serialization, without overtaking the previous ones.
+ */
+struct LinkModel
+{
+    double latency; // seconds
+    double bandwidth; // bytes per second, 0 for unlimited
+    double jitter; // seconds
+
+    LinkModel(double latency = 0, double bandwidth = 0, double jitter = 0):
+        latency(latency), bandwidth(bandwidth), jitter(jitter){}
+};
+
+/**
+ * @brief n parties in the same process, exchanging the packages by in-memory queues through the modelled links.
+ * Each party runs a ThreadPlayer(network, player_no) in its own thread, without sockets or privileges (unlike tc/netem).
+ * The jitter of each link is drawn from its own PRNG seeded by (seed, sender, receiver),
+ * so that the sequence of jitter draws is reproducible. The emulated times are not:
+ * the arrivals are scheduled on the steady_clock from the actual send times,
+ * which depend on the thread scheduling and the local computation.
+ */
+class LoopbackNetwork
+{
+public:
+    class Endpoint;
+    typedef std::chrono::steady_clock Clock;
+
+private:
+    struct Package
+    {
+        octetStream data;
+        Clock::time_point arrival;
+    };
+
+    struct Link
+    {
+        pthread_mutex_t mutex; // Protects the model state below.
+        LinkModel model;
+        mt19937_64 prng;
+        Clock::time_point free; // End of the serialization of the last package.
+        Clock::time_point last_arrival;
+
+        WaitQueue<Package*> packages;
+    };
+
+    int n;
+    vector<Names*> names;
+    vector<Link*> links; // links[i * n + j] from party i to party j
+    vector<EventCount*> arrivals; // Notified after each package sent to the party, for wait_receive_any().
+
+    Link& link(int from, int to){return *links[from * n + to];}
+
+    // prevent copying
+    LoopbackNetwork(const LoopbackNetwork& other);
+
+public:
+    /**
+     * @param n number of parties
+     * @param model of every link except the ones to myself, which deliver at once
+     * @param seed of the jitter
+     */
+    LoopbackNetwork(int n, const LinkModel& model = LinkModel(), unsigned seed = 0);
+    ~LoopbackNetwork();
+
+    int num_players() const {return n;}
+    const Names& get_names(int player) const {return *names[player];}
+
+    // Change the model of the link from a party to another, before the parties start.
+    void set_link(int from, int to, const LinkModel& model);
+
+    // The transport of the party, owned by the caller.
+    Endpoint* open(int player);
+};
+
+/**
+ * @brief The transport of a party in a LoopbackNetwork.
+ * A send copies the package into the link at once, and its wait lasts until the package is serialized.
+ * The wait of a receive lasts until the package arrives.
+ */
+class LoopbackNetwork::Endpoint: public Transport
+{
+    LoopbackNetwork &network;
+    int player;
+    vector<deque<pair<const void*, Clock::time_point>>> sent; // id and end of the serialization
+    vector<deque<ReceiveTarget>> posted;
+
+public:
+    Endpoint(LoopbackNetwork &network, int player);
+
+    void request_send(int i, const octetViews& views, const void *id)override;
+    void wait_send(int i, const void *id)override;
+    void request_receive(int i, const ReceiveTarget& target)override;
+    void wait_receive(int i, const void *id)override;
+    size_t wait_receive_any(const vector<int>& players, const vector<const void*>& ids)override;
+};
+
+#endif
@@ -0,0 +1,311 @@
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <climits>
+
+#include "Networking/Multiplexer.h"
+#include "Networking/sockets.h"
+#include "Tools/Exceptions.h"
+
+using namespace std;
+
+// Bytes of the frame header [len||channel].
+const static size_t FRAME_HEADER_SIZE = LENGTH_SIZE + CHANNEL_SIZE;
+
+/**
+ * @brief Send the gather list, which may be longer than IOV_MAX.
+ *
+ * @param socket
+ * @param iov consumed by the sending
+ */
+static void send_gather(int socket, vector<iovec> &iov)
+{
+    size_t k = 0;
+    while(k < iov.size()){
+        size_t sent = send_non_blocking(socket, &iov[k], min(iov.size() - k, (size_t)IOV_MAX));
+        // Skip the completed entries and advance the partial one.
+        while(sent){
+            size_t l = min(sent, iov[k].iov_len);
+            iov[k].iov_base = (octet*)iov[k].iov_base + l;
+            iov[k].iov_len -= l;
+            sent -= l;
+            if(iov[k].iov_len == 0){k++;}
+        }
+    }
+}
+
+// Move a buffered package to the target of its receive.
+static void deliver(octetStream &buffer, const ReceiveTarget &target)
+{
+    if(target.os){
+        target.os->swap(buffer);
+        target.os->reset_read_head();
+    }
+    else{
+        target.views.unpack(buffer);
+    }
+}
+
+/**
+ * @brief Start a send thread and a receive thread for each party.
+ * The socket to send and the socket to receive from a party are the same, except for myself.
+ *
+ * @param send_sockets
+ * @param receive_sockets
+ */
+Multiplexer::Multiplexer(const vector<int> &send_sockets, const vector<int> &receive_sockets)
+{
+    assert(send_sockets.size() == receive_sockets.size());
+    pthread_mutex_init(&mutex, 0);
+    stop_fd = eventfd(0, EFD_NONBLOCK);
+    if(stop_fd < 0){
+        error("Multiplexer: eventfd");
+    }
+    for(size_t i = 0; i < send_sockets.size(); i++){
+        Peer *peer = new Peer;
+        peer->mux = this;
+        peer->player = i;
+        peer->send_socket = send_sockets[i];
+        peer->receive_socket = receive_sockets[i];
+        peers.push_back(peer);
+    }
+    for(auto peer: peers){
+        pthread_create(&peer->send_thread, 0, run_send_thread, peer);
+        pthread_create(&peer->receive_thread, 0, run_receive_thread, peer);
+    }
+}
+
+/**
+ * @brief Stop and join the threads. The pending requests are dropped.
+ *
+ */
+Multiplexer::~Multiplexer()
+{
+    uint64_t one = 1;
+    if(write(stop_fd, &one, sizeof(one)) < 0){
+        error("Multiplexer: write eventfd");
+    }
+    for(auto peer: peers){
+        peer->to_send.stop();
+        pthread_join(peer->send_thread, 0);
+        pthread_join(peer->receive_thread, 0);
+        delete peer;
+    }
+    close(stop_fd);
+    for(auto &channel: endpoints){
+        for(auto endpoint: channel.second){
+            for(auto buffer: endpoint->arrived){
+                delete buffer;
+            }
+            delete endpoint;
+        }
+    }
+    pthread_mutex_destroy(&mutex);
+}
+
+Multiplexer::Channel* Multiplexer::open(int channel)
+{
+    return new Channel(*this, channel);
+}
+
+// Get the endpoints of the channel, creating them for the first package or open. (Locked by the caller)
+vector<Multiplexer::Endpoint*>& Multiplexer::get_endpoints(int channel)
+{
+    auto &res = endpoints[channel];
+    if(res.empty()){
+        for(size_t i = 0; i < peers.size(); i++){
+            res.push_back(new Endpoint);
+        }
+    }
+    return res;
+}
+
+void* Multiplexer::run_send_thread(void* peer)
+{
+    ((Peer*)peer)->mux->run_send(*(Peer*)peer);
+    return 0;
+}
+
+void* Multiplexer::run_receive_thread(void* peer)
+{
+    ((Peer*)peer)->mux->run_receive(*(Peer*)peer);
+    return 0;
+}
+
+/**
+ * @brief Write the frames queued for the party.
+ * All the frames queued at once (from any channel) are coalesced into a single gather list.
+ *
+ * @param peer
+ */
+void Multiplexer::run_send(Peer &peer)
+{
+    deque<Frame> frames;
+    vector<octet> headers;
+    vector<iovec> iov;
+    while(peer.to_send.pop_all(frames)){
+        headers.resize(frames.size() * FRAME_HEADER_SIZE);
+        iov.clear();
+        for(size_t k = 0; k < frames.size(); k++){
+            octet *header = headers.data() + k * FRAME_HEADER_SIZE;
+            encode_length(header, frames[k].views.get_length(), LENGTH_SIZE);
+            encode_length(header + LENGTH_SIZE, frames[k].channel, CHANNEL_SIZE);
+            iov.push_back({header, FRAME_HEADER_SIZE});
+            size_t n = iov.size();
+            iov.resize(n + frames[k].views.size());
+            frames[k].views.get_iov(0, LENGTH_SIZE, iov.data() + n, frames[k].views.size());
+        }
+        send_gather(peer.send_socket, iov);
+
+        for(auto &frame: frames){
+            frame.sent->push(frame.id);
+        }
+        frames.clear();
+    }
+}
+
+/**
+ * @brief Dispatch the frames from the party to their channels,
+ * receiving straight into the target if the receive is already requested, or into a buffer otherwise.
+ *
+ * @param peer
+ */
+void Multiplexer::run_receive(Peer &peer)
+{
+    octet header[FRAME_HEADER_SIZE];
+    while(true){
+        pollfd fds[2] = {{peer.receive_socket, POLLIN, 0}, {stop_fd, POLLIN, 0}};
+        if(poll(fds, 2, -1) < 0){
+            if(errno == EINTR){continue;}
+            error("Multiplexer: poll");
+        }
+        if(fds[1].revents){return;}
+        try{
+            receive(peer.receive_socket, header, FRAME_HEADER_SIZE);
+        }
+        catch(closed_connection&){
+            return; // The party has finished.
+        }
+        size_t len = decode_length(header, LENGTH_SIZE);
+        int channel = decode_length(header + LENGTH_SIZE, CHANNEL_SIZE);
+
+        pthread_mutex_lock(&mutex);
+        Endpoint &endpoint = *get_endpoints(channel)[peer.player];
+        bool posted = !endpoint.posted.empty();
+        ReceiveTarget target;
+        if(posted){
+            target = endpoint.posted.front();
+            endpoint.posted.pop_front();
+        }
+        pthread_mutex_unlock(&mutex);
+
+        if(posted){
+            if(target.os){
+                receive(peer.receive_socket, target.os->append(len), len);
+                target.os->reset_read_head();
+            }
+            else{
+                target.views.check_length(header);
+                target.views.receive_data(peer.receive_socket);
+            }
+        }
+        else{
+            octetStream *buffer = new octetStream;
+            receive(peer.receive_socket, buffer->append(len), len);
+            // The receive may be requested in the meantime.
+            pthread_mutex_lock(&mutex);
+            posted = !endpoint.posted.empty();
+            if(posted){
+                target = endpoint.posted.front();
+                endpoint.posted.pop_front();
+            }
+            else{
+                endpoint.arrived.push_back(buffer);
+            }
+            pthread_mutex_unlock(&mutex);
+            if(!posted){continue;}
+            deliver(*buffer, target);
+            delete buffer;
+        }
+        endpoint.received.push(target.id);
+    }
+}
+
+Multiplexer::Channel::Channel(Multiplexer &mux, int channel): mux(mux), channel(channel)
+{
+    pthread_mutex_lock(&mux.mutex);
+    endpoints = mux.get_endpoints(channel);
+    pthread_mutex_unlock(&mux.mutex);
+    for(auto endpoint: endpoints){
+        endpoint->received.set_event(&arrivals);
+    }
+}
+
+void Multiplexer::Channel::request_send(int i, const octetViews& views, const void *id)
+{
+    mux.peers[i]->to_send.push({channel, views, id, &endpoints[i]->sent});
+}
+
+void Multiplexer::Channel::wait_send(int i, const void *id)
+{
+    const void* queued = 0;
+    endpoints[i]->sent.pop(queued);
+    if (queued != id){
+        throw not_implemented();
+    }
+}
+
+/**
+ * @brief Request to receive the next package of the channel from party i,
+ * which completes at once if the package is already buffered.
+ *
+ * @param i
+ * @param target
+ */
+void Multiplexer::Channel::request_receive(int i, const ReceiveTarget& target)
+{
+    Endpoint &endpoint = *endpoints[i];
+    if(target.os){target.os->reset_write_head();}
+    octetStream *buffer = 0;
+    pthread_mutex_lock(&mux.mutex);
+    if(endpoint.arrived.empty()){
+        endpoint.posted.push_back(target);
+    }
+    else{
+        buffer = endpoint.arrived.front();
+        endpoint.arrived.pop_front();
+    }
+    pthread_mutex_unlock(&mux.mutex);
+    if(buffer){
+        deliver(*buffer, target);
+        delete buffer;
+        endpoint.received.push(target.id);
+    }
+}
+
+void Multiplexer::Channel::wait_receive(int i, const void *id)
+{
+    const void* queued = 0;
+    endpoints[i]->received.pop(queued);
+    if (queued != id){
+        throw not_implemented();
+    }
+}
+
+size_t Multiplexer::Channel::wait_receive_any(const vector<int>& players, const vector<const void*>& ids)
+{
+    size_t res = 0;
+    wait_until(arrivals, [&](){
+        for(size_t k = 0; k < players.size(); k++){
+            const void* queued = 0;
+            if(endpoints[players[k]]->received.try_pop(queued)){
+                if(queued != ids[k]){
+                    throw not_implemented();
+                }
+                res = k;
+                return true;
+            }
+        }
+        return false;
+    });
+    return res;
+}
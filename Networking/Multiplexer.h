@@ -0,0 +1,100 @@
+#ifndef NETWORKING_MULTIPLEXER_H_
+#define NETWORKING_MULTIPLEXER_H_
+
+#include <pthread.h>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "Networking/Transport.h"
+#include "Tools/WaitQueue.h"
+
+// bytesize of the channel field of a frame
+#define CHANNEL_SIZE 4
+
+/**
+ * @brief Logical channels over the single connection to each party.
+ * Each package is framed as [len||channel||data], and the packages of a channel complete in FIFO order
+ * independently of the other channels, so that independent protocol instances can overlap their rounds.
+ * A send thread per party writes all the frames queued for it (from any channel) by a single sendmsg,
+ * and a receive thread per party dispatches the arriving frames to the channels.
+ * A package arriving before its receive is requested is buffered in its channel.
+ */
+class Multiplexer
+{
+public:
+    class Channel;
+
+private:
+    struct Frame
+    {
+        int channel;
+        octetViews views;
+        const void *id;
+        WaitQueue<const void*> *sent; // Completion queue of the channel.
+    };
+
+    struct Peer
+    {
+        Multiplexer *mux;
+        int player;
+        int send_socket, receive_socket;
+        WaitQueue<Frame> to_send;
+        pthread_t send_thread, receive_thread;
+    };
+
+    // State of a channel with a party. posted and arrived are protected by the mutex, and at most one of them is non-empty.
+    struct Endpoint
+    {
+        deque<ReceiveTarget> posted; // Receives requested before the packages arrive.
+        deque<octetStream*> arrived; // Packages arrived before the receives are requested.
+        WaitQueue<const void*> sent, received;
+    };
+
+    vector<Peer*> peers;
+    map<int, vector<Endpoint*>> endpoints; // Endpoints of each channel with every party.
+    pthread_mutex_t mutex;
+    int stop_fd; // eventfd to stop the receive threads.
+
+    vector<Endpoint*>& get_endpoints(int channel);
+    static void* run_send_thread(void* peer);
+    static void* run_receive_thread(void* peer);
+    void run_send(Peer &peer);
+    void run_receive(Peer &peer);
+
+    // prevent copying
+    Multiplexer(const Multiplexer& other);
+
+public:
+    /**
+     * @param send_sockets socket to send to each party
+     * @param receive_sockets socket to receive from each party
+     */
+    Multiplexer(const vector<int> &send_sockets, const vector<int> &receive_sockets);
+    ~Multiplexer();
+
+    // Open the channel, which must be opened once by every party.
+    Channel* open(int channel);
+};
+
+/**
+ * @brief A channel of a Multiplexer, used as the transport of a ThreadPlayer.
+ */
+class Multiplexer::Channel: public Transport
+{
+    Multiplexer &mux;
+    int channel;
+    vector<Endpoint*> endpoints;
+    EventCount arrivals; // Notified after each receive completed, for wait_receive_any().
+
+public:
+    Channel(Multiplexer &mux, int channel);
+
+    void request_send(int i, const octetViews& views, const void *id)override;
+    void wait_send(int i, const void *id)override;
+    void request_receive(int i, const ReceiveTarget& target)override;
+    void wait_receive(int i, const void *id)override;
+    size_t wait_receive_any(const vector<int>& players, const vector<const void*>& ids)override;
+};
+
+#endif
@@ -27,6 +27,7 @@ void Names::init(int n, int playernum, int pnb, int my_port , const char *server
     my_port = default_port(playernum);
     // 1. communication with coordination server
     setup_names(servername, my_port);
+    setup_hosts();
     // 2. setup a server to construct conneciton sockets with other player. 
     setup_server();
 }
@@ -45,8 +46,18 @@ void Names::init(int player, int pnb, const string& filename, int nplayers_wante
     portnum_base = pnb;
     string line;
     ports.clear();
+    weights.clear();
     while (getline(hostsfile, line)){
         if (line.length() > 0 && line.at(0) != '#') {
+            // Optional weight after the address
+            double weight;
+            stringstream fields(line);
+            fields >> line;
+            if (!(fields >> weight))
+                weight = 1;
+            if (weight <= 0)
+                throw runtime_error("the weight of a host must be positive");
+            weights.push_back(weight);
             auto pos = line.find(':');
             if (pos == string::npos){
                 names.push_back(line);
@@ -67,10 +78,11 @@ void Names::init(int player, int pnb, const string& filename, int nplayers_wante
     hostsfile.close();
     if (nplayers_wanted > 0 and nplayers_wanted != nplayers)
         throw runtime_error("not enought hosts in HOSTS");
+    setup_hosts();
 #ifdef DEBUG_NETWORKING
     cerr << "Got list of " << nplayers << " players from file: " << endl;
     for (unsigned int i = 0; i < names.size(); i++)
-        cerr << "    " << names[i] << ":" << ports[i] << endl;
+        cerr << "    " << names[i] << ":" << ports[i] << " (weight " << weights[i] << ")" << endl;
 #endif
     setup_server();
 }
@@ -163,6 +175,31 @@ void Names::setup_names (const char *servername, int my_port)
     close_client_socket(socket_num);
 }
 
+/**
+ * @brief Find the players on the same host as me,
+ * whose names resolve to the same IPv4 address (or both to loopback).
+ * 
+ */
+void Names::setup_hosts()
+{
+    vector<in_addr_t> addresses(nplayers, INADDR_NONE);
+    for (int i = 0; i < nplayers; i++){
+        addrinfo hints, *ai;
+        memset(&hints, 0, sizeof hints);
+        hints.ai_family = AF_INET;
+        if (getaddrinfo(names[i].c_str(), NULL, &hints, &ai) == 0){
+            addresses[i] = ((sockaddr_in*)ai->ai_addr)->sin_addr.s_addr;
+            freeaddrinfo(ai);
+        }
+    }
+    auto loopback = [](in_addr_t address){return (ntohl(address) >> 24) == 127;};
+    in_addr_t mine = addresses[player_no];
+    local.resize(nplayers);
+    for (int i = 0; i < nplayers; i++){
+        local[i] = mine != INADDR_NONE and (addresses[i] == mine or (loopback(addresses[i]) and loopback(mine)));
+    }
+}
+
 /**
  * @brief Setup client's server to listen
  * 
@@ -320,6 +357,24 @@ MultiPlayer::MultiPlayer(const Names& Nms):
     sockets.resize(Nms.num_players());
 }
 
+vector<int> MultiPlayer::stripes_to_send(int player)const
+{
+    vector<int> res = {socket_to_send(player)};
+    for(size_t s = 0; s < stripe_sockets.size(); s++){
+        res.push_back(player == player_no ? stripe_send_to_self_sockets[s] : stripe_sockets[s][player]);
+    }
+    return res;
+}
+
+vector<int> MultiPlayer::stripes_to_receive(int player)const
+{
+    vector<int> res = {sockets[player]};
+    for(auto &stripe: stripe_sockets){
+        res.push_back(stripe[player]);
+    }
+    return res;
+}
+
 MultiPlayer::~MultiPlayer()
 {
 
@@ -338,35 +393,122 @@ PlainPlayer::PlainPlayer(const Names& Nms, const string& id):
         setup_sockets(Nms.names, Nms.ports, id, *Nms.server);
     }
 }
+PlainPlayer::PlainPlayer(const Names& Nms):
+    MultiPlayer(Nms)
+{
+    sockets.clear();
+}
+
 PlainPlayer::~PlainPlayer()
 {
-    if(num_players()>1){
+    if(num_players()>1 && !sockets.empty()){
         for(auto socket:sockets){
             close_client_socket(socket);
         }
         close_client_socket(send_to_self_socket);
+        for(size_t s = 0; s < stripe_sockets.size(); s++){
+            for(auto socket:stripe_sockets[s]){
+                close_client_socket(socket);
+            }
+            close_client_socket(stripe_send_to_self_sockets[s]);
+        }
     }
 }
 
 /**
- * @brief Construct a new Thread Player and run 2*nplayers threads to Receive and Send.
- * There are n threads runing the Receiver, and the other runing the Sender.
+ * @brief Construct a new Thread Player.
+ * - THREAD_PER_PLAYER runs 2*nplayers threads:
+ *   n threads runing the Receiver, and the other runing the Sender.
+ *   The players on the same host communicate via shared memory rings instead of TCP.
+ * - EPOLL_REACTOR runs REACTOR_THREADS I/O threads of a Reactor serving all players.
+ * - IO_URING runs no thread, and falls back to EPOLL_REACTOR without the kernel support.
+ * - MULTIPLEXED runs 2*nplayers threads of a Multiplexer, shared by all its channels.
  * 
  * @param Nms Network setup
  * @param id_base 
+ * @param backend
  */
-ThreadPlayer::ThreadPlayer(const Names& Nms, const string& id_base):
-    PlainPlayer(Nms, id_base)
+ThreadPlayer::ThreadPlayer(const Names& Nms, const string& id_base, IOBackend backend):
+    PlainPlayer(Nms, id_base), transport(0), mux(0)
 {
-    for (int i = 0; i < Nms.num_players(); i++)
-    {
-        receivers.push_back(new Receiver(sockets[i]));
-        senders.push_back(new Sender(socket_to_send(i)));
+    if(backend == THREAD_PER_PLAYER){
+        segments.resize(Nms.num_players());
+        for (int i = 0; i < Nms.num_players(); i++)
+        {
+            if(SHM_RING_SIZE > 0 and i != player_no and Nms.same_host(i)){
+                // The lower-numbered player creates the segment.
+                segments[i] = new ShmSegment(sockets[i], player_no < i);
+                receivers.push_back(new Receiver(segments[i]->to_receive));
+                senders.push_back(new Sender(segments[i]->to_send));
+            }
+            else{
+                receivers.push_back(new Receiver(stripes_to_receive(i)));
+                senders.push_back(new Sender(stripes_to_send(i)));
+            }
+            receivers.back()->set_event(&arrivals);
+        }
+        return;
+    }
+
+    vector<int> send_sockets(Nms.num_players());
+    for (int i = 0; i < Nms.num_players(); i++){
+        send_sockets[i] = socket_to_send(i);
+    }
+    if(backend == MULTIPLEXED){
+        mux = new Multiplexer(send_sockets, sockets);
+        transport = mux->open(0);
+        return;
+    }
+    if(backend == IO_URING){
+        if(IOUring::available()){
+            transport = new IOUring(send_sockets, sockets);
+            return;
+        }
+        cerr<<"io_uring is not supported, falling back to epoll"<<endl;
     }
+    transport = new Reactor(send_sockets, sockets, min(REACTOR_THREADS, Nms.num_players()));
+}
+
+/**
+ * @brief Construct a new Thread Player on the given channel of the connections of base,
+ * which must be constructed with MULTIPLEXED and outlive this player.
+ * Its packages are ordered independently of the other channels.
+ * 
+ * @param base 
+ * @param channel (0 is the channel of base)
+ */
+ThreadPlayer::ThreadPlayer(const ThreadPlayer& base, int channel):
+    PlainPlayer(base.N), mux(0)
+{
+    assert(base.mux);
+    assert(channel != 0);
+    transport = base.mux->open(channel);
+}
+
+/**
+ * @brief Construct a new Thread Player as a party of the in-process network,
+ * without sockets or threads of its own.
+ * 
+ * @param network 
+ * @param player_no 
+ */
+ThreadPlayer::ThreadPlayer(LoopbackNetwork& network, int player_no):
+    PlainPlayer(network.get_names(player_no)), mux(0)
+{
+    transport = network.open(player_no);
 }
 
 ThreadPlayer::~ThreadPlayer()
 {
+    for (size_t i = 0; i < late.size(); i++){
+        drain_late(i);
+    }
+    if(transport){
+        delete transport;
+    }
+    if(mux){
+        delete mux;
+    }
     for (unsigned int i = 0; i < receivers.size(); i++){
 #ifdef VERBOSE
         if(receivers[i]->timer.elapsed()>0){
@@ -383,6 +525,11 @@ ThreadPlayer::~ThreadPlayer()
 #endif
         delete senders[i];
     }
+    for (auto segment: segments){
+        if(segment){
+            delete segment;
+        }
+    }
 }
 
 /**
@@ -545,7 +692,27 @@ void MultiPlayer::receive_player_no_stats(int i, octetStream& o) const
 }
 
 /**
- * @brief Set up connection sockets with other players.
+ * @brief Set up connection sockets with other players,
+ * and STRIPES-1 additional connections with each player to stripe the large packages.
+ * 
+ * @param names all names
+ * @param ports all ports
+ * @param id_base 
+ * @param server player's server
+ */
+void PlainPlayer::setup_sockets (const vector<string>& names,
+    const vector<int>& ports, const string& id_base, ServerSocket& server)
+{
+    connect_sockets(names, ports, id_base, server, sockets, send_to_self_socket);
+    stripe_sockets.resize(STRIPES - 1);
+    stripe_send_to_self_sockets.resize(STRIPES - 1);
+    for (int s = 1; s < STRIPES; s++){
+        connect_sockets(names, ports, id_base+"S"+to_string(s), server, stripe_sockets[s-1], stripe_send_to_self_sockets[s-1]);
+    }
+}
+
+/**
+ * @brief Set up a connection socket with each player.
  * Between the player A and the player B (#A < #B),
  * A is the client while B is the server.
  * As a client: connect to my_num() --- num_players().
@@ -555,12 +722,13 @@ void MultiPlayer::receive_player_no_stats(int i, octetStream& o) const
  * @param ports all ports
  * @param id_base 
  * @param server player's server
+ * @param connections [out] connection socket with each player (receive from self socket for myself)
+ * @param send_to_self [out] send to self socket
  */
-void PlainPlayer::setup_sockets (const vector<string>& names,
-    const vector<int>& ports, const string& id_base, ServerSocket& server)
+void PlainPlayer::connect_sockets(const vector<string>& names, const vector<int>& ports,
+    const string& id_base, ServerSocket& server, vector<int>& connections, int& send_to_self)
 {
-    sockets.resize(nplayers);
-    
+    connections.resize(nplayers);
     // 1. Set up the client side: client connect the server to get socket
     for (int i = player_no; i < nplayers; i++){
         auto pn = id_base+"P"+to_string(player_no);
@@ -571,7 +739,7 @@ void PlainPlayer::setup_sockets (const vector<string>& names,
             fprintf(stderr, "Setting up send to self socket to %s:%d with id %s\n",
                 localhost, ports[i], pn.c_str());
 #endif
-            set_up_client_socket(sockets[i], localhost, ports[i]);
+            set_up_client_socket(connections[i], localhost, ports[i]);
         }
         // send to others
         else{
@@ -579,15 +747,15 @@ void PlainPlayer::setup_sockets (const vector<string>& names,
             fprintf(stderr, "Setting up client to %s:%d with id %s\n",
                 names[i].c_str(), ports[i], pn.c_str());
 #endif
-            set_up_client_socket(sockets[i], names[i].c_str(), ports[i]);
+            set_up_client_socket(connections[i], names[i].c_str(), ports[i]);
         }
         // 2. Send client id to the player's server
         // The player's server will receive it to get socket
-        octetStream(pn).Send(sockets[i]);
+        octetStream(pn).Send(connections[i]);
     }
 
     // send_to_self_socket
-    send_to_self_socket = sockets[player_no];
+    send_to_self = connections[player_no];
 
     // 3. Setting up the server side to get connection socket
     for (int i = 0; i <= player_no; i++){
@@ -596,19 +764,23 @@ void PlainPlayer::setup_sockets (const vector<string>& names,
         fprintf(stderr, "As a server, waiting for client with id %s to connect.\n",
             id.c_str());
 #endif
-        sockets[i] = server.get_connection_socket(id);
+        connections[i] = server.get_connection_socket(id);
     }
-    // sockets[player_no]: receive from self socket
+    // connections[player_no]: receive from self socket
 
     for (int i = 0; i < nplayers; i++){
         // timeout of 5 minutes
         struct timeval tv;
         tv.tv_sec = 300;
         tv.tv_usec = 0;
-        int fl = setsockopt(sockets[i], SOL_SOCKET, SO_RCVTIMEO, (char*)&tv, sizeof(struct timeval));
+        int fl = setsockopt(connections[i], SOL_SOCKET, SO_RCVTIMEO, (char*)&tv, sizeof(struct timeval));
         if (fl < 0){
             error("set_up_socket:setsocketopt");
         }
+        // Large sends avoid the copy into the kernel if supported.
+        if (ZEROCOPY_THRESHOLD > 0){
+            enable_zerocopy(connections[i]);
+        }
     }
 }
 
@@ -620,12 +792,98 @@ void PlainPlayer::setup_sockets (const vector<string>& names,
  */
 void ThreadPlayer::request_receive(int i, octetStream& o)const
 {
-    receivers[i]->request(o);
+    if(transport){transport->request_receive(i, o);}
+    else{receivers[i]->request(o);}
 }
 
 void ThreadPlayer::wait_receive(int i, octetStream& o)const
 {
-    receivers[i]->wait(o);
+    drain_late(i);
+    wait_next(i, &o);
+}
+
+// Wait for the next receive from player i, by the backend.
+void ThreadPlayer::wait_next(int i, const void *id)const
+{
+    if(transport){transport->wait_receive(i, id);}
+    else{receivers[i]->wait(id);}
+}
+
+// Wait for the first of the next receives from the players to complete, and return its index.
+size_t ThreadPlayer::wait_next_any(const vector<int>& players, const vector<const void*>& ids)const
+{
+    if(transport){return transport->wait_receive_any(players, ids);}
+    size_t res = 0;
+    wait_until(arrivals, [&](){
+        for(size_t k = 0; k < players.size(); k++){
+            if(receivers[players[k]]->try_wait(ids[k])){
+                res = k;
+                return true;
+            }
+        }
+        return false;
+    });
+    return res;
+}
+
+void ThreadPlayer::drain_late(int i)const
+{
+    if(i >= (int)late.size()){return;}
+    for(auto buffer: late[i]){
+        wait_next(i, buffer);
+        delete buffer;
+    }
+    late[i].clear();
+}
+
+/**
+ * @brief Receive a package from each of the players, and return the first k of them to arrive (in the order of arrival),
+ * whose packages are moved into os[i].
+ * The packages of the others are received into internal buffers, and dropped before the next wait on these players
+ * (as the receives from a player complete in FIFO order).
+ * 
+ * @param players 
+ * @param k 
+ * @param os [out] of size nplayers
+ * @return vector<int> 
+ */
+vector<int> ThreadPlayer::receive_first(const vector<int>& players, size_t k, octetStreams &os)const
+{
+    assert(k <= players.size());
+    late.resize(nplayers);
+    vector<int> pending = players;
+    vector<octetStream*> buffers;
+    for(int i: players){
+        buffers.push_back(new octetStream);
+        request_receive(i, *buffers.back());
+    }
+
+    vector<int> res;
+    vector<const void*> ids;
+    while(res.size() < k){
+        // The next receive from a player is its oldest late one, if any.
+        ids.clear();
+        for(size_t j = 0; j < pending.size(); j++){
+            int i = pending[j];
+            ids.push_back(late[i].empty() ? buffers[j] : late[i].front());
+        }
+        size_t j = wait_next_any(pending, ids);
+        int i = pending[j];
+        if(!late[i].empty()){
+            delete late[i].front();
+            late[i].pop_front();
+            continue;
+        }
+        os[i].swap(*buffers[j]);
+        delete buffers[j];
+        res.push_back(i);
+        pending.erase(pending.begin() + j);
+        buffers.erase(buffers.begin() + j);
+    }
+    for(size_t j = 0; j < pending.size(); j++){
+        late[pending[j]].push_back(buffers[j]);
+    }
+    return res;
 }
 
 /**
@@ -642,12 +900,14 @@ void ThreadPlayer::receive_player_no_stats(int i, octetStream& o) const
 
 void ThreadPlayer::request_send(int i, const octetStream& o)const
 {
-    senders[i]->request(o);
+    if(transport){transport->request_send(i, o);}
+    else{senders[i]->request(o);}
 }
 
 void ThreadPlayer::wait_send(int i, const octetStream& o)const
 {
-    senders[i]->wait(o);
+    if(transport){transport->wait_send(i, o);}
+    else{senders[i]->wait(o);}
 }
 
 void ThreadPlayer::send_to_no_stats(int player, const octetStream& o) const
@@ -661,12 +921,12 @@ void ThreadPlayer::send_all(const octetStream& o)const
     TimeScope ts(comm_stats["Sending to all"].add(o));
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            senders[i]->request(o);
+            request_send(i, o);
         }
     }
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            senders[i]->wait(o);
+            wait_send(i, o);
         }
     }
     sent += o.get_length() * (num_players() - 1);
@@ -677,7 +937,7 @@ void ThreadPlayer::request_send_all(const octetStream &o)const
     TimeScope ts(comm_stats["Sending to all"].add(o));
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            senders[i]->request(o);
+            request_send(i, o);
         }
     }
     sent += o.get_length() * (num_players() - 1);
@@ -687,7 +947,7 @@ void ThreadPlayer::wait_send_all(const octetStream &o)const
 {
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            senders[i]->wait(o);
+            wait_send(i, o);
         }
     }
 }
@@ -698,13 +958,13 @@ void ThreadPlayer::send_respective(const octetStreams& os)const
     size_t length = 0;
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            senders[i]->request(os[i]);
+            request_send(i, os[i]);
             length += os[i].get_length();
         }
     }
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            senders[i]->wait(os[i]);
+            wait_send(i, os[i]);
         }
     }
     TimeScope ts(comm_stats["Sending to all parties respectively"].add(length));
@@ -716,7 +976,7 @@ void ThreadPlayer::request_send_respective(const octetStreams&os)const
     size_t length = 0;
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            senders[i]->request(os[i]);
+            request_send(i, os[i]);
             length += os[i].get_length();
         }
     }
@@ -728,7 +988,7 @@ void ThreadPlayer::wait_send_respective(const octetStreams&os)const
 {
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            senders[i]->wait(os[i]);
+            wait_send(i, os[i]);
         }
     }
 }
@@ -737,12 +997,12 @@ void ThreadPlayer::receive_respective(octetStreams &os)const
 {
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            receivers[i]->request(os[i]);
+            request_receive(i, os[i]);
         }
     }
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            receivers[i]->wait(os[i]);
+            wait_receive(i, os[i]);
         }
     }
 }
@@ -751,7 +1011,7 @@ void ThreadPlayer::request_receive_respective(octetStreams &os)const
 {
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            receivers[i]->request(os[i]);
+            request_receive(i, os[i]);
         }
     }
 }
@@ -760,7 +1020,7 @@ void ThreadPlayer::wait_receive_respective(octetStreams &os)const
 {
     for(int i = 0; i < nplayers; i++){
         if(i!=player_no){
-            receivers[i]->wait(os[i]);
+            wait_receive(i, os[i]);
         }
     }
 }
@@ -773,7 +1033,7 @@ void ThreadPlayer::send_respective(int start, int nSize, const octetStreams &os)
     for(int i = 0; i < nSize; i++){
         int id = positive_modulo(start+i, num_players());
         if(id!=player_no){
-            senders[id]->request(os[i]);
+            request_send(id, os[i]);
             length += os[i].get_length();
         }
     }
@@ -781,7 +1041,7 @@ void ThreadPlayer::send_respective(int start, int nSize, const octetStreams &os)
     for(int i = 0; i < nSize; i++){
         int id = positive_modulo(start+i, num_players());
         if(id!=player_no){
-            senders[id]->wait(os[i]);
+            wait_send(id, os[i]);
         }
     }
     TimeScope ts(comm_stats["Sending to a set of parties respectively"].add(length));
@@ -795,7 +1055,7 @@ void ThreadPlayer::request_send_respective(int start, int nSize, const octetStre
     for(int i = 0; i < nSize; i++){
         int id = positive_modulo(start+i, num_players());
         if(id!=player_no){
-            senders[id]->request(os[i]);
+            request_send(id, os[i]);
             length += os[i].get_length();
         }
     }
@@ -808,7 +1068,116 @@ void ThreadPlayer::wait_send_respective(int start, int nSize, const octetStreams
     for(int i = 0; i < nSize; i++){
         int id = positive_modulo(start+i, num_players());
         if(id!=player_no){
-            senders[id]->wait(os[i]);
+            wait_send(id, os[i]);
+        }
+    }
+}
+
+void ThreadPlayer::request_send(int i, const octetViews& views)const
+{
+    if(transport){transport->request_send(i, views, &views);}
+    else{senders[i]->request(views, &views);}
+}
+
+void ThreadPlayer::wait_send(int i, const octetViews& views)const
+{
+    if(transport){transport->wait_send(i, &views);}
+    else{senders[i]->wait(&views);}
+}
+
+void ThreadPlayer::request_send_all(const octetViews& views)const
+{
+    TimeScope ts(comm_stats["Sending to all"].add(views.get_length()));
+    for(int i = 0; i < nplayers; i++){
+        if(i!=player_no){
+            request_send(i, views);
+        }
+    }
+    sent += views.get_length() * (num_players() - 1);
+}
+
+void ThreadPlayer::wait_send_all(const octetViews& views)const
+{
+    for(int i = 0; i < nplayers; i++){
+        if(i!=player_no){
+            wait_send(i, views);
+        }
+    }
+}
+
+void ThreadPlayer::request_send_respective(const vector<octetViews> &views)const
+{
+    size_t length = 0;
+    for(int i = 0; i < nplayers; i++){
+        if(i!=player_no){
+            request_send(i, views[i]);
+            length += views[i].get_length();
+        }
+    }
+    TimeScope ts(comm_stats["Sending to all parties respectively"].add(length));
+    sent += length;
+}
+
+void ThreadPlayer::wait_send_respective(const vector<octetViews> &views)const
+{
+    for(int i = 0; i < nplayers; i++){
+        if(i!=player_no){
+            wait_send(i, views[i]);
+        }
+    }
+}
+
+void ThreadPlayer::request_send_respective(int start, int nSize, const vector<octetViews> &views)const
+{
+    assert((size_t)nSize==views.size());
+    size_t length = 0;
+    for(int i = 0; i < nSize; i++){
+        int id = positive_modulo(start+i, num_players());
+        if(id!=player_no){
+            request_send(id, views[i]);
+            length += views[i].get_length();
+        }
+    }
+    TimeScope ts(comm_stats["Sending to a set of parties respectively"].add(length));
+    sent += length;
+}
+
+void ThreadPlayer::wait_send_respective(int start, int nSize, const vector<octetViews> &views)const
+{
+    for(int i = 0; i < nSize; i++){
+        int id = positive_modulo(start+i, num_players());
+        if(id!=player_no){
+            wait_send(id, views[i]);
+        }
+    }
+}
+
+void ThreadPlayer::request_receive(int i, const octetViews& views)const
+{
+    if(transport){transport->request_receive(i, views, &views);}
+    else{receivers[i]->request(views, &views);}
+}
+
+void ThreadPlayer::wait_receive(int i, const octetViews& views)const
+{
+    drain_late(i);
+    wait_next(i, &views);
+}
+
+void ThreadPlayer::request_receive_respective(const vector<octetViews> &views)const
+{
+    for(int i = 0; i < nplayers; i++){
+        if(i!=player_no){
+            request_receive(i, views[i]);
+        }
+    }
+}
+
+void ThreadPlayer::wait_receive_respective(const vector<octetViews> &views)const
+{
+    for(int i = 0; i < nplayers; i++){
+        if(i!=player_no){
+            wait_receive(i, views[i]);
         }
     }
 }
@@ -11,6 +11,10 @@
 #include "Networking/ServerSocket.h"
 #include "Networking/Sender.h"
 #include "Networking/Receiver.h"
+#include "Networking/Reactor.h"
+#include "Networking/IOUring.h"
+#include "Networking/Multiplexer.h"
+#include "Networking/Loopback.h"
 #include "Networking/sockets.h"
 
 using namespace std;
@@ -29,6 +33,8 @@ class Names
     int nplayers;/* number of players */
     int portnum_base;/* base of portnum */
     int player_no;/* player numer */
+    vector<bool> local;/* Whether each player is on the same host as me */
+    vector<double> weights;/* Static weights of the players from the hosts file */
 
     // Player as a server
     ServerSocket* server;
@@ -39,6 +45,7 @@ class Names
     // Player as a client.
     void setup_ports();/* Set up all players' listening ports */
     void setup_names(const char *servername, int my_port);/* Set up to get all players' names/ips. */
+    void setup_hosts();/* Find the players on the same host as me. */
 
 public:
 
@@ -51,7 +58,8 @@ public:
     {init(n, playernum, pnb, my_port, servername);}
 
     /**
-     * Initialize from file. One party per line, format ``<hostname>[:<port>]``
+     * Initialize from file. One party per line, format ``<hostname>[:<port>] [<weight>]``
+     * The optional weight is the relative speed of the party in the dispersed operations (default 1).
      * @param player my number
      * @param pnb base port number
      * @param hostsfile filename
@@ -62,6 +70,8 @@ public:
     {init(player, pnb, hostsfile); }
   
     Names() : nplayers(1), portnum_base(-1), player_no(0), server(0) {}
+    // Initialize for n parties in the same process, without the network setup.
+    Names(int player, int n) : Names() {nplayers = n; player_no = player;}
     Names(const Names& other);
     ~Names();
 
@@ -71,6 +81,8 @@ public:
     const string get_name(int i)const {return names[i];}/* get the name of player i */
     const int get_port(int i)const {return ports[i];}/*get the port of player i*/
     int get_portnum_base()const{return portnum_base;}/* get the base of portnum */
+    bool same_host(int i)const{return i < (int)local.size() and local[i];}/* whether player i is on the same host */
+    double get_weight(int i)const{return i < (int)weights.size() ? weights[i] : 1;}/* get the static weight of player i */
 };
 
 /**
@@ -224,6 +236,12 @@ protected:
 
     int socket(int i) const {return sockets[i];}/* Return the connection sockets to player i */
 
+    // Additional connections of each stripe, in the same layout as sockets and send_to_self_socket.
+    vector<vector<int>> stripe_sockets;
+    vector<int> stripe_send_to_self_sockets;
+    vector<int> stripes_to_send(int player)const;/* All connections to send to player, starting from socket_to_send */
+    vector<int> stripes_to_receive(int player)const;
+
 public:
     MultiPlayer(const Names& Nms);
     virtual ~MultiPlayer();
@@ -243,22 +261,68 @@ class PlainPlayer: public MultiPlayer
     // Set up connection sockets with other players.
     void setup_sockets(const vector<string>& names, const vector<int>& ports,
         const string& id_base, ServerSocket& server);
+    void connect_sockets(const vector<string>& names, const vector<int>& ports,
+        const string& id_base, ServerSocket& server, vector<int>& connections, int& send_to_self);
+protected:
+    // Construct a Plain Player without its own connections.
+    PlainPlayer(const Names& Nms);
 public:
     // Construct a new Plain Player and setup the socket network with other player.
     PlainPlayer(const Names& Nms, const string& id);
     ~PlainPlayer();
 };
 
+// I/O backends of ThreadPlayer
+enum IOBackend
+{
+    THREAD_PER_PLAYER, // A Sender and a Receiver thread per player
+    EPOLL_REACTOR, // REACTOR_THREADS I/O threads multiplexing all players by epoll
+    IO_URING, // An io_uring driven by the calling thread, or EPOLL_REACTOR if the kernel does not support it
+    MULTIPLEXED, // Channel 0 of a Multiplexer, whose other channels are opened by ThreadPlayer(base, channel)
+};
+
+// Default backend of ThreadPlayer
+#ifndef IO_BACKEND
+#define IO_BACKEND THREAD_PER_PLAYER
+#endif
+
+// Number of parallel connections with each player, over which THREAD_PER_PLAYER stripes the large packages
+#ifndef STRIPES
+#define STRIPES 1
+#endif
+
+// Number of I/O threads of EPOLL_REACTOR
+#ifndef REACTOR_THREADS
+#define REACTOR_THREADS 2
+#endif
+
 class ThreadPlayer: public PlainPlayer
 {
+    mutable EventCount arrivals;/* Notified after each package received by the Receivers */
+    mutable vector<deque<octetStream*>> late;/* Packages not among the first ones in receive_first(), in FIFO order per player */
+
+    void drain_late(int i)const;/* Wait for and drop the late packages from player i */
+    void wait_next(int i, const void *id)const;
+    size_t wait_next_any(const vector<int>& players, const vector<const void*>& ids)const;
+
 public:
     mutable vector<Receiver*> receivers;/* Each thread is a Receiver to receive from a specific player */
     mutable vector<Sender*> senders;/* Each thread is a Sender to send to a specific player */
+    Transport *transport;/* Or the transport of the other backends */
+    vector<ShmSegment*> segments;/* Shared memory with the players on the same host (THREAD_PER_PLAYER) */
+    Multiplexer *mux;/* Owned by the MULTIPLEXED player, and shared by its channels */
     
-    // Construct a new Thread Player and run 2*nplayers threads to Receive and Send.
-    ThreadPlayer(const Names& Nms, const string& id_base);
+    // Construct a new Thread Player and run 2*nplayers threads (or the other backend) to Receive and Send.
+    ThreadPlayer(const Names& Nms, const string& id_base, IOBackend backend = IO_BACKEND);
+    // Open another channel over the connections of the MULTIPLEXED base, as an independent player.
+    ThreadPlayer(const ThreadPlayer& base, int channel);
+    // Run as the party player_no of the in-process network, which must outlive this player.
+    ThreadPlayer(LoopbackNetwork& network, int player_no);
     virtual ~ThreadPlayer();
 
+    // Each request_*() must be followed by the matching wait_*(), in the same order per player.
+    // With THREAD_PER_PLAYER, at most SPSC_MAX_OUTSTANDING (2*SPSC_CAPACITY+1) sends and as many receives
+    // can be outstanding with a player; one more throws overflow, as it would block forever (see Tools/SpscQueue.h).
     void request_receive(int i, octetStream& o)const;/* Request to receive data from player i. */
     void wait_receive(int i, octetStream& o) const;
     void receive_player_no_stats(int i, octetStream& o) const;
@@ -283,7 +347,25 @@ public:
     void receive_respective(octetStreams &os)const;
     void request_receive_respective(octetStreams &os)const;
     void wait_receive_respective(octetStreams&os)const;
-    
+
+    // Send the memory viewed by octetViews without packing it, which must stay alive until the wait.
+    void request_send(int i, const octetViews& views)const;
+    void wait_send(int i, const octetViews& views)const;
+    void request_send_all(const octetViews& views)const;
+    void wait_send_all(const octetViews& views)const;
+    void request_send_respective(const vector<octetViews> &views)const;
+    void wait_send_respective(const vector<octetViews> &views)const;
+    void request_send_respective(int start, int nSize, const vector<octetViews> &views)const;
+    void wait_send_respective(int start, int nSize, const vector<octetViews> &views)const;
+
+    // Receive a package of length views.get_length() straight into the memory viewed by octetViews.
+    void request_receive(int i, const octetViews& views)const;
+    void wait_receive(int i, const octetViews& views)const;
+    void request_receive_respective(const vector<octetViews> &views)const;
+    void wait_receive_respective(const vector<octetViews> &views)const;
+
+    // Receive a package from each of the players, and return the first k of them to arrive, whose packages are moved into os.
+    vector<int> receive_first(const vector<int>& players, size_t k, octetStreams &os)const;
 };
 
 
@@ -0,0 +1,315 @@
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <climits>
+
+#include "Networking/Reactor.h"
+#include "Networking/sockets.h"
+#include "Tools/Exceptions.h"
+
+using namespace std;
+
+// Maximum number of events of one epoll_wait.
+const static int MAX_EVENTS = 64;
+// Tag of the eventfd in the epoll events, which is not a player number.
+const static uint64_t WAKEUP_TAG = ~(uint64_t)0;
+
+Reactor::Peer::Peer(int send_socket, int receive_socket):
+    send_socket(send_socket), receive_socket(receive_socket), send_done(0), receive_done(0)
+{
+}
+
+/**
+ * @brief Register the sockets of all parties to n_threads I/O threads, and start them.
+ * The socket to send and the socket to receive from a party are the same, except for myself.
+ *
+ * @param send_sockets
+ * @param receive_sockets
+ * @param n_threads
+ */
+Reactor::Reactor(const vector<int> &send_sockets, const vector<int> &receive_sockets, int n_threads)
+{
+    assert(send_sockets.size() == receive_sockets.size());
+    assert(n_threads > 0);
+    for(size_t i = 0; i < send_sockets.size(); i++){
+        peers.push_back(new Peer(send_sockets[i], receive_sockets[i]));
+        peers.back()->received.set_event(&arrivals);
+    }
+
+    for(int k = 0; k < n_threads; k++){
+        IOThread *io = new IOThread;
+        io->reactor = this;
+        io->running = true;
+        pthread_mutex_init(&io->mutex, 0);
+        io->epoll_fd = epoll_create1(0);
+        io->wakeup_fd = eventfd(0, EFD_NONBLOCK);
+        if(io->epoll_fd < 0 || io->wakeup_fd < 0){
+            error("Reactor: epoll_create/eventfd");
+        }
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = WAKEUP_TAG;
+        if(epoll_ctl(io->epoll_fd, EPOLL_CTL_ADD, io->wakeup_fd, &event) < 0){
+            error("Reactor: epoll_ctl");
+        }
+        threads.push_back(io);
+    }
+
+    for(size_t i = 0; i < peers.size(); i++){
+        IOThread *io = threads[i % threads.size()];
+        epoll_event event;
+        event.data.u64 = i;
+        if(peers[i]->send_socket == peers[i]->receive_socket){
+            event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+            if(epoll_ctl(io->epoll_fd, EPOLL_CTL_ADD, peers[i]->send_socket, &event) < 0){
+                error("Reactor: epoll_ctl");
+            }
+        }
+        else{
+            event.events = EPOLLOUT | EPOLLET;
+            if(epoll_ctl(io->epoll_fd, EPOLL_CTL_ADD, peers[i]->send_socket, &event) < 0){
+                error("Reactor: epoll_ctl");
+            }
+            event.events = EPOLLIN | EPOLLET;
+            if(epoll_ctl(io->epoll_fd, EPOLL_CTL_ADD, peers[i]->receive_socket, &event) < 0){
+                error("Reactor: epoll_ctl");
+            }
+        }
+    }
+
+    for(auto io: threads){
+        pthread_create(&io->thread, 0, run_thread, io);
+    }
+}
+
+/**
+ * @brief Stop and join the I/O threads. The pending requests are dropped.
+ *
+ */
+Reactor::~Reactor()
+{
+    for(auto io: threads){
+        pthread_mutex_lock(&io->mutex);
+        io->running = false;
+        pthread_mutex_unlock(&io->mutex);
+        uint64_t one = 1;
+        if(write(io->wakeup_fd, &one, sizeof(one)) < 0){
+            error("Reactor: write eventfd");
+        }
+        pthread_join(io->thread, 0);
+        close(io->epoll_fd);
+        close(io->wakeup_fd);
+        pthread_mutex_destroy(&io->mutex);
+        delete io;
+    }
+    for(auto peer: peers){
+        delete peer;
+    }
+}
+
+void* Reactor::run_thread(void* io_thread)
+{
+    IOThread *io = (IOThread*)io_thread;
+    io->reactor->run(*io);
+    return 0;
+}
+
+/**
+ * @brief Event loop of an I/O thread.
+ * The new requests are moved to the queues of the parties, and then every party with an event or a new request makes progress.
+ * As the events are edge-triggered, each progress goes on until the socket would block.
+ *
+ * @param io
+ */
+void Reactor::run(IOThread &io)
+{
+    epoll_event events[MAX_EVENTS];
+    vector<Request> requests;
+    vector<bool> active(peers.size(), false);
+    vector<int> active_list;
+    while(true){
+        int n = epoll_wait(io.epoll_fd, events, MAX_EVENTS, -1);
+        if(n < 0){
+            if(errno == EINTR){continue;}
+            error("Reactor: epoll_wait");
+        }
+
+        for(int k = 0; k < n; k++){
+            uint64_t tag = events[k].data.u64;
+            if(tag == WAKEUP_TAG){
+                uint64_t count;
+                if(read(io.wakeup_fd, &count, sizeof(count)) < 0 && errno != EAGAIN){
+                    error("Reactor: read eventfd");
+                }
+                pthread_mutex_lock(&io.mutex);
+                bool running = io.running;
+                requests.swap(io.requests);
+                pthread_mutex_unlock(&io.mutex);
+                if(!running){return;}
+
+                for(auto &request: requests){
+                    Peer &peer = *peers[request.player];
+                    if(request.is_send){peer.to_send.push_back({request.target.id, request.target.views});}
+                    else{peer.to_receive.push_back(request.target);}
+                    if(!active[request.player]){active[request.player] = true; active_list.push_back(request.player);}
+                }
+                requests.clear();
+            }
+            else if(!active[tag]){
+                active[tag] = true;
+                active_list.push_back(tag);
+            }
+        }
+
+        for(int i: active_list){
+            progress_send(*peers[i]);
+            progress_receive(*peers[i]);
+            active[i] = false;
+        }
+        active_list.clear();
+    }
+}
+
+/**
+ * @brief Send the queued packages until the socket would block.
+ * Each sendmsg gathers the rest of the length field and the views.
+ *
+ * @param peer
+ */
+void Reactor::progress_send(Peer &peer)
+{
+    iovec iov[IOV_MAX];
+    while(!peer.to_send.empty()){
+        const octetViews &views = peer.to_send.front().second;
+        size_t len = views.get_length();
+        if(peer.send_done == 0){
+            encode_length(peer.send_header, len, LENGTH_SIZE);
+        }
+        while(peer.send_done < LENGTH_SIZE + len){
+            size_t n = views.get_iov(peer.send_header, peer.send_done, iov, IOV_MAX);
+            size_t sent = send_non_blocking(peer.send_socket, iov, n);
+            if(sent == 0){return;} // Would block
+            peer.send_done += sent;
+        }
+        peer.send_done = 0;
+        peer.sent.push(peer.to_send.front().first);
+        peer.to_send.pop_front();
+    }
+}
+
+/**
+ * @brief Receive the requested packages until the socket would block.
+ * The packages into octetStreams are received as the length field and then the data,
+ * while the packages into views are scattered by recvmsg straight into the viewed memory.
+ * The data arriving without a request is left in the socket.
+ *
+ * @param peer
+ */
+void Reactor::progress_receive(Peer &peer)
+{
+    iovec iov[IOV_MAX];
+    while(!peer.to_receive.empty()){
+        ReceiveTarget &target = peer.to_receive.front();
+        octetStream *os = target.os;
+        while(true){
+            size_t j;
+            size_t previous = peer.receive_done;
+            if(os){
+                octet *buffer;
+                size_t remaining;
+                if(peer.receive_done < LENGTH_SIZE){
+                    buffer = peer.receive_header + peer.receive_done;
+                    remaining = LENGTH_SIZE - peer.receive_done;
+                }
+                else{
+                    size_t offset = peer.receive_done - LENGTH_SIZE;
+                    buffer = os->get_data() + offset;
+                    remaining = os->get_length() - offset;
+                }
+                if(remaining == 0){break;}
+                iov[0] = {buffer, remaining};
+                j = receive_non_blocking(peer.receive_socket, iov, 1);
+            }
+            else{
+                if(peer.receive_done == LENGTH_SIZE + target.views.get_length()){break;}
+                size_t n = target.views.get_iov(peer.receive_header, peer.receive_done, iov, IOV_MAX);
+                j = receive_non_blocking(peer.receive_socket, iov, n);
+            }
+            if(j == 0){return;} // Would block
+            peer.receive_done += j;
+            if(previous < LENGTH_SIZE && peer.receive_done >= LENGTH_SIZE){
+                // Length field completed
+                if(os){
+                    os->reset_write_head();
+                    os->append(decode_length(peer.receive_header, LENGTH_SIZE));
+                }
+                else{
+                    target.views.check_length(peer.receive_header);
+                }
+            }
+        }
+        if(os){os->reset_read_head();}
+        peer.receive_done = 0;
+        peer.received.push(target.id);
+        peer.to_receive.pop_front();
+    }
+}
+
+void Reactor::submit(const Request &request)
+{
+    IOThread &io = *threads[request.player % threads.size()];
+    pthread_mutex_lock(&io.mutex);
+    io.requests.push_back(request);
+    pthread_mutex_unlock(&io.mutex);
+    uint64_t one = 1;
+    if(write(io.wakeup_fd, &one, sizeof(one)) < 0){
+        error("Reactor: write eventfd");
+    }
+}
+
+void Reactor::request_send(int i, const octetViews& views, const void *id)
+{
+    submit({i, true, {0, views, id}});
+}
+
+void Reactor::wait_send(int i, const void *id)
+{
+    const void* queued = 0;
+    peers[i]->sent.pop(queued);
+    if (queued != id){
+        throw not_implemented();
+    }
+}
+
+void Reactor::request_receive(int i, const ReceiveTarget& target)
+{
+    if(target.os){target.os->reset_write_head();}
+    submit({i, false, target});
+}
+
+void Reactor::wait_receive(int i, const void *id)
+{
+    const void* queued = 0;
+    peers[i]->received.pop(queued);
+    if (queued != id){
+        throw not_implemented();
+    }
+}
+
+size_t Reactor::wait_receive_any(const vector<int>& players, const vector<const void*>& ids)
+{
+    size_t res = 0;
+    wait_until(arrivals, [&](){
+        for(size_t k = 0; k < players.size(); k++){
+            const void* queued = 0;
+            if(peers[players[k]]->received.try_pop(queued)){
+                if(queued != ids[k]){
+                    throw not_implemented();
+                }
+                res = k;
+                return true;
+            }
+        }
+        return false;
+    });
+    return res;
+}
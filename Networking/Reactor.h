@@ -0,0 +1,84 @@
+#ifndef NETWORKING_REACTOR_H_
+#define NETWORKING_REACTOR_H_
+
+#include <pthread.h>
+#include <deque>
+#include <vector>
+
+#include "Networking/Transport.h"
+#include "Tools/WaitQueue.h"
+
+/**
+ * @brief Event-driven I/O of all parties on a fixed number of threads.
+ * The parties are assigned to the threads round-robin, and each thread multiplexes their sockets by epoll (edge-triggered).
+ */
+class Reactor: public Transport
+{
+    struct Request
+    {
+        int player;
+        bool is_send;
+        ReceiveTarget target; // The views and id to send (os is null), or the target to receive.
+    };
+
+    // State of a party, only accessed by its I/O thread (except for the completion queues).
+    struct Peer
+    {
+        int send_socket, receive_socket;
+
+        deque<pair<const void*, octetViews>> to_send; // id and views
+        size_t send_done; // Bytes of the front package sent, including the length field.
+        octet send_header[LENGTH_SIZE];
+
+        deque<ReceiveTarget> to_receive;
+        size_t receive_done; // Bytes of the front package received, including the length field.
+        octet receive_header[LENGTH_SIZE];
+
+        WaitQueue<const void*> sent;
+        WaitQueue<const void*> received;
+
+        Peer(int send_socket, int receive_socket);
+    };
+
+    struct IOThread
+    {
+        Reactor *reactor;
+        int epoll_fd;
+        int wakeup_fd; // eventfd to notify the new requests or the stop.
+        pthread_t thread;
+
+        pthread_mutex_t mutex; // Protects requests and running.
+        vector<Request> requests;
+        bool running;
+    };
+
+    vector<Peer*> peers;
+    vector<IOThread*> threads;
+    EventCount arrivals; // Notified after each receive completed, for wait_receive_any().
+
+    static void* run_thread(void* io_thread);
+    void run(IOThread &io);
+    void progress_send(Peer &peer);
+    void progress_receive(Peer &peer);
+    void submit(const Request &request);
+
+    // prevent copying
+    Reactor(const Reactor& other);
+
+public:
+    /**
+     * @param send_sockets socket to send to each party
+     * @param receive_sockets socket to receive from each party
+     * @param n_threads number of I/O threads
+     */
+    Reactor(const vector<int> &send_sockets, const vector<int> &receive_sockets, int n_threads);
+    ~Reactor();
+
+    void request_send(int i, const octetViews& views, const void *id)override;
+    void wait_send(int i, const void *id)override;
+    void request_receive(int i, const ReceiveTarget& target)override;
+    void wait_receive(int i, const void *id)override;
+    size_t wait_receive_any(const vector<int>& players, const vector<const void*>& ids)override;
+};
+
+#endif
@@ -10,7 +10,27 @@ using namespace std;
  * 
  * @param socket socket number
  */
-Receiver::Receiver(int socket): socket(socket), thread(0)
+Receiver::Receiver(int socket): sockets({socket}), ring(0), thread(0), outstanding(0)
+{
+    start();
+}
+
+/**
+ * @brief Construct a new Receiver to receive data via the parallel connections from a player.
+ * 
+ * @param sockets 
+ */
+Receiver::Receiver(const vector<int> &sockets): sockets(sockets), ring(0), thread(0), outstanding(0)
+{
+    start();
+}
+
+/**
+ * @brief Construct a new Receiver to receive data via the shared memory ring from a player on the same host.
+ * 
+ * @param ring 
+ */
+Receiver::Receiver(ShmRing &ring): ring(&ring), thread(0), outstanding(0)
 {
     start();
 }
@@ -43,17 +63,42 @@ void* Receiver::run_thread(void* receiver)
  */
 void Receiver::run()
 {
-    octetStream* os = 0;
-    while(in.pop(os)){
-        os->reset_write_head();
+    ReceiveTarget target;
+    while(in.pop(target)){
 #ifdef VERBOSE
         timer.start();
 #endif
-        os->Receive(socket);
+        if(ring){
+            ring->Receive(target);
+        }
+        else if(sockets.size() == 1){
+            if(target.os){
+                target.os->reset_write_head();
+                target.os->Receive(sockets[0]);
+            }
+            else{
+                target.views.Receive(sockets[0]);
+            }
+        }
+        else{
+            // The length field is on the first connection.
+            octet header[LENGTH_SIZE];
+            receive(sockets[0], header, LENGTH_SIZE);
+            if(target.os){
+                target.os->reset_write_head();
+                target.os->append(decode_length(header, LENGTH_SIZE));
+                octetViews(*target.os).receive_data(sockets);
+                target.os->reset_read_head();
+            }
+            else{
+                target.views.check_length(header);
+                target.views.receive_data(sockets);
+            }
+        }
 #ifdef VERBOSE       
         timer.stop();
 #endif
-        out.push(os);
+        out.push(target.id);
     }
 }
 
@@ -63,6 +108,18 @@ void Receiver::stop()
     pthread_join(thread, 0);
 }
 
+/**
+ * @brief Throw instead of blocking forever on a request beyond SPSC_MAX_OUTSTANDING without waits.
+ * 
+ */
+void Receiver::check_outstanding()
+{
+    if(outstanding == SPSC_MAX_OUTSTANDING){
+        throw overflow("requests outstanding with a Receiver", outstanding + 1, SPSC_MAX_OUTSTANDING);
+    }
+    outstanding++;
+}
+
 /**
  * @brief Request a octetStream to receive 
  * 
@@ -70,15 +127,47 @@ void Receiver::stop()
  */
 void Receiver::request(octetStream& os)
 {
-    in.push(&os);
+    check_outstanding();
+    in.push({&os, octetViews(), &os});
 }
 
 //TODO 确保收一个，读一个？
 void Receiver::wait(octetStream& os)
 {
-    octetStream* queued = 0;
+    wait(&os);
+}
+
+/**
+ * @brief Request to receive a package of length views.get_length() straight into the viewed memory.
+ * 
+ * @param views 
+ * @param id identifies the package in the wait
+ */
+void Receiver::request(const octetViews& views, const void *id)
+{
+    check_outstanding();
+    in.push({0, views, id});
+}
+
+void Receiver::wait(const void *id)
+{
+    const void* queued = 0;
     out.pop(queued);
-    if (queued != &os){
+    outstanding--;
+    if (queued != id){
+        throw not_implemented();
+    }
+}
+
+bool Receiver::try_wait(const void *id)
+{
+    const void* queued = 0;
+    if (!out.try_pop(queued)){
+        return false;
+    }
+    outstanding--;
+    if (queued != id){
         throw not_implemented();
     }
+    return true;
 }
\ No newline at end of file
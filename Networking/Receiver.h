@@ -3,16 +3,19 @@
 
 #include <pthread.h>
 
-#include "Tools/octetStream.h"
-#include "Tools/WaitQueue.h"
+#include "Networking/Transport.h"
+#include "Tools/SpscQueue.h"
+#include "Networking/SharedMemory.h"
 #include "Tools/time-func.h"
 
 class Receiver
 {
-    int socket;
-    WaitQueue<octetStream*> in;/* to recieve */
-    WaitQueue<octetStream*> out;/* recieved */
+    vector<int> sockets;/* Parallel connections, striping the large packages */
+    ShmRing *ring;/* Or the shared memory ring from a party on the same host */
+    SpscQueue<ReceiveTarget> in;/* to recieve */
+    SpscQueue<const void*> out;/* recieved: id */
     pthread_t thread;
+    size_t outstanding;/* Requests not waited yet, counted by the protocol thread */
 
     static void* run_thread(void* receiver);
 
@@ -20,15 +23,22 @@ class Receiver
 
     void start();/* Create a thread to execute run()(receive data). */
     void stop();
+    void check_outstanding();
     void run();/* Receive data in the thread. */
 
 public:
     Timer timer;
     Receiver(int socket);/* Construct a new Receiver to receive data via the socket. */
+    Receiver(const vector<int> &sockets);
+    Receiver(ShmRing &ring);
     ~Receiver();
 
     void request(octetStream& os);/* Request a octetStream to receive  */
     void wait(octetStream& os);
+    void request(const octetViews& views, const void *id);/* Request to receive into the viewed memory */
+    void wait(const void *id);
+    bool try_wait(const void *id);/* Complete the wait if the package is received, without blocking */
+    void set_event(EventCount *event){out.set_event(event);}/* Notify the event after each package received */
 };
 
 #endif
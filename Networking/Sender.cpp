@@ -6,7 +6,27 @@
  * 
  * @param socket socket number
  */
-Sender::Sender(int socket):socket(socket), thread(0)
+Sender::Sender(int socket):sockets({socket}), ring(0), thread(0), outstanding(0)
+{
+    start();
+}
+
+/**
+ * @brief Construct a new Sender to send data via the parallel connections to a player.
+ * 
+ * @param sockets 
+ */
+Sender::Sender(const vector<int> &sockets):sockets(sockets), ring(0), thread(0), outstanding(0)
+{
+    start();
+}
+
+/**
+ * @brief Construct a new Sender to send data via the shared memory ring to a player on the same host.
+ * 
+ * @param ring 
+ */
+Sender::Sender(ShmRing &ring):ring(&ring), thread(0), outstanding(0)
 {
     start();
 }
@@ -32,25 +52,29 @@ void* Sender::run_thread (void* sender)
 }
 
 /**
- * @brief Sends all octetStream in "in queue"(to send) in the thread.
+ * @brief Sends all packages in "in queue"(to send) in the thread.
  * in queue: to send
  * out queue: sent
  *
  */
 void Sender::run()
 {
-    // pointer to const
-    const octetStream* os = 0;
-    while(in.pop(os))
+    pair<const void*, octetViews> request;
+    while(in.pop(request))
     {
 #ifdef VERBOSE
         timer.start();
 #endif
-        os->Send(socket);
+        if(ring){
+            ring->Send(request.second);
+        }
+        else{
+            request.second.Send(sockets);
+        }
 #ifdef VERBOSE
         timer.stop();
 #endif
-        out.push(os);
+        out.push(request.first);
     }
 }
 
@@ -60,6 +84,18 @@ void Sender::stop()
     pthread_join(thread, 0);
 }
 
+/**
+ * @brief Throw instead of blocking forever on a request beyond SPSC_MAX_OUTSTANDING without waits.
+ * 
+ */
+void Sender::check_outstanding()
+{
+    if(outstanding == SPSC_MAX_OUTSTANDING){
+        throw overflow("requests outstanding with a Sender", outstanding + 1, SPSC_MAX_OUTSTANDING);
+    }
+    outstanding++;
+}
+
 /**
  * @brief Request a octetStream to send.
  * 
@@ -67,15 +103,33 @@ void Sender::stop()
  */
 void Sender::request(const octetStream& os)
 {
-    in.push(&os);
+    request(octetViews(os), &os);
 }
 
 //TODO don't understand
 void Sender::wait(const octetStream& os)
 {
-    const octetStream* queued = 0;
+    wait(&os);
+}
+
+/**
+ * @brief Request to send the memory viewed by views, which must stay alive until the wait.
+ *
+ * @param views
+ * @param id identifies the package in the wait
+ */
+void Sender::request(const octetViews& views, const void *id)
+{
+    check_outstanding();
+    in.push({id, views});
+}
+
+void Sender::wait(const void *id)
+{
+    const void* queued = 0;
     out.pop(queued);
-    if (queued != &os){
+    outstanding--;
+    if (queued != id){
         throw not_implemented();
     }
 }
\ No newline at end of file
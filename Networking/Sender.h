@@ -5,14 +5,17 @@
 
 #include "Tools/octetStream.h"
 #include "Tools/time-func.h"
-#include "Tools/WaitQueue.h"
+#include "Tools/SpscQueue.h"
+#include "Networking/SharedMemory.h"
 
 class Sender
 {
-    int socket;
-    WaitQueue<const octetStream*> in;/* to send */
-    WaitQueue<const octetStream*> out;/* sent */
+    vector<int> sockets;/* Parallel connections, striping the large packages */
+    ShmRing *ring;/* Or the shared memory ring to a party on the same host */
+    SpscQueue<pair<const void*, octetViews>> in;/* to send: id and views */
+    SpscQueue<const void*> out;/* sent: id */
     pthread_t thread;
+    size_t outstanding;/* Requests not waited yet, counted by the protocol thread */
 
     static void* run_thread(void* sender);
 
@@ -21,14 +24,19 @@ class Sender
 
     void start();/* Create a thread to execute run()(send data). */
     void stop();
-    void run();/* Sends all octetStream in "in queue"(to send) in the thread. */
+    void check_outstanding();
+    void run();/* Sends all packages in "in queue"(to send) in the thread. */
 
 public:
     Timer timer;
     Sender(int socket);/* Construct a new Sender to send data via the socket. */
+    Sender(const vector<int> &sockets);
+    Sender(ShmRing &ring);
     ~Sender();
 
     void request(const octetStream& os);/* Request a octetStream to send. */
     void wait(const octetStream& os);
+    void request(const octetViews& views, const void *id);/* Request the views to send, identified by id. */
+    void wait(const void *id);
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+
+#include "Networking/SharedMemory.h"
+#include "Networking/sockets.h"
+#include "Tools/Exceptions.h"
+
+using namespace std;
+
+// Bytes reserved for the control block of a ring, keeping the data page-aligned.
+const static size_t CONTROL_SIZE = 4096;
+
+ShmRing::ShmRing(void *memory, uint32_t capacity):
+    control((Control*)memory), data((octet*)memory + CONTROL_SIZE), capacity(capacity)
+{
+    static_assert(sizeof(Control) <= CONTROL_SIZE, "control block too large");
+    assert(capacity > 0 and (capacity & (capacity - 1)) == 0);
+}
+
+void ShmRing::write(const octet *buffer, size_t len)
+{
+    while(len){
+        uint32_t head = control->head.load(memory_order_relaxed);
+        uint32_t tail = control->tail.load(memory_order_acquire);
+        uint32_t space = capacity - (head - tail);
+        if(space == 0){
+            wait_until(control->read, [&](){return control->tail.load(memory_order_acquire) != tail;});
+            continue;
+        }
+        size_t n = min(len, (size_t)space);
+        size_t offset = head & (capacity - 1);
+        size_t first = min(n, capacity - offset);
+        memcpy(data + offset, buffer, first);
+        memcpy(data, buffer + first, n - first);
+        control->head.store(head + n, memory_order_release);
+        control->written.notify();
+        buffer += n;
+        len -= n;
+    }
+}
+
+void ShmRing::read(octet *buffer, size_t len)
+{
+    while(len){
+        uint32_t tail = control->tail.load(memory_order_relaxed);
+        uint32_t head = control->head.load(memory_order_acquire);
+        uint32_t used = head - tail;
+        if(used == 0){
+            wait_until(control->written, [&](){return control->head.load(memory_order_acquire) != head;});
+            continue;
+        }
+        size_t n = min(len, (size_t)used);
+        size_t offset = tail & (capacity - 1);
+        size_t first = min(n, capacity - offset);
+        memcpy(buffer, data + offset, first);
+        memcpy(buffer + first, data, n - first);
+        control->tail.store(tail + n, memory_order_release);
+        control->read.notify();
+        buffer += n;
+        len -= n;
+    }
+}
+
+void ShmRing::Send(const octetViews& views)
+{
+    octet header[LENGTH_SIZE];
+    encode_length(header, views.get_length(), LENGTH_SIZE);
+    write(header, LENGTH_SIZE);
+    vector<iovec> iov(views.size());
+    iov.resize(views.get_iov(header, LENGTH_SIZE, iov.data(), iov.size()));
+    for(auto &view: iov){
+        write((octet*)view.iov_base, view.iov_len);
+    }
+}
+
+void ShmRing::Receive(const ReceiveTarget& target)
+{
+    octet header[LENGTH_SIZE];
+    read(header, LENGTH_SIZE);
+    if(target.os){
+        size_t len = decode_length(header, LENGTH_SIZE);
+        target.os->reset_write_head();
+        read(target.os->append(len), len);
+        target.os->reset_read_head();
+    }
+    else{
+        target.views.check_length(header);
+        vector<iovec> iov(target.views.size());
+        iov.resize(target.views.get_iov(header, LENGTH_SIZE, iov.data(), iov.size()));
+        for(auto &view: iov){
+            read((octet*)view.iov_base, view.iov_len);
+        }
+    }
+}
+
+/**
+ * @brief Create the segment and send its name, or receive the name and open the segment.
+ * The first ring carries the packages from the creator.
+ *
+ * @param socket
+ * @param create
+ * @param capacity
+ */
+ShmSegment::ShmSegment(int socket, bool create, uint32_t capacity):
+    size(2 * (CONTROL_SIZE + capacity))
+{
+    static atomic<int> counter(0);
+    int fd;
+    octetStream name;
+    if(create){
+        name = octetStream("/hmmpc-" + to_string(getpid()) + "-" + to_string(counter++));
+        fd = shm_open(name.str().c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if(fd < 0 or ftruncate(fd, size) < 0){
+            error("ShmSegment: shm_open/ftruncate");
+        }
+    }
+    else{
+        name.Receive(socket);
+        fd = shm_open(name.str().c_str(), O_RDWR, 0600);
+        if(fd < 0){
+            error("ShmSegment: shm_open");
+        }
+    }
+    memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(memory == MAP_FAILED){
+        error("ShmSegment: mmap");
+    }
+
+    ShmRing first(memory, capacity), second((octet*)memory + size / 2, capacity);
+    if(create){
+        to_send = first;
+        to_receive = second;
+        name.Send(socket);
+    }
+    else{
+        to_send = second;
+        to_receive = first;
+        shm_unlink(name.str().c_str());
+    }
+}
+
+ShmSegment::~ShmSegment()
+{
+    munmap(memory, size);
+}
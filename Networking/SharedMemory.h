@@ -0,0 +1,75 @@
+#ifndef NETWORKING_SHAREDMEMORY_H_
+#define NETWORKING_SHAREDMEMORY_H_
+
+#include <atomic>
+#include <string>
+
+#include "Networking/Transport.h"
+#include "Tools/EventCount.h"
+
+// Bytes of the ring in each direction between two parties on the same host (a power of two), or 0 to use TCP
+#ifndef SHM_RING_SIZE
+#define SHM_RING_SIZE (1 << 22)
+#endif
+
+/**
+ * @brief Lock-free single-producer/single-consumer byte ring in shared memory.
+ * head and tail count the bytes written and read modulo 2^32.
+ * A blocked side spins shortly, and then sleeps by futex until the other side notifies its progress (see EventCount).
+ */
+class ShmRing
+{
+public:
+    struct Control
+    {
+        alignas(64) atomic<uint32_t> head;
+        EventCount written;
+        alignas(64) atomic<uint32_t> tail;
+        EventCount read;
+    };
+
+private:
+    Control *control;
+    octet *data;
+    uint32_t capacity;
+
+public:
+    ShmRing(): control(0), data(0), capacity(0){}
+    ShmRing(void *memory, uint32_t capacity);
+
+    // Write all len bytes, blocking while the ring is full.
+    void write(const octet *buffer, size_t len);
+    // Read exactly len bytes, blocking while the ring is empty.
+    void read(octet *buffer, size_t len);
+
+    // Send and receive the packages in the format of octetStream::Send(), i.e. [len||data].
+    void Send(const octetViews& views);
+    void Receive(const ReceiveTarget& target);
+};
+
+/**
+ * @brief Shared memory segment with the rings in both directions between two parties on the same host.
+ * The segment is created by one party, which sends its name via their connection,
+ * and it is unlinked by the other party once opened.
+ */
+class ShmSegment
+{
+    void *memory;
+    size_t size;
+
+    // prevent copying
+    ShmSegment(const ShmSegment& other);
+
+public:
+    ShmRing to_send, to_receive;
+
+    /**
+     * @param socket connection with the other party
+     * @param create whether to create the segment, or to open the one created by the other party
+     * @param capacity bytes of each ring
+     */
+    ShmSegment(int socket, bool create, uint32_t capacity = SHM_RING_SIZE);
+    ~ShmSegment();
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef NETWORKING_TRANSPORT_H_
+#define NETWORKING_TRANSPORT_H_
+
+#include "Tools/octetStream.h"
+
+/**
+ * @brief Destination of a package: the octetStream os,
+ * or the memory viewed by views if os is null, which must receive a package of length views.get_length().
+ */
+struct ReceiveTarget
+{
+    octetStream *os;
+    octetViews views;
+    const void *id; // identifies the package in the wait
+};
+
+/**
+ * @brief Asynchronous package I/O with all players, in the request/wait style of a Sender and a Receiver per player.
+ * The requests to (or from) the same player complete in FIFO order, and they are waited in the same order.
+ * The package format is the same as octetStream::Send(), i.e. [len||data].
+ */
+class Transport
+{
+public:
+    virtual ~Transport(){}
+
+    // Send the package viewed by views, identified by id in the wait.
+    virtual void request_send(int i, const octetViews& views, const void *id) = 0;
+    virtual void wait_send(int i, const void *id) = 0;
+    void request_send(int i, const octetStream& os){request_send(i, octetViews(os), &os);}
+    void wait_send(int i, const octetStream& os){wait_send(i, &os);}
+
+    // Receive a package into the octetStream, or straight into the memory viewed by views.
+    virtual void request_receive(int i, const ReceiveTarget& target) = 0;
+    virtual void wait_receive(int i, const void *id) = 0;
+    void request_receive(int i, octetStream& os){request_receive(i, {&os, octetViews(), &os});}
+    void wait_receive(int i, octetStream& os){wait_receive(i, &os);}
+    void request_receive(int i, const octetViews& views, const void *id){request_receive(i, {0, views, id});}
+
+    // Wait for the first of the next receives from the players (identified by ids) to complete, and return its index.
+    // The other receives stay pending. By default, the first one is waited.
+    virtual size_t wait_receive_any(const vector<int>& players, const vector<const void*>& ids)
+    {
+        wait_receive(players[0], ids[0]);
+        return 0;
+    }
+};
+
+#endif
@@ -2,6 +2,8 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <cstring>
+#include <poll.h>
+#include <linux/errqueue.h>
 
 #include "Networking/sockets.h"
 #include "Tools/Exceptions.h"
@@ -163,4 +165,59 @@ void close_client_socket(int socket)
         sprintf(tmp, "close(%d)", socket);
         error(tmp);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Enable MSG_ZEROCOPY on the socket.
+ * 
+ * @param socket 
+ * @return true if the kernel supports it
+ */
+bool enable_zerocopy(int socket)
+{
+    int one = 1;
+    return setsockopt(socket, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0;
+}
+
+bool zerocopy_enabled(int socket)
+{
+    int enabled = 0;
+    socklen_t len = sizeof(enabled);
+    if(getsockopt(socket, SOL_SOCKET, SO_ZEROCOPY, &enabled, &len) < 0){
+        return false;
+    }
+    return enabled;
+}
+
+/**
+ * @brief Wait for the completion notifications of n sends with MSG_ZEROCOPY,
+ * after which the sent memory can be modified.
+ * Each notification in the error queue covers a range of sends.
+ * 
+ * @param socket 
+ * @param n 
+ */
+void wait_zerocopy(int socket, size_t n)
+{
+    while(n){
+        pollfd pfd = {socket, 0, 0}; // POLLERR is always reported.
+        if(poll(&pfd, 1, -1) < 0 && errno != EINTR){
+            error("wait_zerocopy: poll");
+        }
+        char control[128];
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        if(recvmsg(socket, &msg, MSG_ERRQUEUE) < 0){
+            if(errno == EAGAIN or errno == EINTR){continue;}
+            error("wait_zerocopy: recvmsg");
+        }
+        for(cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)){
+            sock_extended_err *err = (sock_extended_err*)CMSG_DATA(cm);
+            if(err->ee_errno == 0 && err->ee_origin == SO_EE_ORIGIN_ZEROCOPY){
+                n -= min(n, (size_t)(err->ee_data - err->ee_info + 1));
+            }
+        }
+    }
+}
@@ -16,6 +16,7 @@
 #include <arpa/inet.h>
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/types.h>
 #include <sys/wait.h>   /* Wait for Process Termination */
 
@@ -37,6 +38,12 @@ void send(int socket, octet *msg, size_t len);
 void receive(int& socket, size_t& a, size_t len);
 void receive(int socket, octet *msg, size_t len);
 
+// Enable MSG_ZEROCOPY on the socket if the kernel supports it.
+bool enable_zerocopy(int socket);
+bool zerocopy_enabled(int socket);
+// Wait for the completion notifications of n sends with MSG_ZEROCOPY.
+void wait_zerocopy(int socket, size_t n);
+
 /**
  * @brief Send Package's Length Field via the socket.
  * 
@@ -73,6 +80,34 @@ inline size_t send_non_blocking(int socket, octet *msg, size_t len)
     return j;
 }
 
+/**
+ * @brief subroutine of sending a gather list
+ * 
+ * @param socket 
+ * @param iov 
+ * @param iovcnt 
+ * @param flags extra flags of sendmsg
+ * @return size_t bytes sent, 0 if it would block
+ */
+inline size_t send_non_blocking(int socket, const iovec *iov, size_t iovcnt, int flags = 0)
+{
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = (iovec*)iov;
+    msg.msg_iovlen = iovcnt;
+    ssize_t j = sendmsg(socket, &msg, MSG_DONTWAIT | flags);
+    if (j < 0){
+        if (errno != EINTR and errno != EAGAIN and errno != EWOULDBLOCK
+            and not (errno == ENOBUFS and (flags & MSG_ZEROCOPY))){
+            error("Send error -1");
+        }
+        else{
+            return 0;
+        }
+    }
+    return j;
+}
+
 /**
  * @brief Send any data via the socket
  * 
@@ -89,6 +124,35 @@ inline void send(int socket, octet *msg, size_t len)
     }
 }
 
+/**
+ * @brief subroutine of receiving into a scatter list
+ * 
+ * @param socket 
+ * @param iov 
+ * @param iovcnt 
+ * @return size_t bytes received, 0 if it would block
+ */
+inline size_t receive_non_blocking(int socket, const iovec *iov, size_t iovcnt)
+{
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = (iovec*)iov;
+    msg.msg_iovlen = iovcnt;
+    ssize_t j = recvmsg(socket, &msg, MSG_DONTWAIT);
+    if (j == 0){
+        throw closed_connection();
+    }
+    if (j < 0){
+        if (errno != EINTR and errno != EAGAIN and errno != EWOULDBLOCK){
+            error("Receiving error - 1");
+        }
+        else{
+            return 0;
+        }
+    }
+    return j;
+}
+
 /**
  * @brief Receive Package's Length Field via the socket.
  * 
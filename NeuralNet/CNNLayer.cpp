@@ -7,8 +7,9 @@ using namespace std;
 namespace hmmpc
 {
 
-CNNLayer::CNNLayer(CNNConfig* conf, int _layerNum)
-:Layer(_layerNum),
+template<class Field>
+CNNLayer<Field>::CNNLayer(CNNConfig* conf, int _layerNum)
+:Layer<Field>(_layerNum),
 conf(conf->imageHeight, conf->imageWidth, conf->inputFeatures, 
 	  conf->filters, conf->filterSize, conf->stride, 
 	  conf->padding, conf->batchSize),
@@ -24,12 +25,14 @@ deltas(conf->batchSize, conf->filters *
     initialize();
 }
 
-void CNNLayer::initialize()
+template<class Field>
+void CNNLayer<Field>::initialize()
 {
 
 }
 
-void CNNLayer::printLayer()
+template<class Field>
+void CNNLayer<Field>::printLayer()
 {
 	cout << "----------------------------------------------" << endl;  	
 	cout << "(" << layerNum+1 << ") CNN Layer\t\t  " << conf.imageHeight << " x " << conf.imageWidth 
@@ -44,7 +47,8 @@ void CNNLayer::printLayer()
 
 // Each row stores the feature1, feature2, ..., of the image.
 // TODO: There is some bug when the batch_size > 1. 
-void CNNLayer::forward(const sfixMatrix &inputActivations)
+template<class Field>
+void CNNLayer<Field>::forward(const sfixMatrix<Field> &inputActivations)
 {
 	log_print("CNN.forward");
 	
@@ -59,31 +63,46 @@ void CNNLayer::forward(const sfixMatrix &inputActivations)
 	size_t ow 	= (((iw-f+2*P)/S)+1);
 	size_t oh	= (((ih-f+2*P)/S)+1);
 
-    gfpMatrix paddedInput(B, (iw+2*P)*(ih+2*P)*Din);
+    gfpMatrix<Field> paddedInput(B, (iw+2*P)*(ih+2*P)*Din);
     zeroPad(inputActivations.share(), paddedInput, iw, ih, P, Din, B);
 
-    sfixMatrix extendInput(B*oh*ow, f*f*Din);
+    sfixMatrix<Field> extendInput(B*oh*ow, f*f*Din);
     convolExtend(paddedInput, extendInput.share(), iw, ih, ow, oh, Din, S, f, B);
 
 	// activations(B, oh*ow*Dout)
     if (FUNCTION_TIME)
-		cout << "funcConvMatMul: " << funcTime(funcConvMatMul, extendInput, weights, biases, activations, B, oh, ow, Dout) << endl;
+		cout << "funcConvMatMul: " << funcTime(funcConvMatMul<Field>, extendInput, weights, biases, activations, B, oh, ow, Dout) << endl;
 	else
 		funcConvMatMul(extendInput, weights, biases, activations, B, oh, ow, Dout);
 }
 
-void CNNLayer::forwardOnly(const sfixMatrix &inputActivations)
+template<class Field>
+void CNNLayer<Field>::forwardOnly(const sfixMatrix<Field> &inputActivations)
 {
 	forward(inputActivations);
 }
 
-void CNNLayer::computeDelta(sfixMatrix &prevDelta)
+template<class Field>
+void CNNLayer<Field>::planForwardOnly(PreprocessingPlan<Field> &plan)
 {
-
+	size_t ow 	= (((conf.imageWidth-conf.filterSize+2*conf.padding)/conf.stride)+1);
+	size_t oh	= (((conf.imageHeight-conf.filterSize+2*conf.padding)/conf.stride)+1);
+	plan.reduce_truncate(conf.batchSize*oh*ow*conf.filters);
 }
 
-void CNNLayer::updateEquations(const sfixMatrix &preactivations)
+template<class Field>
+void CNNLayer<Field>::computeDelta(sfixMatrix<Field> &prevDelta)
 {
 
 }
+
+template<class Field>
+void CNNLayer<Field>::updateEquations(const sfixMatrix<Field> &preactivations)
+{
+
 }
+
+template class CNNLayer<PR31>;
+
+template class CNNLayer<PR61>;
+}
\ No newline at end of file
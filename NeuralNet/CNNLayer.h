@@ -8,15 +8,17 @@ using namespace std;
 namespace hmmpc
 {
 
-class CNNLayer: public Layer
+template<class Field>
+class CNNLayer: public Layer<Field>
 {
 private:
     CNNConfig conf;
-    sfixMatrix activations;
-    sfixMatrix deltas;
-    sfixMatrix weights;
-    sfixMatrix biases;
+    sfixMatrix<Field> activations;
+    sfixMatrix<Field> deltas;
+    sfixMatrix<Field> weights;
+    sfixMatrix<Field> biases;
 public:
+    using Layer<Field>::layerNum;
 
     //Constructor and initializer
 	CNNLayer(CNNConfig* conf, int _layerNum);
@@ -24,14 +26,15 @@ public:
 
 	//Functions
 	void printLayer() override;
-	void forward(const sfixMatrix& inputActivation) override;
-    void forwardOnly(const sfixMatrix &inputActivations) override;
-	void computeDelta(sfixMatrix& prevDelta) override;
-	void updateEquations(const sfixMatrix& prevActivations) override;
+	void forward(const sfixMatrix<Field>& inputActivation) override;
+    void forwardOnly(const sfixMatrix<Field> &inputActivations) override;
+    void planForwardOnly(PreprocessingPlan<Field> &plan) override;
+	void computeDelta(sfixMatrix<Field>& prevDelta) override;
+	void updateEquations(const sfixMatrix<Field>& prevActivations) override;
 
-    sfixMatrix& getActivation(){sfixMatrix &ref = activations; return ref;}
-    sfixMatrix& getDelta(){sfixMatrix &ref = deltas; return ref;}
-    sfixMatrix& getWeights(){sfixMatrix &ref = weights; return ref;}
-    sfixMatrix& getBias(){sfixMatrix &ref = biases; return ref;}
+    sfixMatrix<Field>& getActivation(){sfixMatrix<Field> &ref = activations; return ref;}
+    sfixMatrix<Field>& getDelta(){sfixMatrix<Field> &ref = deltas; return ref;}
+    sfixMatrix<Field>& getWeights(){sfixMatrix<Field> &ref = weights; return ref;}
+    sfixMatrix<Field>& getBias(){sfixMatrix<Field> &ref = biases; return ref;}
 };
 }
\ No newline at end of file
@@ -6,8 +6,9 @@ using namespace std;
 namespace hmmpc
 {
 
-FCLayer::FCLayer(FCConfig* conf, int _layerNum)
-:Layer(_layerNum),
+template<class Field>
+FCLayer<Field>::FCLayer(FCConfig* conf, int _layerNum)
+:Layer<Field>(_layerNum),
 conf(conf->inputDim, conf->batchSize, conf->outputDim),
 activations(conf->batchSize, conf->outputDim),
 deltas(conf->batchSize, conf->outputDim),
@@ -17,10 +18,11 @@ biases(conf->outputDim, 1)
     initialize();
 }
 
-void FCLayer::initialize()
+template<class Field>
+void FCLayer<Field>::initialize()
 {
     SeededPRNG prng;
-    TYPE lower = 30, higher = 50, decimation = 10000;
+    typename Field::TYPE lower = 30, higher = 50, decimation = 10000;
     // if(partyNum==0){
     //     for(size_t i = 0; i < weights.size(); i++){
     //         float tmp = (float) (prng.get_uchar() % (higher-lower) + lower)/decimation;
@@ -37,14 +39,16 @@ void FCLayer::initialize()
     // biases.share().setConstant(0);
 }
 
-void FCLayer::printLayer()
+template<class Field>
+void FCLayer<Field>::printLayer()
 {
 	cout << "----------------------------------------------" << endl;  	
 	cout << "(" << layerNum+1 << ") FC Layer\t\t  " << conf.inputDim << " x " << conf.outputDim << endl << "\t\t\t  "
 		 << conf.batchSize << "\t\t (Batch Size)" << endl;
 }
 
-void FCLayer::forward(const sfixMatrix &inputActivations)
+template<class Field>
+void FCLayer<Field>::forward(const sfixMatrix<Field> &inputActivations)
 {
     log_print("FC.forward");
 
@@ -54,9 +58,9 @@ void FCLayer::forward(const sfixMatrix &inputActivations)
 #endif
 
     if (FUNCTION_TIME)
-        cout << "funcMatMul: "<< funcTime(funcMatMul, inputActivations, weights, activations, 0, 0, FIXED_PRECISION) <<endl;
+        cout << "funcMatMul: "<< funcTime(funcMatMul<Field>, inputActivations, weights, activations, 0, 0, Field::FIXED_PRECISION) <<endl;
     else
-        funcMatMul(inputActivations, weights, activations, 0, 0, FIXED_PRECISION);
+        funcMatMul(inputActivations, weights, activations, 0, 0, Field::FIXED_PRECISION);
     
     // activations = inputActivations * weights;
     for(size_t i = 0; i < conf.outputDim; i++){
@@ -69,17 +73,25 @@ void FCLayer::forward(const sfixMatrix &inputActivations)
 #endif
 }
 
-void FCLayer::forwardOnly(const sfixMatrix &inputActivations)
+template<class Field>
+void FCLayer<Field>::forwardOnly(const sfixMatrix<Field> &inputActivations)
 {
     forward(inputActivations);
 }
 
-void FCLayer::computeDelta(sfixMatrix &prevDelta)
+template<class Field>
+void FCLayer<Field>::planForwardOnly(PreprocessingPlan<Field> &plan)
+{
+    plan.reduce_truncate(conf.batchSize * conf.outputDim);
+}
+
+template<class Field>
+void FCLayer<Field>::computeDelta(sfixMatrix<Field> &prevDelta)
 {
     if (FUNCTION_TIME)
-        cout << "funcMatMul: "<< funcTime(funcMatMul, deltas, weights, prevDelta, 0, 1, FIXED_PRECISION) <<endl;
+        cout << "funcMatMul: "<< funcTime(funcMatMul<Field>, deltas, weights, prevDelta, 0, 1, Field::FIXED_PRECISION) <<endl;
     else
-        funcMatMul(deltas, weights, prevDelta, 0, 1, FIXED_PRECISION);
+        funcMatMul(deltas, weights, prevDelta, 0, 1, Field::FIXED_PRECISION);
 
 #ifdef DEBUG_NN
     cout<<"w: "<<weights.reveal(conf.outputDim)<<endl;
@@ -88,31 +100,32 @@ void FCLayer::computeDelta(sfixMatrix &prevDelta)
 #endif
 }
 
-void FCLayer::updateEquations(const sfixMatrix &prevActivations)
+template<class Field>
+void FCLayer<Field>::updateEquations(const sfixMatrix<Field> &prevActivations)
 {
     log_print("FC.updateEquations");
 
-    sfixMatrix batchBiases(conf.outputDim, 1);
-    batchBiases.share() = (deltas.share().colwise().sum()).reshaped<Eigen::RowMajor>();
-
-    // batchBiases.truncate(LOG_LEARNING_RATE+LOG_MINI_BATCH);
-    if (FUNCTION_TIME)
-        cout << "funcT: "<< funcTime(funcTrunc, batchBiases, LOG_LEARNING_RATE+LOG_MINI_BATCH) <<endl;
-    else
-        funcTrunc(batchBiases, LOG_LEARNING_RATE+LOG_MINI_BATCH);
-
-
-    biases.share() -= batchBiases.share();
+    sfixMatrix<Field> batchBiases(conf.outputDim, 1);
+    batchBiases.share() = (deltas.share().colwise().sum()).template reshaped<Eigen::RowMajor>();
 
     // Update Weights
-    sfixMatrix deltaWeights(conf.inputDim, conf.outputDim);
+    sfixMatrix<Field> deltaWeights(conf.inputDim, conf.outputDim);
     // deltaWeights.share() = prevActivations.share().transpose() * deltas.share();
     // deltaWeights.reduce_truncate(LOG_LEARNING_RATE, LOG_MINI_BATCH);
-    if (FUNCTION_TIME)
-        cout << "funcMatMul: "<< funcTime(funcMatMul, prevActivations, deltas, deltaWeights, 1, 0, FIXED_PRECISION+LOG_LEARNING_RATE+LOG_MINI_BATCH) <<endl;
-    else
-        funcMatMul(prevActivations, deltas, deltaWeights, 1, 0, FIXED_PRECISION+LOG_LEARNING_RATE+LOG_MINI_BATCH);
-    
+
+    // batchBiases.truncate(LOG_LEARNING_RATE+LOG_MINI_BATCH);
+    if (FUNCTION_TIME){
+        cout << "funcT: "<< funcTime(funcTrunc<Field>, batchBiases, LOG_LEARNING_RATE+LOG_MINI_BATCH) <<endl;
+        cout << "funcMatMul: "<< funcTime(funcMatMul<Field>, prevActivations, deltas, deltaWeights, 1, 0, Field::FIXED_PRECISION+LOG_LEARNING_RATE+LOG_MINI_BATCH) <<endl;
+    }else{
+        // The truncations of the biases and the weights are independent, which share one round.
+        DeferredRound<Field> round;
+        funcDeferredTrunc(batchBiases, LOG_LEARNING_RATE+LOG_MINI_BATCH, round);
+        funcDeferredMatMul(prevActivations, deltas, deltaWeights, 1, 0, Field::FIXED_PRECISION+LOG_LEARNING_RATE+LOG_MINI_BATCH, round);
+        round.flush();
+    }
+
+    biases.share() -= batchBiases.share();
     weights.share() -= deltaWeights.share();
 }
 
@@ -131,7 +144,7 @@ biases(conf->outputDim, 1)
 void FCLayerClear::initalize()
 {
     SeededPRNG prng;
-    TYPE lower = 30, higher = 50, decimation = 10000;
+    unsigned int lower = 30, higher = 50, decimation = 10000;
     for(size_t i = 0; i < weights.size(); i++){
         weights(i) = (float) (prng.get_uchar() % (higher-lower) + lower)/decimation;
     }
@@ -233,4 +246,8 @@ void FCLayerClear::printBias(std::string fn)
         out<<biases(i)<<endl;
     }
 }
+
+template class FCLayer<PR31>;
+
+template class FCLayer<PR61>;
 }
\ No newline at end of file
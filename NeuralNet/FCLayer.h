@@ -6,29 +6,32 @@ extern int partyNum;
 namespace hmmpc
 {
 
-class FCLayer : public Layer
+template<class Field>
+class FCLayer : public Layer<Field>
 {
 private:
     FCConfig conf;
-    sfixMatrix activations;
-    sfixMatrix deltas;
-    sfixMatrix weights;
-    sfixMatrix biases;
+    sfixMatrix<Field> activations;
+    sfixMatrix<Field> deltas;
+    sfixMatrix<Field> weights;
+    sfixMatrix<Field> biases;
 
 public:
+    using Layer<Field>::layerNum;
     FCLayer(FCConfig* conf, int _layerNum);
     void initialize();
 
     void printLayer() override;
-    void forward(const sfixMatrix& inputActivations) override;
-    void forwardOnly(const sfixMatrix &inputActivations) override;
-    void computeDelta(sfixMatrix &prevDelta)override;
-    void updateEquations(const sfixMatrix &prevActivations)override;
-
-    sfixMatrix& getActivation(){sfixMatrix &ref = activations; return ref;}
-    sfixMatrix& getDelta(){sfixMatrix &ref = deltas; return ref;}
-    sfixMatrix& getWeights(){sfixMatrix &ref = weights; return ref;}
-    sfixMatrix& getBias(){sfixMatrix &ref = biases; return ref;}
+    void forward(const sfixMatrix<Field>& inputActivations) override;
+    void forwardOnly(const sfixMatrix<Field> &inputActivations) override;
+    void planForwardOnly(PreprocessingPlan<Field> &plan) override;
+    void computeDelta(sfixMatrix<Field> &prevDelta)override;
+    void updateEquations(const sfixMatrix<Field> &prevActivations)override;
+
+    sfixMatrix<Field>& getActivation(){sfixMatrix<Field> &ref = activations; return ref;}
+    sfixMatrix<Field>& getDelta(){sfixMatrix<Field> &ref = deltas; return ref;}
+    sfixMatrix<Field>& getWeights(){sfixMatrix<Field> &ref = weights; return ref;}
+    sfixMatrix<Field>& getBias(){sfixMatrix<Field> &ref = biases; return ref;}
 };
 
 class FCLayerClear: public LayerClear
@@ -1,7 +1,9 @@
 #pragma once
 #include "Types/sfixMatrix.h"
+#include "Protocols/PreprocessingPlan.h"
 namespace hmmpc
 {
+template<class Field>
 class Layer
 {
 public:
@@ -9,13 +11,14 @@ public:
     Layer(int _layerNum):layerNum(_layerNum){}
 
     virtual void printLayer(){};
-    virtual void forward(const sfixMatrix &inputActivations) = 0;
-    virtual void forwardOnly(const sfixMatrix &inputActivations) = 0;
-    virtual void computeDelta(sfixMatrix &prevDelta) = 0;
-    virtual void updateEquations(const sfixMatrix &prevActivations)=0;
+    virtual void forward(const sfixMatrix<Field> &inputActivations) = 0;
+    virtual void forwardOnly(const sfixMatrix<Field> &inputActivations) = 0;
+    virtual void planForwardOnly(PreprocessingPlan<Field> &plan) = 0;// Tally the randomness of forwardOnly()
+    virtual void computeDelta(sfixMatrix<Field> &prevDelta) = 0;
+    virtual void updateEquations(const sfixMatrix<Field> &prevActivations)=0;
 
-    virtual sfixMatrix& getActivation() = 0;
-    virtual sfixMatrix& getDelta() = 0;
+    virtual sfixMatrix<Field>& getActivation() = 0;
+    virtual sfixMatrix<Field>& getDelta() = 0;
 
 };
 
@@ -7,8 +7,9 @@ using namespace std;
 
 namespace hmmpc
 {
-MaxpoolLayer::MaxpoolLayer(MaxpoolConfig* conf, int _layerNum)
-:Layer(_layerNum),
+template<class Field>
+MaxpoolLayer<Field>::MaxpoolLayer(MaxpoolConfig* conf, int _layerNum)
+:Layer<Field>(_layerNum),
 conf(conf->imageHeight, conf->imageWidth, conf->features, 
 	  conf->poolSize, conf->stride, conf->batchSize),
 activations(conf->batchSize, conf->features*
@@ -22,7 +23,8 @@ maxPrime(conf->batchSize, conf->features * conf->poolSize * conf->poolSize *
  		    (((conf->imageHeight - conf->poolSize)/conf->stride) + 1))
 {}
 
-void MaxpoolLayer::printLayer()
+template<class Field>
+void MaxpoolLayer<Field>::printLayer()
 {
 	cout << "----------------------------------------------" << endl;  	
 	cout << "(" << layerNum+1 << ") Maxpool Layer\t  " << conf.imageHeight << " x " << conf.imageWidth 
@@ -32,7 +34,8 @@ void MaxpoolLayer::printLayer()
 		 << conf.batchSize << "\t\t(Batch Size)" << endl;
 }
 
-void MaxpoolLayer::forward(const sfixMatrix &inputActivations)
+template<class Field>
+void MaxpoolLayer<Field>::forward(const sfixMatrix<Field> &inputActivations)
 {
     log_print("Maxpool.forward");
 
@@ -45,17 +48,18 @@ void MaxpoolLayer::forward(const sfixMatrix &inputActivations)
 	size_t ow 	= (((iw-f)/S)+1);
 	size_t oh	= (((ih-f)/S)+1);
 
-    sfixMatrix extendInput(B*ow*oh*Din, f*f);
+    sfixMatrix<Field> extendInput(B*ow*oh*Din, f*f);
     maxpoolExtend(inputActivations.share(), extendInput.share(), iw, ih, ow, oh, Din, S, f, B);
 
     if (FUNCTION_TIME)
-		cout << "funcMaxpool: " << funcTime(funcMaxpool,extendInput, maxPrime, activations, B, Din, oh, ow, f) << endl;
+		cout << "funcMaxpool: " << funcTime(funcMaxpool<Field>, extendInput, maxPrime, activations, B, Din, oh, ow, f) << endl;
 	else
 		funcMaxpool(extendInput, maxPrime, activations, B, Din, oh, ow, f);
 
 }
 
-void MaxpoolLayer::forwardOnly(const sfixMatrix &inputActivations)
+template<class Field>
+void MaxpoolLayer<Field>::forwardOnly(const sfixMatrix<Field> &inputActivations)
 {
     log_print("Maxpool.forward");
 
@@ -68,22 +72,38 @@ void MaxpoolLayer::forwardOnly(const sfixMatrix &inputActivations)
 	size_t ow 	= (((iw-f)/S)+1);
 	size_t oh	= (((ih-f)/S)+1);
 
-    sfixMatrix extendInput(B*ow*oh*Din, f*f);
+    sfixMatrix<Field> extendInput(B*ow*oh*Din, f*f);
     maxpoolExtend(inputActivations.share(), extendInput.share(), iw, ih, ow, oh, Din, S, f, B);
 
     if (FUNCTION_TIME)
-		cout << "funcOnlyMaxpool: " << funcTime(funcOnlyMaxpool, extendInput, activations, B, Din, oh, ow) << endl;
+		cout << "funcOnlyMaxpool: " << funcTime(funcOnlyMaxpool<Field>, extendInput, activations, B, Din, oh, ow) << endl;
 	else
         funcOnlyMaxpool(extendInput, activations, B, Din, oh, ow);
 }
 
-void MaxpoolLayer::computeDelta(sfixMatrix &prevDelta)
+template<class Field>
+void MaxpoolLayer<Field>::planForwardOnly(PreprocessingPlan<Field> &plan)
+{
+	size_t f 	= conf.poolSize;
+	size_t S 	= conf.stride;
+	size_t ow 	= (((conf.imageWidth-f)/S)+1);
+	size_t oh	= (((conf.imageHeight-f)/S)+1);
+	plan.MaxRowwise_opt(conf.batchSize*ow*oh*conf.features, f*f);
+}
+
+template<class Field>
+void MaxpoolLayer<Field>::computeDelta(sfixMatrix<Field> &prevDelta)
 {
 
 }
 
-void MaxpoolLayer::updateEquations(const sfixMatrix &prevActivations)
+template<class Field>
+void MaxpoolLayer<Field>::updateEquations(const sfixMatrix<Field> &prevActivations)
 {
 
 }
+
+template class MaxpoolLayer<PR31>;
+
+template class MaxpoolLayer<PR61>;
 }
\ No newline at end of file
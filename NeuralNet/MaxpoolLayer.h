@@ -8,25 +8,28 @@ using namespace std;
 namespace hmmpc
 {
 
-class MaxpoolLayer: public Layer
+template<class Field>
+class MaxpoolLayer: public Layer<Field>
 {
 
 private:
     MaxpoolConfig conf;
-    sfixMatrix activations;
-    sfixMatrix deltas;
-    sintMatrix maxPrime;
+    sfixMatrix<Field> activations;
+    sfixMatrix<Field> deltas;
+    sintMatrix<Field> maxPrime;
 
 public:
+    using Layer<Field>::layerNum;
     MaxpoolLayer(MaxpoolConfig* conf, int _layerNum);
 
     void printLayer() override;
-    void forward(const sfixMatrix &inputActivations) override;
-    void forwardOnly(const sfixMatrix &inputActivations)override;
-    void computeDelta(sfixMatrix &prevDelta)override;
-    void updateEquations(const sfixMatrix &prevActivations)override;
+    void forward(const sfixMatrix<Field> &inputActivations) override;
+    void forwardOnly(const sfixMatrix<Field> &inputActivations)override;
+    void planForwardOnly(PreprocessingPlan<Field> &plan)override;
+    void computeDelta(sfixMatrix<Field> &prevDelta)override;
+    void updateEquations(const sfixMatrix<Field> &prevActivations)override;
 
-    sfixMatrix& getActivation(){sfixMatrix &ref = activations; return ref;}
-    sfixMatrix& getDelta(){sfixMatrix &ref = deltas; return ref;}
+    sfixMatrix<Field>& getActivation(){sfixMatrix<Field> &ref = activations; return ref;}
+    sfixMatrix<Field>& getDelta(){sfixMatrix<Field> &ref = deltas; return ref;}
 };
 }
\ No newline at end of file
@@ -15,35 +15,38 @@ extern size_t MINI_BATCH_SIZE;
 using namespace std;
 namespace hmmpc
 {
-NeuralNetwork::NeuralNetwork(NeuralNetConfig *config)
+template<class Field>
+NeuralNetwork<Field>::NeuralNetwork(NeuralNetConfig *config)
 :inputData(MINI_BATCH_SIZE, INPUT_SIZE), outputData(MINI_BATCH_SIZE, LAST_LAYER_SIZE)
 {
     for(size_t i = 0; i < NUM_LAYERS; i++){
         if(config->layerConf[i]->type.compare("FC")==0){
             FCConfig *cfg = static_cast<FCConfig*>(config->layerConf[i]);
-            layers.push_back(new FCLayer(cfg, i));
+            layers.push_back(new FCLayer<Field>(cfg, i));
         }else if(config->layerConf[i]->type.compare("ReLU")==0){
             ReLUConfig *cfg = static_cast<ReLUConfig*>(config->layerConf[i]);
-            layers.push_back(new ReLULayer(cfg, i));
+            layers.push_back(new ReLULayer<Field>(cfg, i));
         }else if(config->layerConf[i]->type.compare("Maxpool")==0){
             MaxpoolConfig *cfg = static_cast<MaxpoolConfig *>(config->layerConf[i]);
-            layers.push_back(new MaxpoolLayer(cfg, i));
+            layers.push_back(new MaxpoolLayer<Field>(cfg, i));
         }else if(config->layerConf[i]->type.compare("CNN")==0){
             CNNConfig *cfg = static_cast<CNNConfig*>(config->layerConf[i]);
-            layers.push_back(new CNNLayer(cfg, i));
+            layers.push_back(new CNNLayer<Field>(cfg, i));
         }
 	}
 }
 
-NeuralNetwork::~NeuralNetwork()
+template<class Field>
+NeuralNetwork<Field>::~NeuralNetwork()
 {
-	for (vector<Layer*>::iterator it = layers.begin() ; it != layers.end(); ++it)
+	for (typename vector<Layer<Field>*>::iterator it = layers.begin() ; it != layers.end(); ++it)
 		delete (*it);
 
 	layers.clear();
 }
 
-void NeuralNetwork::forward()
+template<class Field>
+void NeuralNetwork<Field>::forward()
 {
     log_print("NN.forward");
 
@@ -60,7 +63,8 @@ void NeuralNetwork::forward()
     }
 }
 
-void NeuralNetwork::forwardOnly()
+template<class Field>
+void NeuralNetwork<Field>::forwardOnly()
 {
     log_print("NN.forwardOnly");
 
@@ -71,25 +75,35 @@ void NeuralNetwork::forwardOnly()
     }
 }
 
-void NeuralNetwork::backward()
+template<class Field>
+void NeuralNetwork<Field>::planForwardOnly(PreprocessingPlan<Field> &plan)
+{
+    for(size_t i = 0; i < NUM_LAYERS; i++){
+        layers[i]->planForwardOnly(plan);
+    }
+}
+
+template<class Field>
+void NeuralNetwork<Field>::backward()
 {
     log_print("NN.backward");
     computeDelta();
     updateEquations();
 }
 
-void NeuralNetwork::computeDelta()
+template<class Field>
+void NeuralNetwork<Field>::computeDelta()
 {
     log_print("NN.computeDelta");
-    sfixMatrix rowSum(MINI_BATCH_SIZE, 1);
+    sfixMatrix<Field> rowSum(MINI_BATCH_SIZE, 1);
 
 #ifdef DEBUG_NN    
     cout << "----------------------------------------------" << endl;
 	cout << "DEBUG: computeDelta() at NeuralNetwork.cpp" << endl;
 #endif
-    sfixMatrix activations(MINI_BATCH_SIZE, LAST_LAYER_SIZE);
+    sfixMatrix<Field> activations(MINI_BATCH_SIZE, LAST_LAYER_SIZE);
     if (FUNCTION_TIME)
-        cout<<"funcOnlyReLU: "<<funcTime(funcOnlyReLU, layers[NUM_LAYERS-1]->getActivation(), activations)<<endl;
+        cout<<"funcOnlyReLU: "<<funcTime(funcOnlyReLU<Field>, layers[NUM_LAYERS-1]->getActivation(), activations)<<endl;
     else
         funcOnlyReLU(layers[NUM_LAYERS-1]->getActivation(), activations);
 
@@ -98,9 +112,9 @@ void NeuralNetwork::computeDelta()
     rowSum.share() = activations.share().rowwise().sum();
 
     // sfixMatrix softmaxOutput = divideRowwise(activations, rowSum);
-    sfixMatrix softmaxOutput(MINI_BATCH_SIZE, LAST_LAYER_SIZE);
+    sfixMatrix<Field> softmaxOutput(MINI_BATCH_SIZE, LAST_LAYER_SIZE);
     if (FUNCTION_TIME)
-        cout<<"funcDivision: "<<funcTime(funcDivision, activations, rowSum, softmaxOutput)<<endl;
+        cout<<"funcDivision: "<<funcTime(funcDivision<Field>, activations, rowSum, softmaxOutput)<<endl;
     else
         funcDivision(activations, rowSum, softmaxOutput);
     // cout<<"softmax: "<<softmaxOutput.reveal(10*3)<<endl;
@@ -114,7 +128,8 @@ void NeuralNetwork::computeDelta()
     }
 }
 
-void NeuralNetwork::updateEquations()
+template<class Field>
+void NeuralNetwork<Field>::updateEquations()
 {
     log_print("NN.updateEquations");
 
@@ -125,21 +140,23 @@ void NeuralNetwork::updateEquations()
     layers[0]->updateEquations(inputData);
 }
 
-void NeuralNetwork::predict(sintMatrix &maxIndex)
+template<class Field>
+void NeuralNetwork<Field>::predict(sintMatrix<Field> &maxIndex)
 {
     log_print("NN.predict");
     // cout<<layers[NUM_LAYERS-1]->getActivation().reveal()<<endl;
     layers[NUM_LAYERS-1]->getActivation().MaxpoolPrime(maxIndex);
 }
 
-void NeuralNetwork::getAccuracy(sintMatrix &maxIndex, vector<size_t>&counter)
+template<class Field>
+void NeuralNetwork<Field>::getAccuracy(sintMatrix<Field> &maxIndex, vector<size_t>&counter)
 {
     log_print("NN.getAccuracy");
-    gfpMatrix prediction = maxIndex.reveal().values;
+    gfpMatrix<Field> prediction = maxIndex.reveal().values;
     // cout<<prediction<<endl;
-    gfpMatrix groundTruth = outputData.reveal().values;
+    gfpMatrix<Field> groundTruth = outputData.reveal().values;
     // cout<<groundTruth<<endl;
-    gfpMatrix diff = (prediction.array() * groundTruth.array()).rowwise().sum();
+    gfpMatrix<Field> diff = (prediction.array() * groundTruth.array()).rowwise().sum();
     
     for(size_t i = 0; i < MINI_BATCH_SIZE; i++){
         if(diff(i).get_value()){
@@ -272,4 +289,7 @@ void NeuralNetworkClear::getAccuracy(RowMatrixXd &maxIndex, vector<size_t> &coun
 		 << counter[1] << " (" << (counter[0]*100/counter[1]) << " %)" << endl;
 }
 
+template class NeuralNetwork<PR31>;
+
+template class NeuralNetwork<PR61>;
 }
\ No newline at end of file
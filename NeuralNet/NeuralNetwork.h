@@ -7,23 +7,25 @@
 namespace hmmpc
 {
 
+template<class Field>
 class NeuralNetwork
 {
 public: 
-    sfixMatrix inputData;
-    sfixMatrix outputData;
-    vector<Layer*> layers;
+    sfixMatrix<Field> inputData;
+    sfixMatrix<Field> outputData;
+    vector<Layer<Field>*> layers;
 
     NeuralNetwork(NeuralNetConfig*config);
     ~NeuralNetwork();
 
     void forward();
     void forwardOnly();//for inference
+    void planForwardOnly(PreprocessingPlan<Field> &plan);// Tally the randomness of forwardOnly() without running it
     void backward();
     void computeDelta();
     void updateEquations();
-    void predict(sintMatrix &maxIndex);
-    void getAccuracy(sintMatrix &maxIndex, vector<size_t> &counter);
+    void predict(sintMatrix<Field> &maxIndex);
+    void getAccuracy(sintMatrix<Field> &maxIndex, vector<size_t> &counter);
 };
 
 class NeuralNetworkClear
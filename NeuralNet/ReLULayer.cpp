@@ -8,26 +8,29 @@ using namespace std;
 namespace hmmpc
 {
 
-ReLULayer::ReLULayer(ReLUConfig *conf, int _layerNum)
-:Layer(_layerNum),
+template<class Field>
+ReLULayer<Field>::ReLULayer(ReLUConfig *conf, int _layerNum)
+:Layer<Field>(_layerNum),
 conf(conf->inputDim, conf->batchSize),
 activations(conf->batchSize, conf->inputDim),
 deltas(conf->batchSize, conf->inputDim),
 reluPrime(conf->batchSize, conf->inputDim)
 {}
 
-void ReLULayer::printLayer()
+template<class Field>
+void ReLULayer<Field>::printLayer()
 {
 	cout << "----------------------------------------------" << endl;  	
 	cout << "(" << layerNum+1 << ") ReLU Layer\t\t  " << conf.batchSize << " x " << conf.inputDim << endl;
 }
 
-void ReLULayer::forward(const sfixMatrix& inputActivations)
+template<class Field>
+void ReLULayer<Field>::forward(const sfixMatrix<Field>& inputActivations)
 {
 	log_print("ReLU.forward");
     // inputActivations.ReLU(reluPrime, activations);
 	if (FUNCTION_TIME)
-        cout << "funcReLU: "<< funcTime(funcReLU, inputActivations, reluPrime, activations) <<endl;
+        cout << "funcReLU: "<< funcTime(funcReLU<Field>, inputActivations, reluPrime, activations) <<endl;
     else
         funcReLU(inputActivations, reluPrime, activations);
 
@@ -37,21 +40,29 @@ void ReLULayer::forward(const sfixMatrix& inputActivations)
 #endif
 }
 
-void ReLULayer::forwardOnly(const sfixMatrix&inputActivations)
+template<class Field>
+void ReLULayer<Field>::forwardOnly(const sfixMatrix<Field>&inputActivations)
 {
 	log_print("ReLU.forward");
 	if (FUNCTION_TIME)
-		cout<<"funcReLU: "<<funcTime(funcOnlyReLU, inputActivations, activations)<<endl;
+		cout<<"funcReLU: "<<funcTime(funcOnlyReLU<Field>, inputActivations, activations)<<endl;
 	else
 		funcOnlyReLU(inputActivations, activations);
 }
 
-void ReLULayer::computeDelta(sfixMatrix &prevDelta)
+template<class Field>
+void ReLULayer<Field>::planForwardOnly(PreprocessingPlan<Field> &plan)
+{
+	plan.ReLU_opt(conf.batchSize * conf.inputDim);
+}
+
+template<class Field>
+void ReLULayer<Field>::computeDelta(sfixMatrix<Field> &prevDelta)
 {
     // prevDelta.share() = deltas.share().array() * reluPrime.share().array();
     // prevDelta.reduce_degree();
 	if (FUNCTION_TIME)
-        cout << "funcCwiseMul: "<< funcTime(funcCwiseMul, deltas, reluPrime, prevDelta) <<endl;
+        cout << "funcCwiseMul: "<< funcTime(funcCwiseMul<Field>, deltas, reluPrime, prevDelta) <<endl;
     else
         funcCwiseMul(deltas, reluPrime, prevDelta);
 
@@ -62,7 +73,8 @@ void ReLULayer::computeDelta(sfixMatrix &prevDelta)
 #endif
 }
 
-void ReLULayer::updateEquations(const sfixMatrix& prevActivations)
+template<class Field>
+void ReLULayer<Field>::updateEquations(const sfixMatrix<Field>& prevActivations)
 {
 	log_print("ReLU.updateEquations");
 }
@@ -112,4 +124,8 @@ void ReLULayerClear::updateEquations(const RowMatrixXd& prevActivations)
 {
 	log_print("ReLU.updateEquations");
 }
+
+template class ReLULayer<PR31>;
+
+template class ReLULayer<PR61>;
 } // namespace hmmpc
@@ -7,26 +7,29 @@
 namespace hmmpc 
 {
 
-class ReLULayer:public Layer
+template<class Field>
+class ReLULayer:public Layer<Field>
 {
 private:   
     ReLUConfig conf;
-    sfixMatrix activations;
-    sfixMatrix deltas;
-    sintMatrix reluPrime;
+    sfixMatrix<Field> activations;
+    sfixMatrix<Field> deltas;
+    sintMatrix<Field> reluPrime;
 
 public:
+    using Layer<Field>::layerNum;
     ReLULayer(ReLUConfig* conf, int _layerNum);
 
     void printLayer() override;
-    void forward(const sfixMatrix&inputActivations)override;
-    void computeDelta(sfixMatrix &prevDelta)override;
-    void updateEquations(const sfixMatrix& prevActivations)override;
+    void forward(const sfixMatrix<Field>&inputActivations)override;
+    void computeDelta(sfixMatrix<Field> &prevDelta)override;
+    void updateEquations(const sfixMatrix<Field>& prevActivations)override;
 
-    void forwardOnly(const sfixMatrix&inputActivations);// without calculating reluPrime
+    void forwardOnly(const sfixMatrix<Field>&inputActivations);// without calculating reluPrime
+    void planForwardOnly(PreprocessingPlan<Field> &plan);
 
-    sfixMatrix& getActivation(){sfixMatrix &ref = activations; return ref;}
-    sfixMatrix& getDelta(){sfixMatrix &ref = deltas; return ref;}
+    sfixMatrix<Field>& getActivation(){sfixMatrix<Field> &ref = activations; return ref;}
+    sfixMatrix<Field>& getDelta(){sfixMatrix<Field> &ref = deltas; return ref;}
 };
 
 class ReLULayerClear:public LayerClear
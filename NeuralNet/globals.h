@@ -28,7 +28,8 @@ inline void log_print(string str)
 #endif
 }
 
-inline void check_overflow(sfixMatrix &matrix)
+template<class Field>
+inline void check_overflow(sfixMatrix<Field> &matrix)
 {
 	matrix.reveal();
 	for(size_t i = 0; i < matrix.size(); i++){
@@ -15,9 +15,6 @@ size_t NUM_LAYERS;
 size_t MINI_BATCH_SIZE;
 bool WITH_NORMALIZATION;
 
-sfixMatrix trainData, trainLabels;
-sfixMatrix testData, testLabels;
-
 RowMatrixXd trainPlainData, trainPlainLabels;
 RowMatrixXd testPlainData, testPlainLabels;
 
@@ -31,7 +28,8 @@ size_t trainPlainLabelsBatchCounter = 0;
 size_t testPlainDataBatchCounter = 0;
 size_t testPlainLabelsBatchCounter = 0;
 
-void train(NeuralNetwork*net)
+template<class Field>
+void train(NeuralNetwork<Field>*net)
 {
     log_print("train");
 
@@ -79,13 +77,14 @@ void train(NeuralNetworkClear*net)
     }
 }
 
-void test(NeuralNetwork* net)
+template<class Field>
+void test(NeuralNetwork<Field>* net)
 {
     log_print("test");
 
     //counter[0]: Correct samples, counter[1]: total samples
 	vector<size_t> counter(2,0);
-    sintMatrix maxIndex(MINI_BATCH_SIZE, LAST_LAYER_SIZE);
+    sintMatrix<Field> maxIndex(MINI_BATCH_SIZE, LAST_LAYER_SIZE);
     
     for(size_t i = 0; i < TEST_ITERATIONS; i++){
         // readMiniBatch(net, "TESTING");
@@ -108,6 +107,14 @@ void test(NeuralNetwork* net)
     // cout<<"bias2"<<((FCLayer*)(net->layers[4]))->getBias().reveal(10)<<endl;
 }
 
+template<class Field>
+void planTest(NeuralNetwork<Field>* net, PreprocessingPlan<Field> &plan)
+{
+    for(size_t i = 0; i < TEST_ITERATIONS; i++){
+        net->planForwardOnly(plan);
+    }
+}
+
 void test(NeuralNetworkClear* net)
 {
     log_print("test");
@@ -135,7 +142,8 @@ void test(NeuralNetworkClear* net)
     ((FCLayerClear*)(net->layers[4]))->printBias(default_path+"bias3");
 }
 
-void preload_netwok(bool PRELOADING, string network, NeuralNetwork *net)
+template<class Field>
+void preload_netwok(bool PRELOADING, string network, NeuralNetwork<Field> *net)
 {
     log_print("preload_network");
     
@@ -150,23 +158,23 @@ void preload_netwok(bool PRELOADING, string network, NeuralNetwork *net)
         string path_weight1 = default_path+"weight1";
         string path_weight2 = default_path+"weight2";
         string path_weight3 = default_path+"weight3";
-        (((FCLayer*)net->layers[0])->getWeights()).input_secrets_from_ColMajor(path_weight1, 0, 784);
-        (((FCLayer*)net->layers[2])->getWeights()).input_secrets_from_ColMajor(path_weight2, 0, 128);
-        (((FCLayer*)net->layers[4])->getWeights()).input_secrets_from_ColMajor(path_weight3, 0, 128);
+        (((FCLayer<Field>*)net->layers[0])->getWeights()).input_secrets_from_ColMajor(path_weight1, 0, 784);
+        (((FCLayer<Field>*)net->layers[2])->getWeights()).input_secrets_from_ColMajor(path_weight2, 0, 128);
+        (((FCLayer<Field>*)net->layers[4])->getWeights()).input_secrets_from_ColMajor(path_weight3, 0, 128);
 
-        (((FCLayer*)net->layers[0])->getWeights()).distribute_shares();
-        (((FCLayer*)net->layers[2])->getWeights()).distribute_shares();
-        (((FCLayer*)net->layers[4])->getWeights()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[0])->getWeights()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[2])->getWeights()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[4])->getWeights()).distribute_shares();
 
         string path_bias1 = default_path+"bias1";
         string path_bias2 = default_path+"bias2";
         string path_bias3 = default_path+"bias3";
-        (((FCLayer*)net->layers[0])->getBias()).input_secrets_from(path_bias1, 0, 128);
-        (((FCLayer*)net->layers[2])->getBias()).input_secrets_from(path_bias2, 0, 128);
-        (((FCLayer*)net->layers[4])->getBias()).input_secrets_from(path_bias3, 0, 10);
-        (((FCLayer*)net->layers[0])->getBias()).distribute_shares();
-        (((FCLayer*)net->layers[2])->getBias()).distribute_shares();
-        (((FCLayer*)net->layers[4])->getBias()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[0])->getBias()).input_secrets_from(path_bias1, 0, 128);
+        (((FCLayer<Field>*)net->layers[2])->getBias()).input_secrets_from(path_bias2, 0, 128);
+        (((FCLayer<Field>*)net->layers[4])->getBias()).input_secrets_from(path_bias3, 0, 10);
+        (((FCLayer<Field>*)net->layers[0])->getBias()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[2])->getBias()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[4])->getBias()).distribute_shares();
     }
     // ! The following networks need to use PR61 or lower the precision, otherwise it overflows.
     else if (network.compare("Sarda")==0)
@@ -176,56 +184,56 @@ void preload_netwok(bool PRELOADING, string network, NeuralNetwork *net)
         string path_weight2 = default_path+"weight2";
         string path_weight3 = default_path+"weight3";
         // Note: The weights of CNN layer stored in the file is slightly strange...(Pay attention)
-        (((CNNLayer*)net->layers[0])->getWeights()).input_secrets_from_ColMajor(path_weight1, 0, 2*2*1);//row=4, col=5
-        (((FCLayer*)net->layers[2])->getWeights()).input_secrets_from_ColMajor(path_weight2, 0, 980);//row=100, col=100
-        (((FCLayer*)net->layers[4])->getWeights()).input_secrets_from_ColMajor(path_weight3, 0, 100);//row=100, col=10
+        (((CNNLayer<Field>*)net->layers[0])->getWeights()).input_secrets_from_ColMajor(path_weight1, 0, 2*2*1);//row=4, col=5
+        (((FCLayer<Field>*)net->layers[2])->getWeights()).input_secrets_from_ColMajor(path_weight2, 0, 980);//row=100, col=100
+        (((FCLayer<Field>*)net->layers[4])->getWeights()).input_secrets_from_ColMajor(path_weight3, 0, 100);//row=100, col=10
 
-        (((CNNLayer*)net->layers[0])->getWeights()).distribute_shares();
-        (((FCLayer*)net->layers[2])->getWeights()).distribute_shares();
-        (((FCLayer*)net->layers[4])->getWeights()).distribute_shares();
+        (((CNNLayer<Field>*)net->layers[0])->getWeights()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[2])->getWeights()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[4])->getWeights()).distribute_shares();
 
         string path_bias1 = default_path+"bias1";
         string path_bias2 = default_path+"bias2";
         string path_bias3 = default_path+"bias3";
-        (((CNNLayer*)net->layers[0])->getBias()).input_secrets_from(path_bias1, 0, 1);// rows=1, cols=5
-        (((FCLayer*)net->layers[2])->getBias()).input_secrets_from(path_bias2, 0, 100);
-        (((FCLayer*)net->layers[4])->getBias()).input_secrets_from(path_bias3, 0, 10);
-        (((CNNLayer*)net->layers[0])->getBias()).distribute_shares();
-        (((FCLayer*)net->layers[2])->getBias()).distribute_shares();
-        (((FCLayer*)net->layers[4])->getBias()).distribute_shares();
+        (((CNNLayer<Field>*)net->layers[0])->getBias()).input_secrets_from(path_bias1, 0, 1);// rows=1, cols=5
+        (((FCLayer<Field>*)net->layers[2])->getBias()).input_secrets_from(path_bias2, 0, 100);
+        (((FCLayer<Field>*)net->layers[4])->getBias()).input_secrets_from(path_bias3, 0, 10);
+        (((CNNLayer<Field>*)net->layers[0])->getBias()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[2])->getBias()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[4])->getBias()).distribute_shares();
 
         // cout<<(((CNNLayer*)net->layers[0])->getBias()).reveal()<<endl;
     }
     else if (network.compare("MiniONN")==0)
     {
-        // This network needs to define PR_61, otherwise it overflows.
+        // This network needs to run over PR61, otherwise it overflows.
         string path_weight1 = default_path+"weight1";
         string path_weight2 = default_path+"weight2";
         string path_weight3 = default_path+"weight3";
         string path_weight4 = default_path+"weight4";
         // Note: The weights of CNN layer stored in the file is slightly strange...(Pay attention)
-        (((CNNLayer*)net->layers[0])->getWeights()).input_secrets_from_ColMajor(path_weight1, 0, 5*5*1);//row=5*5*1, col=16
-        (((CNNLayer*)net->layers[3])->getWeights()).input_secrets_from_ColMajor(path_weight2, 0, 5*5*16);//row=5*5*16, col=16
-        (((FCLayer*)net->layers[6])->getWeights()).input_secrets_from_ColMajor(path_weight3, 0, 256);//row=4*4*16, col=100
-        (((FCLayer*)net->layers[8])->getWeights()).input_secrets_from_ColMajor(path_weight4, 0, 100);//row=100, col=10
+        (((CNNLayer<Field>*)net->layers[0])->getWeights()).input_secrets_from_ColMajor(path_weight1, 0, 5*5*1);//row=5*5*1, col=16
+        (((CNNLayer<Field>*)net->layers[3])->getWeights()).input_secrets_from_ColMajor(path_weight2, 0, 5*5*16);//row=5*5*16, col=16
+        (((FCLayer<Field>*)net->layers[6])->getWeights()).input_secrets_from_ColMajor(path_weight3, 0, 256);//row=4*4*16, col=100
+        (((FCLayer<Field>*)net->layers[8])->getWeights()).input_secrets_from_ColMajor(path_weight4, 0, 100);//row=100, col=10
 
-        (((CNNLayer*)net->layers[0])->getWeights()).distribute_shares();
-        (((CNNLayer*)net->layers[3])->getWeights()).distribute_shares();
-        (((FCLayer*)net->layers[6])->getWeights()).distribute_shares();
-        (((FCLayer*)net->layers[8])->getWeights()).distribute_shares();
+        (((CNNLayer<Field>*)net->layers[0])->getWeights()).distribute_shares();
+        (((CNNLayer<Field>*)net->layers[3])->getWeights()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[6])->getWeights()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[8])->getWeights()).distribute_shares();
 
         string path_bias1 = default_path+"bias1";
         string path_bias2 = default_path+"bias2";
         string path_bias3 = default_path+"bias3";
         string path_bias4 = default_path+"bias4";
-        (((CNNLayer*)net->layers[0])->getBias()).input_secrets_from(path_bias1, 0, 1);// rows=1, cols=16
-        (((CNNLayer*)net->layers[3])->getBias()).input_secrets_from(path_bias2, 0, 1);//rows=1, cols=16
-        (((FCLayer*)net->layers[6])->getBias()).input_secrets_from(path_bias3, 0, 100);
-        (((FCLayer*)net->layers[8])->getBias()).input_secrets_from(path_bias4, 0, 10);
-        (((CNNLayer*)net->layers[0])->getBias()).distribute_shares();
-        (((CNNLayer*)net->layers[3])->getBias()).distribute_shares();
-        (((FCLayer*)net->layers[6])->getBias()).distribute_shares();
-        (((FCLayer*)net->layers[8])->getBias()).distribute_shares();
+        (((CNNLayer<Field>*)net->layers[0])->getBias()).input_secrets_from(path_bias1, 0, 1);// rows=1, cols=16
+        (((CNNLayer<Field>*)net->layers[3])->getBias()).input_secrets_from(path_bias2, 0, 1);//rows=1, cols=16
+        (((FCLayer<Field>*)net->layers[6])->getBias()).input_secrets_from(path_bias3, 0, 100);
+        (((FCLayer<Field>*)net->layers[8])->getBias()).input_secrets_from(path_bias4, 0, 10);
+        (((CNNLayer<Field>*)net->layers[0])->getBias()).distribute_shares();
+        (((CNNLayer<Field>*)net->layers[3])->getBias()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[6])->getBias()).distribute_shares();
+        (((FCLayer<Field>*)net->layers[8])->getBias()).distribute_shares();
     }
 }
 
@@ -353,8 +361,13 @@ void loadPlainData(string net, string dataset)
     testPlainData = testPlainData.array()/255;
 }
 
-void readMiniBatch(NeuralNetwork* net, string phase)
+template<class Field>
+void readMiniBatch(NeuralNetwork<Field>* net, string phase)
 {
+    // The secret data sets in the field of the network.
+    static sfixMatrix<Field> trainData, trainLabels;
+    static sfixMatrix<Field> testData, testLabels;
+
     size_t s = trainData.rows();
 	// size_t t = trainLabels.rows();
 
@@ -452,7 +465,8 @@ void readPlainMiniBatch(NeuralNetworkClear* net, string phase)
 		testPlainLabelsBatchCounter = testPlainLabelsBatchCounter + MINI_BATCH_SIZE - q;
 }
 
-void printNetwork(NeuralNetwork* net)
+template<class Field>
+void printNetwork(NeuralNetwork<Field>* net)
 {
     for(int i = 0; i < net->layers.size(); i++)
         net->layers[i]->printLayer();
@@ -543,4 +557,19 @@ void selectNetwork(string network, string dataset, NeuralNetConfig*config)
 		// config->addLayer(l9);
 	}
 }
+
+template void train<PR31>(NeuralNetwork<PR31> *net);
+template void test<PR31>(NeuralNetwork<PR31> *net);
+template void planTest<PR31>(NeuralNetwork<PR31> *net, PreprocessingPlan<PR31> &plan);
+template void preload_netwok<PR31>(bool PRELOADING, string network, NeuralNetwork<PR31> *net);
+template void readMiniBatch<PR31>(NeuralNetwork<PR31>* net, string phase);
+template void printNetwork<PR31>(NeuralNetwork<PR31>* net);
+
+template void train<PR61>(NeuralNetwork<PR61> *net);
+template void test<PR61>(NeuralNetwork<PR61> *net);
+template void planTest<PR61>(NeuralNetwork<PR61> *net, PreprocessingPlan<PR61> &plan);
+template void preload_netwok<PR61>(bool PRELOADING, string network, NeuralNetwork<PR61> *net);
+template void readMiniBatch<PR61>(NeuralNetwork<PR61>* net, string phase);
+template void printNetwork<PR61>(NeuralNetwork<PR61>* net);
+
 }
\ No newline at end of file
@@ -7,20 +7,28 @@
 namespace hmmpc
 {
 
-void train(NeuralNetwork *net);
-void test(NeuralNetwork *net);
+template<class Field>
+void train(NeuralNetwork<Field> *net);
+template<class Field>
+void test(NeuralNetwork<Field> *net);
+template<class Field>
+void planTest(NeuralNetwork<Field> *net, PreprocessingPlan<Field> &plan);// The randomness required by test()
 
 void train(NeuralNetworkClear *net);
 void test(NeuralNetworkClear *net);
 
-void preload_netwok(bool PRELOADING, string network, NeuralNetwork *net);
+template<class Field>
+void preload_netwok(bool PRELOADING, string network, NeuralNetwork<Field> *net);
 void loadData(string net, string dataset, size_t test_data_size);
 void loadPlainData(string net, string dataset);
-void readMiniBatch(NeuralNetwork* net, string phase);
+template<class Field>
+void readMiniBatch(NeuralNetwork<Field>* net, string phase);
 void readPlainMiniBatch(NeuralNetworkClear* net, string phase);
 
-void printNetwork(NeuralNetwork* net);
+template<class Field>
+void printNetwork(NeuralNetwork<Field>* net);
 void selectNetwork(string network, string dataset, NeuralNetConfig*config);
-void runOnly(NeuralNetwork *net, size_t l, string what, string&network);
+template<class Field>
+void runOnly(NeuralNetwork<Field> *net, size_t l, string what, string&network);
 
 }
\ No newline at end of file
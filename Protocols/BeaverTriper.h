@@ -3,6 +3,7 @@
 #include "Protocols/ShareBundle.h"
 #include "Math/gfpMatrix.h"
 #include "Math/gfpScalar.h"
+#include "Math/gfpKernels.h"
 namespace hmmpc
 {
 /**
@@ -21,14 +22,15 @@ namespace hmmpc
  * *      let u' = iu, v' = kv, [a'] = i[a], [b'] = k[b], then [c'] = [a'][b'] = ik[c]
  *        = u'v' - u'[b'] - v'[a'] + [c']
  */
+template<class Field>
 class BeaverTriple 
 {
 protected:
-    ShareBundle a;
-    ShareBundle b;
-    ShareBundle c;// c = a * b
-    gfpMatrix u;// [x] = u - [a]t
-    gfpMatrix v;// [y] = v - [b]_t
+    ShareBundle<Field> a;
+    ShareBundle<Field> b;
+    ShareBundle<Field> c;// c = a * b
+    gfpMatrix<Field> u;// [x] = u - [a]t
+    gfpMatrix<Field> v;// [y] = v - [b]_t
 
     /**
      * @brief [x'] = i[x] = i(u - [a]) = iu - i[a]
@@ -36,10 +38,10 @@ protected:
      *             = (iu)v - iu[b] - v(i[a]) +i[ab]
      *  * let u' = iu, [a'] = i[a], [c'] = [a'][b] = i[c]
      */
-    void x_affine_times(gfpScalar i)
-    {u = i * u.array(); a.shares = i * a.shares.array(); c.shares = i * c.shares.array();}
-    void y_affine_times(gfpScalar k)
-    {v = k * v.array(); b.shares = k * b.shares.array(); c.shares = k * c.shares.array();}
+    void x_affine_times(gfpScalar<Field> i)
+    {cwise_mul_const(u, i, u); cwise_mul_const(a.shares, i, a.shares); cwise_mul_const(c.shares, i, c.shares);}
+    void y_affine_times(gfpScalar<Field> k)
+    {cwise_mul_const(v, k, v); cwise_mul_const(b.shares, k, b.shares); cwise_mul_const(c.shares, k, c.shares);}
 
     /**
      * @brief [x'] = [x] + j = (u+j) - [a] 
@@ -47,46 +49,51 @@ protected:
      *             = (u+j)*v - (u+j)[b] - v[a] + [ab]
      *  * let u' = u+j
      */
-    void x_affine_plus(gfpScalar j)
-    {u = u.array() + j;}
-    void y_affine_plus(gfpScalar w)
-    {v = v.array() + w;}
+    void x_affine_plus(gfpScalar<Field> j)
+    {cwise_add_const(u, j, u);}
+    void y_affine_plus(gfpScalar<Field> w)
+    {cwise_add_const(v, w, v);}
 
 public:
     BeaverTriple(const size_t &xSize, const size_t &ySize)
     :a(xSize, ySize), b(xSize, ySize), c(xSize, ySize), u(xSize, ySize), v(xSize,ySize)
     {u.setConstant(0); v.setConstant(0);}
 
-    void set_shares(const gfpMatrix &a_shares, const gfpMatrix &b_shares,const gfpMatrix &c_shares)
+    void set_shares(const gfpMatrix<Field> &a_shares, const gfpMatrix<Field> &b_shares,const gfpMatrix<Field> &c_shares)
     {a.shares = a_shares; b.shares = b_shares; c.shares = c_shares;}
-    gfpMatrix& a_share(){gfpMatrix& ref = a.shares; return ref;}
-    const gfpMatrix& a_share()const{const gfpMatrix &ref = a.shares; return ref;}
-    gfpMatrix& b_share(){gfpMatrix& ref = b.shares; return ref;}
-    const gfpMatrix& b_share()const{const gfpMatrix &ref = b.shares; return ref;}
-    gfpMatrix& c_share(){gfpMatrix& ref = c.shares; return ref;}
-    const gfpMatrix& c_share()const{const gfpMatrix &ref = c.shares; return ref;}
+    gfpMatrix<Field>& a_share(){gfpMatrix<Field>& ref = a.shares; return ref;}
+    const gfpMatrix<Field>& a_share()const{const gfpMatrix<Field> &ref = a.shares; return ref;}
+    gfpMatrix<Field>& b_share(){gfpMatrix<Field>& ref = b.shares; return ref;}
+    const gfpMatrix<Field>& b_share()const{const gfpMatrix<Field> &ref = b.shares; return ref;}
+    gfpMatrix<Field>& c_share(){gfpMatrix<Field>& ref = c.shares; return ref;}
+    const gfpMatrix<Field>& c_share()const{const gfpMatrix<Field> &ref = c.shares; return ref;}
 
-    gfpMatrix& u_value(){gfpMatrix& ref = u; return ref;}
-    const gfpMatrix& u_value()const{const gfpMatrix &ref = u; return ref;}
-    gfpMatrix& v_value(){gfpMatrix& ref = v; return ref;}
-    const gfpMatrix& v_value()const{const gfpMatrix &ref = v; return ref;}
+    gfpMatrix<Field>& u_value(){gfpMatrix<Field>& ref = u; return ref;}
+    const gfpMatrix<Field>& u_value()const{const gfpMatrix<Field> &ref = u; return ref;}
+    gfpMatrix<Field>& v_value(){gfpMatrix<Field>& ref = v; return ref;}
+    const gfpMatrix<Field>& v_value()const{const gfpMatrix<Field> &ref = v; return ref;}
 
     size_t rows()const{return a.rows();}
     size_t cols()const{return a.cols();}
     
     
     // Recommand that do the times operation first.
-    BeaverTriple& x_times(gfpScalar i) { x_affine_times(i); return *this; }
-    BeaverTriple& x_plus(gfpScalar j) {x_affine_plus(j); return *this;}
-    BeaverTriple& y_times(gfpScalar k) { y_affine_times(k); return *this; }
-    BeaverTriple& y_plus(gfpScalar w) {y_affine_plus(w); return *this;}
+    BeaverTriple<Field>& x_times(gfpScalar<Field> i) { x_affine_times(i); return *this; }
+    BeaverTriple<Field>& x_plus(gfpScalar<Field> j) {x_affine_plus(j); return *this;}
+    BeaverTriple<Field>& y_times(gfpScalar<Field> k) { y_affine_times(k); return *this; }
+    BeaverTriple<Field>& y_plus(gfpScalar<Field> w) {y_affine_plus(w); return *this;}
 
 
     // Compute [xy]_t locally by the Beaver Triple.
-    ShareBundle mult()
-    {   ShareBundle res(rows(), cols());
-        res.shares = u.array() * v.array() - u.array() * b.shares.array() - v.array() * a.shares.array()
-                    + c.shares.array();
+    // uv - u[b] - v[a] + [c] = u(v - [b]) - v[a] + [c]
+    ShareBundle<Field> mult()
+    {   ShareBundle<Field> res(rows(), cols());
+        gfpMatrix<Field> va(rows(), cols());
+        cwise_sub(v, b.shares, res.shares);
+        cwise_mul(u, res.shares, res.shares);
+        cwise_mul(v, a.shares, va);
+        cwise_sub(res.shares, va, res.shares);
+        cwise_add(res.shares, c.shares, res.shares);
         return res;
     }
 };
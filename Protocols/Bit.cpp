@@ -1,6 +1,7 @@
 #include "Protocols/Bit.h"
 #include "Protocols/RandomShare.h"
 #include "Math/gfpMatrix.h"
+#include "Math/gfpKernels.h"
 #include <cmath>
 using Eigen::seqN, Eigen::seq, Eigen::RowMajor, Eigen::last;
 namespace hmmpc
@@ -10,9 +11,11 @@ namespace hmmpc
  *       Definition of member functions about Bit
  * 
  * **********************************************************************/
-Bit& Bit::random()
+template<class Field>
+Bit<Field>& Bit<Field>::random()
 {
-    RandomShare::get_random(RandomShare::queueRandomBit, share);
+    if(Phase->is_producing()){Phase->request_random_bits(1);}
+    RandomShare<Field>::get_random(RandomShare<Field>::queueRandomBit, share);
     return *this;
 }
 //************************ BitBundle **********************************
@@ -22,7 +25,8 @@ Bit& Bit::random()
  * 
  * @param a colomn vector
  */
-BitBundle::BitBundle(const ShareBundle &a):BitBundle(a.rows(), BITS_LENGTH)
+template<class Field>
+BitBundle<Field>::BitBundle(const ShareBundle<Field> &a):BitBundle(a.rows(), Field::BITS_LENGTH)
 {
     // Not Used
 }
@@ -38,30 +42,30 @@ BitBundle::BitBundle(const ShareBundle &a):BitBundle(a.rows(), BITS_LENGTH)
  * 2. bitwise_and(a, b): ab
  * 
  * **********************************************************************/
-// ! Need to explicitly instantiate all the template instances.
-// Op between bitwise sharings and public bits
-template BitBundle bitwise_xor(const BitBundle &a, const MatrixBase<gfpMatrix> &b);
-template BitBundle bitwise_xor(const MatrixBase<gfpMatrix> &a, const BitBundle &b);
-
-template BitBundle bitwise_and(const BitBundle &a, const MatrixBase<gfpMatrix> &b);
-template BitBundle bitwise_and(const MatrixBase<gfpMatrix> &a, const BitBundle &b);
-
 // Bitwise xor between bitwise sharings and public bits.
 // 1 round multiplication (assuming a.cols()<=b.cols())
-BitBundle bitwise_xor(const BitBundle&a, const BitBundle &b)
+template<class Field>
+BitBundle<Field> bitwise_xor(const BitBundle<Field>&a, const BitBundle<Field> &b)
 {
     assert(a.rows() == b.rows());
     // Assume: a.cols()<=b.cols()
     if(b.cols()<a.cols()){return bitwise_xor(b, a);}
 
-    BitBundle partRes(a.rows(), a.cols());
+    BitBundle<Field> partRes(a.rows(), a.cols());
+    if(b.cols() == a.cols()){
+        cwise_mul(a.shares, b.shares, partRes.shares);
+        partRes.reduce_degree();
+        // a + b - 2ab
+        cwise_mul_const(partRes.shares, -gfpScalar<Field>(2), partRes.shares);
+        cwise_add(partRes.shares, a.shares, partRes.shares);
+        cwise_add(partRes.shares, b.shares, partRes.shares);
+        return partRes;
+    }
     partRes.shares = a.shares.array() * b.shares.array().leftCols(a.cols());
     partRes.reduce_degree();
     partRes.shares = a.shares + b.shares.leftCols(a.cols()) - (2 * partRes.shares);
 
-    if(b.cols() == a.cols()){return partRes;}
-
-    BitBundle res(a.rows(), b.cols());
+    BitBundle<Field> res(a.rows(), b.cols());
     res.shares.leftCols(a.cols()) = partRes.shares;
     res.shares.rightCols(b.cols()-a.cols()) = b.shares.rightCols(b.cols()-a.cols());
     
@@ -69,55 +73,59 @@ BitBundle bitwise_xor(const BitBundle&a, const BitBundle &b)
 }
 
 // (0 communication) Xor between the bitwise sharings and public bits.
-template<typename Derived>
-BitBundle bitwise_xor(const BitBundle&a, const MatrixBase<Derived> &b)
+template<class Field, typename Derived>
+BitBundle<Field> bitwise_xor(const BitBundle<Field>&a, const MatrixBase<Derived> &b)
 {
     assert(a.rows() == b.rows());
     assert(a.cols() == b.cols());
 
-    BitBundle res(a.rows(), a.cols());
+    BitBundle<Field> res(a.rows(), a.cols());
     res.shares = a.shares.array() + b.array() - (2 * a.shares.array() * b.array());
     return res;
 }
 
-template<typename Derived>
-BitBundle bitwise_xor(const MatrixBase<Derived> &a, const BitBundle &b)
+template<class Field, typename Derived>
+BitBundle<Field> bitwise_xor(const MatrixBase<Derived> &a, const BitBundle<Field> &b)
 {
     return bitwise_xor(b, a);
 }
 
-BitBundle bitwise_and(const BitBundle&a, const BitBundle &b)
+template<class Field>
+BitBundle<Field> bitwise_and(const BitBundle<Field>&a, const BitBundle<Field> &b)
 {
     assert(a.rows() == b.rows());
     // Assume: a.cols()<=b.cols()
     if(b.cols()<a.cols()){return bitwise_and(b, a);}
 
-    BitBundle partRes(a.rows(), a.cols());
+    BitBundle<Field> partRes(a.rows(), a.cols());
+    if(b.cols() == a.cols()){
+        cwise_mul(a.shares, b.shares, partRes.shares);
+        partRes.reduce_degree();
+        return partRes;
+    }
     partRes.shares = a.shares.array() * b.shares.array().leftCols(a.cols());
     partRes.reduce_degree();
 
-    if(b.cols() == a.cols()){return partRes;}
-
-    BitBundle res(a.rows(), b.cols());
+    BitBundle<Field> res(a.rows(), b.cols());
     res.shares.leftCols(a.cols()) = partRes.shares;
     res.shares.rightCols(b.cols()-a.cols()) = b.shares.rightCols(b.cols()-a.cols());
     
     return res;
 }
 
-template<typename Derived>
-BitBundle bitwise_and(const BitBundle &a, const MatrixBase<Derived> &b)
+template<class Field, typename Derived>
+BitBundle<Field> bitwise_and(const BitBundle<Field> &a, const MatrixBase<Derived> &b)
 {
     assert(a.rows() == b.rows());
     assert(a.cols() == b.cols());
 
-    BitBundle res(a.rows(), a.cols());
+    BitBundle<Field> res(a.rows(), a.cols());
     res.shares = a.shares.array() * b.array();
     return res;
 }
 
-template<typename Derived>
-BitBundle bitwise_and(const MatrixBase<Derived> &a, const BitBundle &b)
+template<class Field, typename Derived>
+BitBundle<Field> bitwise_and(const MatrixBase<Derived> &a, const BitBundle<Field> &b)
 {
     return bitwise_and(b, a);
 }
@@ -134,13 +142,6 @@ BitBundle bitwise_and(const MatrixBase<Derived> &a, const BitBundle &b)
  * 
  * **********************************************************************/
 
-// Explicitly instantiate all the template instances
-template BitBundle less_than_unsigned(const MatrixBase<gfpMatrix> &a, const BitBundle &b);
-template BitBundle less_than_unsigned(const BitBundle &a, const MatrixBase<gfpMatrix> &b);
-
-template BitBundle bit_add(const MatrixBase<gfpMatrix> &a, const BitBundle &b);
-template BitBundle bit_add(const BitBundle &a, const MatrixBase<gfpMatrix> &b);
-
 
 /**
  * @brief Functionality of less than between two bitwise sharing.
@@ -149,25 +150,26 @@ template BitBundle bit_add(const BitBundle &a, const MatrixBase<gfpMatrix> &b);
  * @param b 
  * @return BitBundle 
  */
-BitBundle less_than_unsigned(const BitBundle &a, const BitBundle &b)
+template<class Field>
+BitBundle<Field> less_than_unsigned(const BitBundle<Field> &a, const BitBundle<Field> &b)
 {
     // a and b can be of different size
-    BitBundle xorRes = bitwise_xor(a, b);
+    BitBundle<Field> xorRes = bitwise_xor(a, b);
 
     // Postfix-OR of xorRes
-    BitBundle postfixOr(xorRes.rows(), xorRes.cols());
+    BitBundle<Field> postfixOr(xorRes.rows(), xorRes.cols());
     postfixOr.shares = xorRes.postfix_op_one_round("OR").shares;
 
     size_t len = xorRes.cols();
 
     // Evaluate the delta of postfix.
-    BitBundle deltaXor(a.rows(), len);
+    BitBundle<Field> deltaXor(a.rows(), len);
     deltaXor.shares.col(len-1) = postfixOr.shares.col(len-1);
     for(size_t i = 0; i < len-1; i++){
         deltaXor.shares.col(i) = postfixOr.shares.col(i) - postfixOr.shares.col(i+1);
     }
 
-    BitBundle res(a.rows(), 1);
+    BitBundle<Field> res(a.rows(), 1);
     // res.row(i) = inner product of deltaXor.row(i) and b.row(i)
     for(size_t i = 0; i < a.rows(); i++){
         res.shares.row(i) = deltaXor.shares.row(i)(seqN(0, b.cols())) * b.shares.row(i).transpose();
@@ -177,25 +179,25 @@ BitBundle less_than_unsigned(const BitBundle &a, const BitBundle &b)
 }
 
 // Time = 2 round
-template<typename Derived>
-BitBundle less_than_unsigned(const MatrixBase<Derived> &a, const BitBundle &b)
+template<class Field, typename Derived>
+BitBundle<Field> less_than_unsigned(const MatrixBase<Derived> &a, const BitBundle<Field> &b)
 {
     // a and b can be of different size
-    BitBundle xorRes = bitwise_xor(a, b);
+    BitBundle<Field> xorRes = bitwise_xor(a, b);
 
     // Postfix-OR of xorRes
-    BitBundle postfixOr(xorRes.rows(), xorRes.cols());
+    BitBundle<Field> postfixOr(xorRes.rows(), xorRes.cols());
     postfixOr.shares = xorRes.postfix_op_one_round("OR").shares;
 
     size_t len = xorRes.cols();
 
-    BitBundle deltaXor(a.rows(), len);
+    BitBundle<Field> deltaXor(a.rows(), len);
     deltaXor.shares.col(len-1) = postfixOr.shares.col(len-1);
     for(size_t i = 0; i < len-1; i++){
         deltaXor.shares.col(i) = postfixOr.shares.col(i) - postfixOr.shares.col(i+1);
     }
 
-    BitBundle res(a.rows(), 1);
+    BitBundle<Field> res(a.rows(), 1);
     res.shares.setConstant(0);
     for(size_t i = 0; i < a.rows(); i++){
         res.shares.row(i) = deltaXor.shares.row(i)(seqN(0, b.cols())) * b.shares.row(i).transpose();
@@ -205,24 +207,24 @@ BitBundle less_than_unsigned(const MatrixBase<Derived> &a, const BitBundle &b)
 }
 
 // Time = 1 round
-template<typename Derived>
-BitBundle less_than_unsigned(const BitBundle &a, const MatrixBase<Derived> &b)
+template<class Field, typename Derived>
+BitBundle<Field> less_than_unsigned(const BitBundle<Field> &a, const MatrixBase<Derived> &b)
 {
-    BitBundle xorRes = bitwise_xor(a, b);
+    BitBundle<Field> xorRes = bitwise_xor(a, b);
 
     // Postfix-OR of xorRes
-    BitBundle postfixOr(xorRes.rows(), xorRes.cols());
+    BitBundle<Field> postfixOr(xorRes.rows(), xorRes.cols());
     postfixOr.shares = xorRes.postfix_op_one_round("OR").shares;
 
     size_t len = xorRes.cols();
 
-    BitBundle deltaXor(a.rows(), len);
+    BitBundle<Field> deltaXor(a.rows(), len);
     deltaXor.shares.col(len-1) = postfixOr.shares.col(len-1);
     for(size_t i = 0; i < len-1; i++){
         deltaXor.shares.col(i) = postfixOr.shares.col(i) - postfixOr.shares.col(i+1);
     }
 
-    BitBundle res(a.rows(), 1);
+    BitBundle<Field> res(a.rows(), 1);
     res.shares.setConstant(0);
     for(size_t i = 0; i < a.rows(); i++){
         res.shares.row(i) = deltaXor.shares.row(i)(seqN(0, b.cols())) * b.row(i).transpose();
@@ -237,19 +239,20 @@ BitBundle less_than_unsigned(const BitBundle &a, const MatrixBase<Derived> &b)
  * @param b 
  * @return BitBundle The length of result is increased by 1.
  */
-BitBundle bit_add(const BitBundle&a, const BitBundle &b)
+template<class Field>
+BitBundle<Field> bit_add(const BitBundle<Field>&a, const BitBundle<Field> &b)
 {
     // Not Used
 }
 
-template<typename Derived>
-BitBundle bit_add(const BitBundle &a, const MatrixBase<Derived>&b)
+template<class Field, typename Derived>
+BitBundle<Field> bit_add(const BitBundle<Field> &a, const MatrixBase<Derived>&b)
 {
     // Not Used
 }
 
-template<typename Derived>
-BitBundle bit_add(const MatrixBase<Derived>&a, const BitBundle &b)
+template<class Field, typename Derived>
+BitBundle<Field> bit_add(const MatrixBase<Derived>&a, const BitBundle<Field> &b)
 {
     return bit_add(b, a);
 }
@@ -259,14 +262,18 @@ BitBundle bit_add(const MatrixBase<Derived>&a, const BitBundle &b)
  * 
  * **********************************************************************/
 // Random bitwise sharings.
-BitBundle& BitBundle::random()
+template<class Field>
+BitBundle<Field>& BitBundle<Field>::random()
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(0);
     return *this;
 #endif
 
-    if(!Phase->is_true_offline()){
+    if(Phase->is_producing()){
+        Phase->request_random_bits(size());
+    }
+    else if(!Phase->is_true_offline()){
         if(Phase->is_Offline()){
             Phase->generate_random_bits(size());
         }
@@ -276,11 +283,12 @@ BitBundle& BitBundle::random()
             Phase->switch_to_online();
         }
     }
-    RandomShare::get_randoms(RandomShare::queueRandomBit, shares);
+    RandomShare<Field>::get_randoms(RandomShare<Field>::queueRandomBit, shares);
     return *this;
 }
 
-BitBundle& BitBundle::solved_random(Share &rField)
+template<class Field>
+BitBundle<Field>& BitBundle<Field>::solved_random(Share<Field> &rField)
 {
     assert(rows()==1);
     random();
@@ -295,7 +303,8 @@ BitBundle& BitBundle::solved_random(Share &rField)
 }
 
 // Get random bitwise sharings and corresponding solved sharings in Fp.
-BitBundle& BitBundle::solved_random(ShareBundle &rField)
+template<class Field>
+BitBundle<Field>& BitBundle<Field>::solved_random(ShareBundle<Field> &rField)
 {
     random();
 #ifdef ZERO_OFFLINE
@@ -304,20 +313,24 @@ BitBundle& BitBundle::solved_random(ShareBundle &rField)
 #endif
 
     if(Phase->is_Offline()){
-        rField.shares = (shares * bits_coeff).reshaped<RowMajor>(rField.rows(), rField.cols());
+        rField.shares = (shares * bits_coeff).template reshaped<RowMajor>(rField.rows(), rField.cols());
     }else{
         Phase->switch_to_offline();
-        rField.shares = (shares * bits_coeff).reshaped<RowMajor>(rField.rows(), rField.cols());
+        rField.shares = (shares * bits_coeff).template reshaped<RowMajor>(rField.rows(), rField.cols());
         Phase->switch_to_online();
     }
     return *this;
 }
 
 // cond ? a : b on each entry
-ShareBundle BitBundle::if_else(const ShareBundle&a, const ShareBundle &b)
+template<class Field>
+ShareBundle<Field> BitBundle<Field>::if_else(const ShareBundle<Field>&a, const ShareBundle<Field> &b)
 {
-    ShareBundle res(a.rows(), a.cols());
-    res.shares = shares.array() * a.shares.array() + (1 - shares.array()) * b.shares.array();
+    // cond * a + (1 - cond) * b = cond * (a - b) + b
+    ShareBundle<Field> res(a.rows(), a.cols());
+    cwise_sub(a.shares, b.shares, res.shares);
+    cwise_mul(shares, res.shares, res.shares);
+    cwise_add(res.shares, b.shares, res.shares);
     res.reduce_degree();
     return res;
 }
@@ -330,7 +343,8 @@ ShareBundle BitBundle::if_else(const ShareBundle&a, const ShareBundle &b)
  * @param blk_size 
  * @return BitBundle 
  */
-BitBundle BitBundle::unbounded_blk_op(string fn, size_t blk_size)
+template<class Field>
+BitBundle<Field> BitBundle<Field>::unbounded_blk_op(string fn, size_t blk_size)
 {
     // !Depricated
 }
@@ -346,12 +360,14 @@ BitBundle BitBundle::unbounded_blk_op(string fn, size_t blk_size)
  * @param blk_size We deal each block on parallel, which means to calculate the prefix op on each block.
  * @return BitBundle Each block corresponds to the prefix op on the input block.
  */
-BitBundle BitBundle::prefix_blk_op(string fn, size_t blk_size)
+template<class Field>
+BitBundle<Field> BitBundle<Field>::prefix_blk_op(string fn, size_t blk_size)
 {   
     // !Depricated
 }
 
-BitBundle BitBundle::postfix_blk_op(string fn, size_t blk_size)
+template<class Field>
+BitBundle<Field> BitBundle<Field>::postfix_blk_op(string fn, size_t blk_size)
 {
     // Depricated
 }
@@ -365,44 +381,48 @@ BitBundle BitBundle::postfix_blk_op(string fn, size_t blk_size)
  * @param blkSize 
  * @return BitBundle 
  */
-BitBundle BitBundle::prefix_op(string fn, size_t blkSize)
+template<class Field>
+BitBundle<Field> BitBundle<Field>::prefix_op(string fn, size_t blkSize)
 {
     // !Depricated
 }
 
-BitBundle BitBundle::postfix_op(string fn, size_t blk_size)
+template<class Field>
+BitBundle<Field> BitBundle<Field>::postfix_op(string fn, size_t blk_size)
 {
     // !Depricated
 }
 
-BitBundle BitBundle::prefix_op_one_round(string fn)
+template<class Field>
+BitBundle<Field> BitBundle<Field>::prefix_op_one_round(string fn)
 {
-    BitBundle res(rows(), cols());
+    BitBundle<Field> res(rows(), cols());
     if(fn=="AND"){
         res.shares = unbounded_prefix_mult().shares;
         return res;
     }
 
-    BitBundle mapped(rows(), cols());
+    BitBundle<Field> mapped(rows(), cols());
     if(fn=="OR"){
-        mapped.shares = 1 - shares.array();
-        res.shares = 1 - mapped.unbounded_prefix_mult().shares.array();
+        cwise_sub(1, shares, mapped.shares);
+        cwise_sub(1, mapped.unbounded_prefix_mult().shares, res.shares);
         return res;
     }
 }
 
-BitBundle BitBundle::postfix_op_one_round(string fn)
+template<class Field>
+BitBundle<Field> BitBundle<Field>::postfix_op_one_round(string fn)
 {
-    BitBundle res(rows(), cols());
+    BitBundle<Field> res(rows(), cols());
     if(fn=="AND"){
         res.shares = unbounded_postfix_mult().shares;
         return res;
     }
 
-    BitBundle mapped(rows(), cols());
+    BitBundle<Field> mapped(rows(), cols());
     if(fn=="OR"){
-        mapped.shares = 1 - shares.array();
-        res.shares = 1 - mapped.unbounded_postfix_mult().shares.array();
+        cwise_sub(1, shares, mapped.shares);
+        cwise_sub(1, mapped.unbounded_postfix_mult().shares, res.shares);
         return res;
     }
 }
@@ -412,30 +432,31 @@ BitBundle BitBundle::postfix_op_one_round(string fn)
  *       Definition of member functions about TripleBitBundle
  * 
  * **********************************************************************/
-template TripleBitBundle::TripleBitBundle(const BitBundle &a, const MatrixBase<gfpVector>&b);
-template TripleBitBundle::TripleBitBundle(const BitBundle &a, const MatrixBase<gfpMatrix>&b);
-template TripleBitBundle::TripleBitBundle(const MatrixBase<gfpVector>&a, const BitBundle &b);
-template TripleBitBundle::TripleBitBundle(const MatrixBase<gfpMatrix>&a, const BitBundle &b);
-TripleBitBundle::TripleBitBundle(const BitBundle &a, const BitBundle &b)
+template<class Field>
+TripleBitBundle<Field>::TripleBitBundle(const BitBundle<Field> &a, const BitBundle<Field> &b)
 {
     // Not Used
 }
 
+template<class Field>
 template<typename Derived>
-TripleBitBundle::TripleBitBundle(const BitBundle &a, const MatrixBase<Derived> &b):sBits(a.rows(), a.cols()), pBits(a.rows(), a.cols()), kBits(a.rows(), a.cols())
+TripleBitBundle<Field>::TripleBitBundle(const BitBundle<Field> &a, const MatrixBase<Derived> &b):sBits(a.rows(), a.cols()), pBits(a.rows(), a.cols()), kBits(a.rows(), a.cols())
 {
     // Not Used
 }
 
+template<class Field>
 template<typename Derived>
-TripleBitBundle::TripleBitBundle(const MatrixBase<Derived> &a, const BitBundle &b):TripleBitBundle(b, a){}
+TripleBitBundle<Field>::TripleBitBundle(const MatrixBase<Derived> &a, const BitBundle<Field> &b):TripleBitBundle(b, a){}
 
-TripleBitBundle TripleBitBundle::unbounded_blk_carry_propagation(size_t blkSize)
+template<class Field>
+TripleBitBundle<Field> TripleBitBundle<Field>::unbounded_blk_carry_propagation(size_t blkSize)
 {
     // Not Used
 }
 
-void TripleBitBundle::represent_idx(TYPE idx, size_t mxBlkSize, vector<size_t> &rep)
+template<class Field>
+void TripleBitBundle<Field>::represent_idx(typename Field::TYPE idx, size_t mxBlkSize, vector<size_t> &rep)
 {
     // Not Used
 }
@@ -445,8 +466,51 @@ void TripleBitBundle::represent_idx(TYPE idx, size_t mxBlkSize, vector<size_t> &
  * 
  * @return TripleBitBundle sBit is the carry bit.
  */
-TripleBitBundle TripleBitBundle::prefix_carry_propagation()
+template<class Field>
+TripleBitBundle<Field> TripleBitBundle<Field>::prefix_carry_propagation()
 {
     // Not Used
 }
-}
\ No newline at end of file
+// Explicitly instantiate all the template instances of each field
+template class Bit<PR31>;
+template class BitBundle<PR31>;
+template class TripleBitBundle<PR31>;
+
+template BitBundle<PR31> bitwise_xor(const BitBundle<PR31> &a, const BitBundle<PR31> &b);
+template BitBundle<PR31> bitwise_xor(const BitBundle<PR31> &a, const MatrixBase<gfpMatrix<PR31>> &b);
+template BitBundle<PR31> bitwise_xor(const MatrixBase<gfpMatrix<PR31>> &a, const BitBundle<PR31> &b);
+template BitBundle<PR31> bitwise_and(const BitBundle<PR31> &a, const BitBundle<PR31> &b);
+template BitBundle<PR31> bitwise_and(const BitBundle<PR31> &a, const MatrixBase<gfpMatrix<PR31>> &b);
+template BitBundle<PR31> bitwise_and(const MatrixBase<gfpMatrix<PR31>> &a, const BitBundle<PR31> &b);
+template BitBundle<PR31> less_than_unsigned(const BitBundle<PR31> &a, const BitBundle<PR31> &b);
+template BitBundle<PR31> less_than_unsigned(const MatrixBase<gfpMatrix<PR31>> &a, const BitBundle<PR31> &b);
+template BitBundle<PR31> less_than_unsigned(const BitBundle<PR31> &a, const MatrixBase<gfpMatrix<PR31>> &b);
+template BitBundle<PR31> bit_add(const BitBundle<PR31> &a, const BitBundle<PR31> &b);
+template BitBundle<PR31> bit_add(const MatrixBase<gfpMatrix<PR31>> &a, const BitBundle<PR31> &b);
+template BitBundle<PR31> bit_add(const BitBundle<PR31> &a, const MatrixBase<gfpMatrix<PR31>> &b);
+template TripleBitBundle<PR31>::TripleBitBundle(const BitBundle<PR31> &a, const MatrixBase<gfpVector<PR31>>&b);
+template TripleBitBundle<PR31>::TripleBitBundle(const BitBundle<PR31> &a, const MatrixBase<gfpMatrix<PR31>>&b);
+template TripleBitBundle<PR31>::TripleBitBundle(const MatrixBase<gfpVector<PR31>>&a, const BitBundle<PR31> &b);
+template TripleBitBundle<PR31>::TripleBitBundle(const MatrixBase<gfpMatrix<PR31>>&a, const BitBundle<PR31> &b);
+
+template class Bit<PR61>;
+template class BitBundle<PR61>;
+template class TripleBitBundle<PR61>;
+
+template BitBundle<PR61> bitwise_xor(const BitBundle<PR61> &a, const BitBundle<PR61> &b);
+template BitBundle<PR61> bitwise_xor(const BitBundle<PR61> &a, const MatrixBase<gfpMatrix<PR61>> &b);
+template BitBundle<PR61> bitwise_xor(const MatrixBase<gfpMatrix<PR61>> &a, const BitBundle<PR61> &b);
+template BitBundle<PR61> bitwise_and(const BitBundle<PR61> &a, const BitBundle<PR61> &b);
+template BitBundle<PR61> bitwise_and(const BitBundle<PR61> &a, const MatrixBase<gfpMatrix<PR61>> &b);
+template BitBundle<PR61> bitwise_and(const MatrixBase<gfpMatrix<PR61>> &a, const BitBundle<PR61> &b);
+template BitBundle<PR61> less_than_unsigned(const BitBundle<PR61> &a, const BitBundle<PR61> &b);
+template BitBundle<PR61> less_than_unsigned(const MatrixBase<gfpMatrix<PR61>> &a, const BitBundle<PR61> &b);
+template BitBundle<PR61> less_than_unsigned(const BitBundle<PR61> &a, const MatrixBase<gfpMatrix<PR61>> &b);
+template BitBundle<PR61> bit_add(const BitBundle<PR61> &a, const BitBundle<PR61> &b);
+template BitBundle<PR61> bit_add(const MatrixBase<gfpMatrix<PR61>> &a, const BitBundle<PR61> &b);
+template BitBundle<PR61> bit_add(const BitBundle<PR61> &a, const MatrixBase<gfpMatrix<PR61>> &b);
+template TripleBitBundle<PR61>::TripleBitBundle(const BitBundle<PR61> &a, const MatrixBase<gfpVector<PR61>>&b);
+template TripleBitBundle<PR61>::TripleBitBundle(const BitBundle<PR61> &a, const MatrixBase<gfpMatrix<PR61>>&b);
+template TripleBitBundle<PR61>::TripleBitBundle(const MatrixBase<gfpVector<PR61>>&a, const BitBundle<PR61> &b);
+template TripleBitBundle<PR61>::TripleBitBundle(const MatrixBase<gfpMatrix<PR61>>&a, const BitBundle<PR61> &b);
+}
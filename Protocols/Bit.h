@@ -7,128 +7,115 @@ using Eigen::MatrixBase, Eigen::DenseBase;
 namespace hmmpc
 {
 
-class Bit:public Share
+template<class Field>
+class Bit:public Share<Field>
 {
 public:
-    Bit():Share(){}
+    using Share<Field>::Phase; using Share<Field>::share;
+    Bit():Share<Field>(){}
 
-    Bit& random();
+    Bit<Field>& random();
 };
 
-class BitBundle:public ShareBundle
+template<class Field>
+class BitBundle:public ShareBundle<Field>
 {
-    // Bitwise xor on two sharings
-    friend BitBundle bitwise_xor(const BitBundle &a, const BitBundle &b);
-    // Bitwise xor beween a sharing and a public value
-    template<typename Derived>
-    friend BitBundle bitwise_xor(const BitBundle &a, const MatrixBase<Derived> &b);
-    template<typename Derived>
-    friend BitBundle bitwise_xor(const MatrixBase<Derived> &a, const BitBundle &b);
-    
-    // Bitwise and on two sharings
-    friend BitBundle bitwise_and(const BitBundle &a, const BitBundle &b);
-    // Bitwise xor beween a sharing and a public value
-    template<typename Derived>
-    friend BitBundle bitwise_and(const BitBundle &a, const MatrixBase<Derived> &b);
-    template<typename Derived>
-    friend BitBundle bitwise_and(const MatrixBase<Derived> &a, const BitBundle &b);
-
-    // Unsigned less-than
-    friend BitBundle less_than_unsigned(const BitBundle &a, const BitBundle &b);
-    template<typename Derived>
-    friend BitBundle less_than_unsigned(const MatrixBase<Derived> &a, const BitBundle &b);
-    template<typename Derived>
-    friend BitBundle less_than_unsigned(const BitBundle &a, const MatrixBase<Derived> &b);
-
-    // Bit add
-    friend BitBundle bit_add(const BitBundle &a, const BitBundle &b);
-    template<typename Derived>
-    friend BitBundle bit_add(const MatrixBase<Derived> &a, const BitBundle &b);
-    template<typename Derived>
-    friend BitBundle bit_add(const BitBundle &a, const MatrixBase<Derived> &b);
 public:
-    
+    USING_SHARE_BASE(ShareBundle<Field>)
+    using ShareBundle<Field>::shares; using ShareBundle<Field>::rows; using ShareBundle<Field>::cols; using ShareBundle<Field>::size;
+    using ShareBundle<Field>::unbounded_prefix_mult; using ShareBundle<Field>::unbounded_postfix_mult;
+
     // Construction: Each row corresponds to one bitwise sharing.
-    BitBundle(const size_t &n, const size_t &length):ShareBundle(n, length){}
-    BitBundle(const size_t &n):ShareBundle(n, BITS_LENGTH){}
-    BitBundle():ShareBundle(1, BITS_LENGTH){}// One bitwise sharing
+    BitBundle(const size_t &n, const size_t &length):ShareBundle<Field>(n, length){}
+    BitBundle(const size_t &n):ShareBundle<Field>(n, Field::BITS_LENGTH){}
+    BitBundle():ShareBundle<Field>(1, Field::BITS_LENGTH){}// One bitwise sharing
     template <typename Derived>
     BitBundle(const Eigen::MatrixBase<Derived> &X){shares = X;}; // Stored in row-major
     // Private bitwise sharing
-    BitBundle(const Share &x);
-    BitBundle(const ShareBundle &X);
+    BitBundle(const Share<Field> &x);
+    BitBundle(const ShareBundle<Field> &X);
 
     // Random
-    BitBundle& random();
-    BitBundle& solved_random(Share &rField);//Get the corresponding t-sharing of the bits.
-    BitBundle& solved_random(ShareBundle &rField);//Vectorization
+    BitBundle<Field>& random();
+    BitBundle<Field>& solved_random(Share<Field> &rField);//Get the corresponding t-sharing of the bits.
+    BitBundle<Field>& solved_random(ShareBundle<Field> &rField);//Vectorization
 
     // Signed less-than
-    BitBundle less_than(const BitBundle &other);
+    BitBundle<Field> less_than(const BitBundle<Field> &other);
 
     // cond ? a : b
-    ShareBundle if_else(const ShareBundle &a, const ShareBundle &b);
+    ShareBundle<Field> if_else(const ShareBundle<Field> &a, const ShareBundle<Field> &b);
 
     // * Bit Op */
     // a AND b = ab (Hence, bit AND = multiplication)
     // a or b = a + b - ab
     // a XOR b = a + b - 2ab
     // Unbounded fan-in operation: OR, AND, XOR over each block. (evaluate the function value)
-    BitBundle unbounded_blk_op(string fn, size_t blk_size);
+    BitBundle<Field> unbounded_blk_op(string fn, size_t blk_size);
     // Prefix op over large fan-in: we chunk it into small blocks, and use the prefix_blk_op to evalucate each block.
-    BitBundle prefix_op(string fn, size_t blk_size = 8);
-    BitBundle postfix_op(string fn, size_t blk_size = 8);
+    BitBundle<Field> prefix_op(string fn, size_t blk_size = 8);
+    BitBundle<Field> postfix_op(string fn, size_t blk_size = 8);
     // Prefix op on a small block using unbounded_blk_op.
-    BitBundle prefix_blk_op(string fn, size_t blk_size = 8);
-    BitBundle postfix_blk_op(string fn, size_t blk_size = 8); 
+    BitBundle<Field> prefix_blk_op(string fn, size_t blk_size = 8);
+    BitBundle<Field> postfix_blk_op(string fn, size_t blk_size = 8); 
 
-    BitBundle prefix_op_one_round(string fn);
-    BitBundle postfix_op_one_round(string fn);
+    BitBundle<Field> prefix_op_one_round(string fn);
+    BitBundle<Field> postfix_op_one_round(string fn);
 
 };
 
 // This class is used to calculate the carry bits.
+template<class Field>
 class TripleBitBundle{
 
-    void represent_idx(TYPE idx, size_t mxBlk, vector<size_t> &rep);
+    void represent_idx(typename Field::TYPE idx, size_t mxBlk, vector<size_t> &rep);
 public:
-    BitBundle sBits;
-    BitBundle pBits;
-    BitBundle kBits;
+    BitBundle<Field> sBits;
+    BitBundle<Field> pBits;
+    BitBundle<Field> kBits;
 
     TripleBitBundle(const size_t &xSize, const size_t &ySize):sBits(xSize, ySize), pBits(xSize, ySize), kBits(xSize, ySize){}
-    TripleBitBundle(const BitBundle &a, const BitBundle &b);
+    TripleBitBundle(const BitBundle<Field> &a, const BitBundle<Field> &b);
     template<typename Derived>
-    TripleBitBundle(const BitBundle &a, const MatrixBase<Derived>&b);
+    TripleBitBundle(const BitBundle<Field> &a, const MatrixBase<Derived>&b);
     template<typename Derived>
-    TripleBitBundle(const MatrixBase<Derived>&a, const BitBundle &b);
+    TripleBitBundle(const MatrixBase<Derived>&a, const BitBundle<Field> &b);
 
     size_t rows()const{return sBits.rows();}
     size_t cols()const{return sBits.cols();}
-    TripleBitBundle unbounded_blk_carry_propagation(size_t blk_size);
-    TripleBitBundle prefix_carry_propagation();
+    TripleBitBundle<Field> unbounded_blk_carry_propagation(size_t blk_size);
+    TripleBitBundle<Field> prefix_carry_propagation();
 };
 
 // Declaration of the templates
-template<typename Derived>
-BitBundle bitwise_xor(const BitBundle &a, const MatrixBase<Derived> &b);
-template<typename Derived>
-BitBundle bitwise_xor(const MatrixBase<Derived> &a, const BitBundle &b);
-
-template<typename Derived>
-BitBundle bitwise_and(const BitBundle &a, const MatrixBase<Derived> &b);
-template<typename Derived>
-BitBundle bitwise_and(const MatrixBase<Derived> &a, const BitBundle &b);
-
-template<typename Derived>
-BitBundle less_than_unsigned(const MatrixBase<Derived> &a, const BitBundle &b);
-template<typename Derived>
-BitBundle less_than_unsigned(const BitBundle &a, const MatrixBase<Derived> &b);
-
-template<typename Derived>
-BitBundle bit_add(const MatrixBase<Derived> &a, const BitBundle &b);
-template<typename Derived>
-BitBundle bit_add(const BitBundle &a, const MatrixBase<Derived> &b);
+template<class Field>
+BitBundle<Field> bitwise_xor(const BitBundle<Field> &a, const BitBundle<Field> &b);
+template<class Field>
+BitBundle<Field> bitwise_and(const BitBundle<Field> &a, const BitBundle<Field> &b);
+template<class Field>
+BitBundle<Field> less_than_unsigned(const BitBundle<Field> &a, const BitBundle<Field> &b);
+template<class Field>
+BitBundle<Field> bit_add(const BitBundle<Field> &a, const BitBundle<Field> &b);
+
+template<class Field, typename Derived>
+BitBundle<Field> bitwise_xor(const BitBundle<Field> &a, const MatrixBase<Derived> &b);
+template<class Field, typename Derived>
+BitBundle<Field> bitwise_xor(const MatrixBase<Derived> &a, const BitBundle<Field> &b);
+
+template<class Field, typename Derived>
+BitBundle<Field> bitwise_and(const BitBundle<Field> &a, const MatrixBase<Derived> &b);
+template<class Field, typename Derived>
+BitBundle<Field> bitwise_and(const MatrixBase<Derived> &a, const BitBundle<Field> &b);
+
+template<class Field, typename Derived>
+BitBundle<Field> less_than_unsigned(const MatrixBase<Derived> &a, const BitBundle<Field> &b);
+template<class Field, typename Derived>
+BitBundle<Field> less_than_unsigned(const BitBundle<Field> &a, const MatrixBase<Derived> &b);
+
+template<class Field, typename Derived>
+BitBundle<Field> bit_add(const MatrixBase<Derived> &a, const BitBundle<Field> &b);
+template<class Field, typename Derived>
+BitBundle<Field> bit_add(const BitBundle<Field> &a, const MatrixBase<Derived> &b);
 }
 
 #endif
\ No newline at end of file
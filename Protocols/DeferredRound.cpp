@@ -0,0 +1,145 @@
+#include "Protocols/DeferredRound.h"
+#include "Math/gfpKernels.h"
+using Eigen::Map;
+namespace hmmpc
+{
+
+template<class Field>
+typename DeferredRound<Field>::Opening& DeferredRound<Field>::open(ShareBundle<Field> &x, size_t precision)
+{
+    openings.emplace_back();
+    Opening &o = openings.back();
+    o.x = &x;
+    o.precision.assign(x.size(), precision);
+    o.masked = o.fixed = o.reduced = false;
+    return o;
+}
+
+template<class Field>
+void DeferredRound<Field>::reveal(ShareBundle<Field> &x)
+{
+    open(x, 0);
+}
+
+template<class Field>
+void DeferredRound<Field>::reveal_truncate(ShareBundle<Field> &x, size_t precision)
+{
+    open(x, precision);
+}
+
+// See ShareBundle::reduce_degree()
+template<class Field>
+void DeferredRound<Field>::reduce_degree(ShareBundle<Field> &x)
+{
+    x.double_degree();
+    assert(x.degree == ShareBase<Field>::threshold<<1);
+    Opening &o = open(x, 0);
+    o.masked = o.reduced = true;
+    o.R.resize(x.rows(), x.cols());
+    o.R.reduced_random();
+    cwise_add(x.shares, o.R.aux_shares, x.shares);
+}
+
+// See ShareBundle::truncate()
+template<class Field>
+void DeferredRound<Field>::truncate(ShareBundle<Field> &x)
+{
+    assert(x.degree == ShareBase<Field>::threshold);
+    Opening &o = open(x, Field::FIXED_PRECISION);
+    o.fixed = true;
+    o.R.resize(x.rows(), x.cols());
+    o.r_msb = ShareBundle<Field>(x.rows(), x.cols());
+    o.R.truncated_random(o.r_msb);
+    // Encode to make sure MSB(a)=0
+    cwise_add(x.shares, o.R.aux_shares, x.shares);
+    cwise_add_const(x.shares, Field::ConstEncode, x.shares);
+}
+
+template<class Field>
+void DeferredRound<Field>::truncate(ShareBundle<Field> &x, size_t precision)
+{
+    assert(x.degree == ShareBase<Field>::threshold);
+    Opening &o = open(x, precision);
+    o.masked = true;
+    o.R.resize(x.rows(), x.cols());
+    o.R.truncated_random(precision);
+    cwise_add(x.shares, o.R.aux_shares, x.shares);
+}
+
+// See ShareBundle::reduce_truncate()
+template<class Field>
+void DeferredRound<Field>::reduce_truncate(ShareBundle<Field> &x)
+{
+    x.double_degree();
+    assert(x.degree == ShareBase<Field>::threshold<<1);
+    Opening &o = open(x, Field::FIXED_PRECISION);
+    o.fixed = o.reduced = true;
+    o.R.resize(x.rows(), x.cols());
+    o.r_msb = ShareBundle<Field>(x.rows(), x.cols());
+    o.R.reduced_truncated_random(o.r_msb);
+    cwise_add(x.shares, o.R.aux_shares, x.shares);
+    cwise_add_const(x.shares, Field::ConstEncode, x.shares);
+}
+
+template<class Field>
+void DeferredRound<Field>::reduce_truncate(ShareBundle<Field> &x, size_t precision)
+{
+    x.double_degree();
+    assert(x.degree == ShareBase<Field>::threshold<<1);
+    Opening &o = open(x, precision);
+    o.masked = o.reduced = true;
+    o.R.resize(x.rows(), x.cols());
+    o.R.reduced_truncated_random(precision);
+    cwise_add(x.shares, o.R.aux_shares, x.shares);
+}
+
+/**
+ * @brief Concatenate the pending sharings into one bundle, reveal it with the truncation of each element,
+ * and then finish each operation with its block of the secrets.
+ *
+ */
+template<class Field>
+void DeferredRound<Field>::flush()
+{
+    if(openings.empty()){return;}
+
+    size_t total = 0;
+    int degree = ShareBase<Field>::threshold;
+    for(auto &o: openings){
+        total += o.x->size();
+        degree = max(degree, o.x->degree);
+    }
+    ShareBundle<Field> all(1, total);
+    all.set_degree(degree);
+    vector<size_t> precision(total);
+    size_t offset = 0;
+    for(auto &o: openings){
+        Map<gfpMatrix<Field>>(all.shares.data() + offset, o.x->rows(), o.x->cols()) = o.x->shares;
+        copy(o.precision.begin(), o.precision.end(), precision.begin() + offset);
+        offset += o.x->size();
+    }
+
+    all.reveal_truncate(precision);
+
+    offset = 0;
+    for(auto &o: openings){
+        ShareBundle<Field> &x = *o.x;
+        x.secrets = Map<const gfpMatrix<Field>>(all.secrets.data() + offset, x.rows(), x.cols());
+        offset += x.size();
+        if(o.reduced){
+            x.degree >>= 1;
+        }
+        if(o.fixed){
+            x.fix_truncation(o.R, o.r_msb);
+        }else if(o.masked){
+            cwise_sub(x.secrets, o.R.shares, x.shares);
+        }
+    }
+    openings.clear();
+}
+
+template class DeferredRound<PR31>;
+
+template class DeferredRound<PR61>;
+
+}
@@ -0,0 +1,62 @@
+#ifndef PROTOCOLS_DEFERRED_ROUND_H_
+#define PROTOCOLS_DEFERRED_ROUND_H_
+
+#include <deque>
+#include "Protocols/ShareBundle.h"
+
+namespace hmmpc
+{
+
+/**
+ * @brief Lazy execution of the openings of independent ShareBundles, to share their rounds.
+ * Each call masks the sharings as its eager counterpart in ShareBundle (e.g. reduce_degree()), registers them to open, and returns at once.
+ * flush() opens all the registered sharings in a single dispersed reveal, and then finishes each operation locally.
+ * The bundles are the futures of the calls: their secrets (reveal) or shares (the others) are only valid after flush().
+ * A round with pending openings must not be destroyed: the caller flushes it explicitly.
+ *
+ * The operations must be independent, i.e. a bundle is registered once and is not used by other registered operations before the flush.
+ * As a sharing of degree t is also a sharing of degree 2t, the sharings of different degrees are opened together by the highest degree.
+ * Unlike the dispersed reduce_degree(), the masked [x+r]_2t is revealed to all parties as in the original DN protocol,
+ * so that the reduction and the truncations finish in the same round.
+ */
+template<class Field>
+class DeferredRound
+{
+    struct Opening
+    {
+        ShareBundle<Field> *x;
+        vector<size_t> precision; // Bits to truncate from each opened element.
+        bool masked; // Subtract the mask R.shares after opening.
+        bool fixed; // Fix the truncation by r_msb after opening (see ShareBundle::fix_truncation).
+        bool reduced; // Halve the degree after opening.
+        DoubleShareBundle<Field> R;
+        ShareBundle<Field> r_msb;
+    };
+    // The openings are not moved, as R and r_msb are filled in place.
+    deque<Opening> openings;
+
+    Opening& open(ShareBundle<Field> &x, size_t precision);
+
+public:
+    DeferredRound(){}
+    // flush() is the only call that communicates, so the round must be flushed before it is destroyed.
+    ~DeferredRound(){assert(openings.empty());}
+
+    size_t size()const{return openings.size();}
+
+    // Counterparts of the ShareBundle methods.
+    void reveal(ShareBundle<Field> &x);
+    void reveal_truncate(ShareBundle<Field> &x, size_t precision);
+    void reduce_degree(ShareBundle<Field> &x);
+    void truncate(ShareBundle<Field> &x);
+    void truncate(ShareBundle<Field> &x, size_t precision);
+    void reduce_truncate(ShareBundle<Field> &x);
+    void reduce_truncate(ShareBundle<Field> &x, size_t precision);
+
+    // Open all the pending sharings in one round and finish their operations.
+    void flush();
+};
+
+}
+
+#endif
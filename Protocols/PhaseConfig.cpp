@@ -1,73 +1,180 @@
 #include "PhaseConfig.h"
 #include "Protocols/RandomShare.h"
+#include "Protocols/PreprocessingStore.h"
+#include "Protocols/PreprocessingProducer.h"
+#include "Protocols/PreprocessingPlan.h"
 namespace hmmpc
 {
 
-void PhaseConfig::init(int n, int t, ThreadPlayer *_P, int _Pking)
+template<class Field>
+void PhaseConfig<Field>::init(int n, int t, ThreadPlayer *_P, int _Pking)
 {
-    ShareBase::n_players = n;
-    ShareBase::threshold = t;
-    ShareBase::P = _P;
-    ShareBase::Pking = _Pking;
-    ShareBase::Phase = this; // Bind the phase pointer.
+    ShareBase<Field>::n_players = n;
+    ShareBase<Field>::threshold = t;
+    ShareBase<Field>::Pking = _Pking;
+    bind_thread(_P);
+
+    ShareBase<Field>::init_vandermondes();
+    ShareBase<Field>::init_reconstruction_vectors();
+
+    ShareBase<Field>::init_bits_coeff();
+
+    // The weights of the parties, either static from the hosts file or measured.
+    if(n > 1){
+#ifdef PROBE_WEIGHTS
+        agree_weights(probe_weight());
+#else
+        agree_weights(_P->N.get_weight(_P->my_num()));
+#endif
+    }
+}
 
-    // Suppose this the the random seed agreed among the parties.
-    const char key[SEED_SIZE]="ThisIs7heSeed.";
-    ShareBase::PRNG_agreed.SetSeed((const octet*)key);
-    // cout<<ShareBase::PRNG_agreed.get_uint()<<endl;
+/**
+ * @brief Agree on the weights of the parties, which partition the dispersed operations (see ShareBundle::partition_elements).
+ * Each party announces its own weight, so that all parties hold the same weights and hence the same layout of blocks,
+ * even if their hosts files or measurements differ.
+ * If all weights are equal, the parties keep the equal blocks.
+ * 
+ * @param my_weight positive weight of this party
+ */
+template<class Field>
+void PhaseConfig<Field>::agree_weights(double my_weight)
+{
+    assert(my_weight > 0);
+    auto &P = ShareBase<Field>::P;
+    octetStream o;
+    o.append((octet*)&my_weight, sizeof(double));
+    P->send_all_no_stats(o);
+    octetStreams os;
+    P->receive_all_no_stats(os);
 
-    ShareBase::init_vandermondes();
-    ShareBase::init_reconstruction_vectors();
+    vector<double> weights(P->num_players(), my_weight);
+    bool equal = true;
+    for(int i = 0; i < P->num_players(); i++){
+        if(i != P->my_num()){
+            os[i].consume((octet*)&weights[i], sizeof(double));
+        }
+        equal &= weights[i] == weights[0];
+    }
+    if(equal){
+        weights.clear();
+    }
+    ShareBase<Field>::weights = weights;
+}
 
-    ShareBase::init_bits_coeff();
+/**
+ * @brief Measure the speed of this party in the dispersed operations, in which it sends a block to every party and reconstructs it.
+ * The parties take turns to send 'bytes' to all others, who acknowledge it, such that each party measures its own upload.
+ * Then the party times the reconstruction of as many secrets of degree 2t.
+ * 
+ * @param bytes size of the probe
+ * @return double the weight, i.e. the inverse of the measured time
+ */
+template<class Field>
+double PhaseConfig<Field>::probe_weight(size_t bytes)
+{
+    auto &P = ShareBase<Field>::P;
+    octetStream probe, ack;
+    Timer timer;
+    for(int j = 0; j < P->num_players(); j++){
+        if(j == P->my_num()){
+            probe.reset_write_head();
+            memset(probe.append(bytes), 0, bytes);
+            timer.start();
+            P->send_all_no_stats(probe);
+            for(int i = 0; i < P->num_players(); i++){
+                if(i != j){
+                    P->receive_player_no_stats(i, ack);
+                }
+            }
+            timer.stop();
+        }else{
+            P->receive_player_no_stats(j, probe);
+            P->send_to_no_stats(j, ack);
+        }
+    }
 
-    ShareBase::send_buffers.reset(n);
-    ShareBase::receive_buffers.reset(n);
+    gfpMatrix<Field> sharings(ShareBase<Field>::reconstruction_vector_2t.size(), bytes / sizeof(gfpScalar<Field>));
+    fill_uniform(sharings);
+    timer.start();
+    gfpVector<Field> secrets = (ShareBase<Field>::reconstruction_vector_2t.transpose() * sharings).transpose();
+    timer.stop();
+    return 1 / timer.elapsed();
+}
 
-    ShareBase::send_buffers_PRG.reset(t+1);
-    ShareBase::receive_buffers_PRG.reset(n);
+/**
+ * @brief Bind the player, the phase pointer, the agreed PRNG and the buffers of the calling thread.
+ * The constants (n, t, vandermonde matrices, ...) are shared by all threads and set by init().
+ * 
+ * @param _P the channel of this thread
+ * @param stream Each thread uses a different stream of the agreed randomness.
+ */
+template<class Field>
+void PhaseConfig<Field>::bind_thread(ThreadPlayer *_P, int stream)
+{
+    int n = ShareBase<Field>::n_players, t = ShareBase<Field>::threshold;
+    ShareBase<Field>::P = _P;
+    ShareBase<Field>::Phase = this; // Bind the phase pointer.
+
+    // Suppose this the the random seed agreed among the parties.
+    char key[SEED_SIZE]="ThisIs7heSeed.";
+    key[SEED_SIZE-1] = (char)stream;
+    ShareBase<Field>::PRNG_agreed.SetSeed((const octet*)key);
+    // cout<<ShareBase::PRNG_agreed.get_uint()<<endl;
+
+    ShareBase<Field>::send_buffers.reset(n);
+    ShareBase<Field>::receive_buffers.reset(n);
+
+    ShareBase<Field>::send_buffers_PRG.reset(t+1);
+    ShareBase<Field>::receive_buffers_PRG.reset(n);
 }
 
-void PhaseConfig::set_input_file(string fn)
+template<class Field>
+void PhaseConfig<Field>::set_input_file(string fn)
 {
-    ShareBase::set_input_file(fn);
+    ShareBase<Field>::set_input_file(fn);
 }
 
-void PhaseConfig::close_input_file()
+template<class Field>
+void PhaseConfig<Field>::close_input_file()
 {
-    ShareBase::close_input_file();
+    ShareBase<Field>::close_input_file();
 }
 
-void PhaseConfig::start_offline()
+template<class Field>
+void PhaseConfig<Field>::start_offline()
 {
     isOffline = true;
-    auto &P = ShareBase::P;
+    auto &P = ShareBase<Field>::P;
     P->comm_stats.clear();
     P->timer.reset();
     P->sent = 0;
     P->timer.start();
 }
 
-void PhaseConfig::end_offline()
+template<class Field>
+void PhaseConfig<Field>::end_offline()
 {
     isOffline = false;
-    auto &P = ShareBase::P;
+    auto &P = ShareBase<Field>::P;
     P->timer.stop();
     offlineTimer += P->timer.elapsed();
     offlineSent += P->sent;
     offlineComm += P->comm_stats;
 }
 
-void PhaseConfig::clear_offline_status()
+template<class Field>
+void PhaseConfig<Field>::clear_offline_status()
 {
     offlineTimer = 0;
     offlineSent = 0;
     offlineComm.clear();
 }
 
-void PhaseConfig::print_offline_communication()
+template<class Field>
+void PhaseConfig<Field>::print_offline_communication()
 {
-    auto &P = ShareBase::P;
+    auto &P = ShareBase<Field>::P;
     cout << "---OFFLINE----"<<endl;
     cout << "Time (for P"<<P->my_num()<<") = "<<offlineTimer<<" seconds"<<endl;
     cout << "Data sent (for P"<<P->my_num()<<") = "<< offlineSent/1e6 <<" MB in ~"<<offlineComm.total_rounds()<<" rounds"<<endl;
@@ -97,10 +204,11 @@ void PhaseConfig::print_offline_communication()
     cout << "-------------"<<endl;
 }
 
-void PhaseConfig::start_online()
+template<class Field>
+void PhaseConfig<Field>::start_online()
 {
     isOnline = true;
-    auto &P = ShareBase::P;
+    auto &P = ShareBase<Field>::P;
     P->comm_stats.clear();
     P->timer.reset();
     P->sent = 0;
@@ -109,26 +217,29 @@ void PhaseConfig::start_online()
 
 
 
-void PhaseConfig::end_online()
+template<class Field>
+void PhaseConfig<Field>::end_online()
 {
     isOnline = false;
-    auto &P = ShareBase::P;
+    auto &P = ShareBase<Field>::P;
     P->timer.stop();
     onlineTimer += P->timer.elapsed();
     onlineComm += P->comm_stats;
     onlineSent += P->sent;
 }
 
-void PhaseConfig::clear_online_status()
+template<class Field>
+void PhaseConfig<Field>::clear_online_status()
 {
     onlineTimer = 0;
     onlineComm.clear();
     onlineSent = 0;
 }
 
-void PhaseConfig::print_online_communication()
+template<class Field>
+void PhaseConfig<Field>::print_online_communication()
 {
-    auto &P = ShareBase::P;
+    auto &P = ShareBase<Field>::P;
     cout << "---ONLINE---"<<endl;
     cout << "Time (for P"<<P->my_num()<<") = "<<onlineTimer<<" seconds"<<endl;
     cout << "Data sent (for P"<<P->my_num()<<") = "<< onlineSent/1e6 <<" MB in ~"<<onlineComm.total_rounds()<<" rounds"<<endl;
@@ -144,7 +255,8 @@ void PhaseConfig::print_online_communication()
     cout << "Global data sent = "<<global/1e6<<" MB (all parties)"<<endl;
     cout << "-------------"<<endl;
 }
-size_t PhaseConfig::get_global_communication(string phase)
+template<class Field>
+size_t PhaseConfig<Field>::get_global_communication(string phase)
 {
     size_t nSent;
     if(phase.compare("online")==0){
@@ -157,7 +269,7 @@ size_t PhaseConfig::get_global_communication(string phase)
         assert(false && "get_global_communication");
     }
 
-    auto &P = ShareBase::P;
+    auto &P = ShareBase<Field>::P;
     octetStream o;
     o.store(nSent);
     P->send_all_no_stats(o);
@@ -170,9 +282,10 @@ size_t PhaseConfig::get_global_communication(string phase)
     return global;
 }
 
-void PhaseConfig::print_communication_oneline()
+template<class Field>
+void PhaseConfig<Field>::print_communication_oneline()
 {
-    auto &P = ShareBase::P;
+    auto &P = ShareBase<Field>::P;
     // communication per party
     cout<<onlineTimer<<" "<<get_global_communication("online")/1e6/P->num_players()<<" ";
     cout<<offlineTimer<<" "<<get_global_communication("offline")/1e6/P->num_players()<<" ";
@@ -180,137 +293,241 @@ void PhaseConfig::print_communication_oneline()
 }
 
 
-void PhaseConfig::print_online_comm_online()
+template<class Field>
+void PhaseConfig<Field>::print_online_comm_online()
 {
     cout<<onlineTimer<<" "<<get_global_communication("online")/1e6<<endl;
 }
 
-void PhaseConfig::switch_to_offline()
+template<class Field>
+void PhaseConfig<Field>::switch_to_offline()
 {
     assert(isOnline);
     end_online();
     start_offline();
 }
 
-void PhaseConfig::switch_to_online()
+template<class Field>
+void PhaseConfig<Field>::switch_to_online()
 {
     assert(isOffline);
     end_offline();
     start_online();
 }
 
-void PhaseConfig::generate_random(string filename)
-{
-    ifstream in(filename);
-// #Random = 5232650
-// #DoubleR = 7714250
-// #RandomBit = 1262090
-// #RandomUn = 248160 8
-// #RandomTrunc = 0
-// #RandomReTrunc = 10350
-    for(int i = 0; i < 6; i++){
-        int x;
-        in>>x;
-        if(x){
-            switch (i)
-            {
-            case 0:
-                generate_random_sharings(x);
-                break;
-            case 1:
-                generate_reduced_random_sharings(x);
-                break;
-            case 2:
-                generate_random_bits(x);
-                break;
-            case 3:
-                int y;
-                in>>y;
-                generate_unbounded_mult_random_sharings(x, y);
-                break;
-            case 4:
-                generate_truncated_random_sharings(x);
-                break;
-            case 5:
-                generate_reduced_truncated_sharings(x);
-                break;
-            default:
-                break;
-            }
-        }
-        
-    }
+/**
+ * @brief Start a producer thread over the channel producerP, which keeps at least low_water tuples
+ * of each kind ahead of the consumption in the online phase.
+ * Its traffic and busy time are accounted in the offline phase by stop_producer().
+ * 
+ * @param producerP 
+ * @param low_water 
+ */
+template<class Field>
+void PhaseConfig<Field>::start_producer(ThreadPlayer *producerP, size_t low_water)
+{
+    assert(producer == nullptr && !trueOffline);
+    producer = new PreprocessingProducer<Field>(producerP, low_water);
+}
+
+template<class Field>
+void PhaseConfig<Field>::stop_producer()
+{
+    if(producer == nullptr){return;}
+    producer->stop();
+    add_offline_status(producer->get_phase());
+    delete producer;
+    producer = nullptr;
 }
 
-void PhaseConfig::generate_random_sharings(size_t n)
+template<class Field>
+void PhaseConfig<Field>::add_offline_status(const PhaseConfig<Field> &other)
+{
+    offlineTimer += other.offlineTimer;
+    offlineSent += other.offlineSent;
+    offlineComm += other.offlineComm;
+}
+
+template<class Field>
+void PhaseConfig<Field>::request_random_sharings(size_t n)
+{
+    cntRandom += n;
+    producer->request(PreprocessingProducer<Field>::RANDOM, n);
+}
+
+template<class Field>
+void PhaseConfig<Field>::request_random_bits(size_t n)
+{
+    cntRandomBit += n;
+    producer->request(PreprocessingProducer<Field>::RANDOM_BIT, n);
+}
+
+template<class Field>
+void PhaseConfig<Field>::request_reduced_random_sharings(size_t n)
+{
+    cntReducedRandom += n;
+    producer->request(PreprocessingProducer<Field>::DOUBLE_RANDOM, n);
+}
+
+template<class Field>
+void PhaseConfig<Field>::request_truncated_random_sharings(size_t n)
+{
+    cntTruncatedRandom += n;
+    producer->request(PreprocessingProducer<Field>::TRUNCATED, n);
+}
+
+template<class Field>
+void PhaseConfig<Field>::request_reduced_truncated_sharings(size_t n)
+{
+    cntReducedTruncatedRandom += n;
+    producer->request(PreprocessingProducer<Field>::REDUCED_TRUNCATED, n);
+}
+
+template<class Field>
+void PhaseConfig<Field>::generate_random(string filename)
+{
+    PreprocessingPlan<Field> plan;
+    plan.read(filename);
+    generate_random(plan);
+}
+
+/**
+ * @brief Generate the randomness of the plan, e.g. tallied by planTest() or read from the offline file.
+ * The kinds are generated in the order of the offline file.
+ * 
+ * @param plan 
+ */
+template<class Field>
+void PhaseConfig<Field>::generate_random(const PreprocessingPlan<Field> &plan)
+{
+    if(plan.nRandom){generate_random_sharings(plan.nRandom);}
+    if(plan.nDoubleR){generate_reduced_random_sharings(plan.nDoubleR);}
+    if(plan.nRandomBit){generate_random_bits(plan.nRandomBit);}
+    if(plan.nRandomUn){generate_unbounded_mult_random_sharings(plan.nRandomUn, plan.unboundedSize);}
+    if(plan.nRandomTrunc){generate_truncated_random_sharings(plan.nRandomTrunc);}
+    if(plan.nRandomReTrunc){generate_reduced_truncated_sharings(plan.nRandomReTrunc);}
+}
+
+/**
+ * @brief Move the randomness left after generate_random() into the persistent store in dir,
+ * as the material of one online run in another process (load_random).
+ * The file of each kind is named after its line in the offline file, e.g. DoubleR.
+ * 
+ * @param dir 
+ */
+template<class Field>
+void PhaseConfig<Field>::store_random(string dir)
+{
+    PreprocessingStore<Field> store(dir, ShareBase<Field>::n_players, ShareBase<Field>::threshold, ShareBase<Field>::P->my_num());
+    store.store("Random", RandomShare<Field>::queueRandom);
+    store.store("DoubleR", DoubleRandom<Field>::queueReducedRandom);
+    store.store("RandomBit", RandomShare<Field>::queueRandomBit);
+    store.store("RandomUn", DoubleRandom<Field>::queueUnboundedMultRandom, constUnboundedSize ? constUnboundedSize : 1);
+    store.store("RandomTrunc", DoubleRandom<Field>::queueTruncatedRandom);
+    store.store("RandomReTrunc", DoubleRandom<Field>::queueReducedTruncatedRandom);
+}
+
+/**
+ * @brief Load the randomness of one online run from the persistent store in dir instead of generating it.
+ * 
+ * @param dir 
+ */
+template<class Field>
+void PhaseConfig<Field>::load_random(string dir)
+{
+    PreprocessingStore<Field> store(dir, ShareBase<Field>::n_players, ShareBase<Field>::threshold, ShareBase<Field>::P->my_num());
+    store.load("Random", RandomShare<Field>::queueRandom);
+    store.load("DoubleR", DoubleRandom<Field>::queueReducedRandom);
+    store.load("RandomBit", RandomShare<Field>::queueRandomBit);
+    store.load("RandomUn", DoubleRandom<Field>::queueUnboundedMultRandom);
+    store.load("RandomTrunc", DoubleRandom<Field>::queueTruncatedRandom);
+    store.load("RandomReTrunc", DoubleRandom<Field>::queueReducedTruncatedRandom);
+}
+
+template<class Field>
+void PhaseConfig<Field>::generate_random_sharings(size_t n)
 {
     cntRandom += n;
     // RandomShare::generate_random_sharings(n);
-    RandomShare::generate_random_sharings_PRG(n);
+    RandomShare<Field>::generate_random_sharings_PRG(n);
 }
 
-void PhaseConfig::generate_random_bits(size_t n)
+template<class Field>
+void PhaseConfig<Field>::generate_random_bits(size_t n)
 {
     cntRandomBit += n;
-    RandomShare::generate_random_bits(n);
+    RandomShare<Field>::generate_random_bits(n);
 }
 
-void PhaseConfig::generate_reduced_random_sharings(size_t n)
+template<class Field>
+void PhaseConfig<Field>::generate_reduced_random_sharings(size_t n)
 {
     cntReducedRandom += n;
     // DoubleRandom::generate_reduced_random_sharings(n);
-    DoubleRandom::generate_reduced_random_sharings_PRG(n);
+    DoubleRandom<Field>::generate_reduced_random_sharings_PRG(n);
 }
 
-void PhaseConfig::generate_truncated_random_sharings(size_t n)
+template<class Field>
+void PhaseConfig<Field>::generate_truncated_random_sharings(size_t n)
 {
     cntTruncatedRandom += n;
-    DoubleRandom::generate_truncated_random_sharings(n);
+    DoubleRandom<Field>::generate_truncated_random_sharings(n);
 }
 
-void PhaseConfig::generate_truncated_random_sharings(size_t n, size_t precision)
+template<class Field>
+void PhaseConfig<Field>::generate_truncated_random_sharings(size_t n, size_t precision)
 {
     cntTruncatedRandomInML += n;
-    DoubleRandom::generate_truncated_random_sharings(n, precision);
+    DoubleRandom<Field>::generate_truncated_random_sharings(n, precision);
 }
 
-void PhaseConfig::generate_reduced_truncated_sharings(size_t n)
+template<class Field>
+void PhaseConfig<Field>::generate_reduced_truncated_sharings(size_t n)
 {
     cntReducedTruncatedRandom += n;
-    DoubleRandom::generate_reduced_truncated_random_sharings(n);
+    DoubleRandom<Field>::generate_reduced_truncated_random_sharings(n);
 }
 
 // Combine the reduced truncation with the opration *learning_rate/batch_size.
-void PhaseConfig::generate_reduced_truncated_sharings(size_t n, size_t logLearningRate, size_t logMiniBatch)
+template<class Field>
+void PhaseConfig<Field>::generate_reduced_truncated_sharings(size_t n, size_t logLearningRate, size_t logMiniBatch)
 {
     cntReducedTruncatedInMLRandom += n;
-    DoubleRandom::generate_reduced_truncated_random_sharings(DoubleRandom::queueReducedTruncatedInML, n, FIXED_PRECISION+logLearningRate+logMiniBatch);
+    DoubleRandom<Field>::generate_reduced_truncated_random_sharings(DoubleRandom<Field>::queueReducedTruncatedInML, n, Field::FIXED_PRECISION+logLearningRate+logMiniBatch);
 }
 
-void PhaseConfig::generate_reduced_truncated_sharings(size_t n, size_t precision)
+template<class Field>
+void PhaseConfig<Field>::generate_reduced_truncated_sharings(size_t n, size_t precision)
 {
     cntRTRandomWithDifferentPrecision += n;
-    DoubleRandom::generate_reduced_truncated_random_sharings(DoubleRandom::queueReducedTruncatedWithPrecisionRandom ,n, precision);
+    DoubleRandom<Field>::generate_reduced_truncated_random_sharings(DoubleRandom<Field>::queueReducedTruncatedWithPrecisionRandom ,n, precision);
 }
 
-void PhaseConfig::generate_reduced_truncated_sharings(size_t n, vector<size_t> &precision, size_t num_repetition)
+template<class Field>
+void PhaseConfig<Field>::generate_reduced_truncated_sharings(size_t n, vector<size_t> &precision, size_t num_repetition)
 {
     cntRTRandomWithDifferentPrecision += n * num_repetition;
-    DoubleRandom::generate_reduced_truncated_random_sharings(DoubleRandom::queueReducedTruncatedWithPrecisionRandom ,n, precision, num_repetition);
+    DoubleRandom<Field>::generate_reduced_truncated_random_sharings(DoubleRandom<Field>::queueReducedTruncatedWithPrecisionRandom ,n, precision, num_repetition);
 }
 
-void PhaseConfig::generate_unbounded_mult_random_sharings(size_t xSize, size_t ySize)
+template<class Field>
+void PhaseConfig<Field>::generate_unbounded_mult_random_sharings(size_t xSize, size_t ySize)
 {
     cntUnboundedMultRandom += xSize;
     if(constUnboundedSize==0){constUnboundedSize=ySize;}
     else if(ySize!=constUnboundedSize)assert(false && "Unbounded ySize is inconsistent");
-    DoubleRandom::generate_unbounded_random_sharings(xSize, ySize);
+    DoubleRandom<Field>::generate_unbounded_random_sharings(xSize, ySize);
 }
 
-void PhaseConfig::generate_unbounded_mult_random_sharings(size_t num)
+template<class Field>
+void PhaseConfig<Field>::generate_unbounded_mult_random_sharings(size_t num)
 {
     // cntUnboundedMultRandom += num;
-    DoubleRandom::generate_unbounded_random_sharings(num);
+    DoubleRandom<Field>::generate_unbounded_random_sharings(num);
 }
 
-}
\ No newline at end of file
+template class PhaseConfig<PR31>;
+
+template class PhaseConfig<PR61>;
+
+}
@@ -1,9 +1,19 @@
 #ifndef PROTOCOLS_PHASE_CONFIG_H_
 #define PROTOCOLS_PHASE_CONFIG_H_
 #include "Networking/Player.h"
+
+// Bytes of the probe to measure the speed of each party for the dispersed operations
+#ifndef PROBE_BYTES
+#define PROBE_BYTES (1 << 20)
+#endif
+
 namespace hmmpc
 {
 
+template<class Field> class PreprocessingProducer;
+template<class Field> class PreprocessingPlan;
+
+template<class Field>
 class PhaseConfig
 {
     size_t offlineSent;
@@ -34,9 +44,15 @@ class PhaseConfig
     size_t constUnboundedSize = 0;
 
     size_t cntRTRandomWithDifferentPrecision = 0;
+
+    // Background producer of the random sharings, running over its own channel.
+    PreprocessingProducer<Field> *producer = nullptr;
 public:
     PhaseConfig():offlineSent(0), offlineTimer(0), onlineSent(0), onlineTimer(0){}
     void init(int n, int t, ThreadPlayer *_P, int _Pking = 0);
+    void bind_thread(ThreadPlayer *_P, int stream = 0);// Bind the per-thread state of the protocols to this phase.
+    void agree_weights(double my_weight);// Agree on the weights of the parties in the dispersed operations.
+    double probe_weight(size_t bytes = PROBE_BYTES);// Measure the speed of this party in the dispersed operations.
     void set_input_file(string fn);
     void close_input_file();
 
@@ -54,7 +70,22 @@ public:
     void switch_to_offline();
     void switch_to_online();
 
+    void start_producer(ThreadPlayer *producerP, size_t low_water);// Generate the random sharings in background during the online phase.
+    void stop_producer();
+    bool is_producing(){return producer != nullptr;}
+    void add_offline_status(const PhaseConfig<Field> &other);
+
+    // Take the random sharings from the producer (blocking).
+    void request_random_sharings(size_t n);
+    void request_random_bits(size_t n);
+    void request_reduced_random_sharings(size_t n);
+    void request_truncated_random_sharings(size_t n);
+    void request_reduced_truncated_sharings(size_t n);
+
     void generate_random(string filename);// read argv from filename
+    void generate_random(const PreprocessingPlan<Field> &plan);
+    void store_random(string dir);// Move the generated randomness into the persistent store.
+    void load_random(string dir);// Load the randomness of one run from the persistent store.
     void generate_random_sharings(size_t n);
     void generate_random_bits(size_t n);
     void generate_reduced_random_sharings(size_t n);
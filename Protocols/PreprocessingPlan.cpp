@@ -0,0 +1,163 @@
+#include "Protocols/PreprocessingPlan.h"
+#include "Tools/Exceptions.h"
+#include <fstream>
+
+namespace hmmpc
+{
+
+/*********************************************************************
+ *
+ *       Random sharings
+ * They follow the generation in RandomShare.cpp.
+ *
+ * *******************************************************************/
+template<class Field>
+void PreprocessingPlan<Field>::random_sharings(size_t n)
+{
+    nRandom += n;
+}
+
+template<class Field>
+void PreprocessingPlan<Field>::reduced_random_sharings(size_t n)
+{
+    nDoubleR += n;
+}
+
+// [r]_t -> r^2 -> [r/sqrt(r^2)]
+template<class Field>
+void PreprocessingPlan<Field>::random_bits(size_t n)
+{
+    nRandomBit += n;
+    random_sharings(n);
+}
+
+// 2 random sharings for each element, and a reduce_degree for (b, b') and (b_{i-1}, b_i').
+template<class Field>
+void PreprocessingPlan<Field>::unbounded_mult_random_sharings(size_t xSize, size_t ySize)
+{
+    nRandomUn += xSize;
+    if(unboundedSize==0){unboundedSize=ySize;}
+    else if(ySize!=unboundedSize)assert(false && "Unbounded ySize is inconsistent");
+    random_sharings((xSize<<1) * ySize);
+    reduce_degree(xSize * (ySize+ySize-1));
+}
+
+template<class Field>
+void PreprocessingPlan<Field>::truncated_random_sharings(size_t n)
+{
+    nRandomTrunc += n;
+    random_bits(n * Field::BITS_LENGTH);
+}
+
+template<class Field>
+void PreprocessingPlan<Field>::reduced_truncated_sharings(size_t n)
+{
+    nRandomReTrunc += n;
+    random_bits(n * Field::BITS_LENGTH);
+}
+
+/*********************************************************************
+ *
+ *       Protocols
+ * They follow the implementation in ShareBundle.cpp and Bit.cpp.
+ *
+ * *******************************************************************/
+template<class Field>
+void PreprocessingPlan<Field>::reduce_degree(size_t n)
+{
+    reduced_random_sharings(n);
+}
+
+template<class Field>
+void PreprocessingPlan<Field>::reduce_truncate(size_t n)
+{
+    reduced_truncated_sharings(n);
+}
+
+// Postfix-OR of the xor by one unbounded multiplication on each row.
+template<class Field>
+void PreprocessingPlan<Field>::less_than_unsigned(size_t n)
+{
+    unbounded_mult_random_sharings(n, Field::BITS_LENGTH);
+}
+
+// get_LSB_impared(2x), then reduce_degree_1stLayer with n_y BeaverTriples.
+template<class Field>
+void PreprocessingPlan<Field>::deltaReLU_opt(size_t n, size_t n_y)
+{
+    random_bits(n * Field::BITS_LENGTH); // solved_random
+    less_than_unsigned(n);
+    reduced_random_sharings(n * (1+n_y));
+}
+
+template<class Field>
+void PreprocessingPlan<Field>::ReLU_opt(size_t n)
+{
+    deltaReLU_opt(n, 1);
+}
+
+// Tournament of hierMaxpoolRowwise_opt: each layer compares the pairs of each row.
+template<class Field>
+void PreprocessingPlan<Field>::MaxRowwise_opt(size_t rows, size_t cols)
+{
+    for(size_t nCols = cols; nCols > 1; nCols = (nCols+1)/2){
+        deltaReLU_opt(rows * (nCols/2), 1);
+    }
+}
+
+/**
+ * @brief Read the offline file in the format of PhaseConfig::generate_random().
+ *
+ * @param filename
+ */
+template<class Field>
+void PreprocessingPlan<Field>::read(std::string filename)
+{
+    std::ifstream in(filename);
+    if(!in.good()){throw file_missing(filename, "PreprocessingPlan::read");}
+    size_t *counts[6] = {&nRandom, &nDoubleR, &nRandomBit, &nRandomUn, &nRandomTrunc, &nRandomReTrunc};
+    for(int i = 0; i < 6; i++){
+        in>>*counts[i];
+        if(i==3 && nRandomUn){in>>unboundedSize;}
+    }
+    if(in.fail()){throw file_error("invalid offline file " + filename);}
+}
+
+/**
+ * @brief Write the offline file, which is read by PhaseConfig::generate_random().
+ *
+ * @param filename
+ */
+template<class Field>
+void PreprocessingPlan<Field>::write(std::string filename)const
+{
+    std::ofstream out(filename);
+    if(!out.good()){throw file_error("cannot write " + filename);}
+    out<<nRandom<<std::endl;
+    out<<nDoubleR<<std::endl;
+    out<<nRandomBit<<std::endl;
+    out<<nRandomUn;
+    if(nRandomUn){out<<" "<<unboundedSize;}
+    out<<std::endl;
+    out<<nRandomTrunc<<std::endl;
+    out<<nRandomReTrunc<<std::endl;
+    out<<std::endl;
+    print(out);
+}
+
+template<class Field>
+void PreprocessingPlan<Field>::print(std::ostream &os)const
+{
+    os<<"#Random = "<<nRandom<<std::endl;
+    os<<"#DoubleR = "<<nDoubleR<<std::endl;
+    os<<"#RandomBit = "<<nRandomBit<<std::endl;
+    os<<"#RandomUn = "<<nRandomUn<<" "<<unboundedSize<<std::endl;
+    os<<"#RandomTrunc = "<<nRandomTrunc<<std::endl;
+    os<<"#RandomReTrunc = "<<nRandomReTrunc<<std::endl;
+}
+
+template class PreprocessingPlan<PR31>;
+
+template class PreprocessingPlan<PR61>;
+
+}
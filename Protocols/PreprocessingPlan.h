@@ -0,0 +1,54 @@
+#ifndef PROTOCOLS_PREPROCESSING_PLAN_H_
+#define PROTOCOLS_PREPROCESSING_PLAN_H_
+
+#include <iostream>
+#include <string>
+#include "Math/gfpScalar.h"
+
+namespace hmmpc
+{
+
+/**
+ * @brief Number of each kind of random sharings required by a computation, i.e. the offline file.
+ *
+ * The counts are tallied without any communication or computation,
+ * by the counting counterparts of the protocols below, which mirror the sizes they request.
+ * As the counters of PhaseConfig, each count also includes the sharings consumed by generating other kinds,
+ * e.g. generating n random bits consumes n random sharings,
+ * so that PhaseConfig::generate_random() generates all of them in a separate offline phase.
+ */
+template<class Field>
+class PreprocessingPlan
+{
+public:
+    size_t nRandom = 0;
+    size_t nDoubleR = 0;
+    size_t nRandomBit = 0;
+    size_t nRandomUn = 0;
+    size_t unboundedSize = 0; // Length of each unbounded multiplication instance.
+    size_t nRandomTrunc = 0;
+    size_t nRandomReTrunc = 0;
+
+    // Random sharings (with the sharings consumed by their generation).
+    void random_sharings(size_t n);
+    void reduced_random_sharings(size_t n);
+    void random_bits(size_t n);
+    void unbounded_mult_random_sharings(size_t xSize, size_t ySize);
+    void truncated_random_sharings(size_t n);
+    void reduced_truncated_sharings(size_t n);
+
+    // Protocols over n entries.
+    void reduce_degree(size_t n);
+    void reduce_truncate(size_t n);
+    void less_than_unsigned(size_t n); // Bitwise sharings (n by BITS_LENGTH) < public bits
+    void deltaReLU_opt(size_t n, size_t n_y); // with n_y BeaverTriples for the next layer of mult
+    void ReLU_opt(size_t n);
+    void MaxRowwise_opt(size_t rows, size_t cols);
+
+    void read(std::string filename);
+    void write(std::string filename)const;
+    void print(std::ostream &os)const;
+};
+
+}
+#endif
@@ -0,0 +1,138 @@
+#include "Protocols/PreprocessingProducer.h"
+#include "Protocols/RandomShare.h"
+
+namespace hmmpc
+{
+
+/**
+ * @brief Construct the producer and start its thread.
+ * It captures the pools of the calling (online) thread as the targets.
+ *
+ * @param P the dedicated ThreadPlayer of the producer, connected in the same order by every party
+ * @param low_water
+ */
+template<class Field>
+PreprocessingProducer<Field>::PreprocessingProducer(ThreadPlayer *P, size_t low_water):
+    P(P), low_water(low_water), thread(0)
+{
+    assert(low_water > 0);
+    targets[RANDOM] = &RandomShare<Field>::queueRandom;
+    targets[DOUBLE_RANDOM] = &DoubleRandom<Field>::queueReducedRandom;
+    targets[RANDOM_BIT] = &RandomShare<Field>::queueRandomBit;
+    targets[TRUNCATED] = &DoubleRandom<Field>::queueTruncatedRandom;
+    targets[REDUCED_TRUNCATED] = &DoubleRandom<Field>::queueReducedTruncatedRandom;
+    for(int i = 0; i < N_KINDS; i++){
+        consumed[i] = 0;
+        requested[i] = 0;
+    }
+    pthread_create(&thread, 0, run_thread, this);
+}
+
+template<class Field>
+PreprocessingProducer<Field>::~PreprocessingProducer()
+{
+    stop();
+}
+
+template<class Field>
+void* PreprocessingProducer<Field>::run_thread(void *producer)
+{
+    ((PreprocessingProducer<Field>*)producer)->run();
+    return 0;
+}
+
+/**
+ * @brief Run the jobs in FIFO order until the stop job.
+ * Only the busy periods are accounted as the offline phase of the producer.
+ *
+ */
+template<class Field>
+void PreprocessingProducer<Field>::run()
+{
+    phase.bind_thread(P, 1);
+    Job job = Job();
+    while(jobs.pop(job) && job.n){
+        phase.start_offline();
+        produce(job.kind, job.n);
+        phase.end_offline();
+    }
+}
+
+/**
+ * @brief Generate n tuples of kind in the pools of this thread, and move them to the target pool.
+ * The generation might output more than n tuples, and the rest is kept for the next job.
+ *
+ * @param kind
+ * @param n
+ */
+template<class Field>
+void PreprocessingProducer<Field>::produce(Kind kind, size_t n)
+{
+    RandomPool<Field> *pool;
+    switch(kind)
+    {
+    case RANDOM:
+        pool = &RandomShare<Field>::queueRandom;
+        if(pool->size() < n){phase.generate_random_sharings(n - pool->size());}
+        break;
+    case DOUBLE_RANDOM:
+        pool = &DoubleRandom<Field>::queueReducedRandom;
+        if(pool->size() < n){phase.generate_reduced_random_sharings(n - pool->size());}
+        break;
+    case RANDOM_BIT:
+        pool = &RandomShare<Field>::queueRandomBit;
+        if(pool->size() < n){phase.generate_random_bits(n - pool->size());}
+        break;
+    case TRUNCATED:
+        pool = &DoubleRandom<Field>::queueTruncatedRandom;
+        if(pool->size() < n){phase.generate_truncated_random_sharings(n - pool->size());}
+        break;
+    case REDUCED_TRUNCATED:
+        pool = &DoubleRandom<Field>::queueReducedTruncatedRandom;
+        if(pool->size() < n){phase.generate_reduced_truncated_sharings(n - pool->size());}
+        break;
+    default:
+        throw runtime_error("Unknown kind of preprocessing");
+    }
+    pool->move_to(*targets[kind], n);
+}
+
+/**
+ * @brief Record the consumption of n tuples of kind, and refill if necessary.
+ * The first job covers the tuples the online thread is waiting for,
+ * and the second one fills up to 2*low_water ahead.
+ *
+ * @param kind
+ * @param n
+ */
+template<class Field>
+void PreprocessingProducer<Field>::request(Kind kind, size_t n)
+{
+    if(n == 0){return;}
+    consumed[kind] += n;
+    if(requested[kind] < consumed[kind] + low_water){
+        if(requested[kind] < consumed[kind]){
+            jobs.push({kind, consumed[kind] - requested[kind]});
+            requested[kind] = consumed[kind];
+        }
+        size_t target = consumed[kind] + (low_water<<1);
+        jobs.push({kind, target - requested[kind]});
+        requested[kind] = target;
+    }
+    targets[kind]->wait(n);
+}
+
+template<class Field>
+void PreprocessingProducer<Field>::stop()
+{
+    if(thread == 0){return;}
+    jobs.push({RANDOM, 0});
+    pthread_join(thread, 0);
+    thread = 0;
+}
+
+template class PreprocessingProducer<PR31>;
+
+template class PreprocessingProducer<PR61>;
+
+}
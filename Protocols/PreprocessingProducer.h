@@ -0,0 +1,69 @@
+#ifndef PROTOCOLS_PREPROCESSING_PRODUCER_H_
+#define PROTOCOLS_PREPROCESSING_PRODUCER_H_
+
+#include <pthread.h>
+
+#include "Protocols/PhaseConfig.h"
+#include "Protocols/RandomPool.h"
+#include "Tools/WaitQueue.h"
+
+namespace hmmpc
+{
+
+// Default number of tuples of each kind the producer keeps ahead of the online phase.
+const static size_t DEFAULT_LOW_WATER = 1<<12;
+
+/**
+ * @brief Background thread which generates the preprocessed random sharings over its own channel,
+ * while the online thread consumes them.
+ *
+ * Each request() of the online thread records the consumption of one kind of tuples.
+ * Once less than low_water tuples are requested ahead of the consumption,
+ * it asks the producer to refill up to 2*low_water ahead, and waits until the requested tuples arrive.
+ * The online thread of every party makes the same requests in the same order,
+ * so the producer of every party runs the same generation jobs in the same order.
+ */
+template<class Field>
+class PreprocessingProducer
+{
+public:
+    enum Kind {RANDOM, DOUBLE_RANDOM, RANDOM_BIT, TRUNCATED, REDUCED_TRUNCATED, N_KINDS};
+
+private:
+    struct Job
+    {
+        Kind kind;
+        size_t n; // n = 0 stops the producer.
+    };
+
+    ThreadPlayer *P; // The dedicated channel of the producer.
+    size_t low_water;
+    PhaseConfig<Field> phase; // The offline phase of the producer thread.
+
+    RandomPool<Field> *targets[N_KINDS]; // Pools of the online thread.
+    size_t consumed[N_KINDS];
+    size_t requested[N_KINDS];
+
+    WaitQueue<Job> jobs;
+    pthread_t thread;
+
+    static void* run_thread(void *producer);
+    void run();
+    void produce(Kind kind, size_t n);
+
+    // prevent copying
+    PreprocessingProducer(const PreprocessingProducer<Field> &other);
+
+public:
+    // Start the producer thread. It must be constructed in the online thread.
+    PreprocessingProducer(ThreadPlayer *P, size_t low_water = DEFAULT_LOW_WATER);
+    ~PreprocessingProducer();
+
+    void request(Kind kind, size_t n); // Block until n tuples of kind are in the pool of the online thread.
+    void stop(); // Finish the pending jobs and join the thread.
+
+    const PhaseConfig<Field>& get_phase()const{return phase;}
+};
+
+}
+#endif
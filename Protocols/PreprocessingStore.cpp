@@ -0,0 +1,192 @@
+#include "Protocols/PreprocessingStore.h"
+#include "Tools/Exceptions.h"
+#include <fstream>
+#include <cstring>
+#include <memory>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace hmmpc
+{
+
+const static char PREPROCESSING_MAGIC[8] = {'H', 'M', 'M', 'P', 'C', 'P', 'R', 'E'};
+// The columns start at a fixed offset, which leaves room for the header to grow.
+const static size_t PREPROCESSING_DATA_OFFSET = 128;
+static_assert(sizeof(PreprocessingHeader) <= PREPROCESSING_DATA_OFFSET, "PreprocessingHeader is too large");
+
+/**
+ * @brief A whole file mapped into memory. It is unmapped and closed on destruction.
+ * 
+ */
+class MappedFile
+{
+    int fd;
+public:
+    octet *data;
+    size_t length;
+
+    MappedFile(const string &fn, bool writable):
+        fd(-1), data(nullptr), length(0)
+    {
+        fd = open(fn.c_str(), writable ? O_RDWR : O_RDONLY);
+        if(fd < 0){throw file_missing(fn, "(preprocessing)");}
+        struct stat st;
+        if(fstat(fd, &st) < 0){close(fd); throw file_error("cannot stat " + fn);}
+        length = st.st_size;
+        if(length < PREPROCESSING_DATA_OFFSET){close(fd); throw signature_mismatch(fn);}
+        void *ptr = mmap(nullptr, length, writable ? PROT_READ|PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if(ptr == MAP_FAILED){close(fd); throw file_error("cannot map " + fn);}
+        data = (octet*)ptr;
+    }
+    ~MappedFile()
+    {
+        munmap(data, length);
+        close(fd);
+    }
+
+    PreprocessingHeader& header(){return *(PreprocessingHeader*)data;}
+    template<class Field>
+    const gfpScalar<Field>* column(size_t c)
+    {
+        return (const gfpScalar<Field>*)(data + PREPROCESSING_DATA_OFFSET) + c * header().capacity;
+    }
+};
+
+template<class Field>
+PreprocessingStore<Field>::PreprocessingStore(std::string dir, int n_players, int threshold, int party):
+    dir(dir), n_players(n_players), threshold(threshold), party(party)
+{
+    mkdir(dir.c_str(), 0755);
+}
+
+template<class Field>
+std::string PreprocessingStore<Field>::path(const std::string &name) const
+{
+    return dir + "/" + Field::NAME + "-n" + to_string(n_players) + "-t" + to_string(threshold)
+            + "-P" + to_string(party) + "-" + name + ".prep";
+}
+
+// The file should be produced for the same field, parties and material.
+template<class Field>
+void PreprocessingStore<Field>::check_header(const PreprocessingHeader &header, const std::string &fn, size_t n_columns) const
+{
+    if(memcmp(header.magic, PREPROCESSING_MAGIC, sizeof(PREPROCESSING_MAGIC)) || header.version != VERSION
+        || header.field_bytes != sizeof(typename Field::TYPE) || header.prime != (uint64_t)Field::PR
+        || header.n_players != (uint32_t)n_players || header.threshold != (uint32_t)threshold
+        || header.party != (uint32_t)party || header.n_columns != n_columns
+        || header.cursor > header.capacity || header.width == 0){
+        throw signature_mismatch(fn);
+    }
+}
+
+template<class Field>
+size_t PreprocessingStore<Field>::available(const std::string &name) const
+{
+    std::string fn = path(name);
+    if(access(fn.c_str(), F_OK)){return 0;}
+    MappedFile file(fn, false);
+    return file.header().capacity - file.header().cursor;
+}
+
+/**
+ * @brief Move all the unused tuples of the pool into the file, as the material of one more online run.
+ * The unused tuples already in the file come first, and the file is replaced atomically (rename).
+ * The file is written even if the pool is empty, so that the online run knows it needs nothing.
+ * 
+ * @param name material type
+ * @param pool [in] It is empty afterwards.
+ * @param width tuples per instance
+ */
+template<class Field>
+void PreprocessingStore<Field>::store(const std::string &name, RandomPool<Field> &pool, size_t width)
+{
+    std::string fn = path(name), tmp_fn = fn + ".tmp";
+    size_t n_columns = pool.n_columns();
+    size_t n_new = pool.size();
+    assert(width && n_new % width == 0);
+
+    unique_ptr<MappedFile> old_file;
+    size_t n_old = 0;
+    if(access(fn.c_str(), F_OK) == 0){
+        old_file.reset(new MappedFile(fn, false));
+        check_header(old_file->header(), fn, n_columns);
+        n_old = old_file->header().capacity - old_file->header().cursor;
+        if(n_new == 0){width = old_file->header().width;}
+        else if(n_old && old_file->header().width != width){throw signature_mismatch(fn);}
+    }
+
+    PreprocessingHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PREPROCESSING_MAGIC, sizeof(PREPROCESSING_MAGIC));
+    header.version = VERSION;
+    header.field_bytes = sizeof(typename Field::TYPE);
+    header.prime = Field::PR;
+    header.n_players = n_players;
+    header.threshold = threshold;
+    header.party = party;
+    header.n_columns = n_columns;
+    header.width = width;
+    header.capacity = n_old + n_new;
+    header.cursor = 0;
+    header.run_size = n_new;
+
+    ofstream out(tmp_fn, ios::binary | ios::trunc);
+    octet padding[PREPROCESSING_DATA_OFFSET] = {0};
+    memcpy(padding, &header, sizeof(header));
+    out.write((const char*)padding, PREPROCESSING_DATA_OFFSET);
+    for(size_t c = 0; c < n_columns; c++){
+        if(n_old){
+            out.write((const char*)(old_file->column<Field>(c) + old_file->header().cursor), n_old * sizeof(gfpScalar<Field>));
+        }
+        out.write((const char*)pool.column(c), n_new * sizeof(gfpScalar<Field>));
+    }
+    out.close();
+    old_file.reset();
+    if(out.fail()){throw file_error("cannot write " + tmp_fn);}
+    if(rename(tmp_fn.c_str(), fn.c_str())){throw file_error("cannot rename " + tmp_fn);}
+    pool.clear();
+}
+
+/**
+ * @brief Load the material of one online run (run_size tuples) from the cursor of the file into the pool,
+ * and advance the persistent cursor.
+ * 
+ * @param name material type
+ * @param pool [out]
+ * @return number of tuples loaded
+ */
+template<class Field>
+size_t PreprocessingStore<Field>::load(const std::string &name, RandomPool<Field> &pool)
+{
+    std::string fn = path(name);
+    MappedFile file(fn, true);
+    PreprocessingHeader &header = file.header();
+    check_header(header, fn, pool.n_columns());
+    if(file.length < PREPROCESSING_DATA_OFFSET + header.n_columns * header.capacity * sizeof(gfpScalar<Field>)){
+        throw signature_mismatch(fn);
+    }
+
+    size_t n_tuples = header.run_size;
+    if(header.capacity - header.cursor < n_tuples){
+        throw runtime_error("Not enough preprocessed " + name + " in " + fn + ": "
+                + to_string(header.capacity - header.cursor) + "/" + to_string(n_tuples) + ". Run the offline job again.");
+    }
+
+    const gfpScalar<Field> *src[3] = {nullptr, nullptr, nullptr};
+    for(size_t c = 0; c < header.n_columns; c++){
+        src[c] = file.column<Field>(c) + header.cursor;
+    }
+    pool.push(n_tuples, src[0], src[1], src[2]);
+
+    header.cursor += n_tuples;
+    msync(file.data, PREPROCESSING_DATA_OFFSET, MS_SYNC);
+    return n_tuples;
+}
+
+template class PreprocessingStore<PR31>;
+
+template class PreprocessingStore<PR61>;
+
+}
@@ -0,0 +1,65 @@
+#ifndef PROTOCOLS_PREPROCESSING_STORE_H_
+#define PROTOCOLS_PREPROCESSING_STORE_H_
+
+#include "Protocols/RandomPool.h"
+#include <string>
+
+namespace hmmpc
+{
+
+/**
+ * @brief Header of a preprocessing file. The file layout is
+ *      header || column 0 || ... || column n_columns-1
+ * where each column holds capacity field elements.
+ * The tuples [0, cursor) have been consumed by the previous online runs,
+ * and each online run consumes run_size tuples (the number produced by the last offline run).
+ */
+struct PreprocessingHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t field_bytes; // sizeof(TYPE)
+    uint64_t prime;
+    uint32_t n_players;
+    uint32_t threshold;
+    uint32_t party;
+    uint32_t n_columns;
+    uint64_t width; // Tuples per instance, e.g. the length of an unbounded multiplication. 1 otherwise.
+    uint64_t capacity; // Number of tuples in the file.
+    uint64_t cursor; // Number of consumed tuples.
+    uint64_t run_size; // Number of tuples consumed by one online run.
+};
+
+/**
+ * @brief Persistent on-disk store of the preprocessed random sharings of one party.
+ * Each material type is kept in its own memory-mapped file
+ *      dir/<field>-n<n_players>-t<threshold>-P<party>-<name>.prep
+ * An offline run stores the content of the RandomPool (appended to the unused tuples in the file),
+ * and each later online run loads the same number of tuples into the pool from the persistent cursor.
+ * Running the offline job k times thus prepares k online runs.
+ * A file is not meant to be used by two processes at the same time.
+ */
+template<class Field>
+class PreprocessingStore
+{
+    std::string dir;
+    int n_players;
+    int threshold;
+    int party;
+
+    void check_header(const PreprocessingHeader &header, const std::string &fn, size_t n_columns) const;
+
+public:
+    const static uint32_t VERSION = 1;
+
+    PreprocessingStore(std::string dir, int n_players, int threshold, int party);
+
+    std::string path(const std::string &name) const;
+    size_t available(const std::string &name) const; // Number of unused tuples.
+
+    void store(const std::string &name, RandomPool<Field> &pool, size_t width = 1);
+    size_t load(const std::string &name, RandomPool<Field> &pool);
+};
+
+}
+#endif
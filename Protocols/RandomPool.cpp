@@ -0,0 +1,150 @@
+#include "Protocols/RandomPool.h"
+#include <cstring>
+
+namespace hmmpc
+{
+
+template<class Field>
+RandomPool<Field>::RandomPool(size_t n_columns):
+    columns(n_columns), head(0)
+{
+    assert(n_columns >= 1 && n_columns <= 3);
+}
+
+template<class Field>
+size_t RandomPool<Field>::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return unused();
+}
+
+template<class Field>
+void RandomPool<Field>::reserve(size_t n)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto &column : columns){
+        column.reserve(head + n);
+    }
+}
+
+template<class Field>
+void RandomPool<Field>::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    clear_unlocked();
+}
+
+template<class Field>
+void RandomPool<Field>::clear_unlocked()
+{
+    for(auto &column : columns){
+        column.clear();
+    }
+    head = 0;
+}
+
+/**
+ * @brief Block until at least n tuples are unused, i.e. pushed by another thread.
+ * 
+ * @param n 
+ */
+template<class Field>
+void RandomPool<Field>::wait(size_t n)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    filled.wait(lock, [&]{return unused() >= n;});
+}
+
+/**
+ * @brief Drop the used tuples at the front.
+ * It is called before pushing once at least half of the pool has been used,
+ * so each tuple is moved at most once on average.
+ */
+template<class Field>
+void RandomPool<Field>::compact()
+{
+    if(head == 0){return;}
+    size_t n = unused();
+    for(auto &column : columns){
+        memmove(column.data(), column.data() + head, n * sizeof(gfpScalar<Field>));
+        column.resize(n);
+    }
+    head = 0;
+}
+
+/**
+ * @brief Append n tuples. The i-th tuple is (r[i], aux_r[i], sub_r[i]).
+ * One pointer should be given for each column.
+ * 
+ * @param n 
+ * @param r [in]
+ * @param aux_r [in]
+ * @param sub_r [in]
+ */
+template<class Field>
+void RandomPool<Field>::push(size_t n, const gfpScalar<Field> *r, const gfpScalar<Field> *aux_r, const gfpScalar<Field> *sub_r)
+{
+    const gfpScalar<Field> *src[3] = {r, aux_r, sub_r};
+    std::lock_guard<std::mutex> lock(mutex);
+    if(head && (head<<1) >= columns[0].size()){compact();}
+    for(size_t c = 0; c < columns.size(); c++){
+        assert(src[c] != nullptr);
+        Column &column = columns[c];
+        size_t old_size = column.size();
+        column.resize(old_size + n);
+        memcpy(column.data() + old_size, src[c], n * sizeof(gfpScalar<Field>));
+    }
+    filled.notify_all();
+}
+
+/**
+ * @brief Take the first n unused tuples.
+ * A null pointer skips the corresponding column, e.g. pop pairs from a pool of triples.
+ * 
+ * @param n 
+ * @param r [out]
+ * @param aux_r [out]
+ * @param sub_r [out]
+ */
+template<class Field>
+void RandomPool<Field>::pop(size_t n, gfpScalar<Field> *r, gfpScalar<Field> *aux_r, gfpScalar<Field> *sub_r)
+{
+    gfpScalar<Field> *dst[3] = {r, aux_r, sub_r};
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(n <= unused());
+    assert(columns.size() >= 3 || dst[columns.size()] == nullptr);
+    for(size_t c = 0; c < columns.size(); c++){
+        if(dst[c] != nullptr){
+            memcpy(dst[c], columns[c].data() + head, n * sizeof(gfpScalar<Field>));
+        }
+    }
+    head += n;
+    if(head == columns[0].size()){clear_unlocked();}
+}
+
+/**
+ * @brief Move the first n unused tuples to the end of dst, which has the same number of columns.
+ * 
+ * @param dst 
+ * @param n 
+ */
+template<class Field>
+void RandomPool<Field>::move_to(RandomPool<Field> &dst, size_t n)
+{
+    assert(&dst != this && dst.n_columns() == n_columns());
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(n <= unused());
+    const gfpScalar<Field> *src[3] = {nullptr, nullptr, nullptr};
+    for(size_t c = 0; c < columns.size(); c++){
+        src[c] = columns[c].data() + head;
+    }
+    dst.push(n, src[0], src[1], src[2]);
+    head += n;
+    if(head == columns[0].size()){clear_unlocked();}
+}
+
+template class RandomPool<PR31>;
+
+template class RandomPool<PR61>;
+
+}
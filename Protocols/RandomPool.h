@@ -0,0 +1,55 @@
+#ifndef PROTOCOLS_RANDOM_POOL_H_
+#define PROTOCOLS_RANDOM_POOL_H_
+
+#include "Math/gfpMatrix.h"
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+namespace hmmpc
+{
+
+/**
+ * @brief Pool of the preprocessed random sharings.
+ * Each entry is a tuple of n_columns sharings, e.g. ([r]_t, [r]_2t) or ([r/2^d]_t, [r]_t, [r_msb]_t).
+ * The tuples are stored in struct-of-arrays: column c holds the c-th sharing of every tuple contiguously,
+ * so the sharings are pushed and popped in bulk (memcpy) in FIFO order.
+ * 
+ * Column 0 is r, column 1 is aux_r and column 2 is sub_r.
+ * 
+ * The pool is filled by a PreprocessingProducer thread while the online thread consumes it,
+ * so every access is guarded by a mutex and wait() blocks until enough tuples arrive.
+ */
+template<class Field>
+class RandomPool
+{
+    typedef std::vector<gfpScalar<Field>, Eigen::aligned_allocator<gfpScalar<Field>>> Column;
+
+    std::vector<Column> columns;
+    size_t head; // The first unused tuple.
+
+    mutable std::mutex mutex;
+    std::condition_variable filled;
+
+    size_t unused() const {return columns[0].size() - head;}
+    void compact();
+    void clear_unlocked();
+
+public:
+    RandomPool(size_t n_columns = 1);
+
+    size_t n_columns() const {return columns.size();}
+    size_t size() const; // Number of unused tuples.
+    bool empty() const {return size()==0;}
+    const gfpScalar<Field>* column(size_t c) const {return columns[c].data() + head;} // Unused sharings of column c (single thread only).
+    void reserve(size_t n);
+    void clear();
+    void wait(size_t n); // Block until at least n tuples are unused.
+
+    void push(size_t n, const gfpScalar<Field> *r, const gfpScalar<Field> *aux_r = nullptr, const gfpScalar<Field> *sub_r = nullptr);
+    void pop(size_t n, gfpScalar<Field> *r, gfpScalar<Field> *aux_r = nullptr, gfpScalar<Field> *sub_r = nullptr);
+    void move_to(RandomPool<Field> &dst, size_t n);
+};
+
+}
+#endif
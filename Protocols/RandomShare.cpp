@@ -6,38 +6,34 @@ using Eigen::seq, Eigen::seqN, Eigen::last;
 namespace hmmpc
 {
 
-// The queue store the preprocessed random share, which is nothing to do with the input of the party.
-queue<gfpScalar> RandomShare::queueRandom; // [r]_t
-queue<gfpScalar> RandomShare::queueRandomBit;
-
-queue<gfpScalar> DoubleRandom::queueReducedRandom; // [r]_t, [r]_2t
-queue<gfpScalar> DoubleRandom::queueTruncatedRandom; // [r/2^d]_t, [r]_t
-queue<gfpScalar> DoubleRandom::queueReducedTruncatedRandom; // [r/2^d]_t, [r]_2t
-queue<gfpScalar> DoubleRandom::queueUnboundedMultRandom; // ([b1], [b1^-1]), ([bi], [bi-1 * bi^-1]) for i = 2, ..., l. 
-queue<gfpScalar> DoubleRandom::queueTruncatedRandomInML;
-queue<gfpScalar> DoubleRandom::queueReducedTruncatedInML;
-queue<gfpScalar> DoubleRandom::queueReducedTruncatedWithPrecisionRandom;
+// The pools store the preprocessed random share, which is nothing to do with the input of the party.
+// Each thread has its own pools, e.g. the producer thread generates in its pools and moves the tuples to the online thread.
+template<class Field> thread_local RandomPool<Field> RandomShare<Field>::queueRandom(1); // [r]_t
+template<class Field> thread_local RandomPool<Field> RandomShare<Field>::queueRandomBit(1);
+
+template<class Field> thread_local RandomPool<Field> DoubleRandom<Field>::queueReducedRandom(2); // [r]_t, [r]_2t
+template<class Field> thread_local RandomPool<Field> DoubleRandom<Field>::queueTruncatedRandom(3); // [r/2^d]_t, [r]_t, [r_msb]_t
+template<class Field> thread_local RandomPool<Field> DoubleRandom<Field>::queueReducedTruncatedRandom(3); // [r/2^d]_t, [r]_2t, [r_msb]_t
+template<class Field> thread_local RandomPool<Field> DoubleRandom<Field>::queueUnboundedMultRandom(2); // ([b1], [b1^-1]), ([bi], [bi-1 * bi^-1]) for i = 2, ..., l. 
+template<class Field> thread_local RandomPool<Field> DoubleRandom<Field>::queueTruncatedRandomInML(2);
+template<class Field> thread_local RandomPool<Field> DoubleRandom<Field>::queueReducedTruncatedInML(2);
+template<class Field> thread_local RandomPool<Field> DoubleRandom<Field>::queueReducedTruncatedWithPrecisionRandom(2);
 /************************************************************************
  * 
  *       Definition of static member functions about RandomShare
  * 
  * **********************************************************************/
-void RandomShare::get_random(queue<gfpScalar> &Q, gfpScalar &res)
+template<class Field>
+void RandomShare<Field>::get_random(RandomPool<Field> &Q, gfpScalar<Field> &res)
 {
-    assert(Q.size()>0);
-    res = Q.front();
-    Q.pop();
+    Q.pop(1, &res);
     return;
 }
 
-void RandomShare::get_randoms(queue<gfpScalar> &Q, gfpMatrix &res)
+template<class Field>
+void RandomShare<Field>::get_randoms(RandomPool<Field> &Q, gfpMatrix<Field> &res)
 {
-    size_t num = res.rows()*res.cols();
-    assert(num <= Q.size());
-    for(size_t i = 0; i < num; i++){
-        res(i) = Q.front();
-        Q.pop();
-    }
+    Q.pop(res.size(), res.data());
     return;
 }
 
@@ -47,13 +43,14 @@ void RandomShare::get_randoms(queue<gfpScalar> &Q, gfpMatrix &res)
  * 
  * @param num 
  */
-void RandomShare::generate_random_sharings(size_t num)
+template<class Field>
+void RandomShare<Field>::generate_random_sharings(size_t num)
 {
     size_t bundle_size = bundles(num); // ceil( num / (n_player - threshold ))
 
-    ShareBundle crude_inputs(n_players, bundle_size);// Each row corresponds the input of one party.
+    ShareBundle<Field> crude_inputs(n_players, bundle_size);// Each row corresponds the input of one party.
     // Input random sharing respectively from each party.
-    vector<ShareBundle> individual_input(n_players);
+    vector<ShareBundle<Field>> individual_input(n_players);
     octetStreams os_send(n_players), os_receive(n_players);
     for(size_t i = 0; i < n_players; i++){
         individual_input[i].resize(1, bundle_size);
@@ -71,10 +68,8 @@ void RandomShare::generate_random_sharings(size_t num)
     }
     
     // Use vandermonde matrix to extract randomness.
-    gfpMatrix extracted_random = vandermonde_n_t.transpose()*crude_inputs.shares;
-    for(size_t i = 0; i < extracted_random.size(); i++){
-        queueRandom.push(extracted_random(i));
-    }
+    gfpMatrix<Field> extracted_random = vandermonde_n_t.transpose()*crude_inputs.shares;
+    queueRandom.push(extracted_random.size(), extracted_random.data());
 }
 
 
@@ -83,19 +78,20 @@ void RandomShare::generate_random_sharings(size_t num)
  * 
  * @param num 
  */
-void RandomShare::generate_random_bits(size_t num)
+template<class Field>
+void RandomShare<Field>::generate_random_bits(size_t num)
 {
-    ShareBundle R(num, 1);
+    ShareBundle<Field> R(num, 1);
     R.random();
-    gfpMatrix &r = R.shares;
+    gfpMatrix<Field> &r = R.shares;
     
-    ShareBundle r_square(num, 1);
-    r_square.shares = square(r.array()); // *BUG LOG: We cannot use r.array().square() since we still use the origin r.
+    ShareBundle<Field> r_square(num, 1);
+    cwise_mul(r, r, r_square.shares); // *BUG LOG: We cannot use r.array().square() since we still use the origin r.
     
     // TODO: Modify with peusodo-random sharing of zero. 
     // In temporary, we use this unsecure operation but with the same complexity. (since PRSZ costs free)
     r_square.double_degree();
-    gfpMatrix s = r_square.reveal();
+    gfpMatrix<Field> s = r_square.reveal();
 
     // r_square.reduce_degree(); // * BUG LOG: Remember to reduce degree when multiplying two shares of degree t. 
     // gfpMatrix s = r_square.reveal();
@@ -106,30 +102,32 @@ void RandomShare::generate_random_bits(size_t num)
     }
     
     // gfpMatrix r_prime = s.array().rsqrt();
-    // Use Batch Inversion in rsqrt
-    gfpMatrix r_sqrt = s.array().sqrt();
-    gfpMatrix r_prime(r_sqrt.rows(), r_sqrt.cols());
-    batch_inversion(r_sqrt, r_prime);
-
-    gfpMatrix res = ((r.array() * r_prime.array() ) + 1)/2;
-    for(size_t i = 0; i < num; i++){
-        queueRandomBit.push(res(i));
-    }
+    // Use the addition chain of sqrt and Batch Inversion in rsqrt
+    gfpMatrix<Field> r_prime;
+    cwise_rsqrt(s, r_prime);
+
+    // res = (r/sqrt(r^2) + 1)/2
+    gfpMatrix<Field> res;
+    cwise_mul(r, r_prime, res);
+    cwise_add_const(res, gfpScalar<Field>(1), res);
+    cwise_mul_const(res, gfpScalar<Field>(Field::ConstTwoInverse), res);
+    queueRandomBit.push(num, res.data());
     
     return;
 }
 
 // Replace with input_from_random_
-void RandomShare::generate_random_sharings_PRG(size_t num)
+template<class Field>
+void RandomShare<Field>::generate_random_sharings_PRG(size_t num)
 {
     size_t bundle_size = bundles(num); // ceil( num / (n_player - threshold ))
 
-    ShareBundle crude_inputs(n_players, bundle_size);// Each row corresponds the input of one party.
+    ShareBundle<Field> crude_inputs(n_players, bundle_size);// Each row corresponds the input of one party.
     
     // Input random sharing respectively from each party.
-    vector<ShareBundle> individual_input(n_players);
+    vector<ShareBundle<Field>> individual_input(n_players);
     octetStreams os_send(n_party_PRG()), os_receive(n_players);
-    vector<gfpMatrix> shares_prng(n_players);
+    vector<gfpMatrix<Field>> shares_prng(n_players);
 
     for(int i = 0; i < n_players; i++){
         individual_input[i].resize(1, bundle_size);
@@ -147,10 +145,8 @@ void RandomShare::generate_random_sharings_PRG(size_t num)
     }
 
     // Use vandermonde matrix to extract randomness.
-    gfpMatrix extracted_random = vandermonde_n_t.transpose()*crude_inputs.shares;
-    for(size_t i = 0; i < extracted_random.size(); i++){
-        queueRandom.push(extracted_random(i));
-    }
+    gfpMatrix<Field> extracted_random = vandermonde_n_t.transpose()*crude_inputs.shares;
+    queueRandom.push(extracted_random.size(), extracted_random.data());
     return;
 }
 
@@ -160,52 +156,34 @@ void RandomShare::generate_random_sharings_PRG(size_t num)
  * 
  * **********************************************************************/
 
-void DoubleRandom::get_random_pair(queue<gfpScalar>&Q, gfpScalar &r, gfpScalar &aux_r)
+template<class Field>
+void DoubleRandom<Field>::get_random_pair(RandomPool<Field> &Q, gfpScalar<Field> &r, gfpScalar<Field> &aux_r)
 {
-    assert(Q.size()>=2);
-    r = Q.front();
-    Q.pop();
-    aux_r = Q.front();
-    Q.pop();
+    Q.pop(1, &r, &aux_r);
     return;
 }
 
 
-void DoubleRandom::get_random_pairs(queue<gfpScalar>&Q, gfpMatrix &r, gfpMatrix &aux_r)
+template<class Field>
+void DoubleRandom<Field>::get_random_pairs(RandomPool<Field> &Q, gfpMatrix<Field> &r, gfpMatrix<Field> &aux_r)
 {
-    assert(r.size()*2 <= Q.size());
-    for(size_t i = 0; i < r.size(); i++){
-        r(i) = Q.front();
-        Q.pop();
-        aux_r(i) = Q.front();
-        Q.pop();
-    }
+    assert(r.size() == aux_r.size());
+    Q.pop(r.size(), r.data(), aux_r.data());
     return;
 }
 
-void DoubleRandom::get_random_triple(queue<gfpScalar>&Q, gfpScalar &r, gfpScalar &aux_r, gfpScalar &sub_r)
+template<class Field>
+void DoubleRandom<Field>::get_random_triple(RandomPool<Field> &Q, gfpScalar<Field> &r, gfpScalar<Field> &aux_r, gfpScalar<Field> &sub_r)
 {
-    assert(Q.size()>=3);
-    r = Q.front();
-    Q.pop();
-    aux_r = Q.front();
-    Q.pop();
-    sub_r = Q.front();
-    Q.pop();
+    Q.pop(1, &r, &aux_r, &sub_r);
     return;
 }
 
-void DoubleRandom::get_random_triples(queue<gfpScalar> &Q, gfpMatrix &r, gfpMatrix &aux_r, gfpMatrix &sub_r)
+template<class Field>
+void DoubleRandom<Field>::get_random_triples(RandomPool<Field> &Q, gfpMatrix<Field> &r, gfpMatrix<Field> &aux_r, gfpMatrix<Field> &sub_r)
 {
-    assert(r.size()*3 <= Q.size());
-    for(size_t i = 0; i < r.size(); i++){
-        r(i) = Q.front();
-        Q.pop();
-        aux_r(i) = Q.front();
-        Q.pop();
-        sub_r(i) = Q.front();
-        Q.pop();
-    }
+    assert(r.size() == aux_r.size() && r.size() == sub_r.size());
+    Q.pop(r.size(), r.data(), aux_r.data(), sub_r.data());
     return;
 }
 /**********************************************************
@@ -218,12 +196,13 @@ void DoubleRandom::get_random_triples(queue<gfpScalar> &Q, gfpMatrix &r, gfpMatr
  * 
  * @param num 
  */
-void DoubleRandom::generate_reduced_random_sharings(size_t num)
+template<class Field>
+void DoubleRandom<Field>::generate_reduced_random_sharings(size_t num)
 {
     size_t bundle_size = bundles(num);
-    DoubleShareBundle crude_inputs(n_players, bundle_size); // Each row corresponds to one party's input
+    DoubleShareBundle<Field> crude_inputs(n_players, bundle_size); // Each row corresponds to one party's input
     // Input reduced random sharing respectively from each party
-    vector<DoubleShareBundle> individual_input(n_players);
+    vector<DoubleShareBundle<Field>> individual_input(n_players);
     octetStreams os_send(n_players), os_receive(n_players);
     for(size_t i = 0; i < n_players; i++){
         individual_input[i].resize(1, bundle_size);
@@ -244,38 +223,33 @@ void DoubleRandom::generate_reduced_random_sharings(size_t num)
     // *Original matrix multiplication
     // gfpMatrix extracted_t_random = vandermonde_n_t.transpose() * crude_inputs.shares;
     // gfpMatrix extracted_2t_random = vandermonde_n_t.transpose() * crude_inputs.aux_shares; 
-    // for(size_t i = 0; i < extracted_t_random.size(); i++){
-    //     queueReducedRandom.push(extracted_t_random(i));
-    //     queueReducedRandom.push(extracted_2t_random(i));
-    // }
+    // queueReducedRandom.push(extracted_t_random.size(), extracted_t_random.data(), extracted_2t_random.data());
 
 
     // Use vandermonde matrix to extract randomness
     // We incorporate two matrix multiplication into one matrix multiplication.
-    gfpMatrix extracted_random = vandermonde_n_t.transpose() * 
-        (gfpMatrix(n_players, bundle_size<<1)<<crude_inputs.shares, crude_inputs.aux_shares).finished();
+    gfpMatrix<Field> extracted_random = vandermonde_n_t.transpose() * 
+        (gfpMatrix<Field>(n_players, bundle_size<<1)<<crude_inputs.shares, crude_inputs.aux_shares).finished();
     
     for(size_t i = 0; i < extracted_random.rows(); i++){
-        // j indicates the t-sharing and k indicates the 2t-sharing
-        for(size_t j = 0, k = bundle_size; k < extracted_random.cols(); j++, k++){
-            queueReducedRandom.push(extracted_random(i, j));
-            queueReducedRandom.push(extracted_random(i, k));
-        }
+        // The left half is the t-sharings and the right half is the 2t-sharings.
+        queueReducedRandom.push(bundle_size, &extracted_random(i, 0), &extracted_random(i, bundle_size));
     }
     
 }
 
 // Replace with input_from_random_request_PRG.
-void DoubleRandom::generate_reduced_random_sharings_PRG(size_t num)
+template<class Field>
+void DoubleRandom<Field>::generate_reduced_random_sharings_PRG(size_t num)
 {
     size_t bundle_size = bundles(num);
-    DoubleShareBundle crude_inputs(n_players, bundle_size); // Each row corresponds to one party's input
+    DoubleShareBundle<Field> crude_inputs(n_players, bundle_size); // Each row corresponds to one party's input
     // Input reduced random sharing respectively from each party
 
     // * The part that is replaced.
-    vector<DoubleShareBundle> individual_input(n_players);
+    vector<DoubleShareBundle<Field>> individual_input(n_players);
     octetStreams os_send(n_players), os_receive(n_players);
-    vector<gfpMatrix>shares_prng(n_players);
+    vector<gfpMatrix<Field>>shares_prng(n_players);
 
     for(int i = 0; i < n_players; i++){
         individual_input[i].resize(1, bundle_size);
@@ -294,31 +268,29 @@ void DoubleRandom::generate_reduced_random_sharings_PRG(size_t num)
     }
     // *
 
-    gfpMatrix extracted_random = vandermonde_n_t.transpose() * 
-        (gfpMatrix(n_players, bundle_size<<1)<<crude_inputs.shares, crude_inputs.aux_shares).finished();
+    gfpMatrix<Field> extracted_random = vandermonde_n_t.transpose() * 
+        (gfpMatrix<Field>(n_players, bundle_size<<1)<<crude_inputs.shares, crude_inputs.aux_shares).finished();
     
     for(size_t i = 0; i < extracted_random.rows(); i++){
-        // j indicates the t-sharing and k indicates the 2t-sharing
-        for(size_t j = 0, k = bundle_size; k < extracted_random.cols(); j++, k++){
-            queueReducedRandom.push(extracted_random(i, j));
-            queueReducedRandom.push(extracted_random(i, k));
-        }
+        // The left half is the t-sharings and the right half is the 2t-sharings.
+        queueReducedRandom.push(bundle_size, &extracted_random(i, 0), &extracted_random(i, bundle_size));
     }
 }
 
 /**********************************************************
  * *      Truncated Random Sharings - ( [r/2^d]_t, [r]_t , [r_{msb}]_t)
  * *********************************************************/
-void DoubleRandom::generate_truncated_random_sharings(size_t num)
+template<class Field>
+void DoubleRandom<Field>::generate_truncated_random_sharings(size_t num)
 {
-    BitBundle bits(num, BITS_LENGTH);
+    BitBundle<Field> bits(num, Field::BITS_LENGTH);
     bits.random();
     
-    gfpMatrix trunc_bits(num, BITS_LENGTH);
-    trunc_bits.leftCols(INT_PRECISION) = bits.shares.rightCols(INT_PRECISION);
-    for(size_t i = INT_PRECISION; i < BITS_LENGTH; i++){
+    gfpMatrix<Field> trunc_bits(num, Field::BITS_LENGTH);
+    trunc_bits.leftCols(Field::INT_PRECISION) = bits.shares.rightCols(Field::INT_PRECISION);
+    for(size_t i = Field::INT_PRECISION; i < Field::BITS_LENGTH; i++){
         // Fill the empty bits with the MSB of the original bits
-        trunc_bits.col(i) = bits.shares.col(BITS_LENGTH - 1);
+        trunc_bits.col(i) = bits.shares.col(Field::BITS_LENGTH - 1);
     }
 
     // *Original matrix multiplication
@@ -326,113 +298,102 @@ void DoubleRandom::generate_truncated_random_sharings(size_t num)
     // gfpMatrix res_trunc = trunc_bits * bits_coeff; 
 
     // We incorporate two matrix multiplication into one matrix multiplication.
-    gfpMatrix res = (gfpMatrix(num<<1, BITS_LENGTH)<< trunc_bits, bits.shares).finished() * bits_coeff;
-    for(size_t i = 0, j = num; i < num; i++, j++){
-        queueTruncatedRandom.push(res(i));
-        queueTruncatedRandom.push(res(j));
-        queueTruncatedRandom.push(bits.shares(i, BITS_LENGTH-1));// msb
-    }
+    gfpMatrix<Field> res = (gfpMatrix<Field>(num<<1, Field::BITS_LENGTH)<< trunc_bits, bits.shares).finished() * bits_coeff;
+    gfpVector<Field> msb = bits.shares.col(Field::BITS_LENGTH-1);
+    queueTruncatedRandom.push(num, res.data(), res.data() + num, msb.data());
 }
 
 // Truncate with specific precision
-void DoubleRandom::generate_truncated_random_sharings(size_t num, size_t precision)
+template<class Field>
+void DoubleRandom<Field>::generate_truncated_random_sharings(size_t num, size_t precision)
 {
-    BitBundle bits(num, BITS_LENGTH);
+    BitBundle<Field> bits(num, Field::BITS_LENGTH);
     bits.random();
     
-    size_t int_precision = BITS_LENGTH - precision;
-    gfpMatrix trunc_bits(num, BITS_LENGTH);
+    size_t int_precision = Field::BITS_LENGTH - precision;
+    gfpMatrix<Field> trunc_bits(num, Field::BITS_LENGTH);
     trunc_bits.leftCols(int_precision) = bits.shares.rightCols(int_precision);
-    for(size_t i = int_precision; i < BITS_LENGTH; i++){
+    for(size_t i = int_precision; i < Field::BITS_LENGTH; i++){
         // Fill the empty bits with the MSB of the original bits
-        trunc_bits.col(i) = bits.shares.col(BITS_LENGTH - 1);
+        trunc_bits.col(i) = bits.shares.col(Field::BITS_LENGTH - 1);
     }
 
     // We incorporate two matrix multiplication into one matrix multiplication.
-    gfpMatrix res = (gfpMatrix(num<<1, BITS_LENGTH)<< trunc_bits, bits.shares).finished() * bits_coeff;
-    for(size_t i = 0, j = num; i < num; i++, j++){
-        queueTruncatedRandomInML.push(res(i));
-        queueTruncatedRandomInML.push(res(j));
-    }
+    gfpMatrix<Field> res = (gfpMatrix<Field>(num<<1, Field::BITS_LENGTH)<< trunc_bits, bits.shares).finished() * bits_coeff;
+    queueTruncatedRandomInML.push(num, res.data(), res.data() + num);
 }
 
 
 /**********************************************************************
  * *      Reduced Truncated Random Sharings - ( [r/2^d]_t, [r]_2t , [r_msb]_t)
  * *********************************************************************/
-void DoubleRandom::generate_reduced_truncated_random_sharings(size_t num)
+template<class Field>
+void DoubleRandom<Field>::generate_reduced_truncated_random_sharings(size_t num)
 {
-    BitBundle bitsBundle(num, BITS_LENGTH);
+    BitBundle<Field> bitsBundle(num, Field::BITS_LENGTH);
     bitsBundle.random();
-    gfpMatrix &bits = bitsBundle.shares;
-    gfpMatrix trunc_bits(num, BITS_LENGTH);
-    trunc_bits.leftCols(INT_PRECISION) = bits.rightCols(INT_PRECISION);
-    for(size_t i = INT_PRECISION; i < BITS_LENGTH; i++){
+    gfpMatrix<Field> &bits = bitsBundle.shares;
+    gfpMatrix<Field> trunc_bits(num, Field::BITS_LENGTH);
+    trunc_bits.leftCols(Field::INT_PRECISION) = bits.rightCols(Field::INT_PRECISION);
+    for(size_t i = Field::INT_PRECISION; i < Field::BITS_LENGTH; i++){
         // Fill the empty bits with the MSB of the original bits
-        trunc_bits.col(i) = bits.col(BITS_LENGTH - 1);
+        trunc_bits.col(i) = bits.col(Field::BITS_LENGTH - 1);
     }
     bits.array().square(); // Each bit turns to 2t-sharing
-    gfpMatrix res = (gfpMatrix(num<<1, BITS_LENGTH)<< trunc_bits, bits).finished() * bits_coeff;
+    gfpMatrix<Field> res = (gfpMatrix<Field>(num<<1, Field::BITS_LENGTH)<< trunc_bits, bits).finished() * bits_coeff;
 
-    for(size_t i = 0, j = num; i < num; i++, j++){
-        queueReducedTruncatedRandom.push(res(i));
-        queueReducedTruncatedRandom.push(res(j));
-        queueReducedTruncatedRandom.push(trunc_bits(i, BITS_LENGTH-1));// msb
-    }
+    gfpVector<Field> msb = trunc_bits.col(Field::BITS_LENGTH-1);
+    queueReducedTruncatedRandom.push(num, res.data(), res.data() + num, msb.data());
 }
 
-void DoubleRandom::generate_reduced_truncated_random_sharings(queue<gfpScalar> &Q, size_t num, size_t precision)
+template<class Field>
+void DoubleRandom<Field>::generate_reduced_truncated_random_sharings(RandomPool<Field> &Q, size_t num, size_t precision)
 {
-    BitBundle R(num, BITS_LENGTH);
+    BitBundle<Field> R(num, Field::BITS_LENGTH);
     R.random();
-    gfpMatrix &bits = R.shares;
+    gfpMatrix<Field> &bits = R.shares;
 
-    gfpMatrix trunc_bits(num, BITS_LENGTH);
-    size_t int_precision = BITS_LENGTH - precision;
+    gfpMatrix<Field> trunc_bits(num, Field::BITS_LENGTH);
+    size_t int_precision = Field::BITS_LENGTH - precision;
     trunc_bits.leftCols(int_precision) = bits.rightCols(int_precision);
-    for(size_t i = int_precision; i < BITS_LENGTH; i++){
+    for(size_t i = int_precision; i < Field::BITS_LENGTH; i++){
         // Fill the empty bits with the MSB of the original bits
-        trunc_bits.col(i) = bits.col(BITS_LENGTH - 1);
+        trunc_bits.col(i) = bits.col(Field::BITS_LENGTH - 1);
     }
 
     bits.array().square(); // Each bit turns to 2t-sharing
-    gfpMatrix res = (gfpMatrix(num<<1, BITS_LENGTH)<< trunc_bits, bits).finished() * bits_coeff;
+    gfpMatrix<Field> res = (gfpMatrix<Field>(num<<1, Field::BITS_LENGTH)<< trunc_bits, bits).finished() * bits_coeff;
 
-    for(size_t i = 0, j = num; i < num; i++, j++){
-        Q.push(res(i));
-        Q.push(res(j));
-    }
+    Q.push(num, res.data(), res.data() + num);
 }
 
 // Generate reduced and truncated random sharings with different precision.
 // num_repetitions: the number of repetitions
-void DoubleRandom::generate_reduced_truncated_random_sharings(queue<gfpScalar> &Q, size_t num, vector<size_t> &precision, size_t num_repetitions)
+template<class Field>
+void DoubleRandom<Field>::generate_reduced_truncated_random_sharings(RandomPool<Field> &Q, size_t num, vector<size_t> &precision, size_t num_repetitions)
 {
     size_t total = num*num_repetitions;
-    BitBundle R(total, BITS_LENGTH);
+    BitBundle<Field> R(total, Field::BITS_LENGTH);
     R.random();
-    gfpMatrix &bits = R.shares;
+    gfpMatrix<Field> &bits = R.shares;
 
-    gfpMatrix trunc_bits(total, BITS_LENGTH);
+    gfpMatrix<Field> trunc_bits(total, Field::BITS_LENGTH);
     vector<size_t> int_precision;
     for(size_t i = 0; i < num_repetitions; i++){
         for(size_t j = 0; j < num; j++){
-            int_precision.push_back(BITS_LENGTH - precision[j]);
+            int_precision.push_back(Field::BITS_LENGTH - precision[j]);
         }
     }
 
     for(size_t i = 0; i < total; i++){
         trunc_bits.row(i).leftCols(int_precision[i]) = bits.row(i).rightCols(int_precision[i]);
-        trunc_bits.row(i).rightCols(BITS_LENGTH - int_precision[i]).setConstant(bits(i, BITS_LENGTH-1));
+        trunc_bits.row(i).rightCols(Field::BITS_LENGTH - int_precision[i]).setConstant(bits(i, Field::BITS_LENGTH-1));
     }
 
     bits.array().square(); // Each bit turns to 2t-sharing
-    gfpMatrix res = (gfpMatrix(total<<1, BITS_LENGTH)<< trunc_bits, bits).finished() * bits_coeff;
+    gfpMatrix<Field> res = (gfpMatrix<Field>(total<<1, Field::BITS_LENGTH)<< trunc_bits, bits).finished() * bits_coeff;
 
-    for(size_t i = 0, j = total; i < total; i++, j++){
-        Q.push(res(i));
-        Q.push(res(j));
-    }
+    Q.push(total, res.data(), res.data() + total);
 }
 
 
@@ -447,12 +408,13 @@ void DoubleRandom::generate_reduced_truncated_random_sharings(queue<gfpScalar> &
  * *********************************************************************/
 // One unbounded-mult instance.
 // The following is unbounded multiplication in parallel, which is more practical.
-void DoubleRandom::generate_unbounded_random_sharings(size_t num)
+template<class Field>
+void DoubleRandom<Field>::generate_unbounded_random_sharings(size_t num)
 {
-    ShareBundle R(num, 2);
+    ShareBundle<Field> R(num, 2);
     R.random();
-    gfpMatrix &b_bPrime = R.shares;
-    gfpMatrix tmp_b_bPrime(num+num-1, 2); // (bi, bi')
+    gfpMatrix<Field> &b_bPrime = R.shares;
+    gfpMatrix<Field> tmp_b_bPrime(num+num-1, 2); // (bi, bi')
     
     tmp_b_bPrime(seqN(0, num), seq(0, last)) = b_bPrime;
     tmp_b_bPrime.col(0)(seqN(num, num-1)) = b_bPrime.col(0)(seqN(0, num-1));
@@ -460,38 +422,37 @@ void DoubleRandom::generate_unbounded_random_sharings(size_t num)
     // tmp_b_bPrime(seqN(num, num-1), seq(0, 0)) = b_bPrime(seqN(0, num-1), seq(0, 0));
     // tmp_b_bPrime(seqN(num, num-1), seq(1, 1)) = b_bPrime(seqN(1, num-1), seq(1, 1));
     
-    ShareBundle prod(num+num-1, 1);
+    ShareBundle<Field> prod(num+num-1, 1);
     prod.shares = tmp_b_bPrime.col(0).array() * tmp_b_bPrime.col(1).array();
     prod.reduce_degree();
 
-    ShareBundle B(num, 1);// Bi = bi * bi'
+    ShareBundle<Field> B(num, 1);// Bi = bi * bi'
     B.shares = prod.shares(seqN(0, num), seq(0, last));
     B.reveal();
 
     // gfpMatrix B_inv = B.secret().array().inverse(); // B_inv 
     // *Use Batch Inversion
-    gfpMatrix B_inv(B.rows(), B.cols());
+    gfpMatrix<Field> B_inv(B.rows(), B.cols());
     batch_inversion(B.secret(), B_inv);
 
-    gfpVector prod_b(num);
+    gfpVector<Field> prod_b(num);
     prod_b(0) = b_bPrime(0, 1); // b0'
     prod_b(seqN(1, num-1)) = prod.shares(seqN(num, num-1), seqN(0, 1));
 
-    gfpVector res = B_inv.array() * prod_b.array();
-    for(size_t i = 0; i < num; i++){
-        queueUnboundedMultRandom.push(b_bPrime(i, 0));
-        queueUnboundedMultRandom.push(res(i));
-    }
+    gfpVector<Field> res = B_inv.array() * prod_b.array();
+    gfpVector<Field> b = b_bPrime.col(0);
+    queueUnboundedMultRandom.push(num, b.data(), res.data());
 }
 
 // Each row corresponds to an unbounded multiplication instance.
-void DoubleRandom::generate_unbounded_random_sharings(size_t xSize, size_t ySize)
+template<class Field>
+void DoubleRandom<Field>::generate_unbounded_random_sharings(size_t xSize, size_t ySize)
 {
-    ShareBundle R(xSize<<1, ySize);
+    ShareBundle<Field> R(xSize<<1, ySize);
     R.random();
-    gfpMatrix &rand = R.shares;
+    gfpMatrix<Field> &rand = R.shares;
 
-    gfpMatrix rand_b(xSize, ySize+ySize-1), rand_b_prime(xSize, ySize+ySize-1);
+    gfpMatrix<Field> rand_b(xSize, ySize+ySize-1), rand_b_prime(xSize, ySize+ySize-1);
 
     // rand_b = b | b
     // rand_b = b'| b'
@@ -500,33 +461,35 @@ void DoubleRandom::generate_unbounded_random_sharings(size_t xSize, size_t ySize
     rand_b_prime(seqN(0, xSize), seqN(0, ySize)) = rand(seqN(xSize, xSize), seqN(0, ySize));
     rand_b_prime(seqN(0, xSize), seqN(ySize, ySize-1)) = rand(seqN(xSize, xSize), seqN(1, ySize-1));
 
-    ShareBundle prod(xSize, ySize+ySize-1);
+    ShareBundle<Field> prod(xSize, ySize+ySize-1);
     prod.shares = rand_b.array() * rand_b_prime.array();
     prod.reduce_degree();
 
-    ShareBundle B(xSize, ySize); // B = mult_cwise(b, b')
+    ShareBundle<Field> B(xSize, ySize); // B = mult_cwise(b, b')
     B.shares = prod.shares(seqN(0, xSize), seqN(0, ySize));
     B.reveal();
     // gfpMatrix B_inv =  B.secret().array().inverse(); // B_inv //TODO: Evaluate the ex_gcd and pow to implement inverse. 
                                                     // BUG LOG: inverse() dose not return the reference.
     // *Use Batch Inversion
-    gfpMatrix B_inv(B.rows(), B.cols());
+    gfpMatrix<Field> B_inv(B.rows(), B.cols());
     batch_inversion(B.secret(), B_inv);
 
-    gfpMatrix X(xSize, ySize);
+    gfpMatrix<Field> X(xSize, ySize);
     X.col(0) = rand_b_prime.col(0); // b'
     X(seqN(0, xSize), seqN(1, ySize-1)) = prod.shares(seqN(0, xSize), seqN(ySize, ySize-1));
     
-    gfpMatrix res(xSize, ySize);
+    gfpMatrix<Field> res(xSize, ySize);
     res = B_inv.array() * X.array();
-    for(size_t i = 0; i < xSize; i++)
-        for(size_t j = 0; j < ySize; j++){
-            queueUnboundedMultRandom.push(rand_b(i, j));
-            queueUnboundedMultRandom.push(res(i, j));
-        }
+    for(size_t i = 0; i < xSize; i++){
+        queueUnboundedMultRandom.push(ySize, &rand_b(i, 0), &res(i, 0));
+    }
     return;
 }
 
+template class RandomShare<PR31>;
+template class DoubleRandom<PR31>;
 
-}
+template class RandomShare<PR61>;
+template class DoubleRandom<PR61>;
 
+}
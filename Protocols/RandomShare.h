@@ -3,69 +3,78 @@
 
 #include "Protocols/Share.h"
 #include "Protocols/ShareBundle.h"
+#include "Protocols/RandomPool.h"
 
 namespace hmmpc
 {
 
-class RandomShare: public ShareBase
+template<class Field>
+class RandomShare: public ShareBase<Field>
 {
 protected:
+    USING_SHARE_BASE(ShareBase<Field>)
+    using ShareBase<Field>::start_party_PRG; using ShareBase<Field>::n_party_PRG;
     static size_t bundles(size_t num);
 
 public:
 
-    // Queues to store the preprocessed random sharings
-    static queue<gfpScalar> queueRandom; // [r]_t
-    static queue<gfpScalar> queueRandomBit;
+    // Pools to store the preprocessed random sharings
+    static thread_local RandomPool<Field> queueRandom; // [r]_t
+    static thread_local RandomPool<Field> queueRandomBit;
 
     static void generate_random_sharings(size_t num); // Output into the queue
     static void generate_random_bits(size_t num); //Output into the queue
     
     static void generate_random_sharings_PRG(size_t num);
     
-    static void get_random(queue<gfpScalar> &Q, gfpScalar &res);
-    static void get_randoms(queue<gfpScalar> &Q, gfpMatrix &res);
+    static void get_random(RandomPool<Field> &Q, gfpScalar<Field> &res);
+    static void get_randoms(RandomPool<Field> &Q, gfpMatrix<Field> &res);
     
 };
 
-inline size_t RandomShare::bundles (size_t num)
+template<class Field>
+inline size_t RandomShare<Field>::bundles (size_t num)
 {
     size_t res = num / (n_players - threshold);
     if(num % (n_players-threshold)){res++;}
     return res;
 }
 
-class DoubleRandom: RandomShare
+template<class Field>
+class DoubleRandom: RandomShare<Field>
 {
+    USING_SHARE_BASE(RandomShare<Field>)
+    using RandomShare<Field>::start_party_PRG; using RandomShare<Field>::n_party_PRG;
+    using RandomShare<Field>::bundles; using RandomShare<Field>::queueRandom;
 public:
-    // Queue to store the preprocessed double sharings in order.
-    static queue<gfpScalar> queueReducedRandom; // [r]_t, [r]_2t
-    static queue<gfpScalar> queueTruncatedRandom; // [r/2^d]_t, [r]_t
-    static queue<gfpScalar> queueTruncatedRandomInML; // truncation: learning rate 2^-5 or 2^-7 ; batch size /2^7
-    static queue<gfpScalar> queueReducedTruncatedRandom; // [r/2^d]_t, [r]_2t
-    static queue<gfpScalar> queueReducedTruncatedInML; // reduced + truncation: 2^-d; learning rate 2^-5 or 2^-7 ; batch size /2^7
-    static queue<gfpScalar> queueUnboundedMultRandom; //([b1], [b1^-1]), ([bi], [bi-1 * bi^-1]) for i = 2, ..., l. 
+    // Pools to store the preprocessed double sharings in order.
+    static thread_local RandomPool<Field> queueReducedRandom; // [r]_t, [r]_2t
+    static thread_local RandomPool<Field> queueTruncatedRandom; // [r/2^d]_t, [r]_t, [r_msb]_t
+    static thread_local RandomPool<Field> queueTruncatedRandomInML; // truncation: learning rate 2^-5 or 2^-7 ; batch size /2^7
+    static thread_local RandomPool<Field> queueReducedTruncatedRandom; // [r/2^d]_t, [r]_2t, [r_msb]_t
+    static thread_local RandomPool<Field> queueReducedTruncatedInML; // reduced + truncation: 2^-d; learning rate 2^-5 or 2^-7 ; batch size /2^7
+    static thread_local RandomPool<Field> queueUnboundedMultRandom; //([b1], [b1^-1]), ([bi], [bi-1 * bi^-1]) for i = 2, ..., l. 
     
-    static queue<gfpScalar> queueReducedTruncatedWithPrecisionRandom; // For variable precision.
+    static thread_local RandomPool<Field> queueReducedTruncatedWithPrecisionRandom; // For variable precision.
 
     // Output into the queue
     static void generate_reduced_random_sharings(size_t num); // [r]_t, [r]_2t
     static void generate_truncated_random_sharings(size_t num); // [r/2^d]_t, [r]_t
     static void generate_truncated_random_sharings(size_t num, size_t precision);
     static void generate_reduced_truncated_random_sharings(size_t num); // [r/2^d]_t, [r]_2t
-    static void generate_reduced_truncated_random_sharings(queue<gfpScalar> &Q, size_t num, size_t precision); // [r/2^p]_t, [r]_2t
-    static void generate_reduced_truncated_random_sharings(queue<gfpScalar> &Q, size_t num, vector<size_t> &precision, size_t num_repetitions);// different precision
+    static void generate_reduced_truncated_random_sharings(RandomPool<Field> &Q, size_t num, size_t precision); // [r/2^p]_t, [r]_2t
+    static void generate_reduced_truncated_random_sharings(RandomPool<Field> &Q, size_t num, vector<size_t> &precision, size_t num_repetitions);// different precision
     
     static void generate_unbounded_random_sharings(size_t num); // ([b1], [b1^-1]), ([bi], [bi-1 * bi^-1]) for i = 2, ..., l
     static void generate_unbounded_random_sharings(size_t xSize, size_t ySize); // Each row corresponds an instance of unbounded prefix mult
 
     static void generate_reduced_random_sharings_PRG(size_t num);
 
-    static void get_random_pair(queue<gfpScalar> &Q, gfpScalar &r, gfpScalar &aux_r);
-    static void get_random_pairs(queue<gfpScalar> &Q, gfpMatrix &r, gfpMatrix &aux_r);
+    static void get_random_pair(RandomPool<Field> &Q, gfpScalar<Field> &r, gfpScalar<Field> &aux_r);
+    static void get_random_pairs(RandomPool<Field> &Q, gfpMatrix<Field> &r, gfpMatrix<Field> &aux_r);
     
-    static void get_random_triple(queue<gfpScalar>&Q, gfpScalar &r, gfpScalar &aux_r, gfpScalar &sub_r);
-    static void get_random_triples(queue<gfpScalar> &Q, gfpMatrix &r, gfpMatrix &aux_r, gfpMatrix &sub_r);
+    static void get_random_triple(RandomPool<Field> &Q, gfpScalar<Field> &r, gfpScalar<Field> &aux_r, gfpScalar<Field> &sub_r);
+    static void get_random_triples(RandomPool<Field> &Q, gfpMatrix<Field> &r, gfpMatrix<Field> &aux_r, gfpMatrix<Field> &sub_r);
 };
 
 }
@@ -12,55 +12,57 @@ namespace hmmpc
 
 // Definition of the static member
 /** Metadata **/
-int ShareBase::threshold;
-int ShareBase::n_players;
-int ShareBase::Pking = 0;
-ThreadPlayer * ShareBase::P;
-ifstream ShareBase::in;
-PhaseConfig * ShareBase::Phase;
-PRNG ShareBase::PRNG_agreed;
+template<class Field> int ShareBase<Field>::threshold;
+template<class Field> int ShareBase<Field>::n_players;
+template<class Field> int ShareBase<Field>::Pking = 0;
+template<class Field> ifstream ShareBase<Field>::in;
+template<class Field> vector<double> ShareBase<Field>::weights;
+template<class Field> thread_local PRNG ShareBase<Field>::PRNG_agreed;
 
-octetStreams ShareBase::send_buffers;
-octetStreams ShareBase::receive_buffers;
+template<class Field> thread_local octetStreams ShareBase<Field>::send_buffers;
+template<class Field> thread_local octetStreams ShareBase<Field>::receive_buffers;
 
-octetStreams ShareBase::send_buffers_PRG;
-octetStreams ShareBase::receive_buffers_PRG;
-gfpMatrix ShareBase::shares_buffers_PRG;
+template<class Field> thread_local octetStreams ShareBase<Field>::send_buffers_PRG;
+template<class Field> thread_local octetStreams ShareBase<Field>::receive_buffers_PRG;
+template<class Field> thread_local gfpMatrix<Field> ShareBase<Field>::shares_buffers_PRG;
 
 // Some fixed vandermond matrix.
-gfpMatrix ShareBase::vandermonde_t; // Van(n, t)
-gfpMatrix ShareBase::vandermonde_2t; // Van(n, 2t)
-gfpMatrix ShareBase::vandermonde_n_t; // Van(n, n-t)
+template<class Field> gfpMatrix<Field> ShareBase<Field>::vandermonde_t; // Van(n, t)
+template<class Field> gfpMatrix<Field> ShareBase<Field>::vandermonde_2t; // Van(n, 2t)
+template<class Field> gfpMatrix<Field> ShareBase<Field>::vandermonde_n_t; // Van(n, n-t)
 
 // Some fixed reconstruction vector of f(0) conditioned on Pking (default=0)
-gfpVector ShareBase::reconstruction_vector_t; // reconstruction t-sharing
-gfpVector ShareBase::reconstruction_vector_2t; // reconstruction 2t-sharing
+template<class Field> gfpVector<Field> ShareBase<Field>::reconstruction_vector_t; // reconstruction t-sharing
+template<class Field> gfpVector<Field> ShareBase<Field>::reconstruction_vector_2t; // reconstruction 2t-sharing
+template<class Field> thread_local map<vector<int>, gfpVector<Field>> ShareBase<Field>::reconstruction_vectors;
 
 
 // The first idx is the player_id of missing share
-gfpMatrix ShareBase::reconstruction_with_secret_2t;// This is to reconstruct Pi's share from the secret and known 2t shares.
-gfpMatrix ShareBase::reconstruction_with_secret_t;// This is to reconstruct Pi's share and P{t+1-2t} shares from the secret and known t shares.
+template<class Field> gfpMatrix<Field> ShareBase<Field>::reconstruction_with_secret_2t;// This is to reconstruct Pi's share from the secret and known 2t shares.
+template<class Field> gfpMatrix<Field> ShareBase<Field>::reconstruction_with_secret_t;// This is to reconstruct Pi's share and P{t+1-2t} shares from the secret and known t shares.
 
 // Bits
-gfpVector ShareBase::bits_coeff(BITS_LENGTH);
+template<class Field> gfpVector<Field> ShareBase<Field>::bits_coeff(Field::BITS_LENGTH);
 
+template<class Field>
 void initiate_protocol(int n, int t, ThreadPlayer *_P, string fn, int _Pking)
 {
-    ShareBase::n_players = n;
-    ShareBase::threshold = t;
-    ShareBase::P = _P;
-    ShareBase::set_input_file(fn);
-    ShareBase::Pking = _Pking;
-    ShareBase::init_vandermondes();
-    ShareBase::init_reconstruction_vectors();
+    ShareBase<Field>::n_players = n;
+    ShareBase<Field>::threshold = t;
+    ShareBase<Field>::P = _P;
+    ShareBase<Field>::set_input_file(fn);
+    ShareBase<Field>::Pking = _Pking;
+    ShareBase<Field>::init_vandermondes();
+    ShareBase<Field>::init_reconstruction_vectors();
 
-    ShareBase::init_bits_coeff();
+    ShareBase<Field>::init_bits_coeff();
 
-    ShareBase::send_buffers.reset(n);
-    ShareBase::receive_buffers.reset(n);
+    ShareBase<Field>::send_buffers.reset(n);
+    ShareBase<Field>::receive_buffers.reset(n);
 }
 
-void ShareBase::set_input_file(string fn)
+template<class Field>
+void ShareBase<Field>::set_input_file(string fn)
 {
     in.open(fn.c_str());
     if((in).fail()){
@@ -70,15 +72,17 @@ void ShareBase::set_input_file(string fn)
     }
 }
 
-void ShareBase::close_input_file()
+template<class Field>
+void ShareBase<Field>::close_input_file()
 {
     in.close();
 }
 
-void ShareBase::init_bits_coeff()
+template<class Field>
+void ShareBase<Field>::init_bits_coeff()
 {
     bits_coeff(0) = 1;
-    for(size_t i = 1; i < BITS_LENGTH; i++){
+    for(size_t i = 1; i < Field::BITS_LENGTH; i++){
         bits_coeff(i) = bits_coeff(i-1) << 1;
     }
 }
@@ -88,7 +92,8 @@ void ShareBase::init_bits_coeff()
  *       Member Methods about Vandermonde Matrix
  * 
  * ***********************************************/
-void ShareBase::init_vandermondes()
+template<class Field>
+void ShareBase<Field>::init_vandermondes()
 {
     vandermonde_t = get_vandermonde(n_players, threshold);
     vandermonde_2t = get_vandermonde(n_players, threshold<<1);
@@ -105,12 +110,13 @@ void ShareBase::init_vandermondes()
  * @param ySize Equal to degree.
  * @return gfpEMatrix 
  */
-gfpMatrix ShareBase::get_vandermonde(const size_t &xSize,const size_t &ySize)
+template<class Field>
+gfpMatrix<Field> ShareBase<Field>::get_vandermonde(const size_t &xSize,const size_t &ySize)
 {
-    gfpMatrix matrix(xSize, ySize);
+    gfpMatrix<Field> matrix(xSize, ySize);
     for(size_t i = 0; i < matrix.rows(); i++){
-        gfpScalar prod = 1;
-        gfpScalar x = i+1;
+        gfpScalar<Field> prod = 1;
+        gfpScalar<Field> x = i+1;
         for(size_t j = 0; j < matrix.cols(); j++){
             prod = prod*x;
             matrix(i, j) = prod;
@@ -126,7 +132,8 @@ gfpMatrix ShareBase::get_vandermonde(const size_t &xSize,const size_t &ySize)
  * 
  * *************************************************************************************/
 
-void ShareBase::init_reconstruction_vectors()
+template<class Field>
+void ShareBase<Field>::init_reconstruction_vectors()
 {
     reconstruction_vector_t = get_reconstruction_vector(threshold);
     reconstruction_vector_2t = get_reconstruction_vector((threshold<<1));
@@ -155,11 +162,23 @@ void ShareBase::init_reconstruction_vectors()
 
 // The reconstruction set C is the set containing P0(Pking), P1, ..., P_{degree}.
 // Pking is decided in advance, so are the reconstruction set. 
-bool ShareBase::is_in_reconstruction_set(const int &degree)
+template<class Field>
+bool ShareBase<Field>::is_in_reconstruction_set(const int &degree)
 {
     return (P->get_relative(Pking)<=degree);
 }
 
+// With FIRST_RESPONDERS, every party sends its shares, and the reconstructor takes the first degree+1 shares (including its own).
+template<class Field>
+bool ShareBase<Field>::is_responder(const int &degree)
+{
+#ifdef FIRST_RESPONDERS
+    return true;
+#else
+    return is_in_reconstruction_set(degree);
+#endif
+}
+
 /**
  * @brief Get the reconstruction factor of the player_i for the specific point.
  * C is the set containing P0, P1, ..., P_{degree}. (starting from Pking)
@@ -170,14 +189,15 @@ bool ShareBase::is_in_reconstruction_set(const int &degree)
  * @param degree degree of the polynomial
  * @return gfpScalar 
  */
-gfpScalar ShareBase::get_reconstruction_factor(const gfpScalar &point,const int &player_i,const int &degree)
+template<class Field>
+gfpScalar<Field> ShareBase<Field>::get_reconstruction_factor(const gfpScalar<Field> &point,const int &player_i,const int &degree)
 {
-    gfpScalar factor(1);
+    gfpScalar<Field> factor(1);
     int n_relevant_player = degree+1;
-    gfpScalar gfp_i(player_i+1); // Player ID shoud start from 1.
+    gfpScalar<Field> gfp_i(player_i+1); // Player ID shoud start from 1.
     for(int offset = 0; offset < n_relevant_player; offset++){
         int player_j = positive_modulo(Pking+offset, n_players);
-        gfpScalar gfp_j(player_j+1);
+        gfpScalar<Field> gfp_j(player_j+1);
         if(player_i!=player_j){
             factor *= (gfp_j - point)/(gfp_j - gfp_i);
         }
@@ -186,9 +206,10 @@ gfpScalar ShareBase::get_reconstruction_factor(const gfpScalar &point,const int
 }
 
 // For the specific point = 0
-gfpScalar ShareBase::get_reconstruction_factor(const int&player_i, const int &degree)
+template<class Field>
+gfpScalar<Field> ShareBase<Field>::get_reconstruction_factor(const int&player_i, const int &degree)
 {
-    return get_reconstruction_factor(gfpScalar(0), player_i, degree);
+    return get_reconstruction_factor(gfpScalar<Field>(0), player_i, degree);
 }
 
 /**
@@ -200,10 +221,11 @@ gfpScalar ShareBase::get_reconstruction_factor(const int&player_i, const int &de
  * @param degree 
  * @return gfpMatrix 
  */
-gfpVector ShareBase::get_reconstruction_vector(const gfpScalar &point, const int &degree)
+template<class Field>
+gfpVector<Field> ShareBase<Field>::get_reconstruction_vector(const gfpScalar<Field> &point, const int &degree)
 {
     int n_relevant_player = degree+1;
-    gfpVector reconstruction(n_relevant_player,1);
+    gfpVector<Field> reconstruction(n_relevant_player,1);
     for(int i = 0; i < n_relevant_player; i++){
         int player_no = positive_modulo(Pking+i, n_players);
         reconstruction(i) = get_reconstruction_factor(point, player_no, degree);
@@ -212,9 +234,41 @@ gfpVector ShareBase::get_reconstruction_vector(const gfpScalar &point, const int
 }
 
 // Reconstruction vector for the specific point = 0
-gfpVector ShareBase::get_reconstruction_vector(const int &degree)
+template<class Field>
+gfpVector<Field> ShareBase<Field>::get_reconstruction_vector(const int &degree)
 {
-    return get_reconstruction_vector(gfpScalar(0), degree);
+    return get_reconstruction_vector(gfpScalar<Field>(0), degree);
+}
+
+/**
+ * @brief Get the Lagrange reconstruction vector to point = 0 from the shares of the given set of players (of degree+1 players),
+ * whose factors are in the same order as the players.
+ * It is cached per set, as the first parties to respond vary from round to round.
+ * 
+ * @param players 
+ * @return const gfpVector& 
+ */
+template<class Field>
+const gfpVector<Field>& ShareBase<Field>::get_reconstruction_vector(const vector<int> &players)
+{
+    auto it = reconstruction_vectors.find(players);
+    if(it != reconstruction_vectors.end()){
+        return it->second;
+    }
+    gfpVector<Field> &reconstruction = reconstruction_vectors[players];
+    reconstruction.resize(players.size());
+    for(size_t i = 0; i < players.size(); i++){
+        gfpScalar<Field> factor(1);
+        gfpScalar<Field> gfp_i(players[i]+1); // Player ID shoud start from 1.
+        for(size_t j = 0; j < players.size(); j++){
+            gfpScalar<Field> gfp_j(players[j]+1);
+            if(j != i){
+                factor *= gfp_j/(gfp_j - gfp_i);
+            }
+        }
+        reconstruction(i) = factor;
+    }
+    return reconstruction;
 }
 
 /**
@@ -229,15 +283,16 @@ gfpVector ShareBase::get_reconstruction_vector(const int &degree)
  * @param degree t or 2t
  * @return gfpScalar 
  */
-gfpScalar ShareBase::get_reconstruction_factor_with_secret(const int &except_player, const gfpScalar &point, const int &player_i,const int &degree)
+template<class Field>
+gfpScalar<Field> ShareBase<Field>::get_reconstruction_factor_with_secret(const int &except_player, const gfpScalar<Field> &point, const int &player_i,const int &degree)
 {
-    gfpScalar factor(1);
+    gfpScalar<Field> factor(1);
     int n_relevant_player = degree+1;
-    gfpScalar gfp_i(player_i);
+    gfpScalar<Field> gfp_i(player_i);
     
     for(int offset = 0; offset < n_relevant_player+1; offset++){
         if(offset == except_player){continue;}
-        gfpScalar gfp_j(offset);
+        gfpScalar<Field> gfp_j(offset);
         if(gfp_i != gfp_j){
             factor *= (gfp_j - point)/(gfp_j - gfp_i);
         }
@@ -256,10 +311,11 @@ gfpScalar ShareBase::get_reconstruction_factor_with_secret(const int &except_pla
  * @param degree 
  * @return gfpVector 
  */
-gfpVector ShareBase::get_reconstruction_vector_with_secret(const int &except_player, const gfpScalar &point, const int &degree)
+template<class Field>
+gfpVector<Field> ShareBase<Field>::get_reconstruction_vector_with_secret(const int &except_player, const gfpScalar<Field> &point, const int &degree)
 {
     int n_relevant_player = degree+1;
-    gfpVector reconstruction(n_relevant_player);
+    gfpVector<Field> reconstruction(n_relevant_player);
 
     int idx = 0;
     for(int i = 0; i < n_relevant_player+1; i++){// P0 ... P2t+1
@@ -294,12 +350,13 @@ gfpVector ShareBase::get_reconstruction_vector_with_secret(const int &except_pla
  * @param share [out] My own share of the sharing.
  * @param os [out] Store other parties' shares
  */
-void Share::calculate_sharing(const gfpScalar &secret, const int &degree, gfpScalar &share, octetStreams &os)
+template<class Field>
+void Share<Field>::calculate_sharing(const gfpScalar<Field> &secret, const int &degree, gfpScalar<Field> &share, octetStreams &os)
 {
-    gfpMatrix vandermonde = (degree==threshold)? vandermonde_t : vandermonde_2t;
-    gfpVector random_coeffs(degree);
-    random_matrix(random_coeffs);
-    gfpVector sharing = (vandermonde * random_coeffs).array() + secret; 
+    gfpMatrix<Field> vandermonde = (degree==threshold)? vandermonde_t : vandermonde_2t;
+    gfpVector<Field> random_coeffs(degree);
+    fill_uniform(random_coeffs);
+    gfpVector<Field> sharing = (vandermonde * random_coeffs).array() + secret; 
     share = sharing(P->my_num());
     pack_row(sharing, os);
 }
@@ -313,10 +370,11 @@ void Share::calculate_sharing(const gfpScalar &secret, const int &degree, gfpSca
  * @param share [in] P's share
  * @param os [in] The shares from parties of the reconstruction set.
  */
-void Share::calculate_secret(gfpScalar &secret, const int &degree, const gfpScalar &share, octetStreams &os)
+template<class Field>
+void Share<Field>::calculate_secret(gfpScalar<Field> &secret, const int &degree, const gfpScalar<Field> &share, octetStreams &os)
 {
-    gfpVector reconstruction = (degree==threshold)?reconstruction_vector_t:reconstruction_vector_2t;
-    gfpVector sharing(degree+1);
+    gfpVector<Field> reconstruction = (degree==threshold)?reconstruction_vector_t:reconstruction_vector_2t;
+    gfpVector<Field> sharing(degree+1);
     unpack_row(sharing, os);
     // If P is in the reconstruction set, the share of P is not in os because we avoid the loopback.
     if(is_in_reconstruction_set(degree)){
@@ -329,7 +387,8 @@ void Share::calculate_secret(gfpScalar &secret, const int &degree, const gfpScal
  * @brief Calcuate and distribute the sharing of degree t of the secret.
  * 
  */
-void Share::distribute_sharing()
+template<class Field>
+void Share<Field>::distribute_sharing()
 {
     octetStreams os(n_players);
     calculate_sharing(secret, degree, share, os);
@@ -340,7 +399,8 @@ void Share::distribute_sharing()
  * @brief Collect the sharing and reconstruct the secret.
  * 
  */
-void Share::reconstruct_secret()
+template<class Field>
+void Share<Field>::reconstruct_secret()
 {
     octetStreams os(degree+1);
     // os[player_no] stores the share of P_{player_no}
@@ -352,14 +412,16 @@ void Share::reconstruct_secret()
     calculate_secret(secret, degree, share, os);
 }
 
-void Share::send_share(int player_no)
+template<class Field>
+void Share<Field>::send_share(int player_no)
 {
     octetStream o;
     share.pack(o);
     P->send_to(player_no, o);
 }
 
-void Share::receive_share(int player_no)
+template<class Field>
+void Share<Field>::receive_share(int player_no)
 {
     octetStream o;
     P->receive_player(player_no, o);
@@ -368,7 +430,8 @@ void Share::receive_share(int player_no)
 
 // * Distribute and receive shares with help of PRG. 
 
-void Share::distrbute_sharing_PRG(const gfpScalar &_secret, gfpScalar &_share)
+template<class Field>
+void Share<Field>::distrbute_sharing_PRG(const gfpScalar<Field> &_secret, gfpScalar<Field> &_share)
 {
     if(degree==threshold){ distribute_t_sharint_PRG(_secret, _share);}
     else{ distribute_2t_sharing_PRG(_secret, _share);}
@@ -381,14 +444,15 @@ void Share::distrbute_sharing_PRG(const gfpScalar &_secret, gfpScalar &_share)
  *
  * Other parties can get its share directly from the PRG.
  */
-void Share::distribute_2t_sharing_PRG(const gfpScalar &_secret, gfpScalar &_share)
+template<class Field>
+void Share<Field>::distribute_2t_sharing_PRG(const gfpScalar<Field> &_secret, gfpScalar<Field> &_share)
 {
     int _degree=threshold<<1;
-    gfpVector shares_prng(_degree);
-    random_matrix(shares_prng, PRNG_agreed);
+    gfpVector<Field> shares_prng(_degree);
+    fill_uniform(shares_prng, PRNG_agreed);
 
     // For ease of coding, we assume n = 2t+1;
-    gfpVector material(_degree+1);
+    gfpVector<Field> material(_degree+1);
     material(0) = _secret;
     material.tail(_degree) = shares_prng;
     _share = reconstruction_with_secret_2t.row(P->my_num()).dot(material);
@@ -403,25 +467,26 @@ void Share::distribute_2t_sharing_PRG(const gfpScalar &_secret, gfpScalar &_shar
  * Pt+1 ... P2t, and P0 need receive from Pi. (Assume Pi is not in them)
  * 
  */
-void Share::distribute_t_sharint_PRG(const gfpScalar &_secret, gfpScalar &_share)
+template<class Field>
+void Share<Field>::distribute_t_sharint_PRG(const gfpScalar<Field> &_secret, gfpScalar<Field> &_share)
 {
     assert(degree==threshold);
     // Mapped party
     // P0 P1 ... Pt Pt+1
     
     // shares from prng: P2 ... Pt+1
-    gfpVector shares_prng(degree);
-    random_matrix(shares_prng, PRNG_agreed);
+    gfpVector<Field> shares_prng(degree);
+    fill_uniform(shares_prng, PRNG_agreed);
 
     // material: P0 P2 ... Pt+1
     // True idx is P1 ... Pt
-    gfpVector material(degree+1);
+    gfpVector<Field> material(degree+1);
     material(0) = _secret;
     material.tail(degree) = shares_prng;
     
     // sharing(t+1, 1): Calculate shares for P_t+2 ... P_2t+1 P1
     // True idx is P_{t+1} ... P_{2t} P0
-    gfpVector sharing = reconstruction_with_secret_t * material;
+    gfpVector<Field> sharing = reconstruction_with_secret_t * material;
 
     if(P->my_num()>=1 && P->my_num()<=degree){// We can get shares from PRG directly.
         _share = shares_prng(P->my_num() - 1);
@@ -436,17 +501,19 @@ void Share::distribute_t_sharint_PRG(const gfpScalar &_secret, gfpScalar &_share
     P->send_respective(degree+1, degree+1, os);
 }
 
-void Share::get_sharing_PRG(int player_no, gfpScalar &_share)
+template<class Field>
+void Share<Field>::get_sharing_PRG(int player_no, gfpScalar<Field> &_share)
 {
     if(degree==threshold){get_t_sharing_PRG(player_no, _share);}
     else {get_2t_sharing_PRG(player_no, _share);}
 }
 
 // If my_num() != player_no, receive from player_no or get directly from PRG.
-void Share::get_t_sharing_PRG(int player_no, gfpScalar &_share)
+template<class Field>
+void Share<Field>::get_t_sharing_PRG(int player_no, gfpScalar<Field> &_share)
 {
-    gfpVector shares_prng(degree);
-    random_matrix(shares_prng, PRNG_agreed);
+    gfpVector<Field> shares_prng(degree);
+    fill_uniform(shares_prng, PRNG_agreed);
 
     if(P->my_num()>=1 && P->my_num()<=degree){// We can get shares from PRG directly.
         _share = shares_prng(P->my_num() - 1);
@@ -459,10 +526,11 @@ void Share::get_t_sharing_PRG(int player_no, gfpScalar &_share)
 }
 
 // Get from PRG directly.
-void Share::get_2t_sharing_PRG(int player_no, gfpScalar &_share)
+template<class Field>
+void Share<Field>::get_2t_sharing_PRG(int player_no, gfpScalar<Field> &_share)
 {
-    gfpVector shares_prng(threshold<<1);
-    random_matrix(shares_prng, PRNG_agreed);
+    gfpVector<Field> shares_prng(threshold<<1);
+    fill_uniform(shares_prng, PRNG_agreed);
 
     if(P->my_num()>player_no){
         _share = shares_prng(P->my_num()-1);
@@ -477,12 +545,13 @@ void Share::get_2t_sharing_PRG(int player_no, gfpScalar &_share)
  * 
  * @return Share& 
  */
-Share& Share::reduce_degree()
+template<class Field>
+Share<Field>& Share<Field>::reduce_degree()
 {
     double_degree();
     assert(degree == threshold<<1);
 
-    DoubleShare r;
+    DoubleShare<Field> r;
     r.reduced_random(); // Get a reduced random sharing. ([r]_t, [r]_2t)
     share += r.aux_share;
 
@@ -502,19 +571,20 @@ Share& Share::reduce_degree()
  * 
  * @return Share& 
  */
-Share& Share::truncate()
+template<class Field>
+Share<Field>& Share<Field>::truncate()
 {
     assert(degree == threshold);
-    DoubleShare r;
-    Share r_msb;
+    DoubleShare<Field> r;
+    Share<Field> r_msb;
     r.truncated_random(r_msb);
-    share += r.aux_share + ConstEncode;
+    share += r.aux_share + Field::ConstEncode;
     
     reveal();
     secret.truncate();
 
-    gfpScalar is_overflow = (1-r_msb.share) * secret.msb();
-    share = secret - r.share + ConstGapInTruncation * is_overflow - ConstDecode;
+    gfpScalar<Field> is_overflow = (1-r_msb.share) * secret.msb();
+    share = secret - r.share + Field::ConstGapInTruncation * is_overflow - Field::ConstDecode;
     return *this;
 }
 
@@ -523,24 +593,25 @@ Share& Share::truncate()
  * 
  * @return Share& 
  */
-Share& Share::reduce_truncate()
+template<class Field>
+Share<Field>& Share<Field>::reduce_truncate()
 {
     double_degree();
     assert(degree == threshold<<1);
-    DoubleShare r;
-    Share r_msb;
+    DoubleShare<Field> r;
+    Share<Field> r_msb;
     r.reduced_truncated_random(r_msb);
 
-    share += r.aux_share + ConstEncode;// Encode to make sure MSB(a)=0
+    share += r.aux_share + Field::ConstEncode;// Encode to make sure MSB(a)=0
     
     reveal();
     degree >>=1;
     secret.truncate();
 
-    gfpScalar is_overflow = (1-r_msb.share) * secret.msb();
+    gfpScalar<Field> is_overflow = (1-r_msb.share) * secret.msb();
 
     // Decode: bring another 1 bit error
-    share = secret - r.share + ConstGapInTruncation * is_overflow - ConstDecode;
+    share = secret - r.share + Field::ConstGapInTruncation * is_overflow - Field::ConstDecode;
 
     
     return *this;
@@ -570,11 +641,12 @@ Share& Share::reduce_truncate()
 }
 
 // TODO: Encode to make Sure MSB(a) = 0
-Share& Share::reduce_truncate(size_t precision)
+template<class Field>
+Share<Field>& Share<Field>::reduce_truncate(size_t precision)
 {
     double_degree();
     assert(degree == threshold<<1);
-    DoubleShare r;
+    DoubleShare<Field> r;
     r.reduced_truncated_random(precision);
     share += r.aux_share;
 
@@ -599,7 +671,8 @@ Share& Share::reduce_truncate(size_t precision)
  * 
  * *******************************************************************/
 
-void Share::input_from_file(int player_no)
+template<class Field>
+void Share<Field>::input_from_file(int player_no)
 {
     if(player_no == P->my_num()){
         in>>secret; // Input secret from the file.
@@ -607,18 +680,21 @@ void Share::input_from_file(int player_no)
     }else{receive_share(player_no);}
 }
 
-void Share::input_from_party(int player_no)
+template<class Field>
+void Share<Field>::input_from_party(int player_no)
 {
     if(player_no == P->my_num()) { distribute_sharing();}
     else { receive_share(player_no);}
 }
 
-void Share::input_from_pking()
+template<class Field>
+void Share<Field>::input_from_pking()
 {
     input_from_party(Pking);
 }
 
-void Share::input_from_random(int player_no)
+template<class Field>
+void Share<Field>::input_from_random(int player_no)
 {
     if(player_no == P->my_num()) {
         secret.random();
@@ -626,13 +702,15 @@ void Share::input_from_random(int player_no)
     }else {receive_share(player_no);}
 }
 
-void Share::input_from_party_PRG(int player_no)
+template<class Field>
+void Share<Field>::input_from_party_PRG(int player_no)
 {
     if(player_no == P->my_num()){distrbute_sharing_PRG(secret, share);}
     else{get_sharing_PRG(player_no, share);}
 }
 
-void Share::input_from_random_PRG(int player_no)
+template<class Field>
+void Share<Field>::input_from_random_PRG(int player_no)
 {
     if(player_no == P->my_num()){
         secret.random();// This PRG is different from the PRG used to generate shares.
@@ -659,7 +737,8 @@ void Share::input_from_random_PRG(int player_no)
  * 
  * @param player_no 
  */
-void Share::reveal_to_party(int player_no)
+template<class Field>
+void Share<Field>::reveal_to_party(int player_no)
 {
     // If it is in the reconstruction set, send the share to Pking.
     // We exclude the P to avoid the loopback.
@@ -674,13 +753,15 @@ void Share::reveal_to_party(int player_no)
 }
 
 // Reveal the secret only to Pking
-void Share::reveal_to_pking()
+template<class Field>
+void Share<Field>::reveal_to_pking()
 {
     reveal_to_party(Pking);
 }
 
 // Reveal to Pking, then send the secret to other parties.
-gfpScalar Share::reveal()
+template<class Field>
+gfpScalar<Field> Share<Field>::reveal()
 {
     reveal_to_pking();
     octetStream o;
@@ -700,12 +781,13 @@ gfpScalar Share::reveal()
  * 
  * 
  * *******************************************************************/
-Share& Share::random()
+template<class Field>
+Share<Field>& Share<Field>::random()
 {
     share = 0;
     return *this;
     
-    RandomShare::get_random(RandomShare::queueRandom, share);
+    RandomShare<Field>::get_random(RandomShare<Field>::queueRandom, share);
     return *this;
 }
 
@@ -723,7 +805,8 @@ Share& Share::random()
  * 
  * @param player_no 
  */
-void DoubleShare::input_from_random(int player_no)
+template<class Field>
+void DoubleShare<Field>::input_from_random(int player_no)
 {
     assert(degree == threshold);
     if(player_no == P->my_num()){
@@ -740,7 +823,8 @@ void DoubleShare::input_from_random(int player_no)
     }
 }
 
-void DoubleShare::input_from_ath_random(int player_no, TYPE a)
+template<class Field>
+void DoubleShare<Field>::input_from_ath_random(int player_no, typename Field::TYPE a)
 {
     assert(degree == threshold);
     if(player_no == P->my_num()){
@@ -758,7 +842,8 @@ void DoubleShare::input_from_ath_random(int player_no, TYPE a)
     }
 }
 
-void DoubleShare::input_from_random_PRG(int player_no)
+template<class Field>
+void DoubleShare<Field>::input_from_random_PRG(int player_no)
 {
     assert(degree==threshold);
     if(player_no == P->my_num()){
@@ -777,7 +862,8 @@ void DoubleShare::input_from_random_PRG(int player_no)
  * 
  * 
  * *******************************************************************/
-DoubleShare& DoubleShare::reduced_random()
+template<class Field>
+DoubleShare<Field>& DoubleShare<Field>::reduced_random()
 {
 #ifdef ZERO_OFFLINE
     share = 0;
@@ -785,11 +871,13 @@ DoubleShare& DoubleShare::reduced_random()
     return *this;
 #endif
 
-    DoubleRandom::get_random_pair(DoubleRandom::queueReducedRandom, share, aux_share);// [r]_t, [r]_2t
+    if(Phase->is_producing()){Phase->request_reduced_random_sharings(1);}
+    DoubleRandom<Field>::get_random_pair(DoubleRandom<Field>::queueReducedRandom, share, aux_share);// [r]_t, [r]_2t
     return *this;
 }
 
-DoubleShare& DoubleShare::truncated_random(Share &r_msb)
+template<class Field>
+DoubleShare<Field>& DoubleShare<Field>::truncated_random(Share<Field> &r_msb)
 {
 #ifdef ZERO_OFFLINE
     share = 0;
@@ -799,11 +887,13 @@ DoubleShare& DoubleShare::truncated_random(Share &r_msb)
 #endif
 
     // DoubleRandom::get_random_pair(DoubleRandom::queueTruncatedRandom, share, aux_share);//  [r/2^d]_t, [r]_2
-    DoubleRandom::get_random_triple(DoubleRandom::queueTruncatedRandom, share, aux_share, r_msb.share);
+    if(Phase->is_producing()){Phase->request_truncated_random_sharings(1);}
+    DoubleRandom<Field>::get_random_triple(DoubleRandom<Field>::queueTruncatedRandom, share, aux_share, r_msb.share);
     return *this;
 }
 
-DoubleShare& DoubleShare::reduced_truncated_random(Share &r_msb)
+template<class Field>
+DoubleShare<Field>& DoubleShare<Field>::reduced_truncated_random(Share<Field> &r_msb)
 {
 #ifdef ZERO_OFFLINE
     // share = 0;
@@ -811,19 +901,21 @@ DoubleShare& DoubleShare::reduced_truncated_random(Share &r_msb)
     // r_msb.share = 0;
 
     // Just for test the gap
-    gfpScalar tmp = MAX_POSITIVE;
+    gfpScalar<Field> tmp = Field::MAX_POSITIVE;
     share = tmp.truncate();
-    aux_share = MAX_POSITIVE;
+    aux_share = Field::MAX_POSITIVE;
     r_msb.share = 0;
     return *this;
 #endif
 
     // DoubleRandom::get_random_pair(DoubleRandom::queueReducedTruncatedRandom, share, aux_share); // [r/2^d]_2t, [r]_t
-    DoubleRandom::get_random_triple(DoubleRandom::queueReducedTruncatedRandom, share, aux_share, r_msb.share);
+    if(Phase->is_producing()){Phase->request_reduced_truncated_sharings(1);}
+    DoubleRandom<Field>::get_random_triple(DoubleRandom<Field>::queueReducedTruncatedRandom, share, aux_share, r_msb.share);
     return *this;
 }
 
-DoubleShare& DoubleShare::reduced_truncated_random(size_t precision)
+template<class Field>
+DoubleShare<Field>& DoubleShare<Field>::reduced_truncated_random(size_t precision)
 {
 #ifdef ZERO_OFFLINE
     share = 0;
@@ -831,16 +923,27 @@ DoubleShare& DoubleShare::reduced_truncated_random(size_t precision)
     return *this;
 #endif
 
-    DoubleRandom::get_random_pair(DoubleRandom::queueReducedTruncatedWithPrecisionRandom, share, aux_share); // [r/2^d]_2t, [r]_t
+    DoubleRandom<Field>::get_random_pair(DoubleRandom<Field>::queueReducedTruncatedWithPrecisionRandom, share, aux_share); // [r/2^d]_2t, [r]_t
     return *this;
 }
 
-gfpScalar DoubleShare::reveal_aux(int degree)
+template<class Field>
+gfpScalar<Field> DoubleShare<Field>::reveal_aux(int degree)
 {
-    Share aux;
+    Share<Field> aux;
     aux.share = aux_share;
     aux.set_degree(degree);
     return aux.reveal();
 }
 
-}
\ No newline at end of file
+template class ShareBase<PR31>;
+template class Share<PR31>;
+template class DoubleShare<PR31>;
+template void initiate_protocol<PR31>(int n, int t, ThreadPlayer *_P, string fn, int _Pking);
+
+template class ShareBase<PR61>;
+template class Share<PR61>;
+template class DoubleShare<PR61>;
+template void initiate_protocol<PR61>(int n, int t, ThreadPlayer *_P, string fn, int _Pking);
+
+}
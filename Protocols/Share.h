@@ -2,6 +2,7 @@
 #define PROTOCOLS_SHARE_H_
 
 #include <iostream>
+#include <map>
 #include "Networking/Player.h"
 #include "Math/gfpScalar.h"
 #include "Math/gfpMatrix.h"
@@ -15,55 +16,75 @@ namespace hmmpc
 {
 
 // Classes about Share
-class ShareBase; // Store the basic static attributes about the Share.
-class Share; // Store one share
-class DoubleShare; // Store double shares
+template<class Field> class ShareBase; // Store the basic static attributes about the Share.
+template<class Field> class Share; // Store one share
+template<class Field> class DoubleShare; // Store double shares
 
-class Bit;
+template<class Field> class Bit;
+template<class Field> class sint;
 
 // Initiate the protocol to set the basic parameters.
+template<class Field>
 void initiate_protocol(int n, int t, ThreadPlayer *_P, string fn, int _Pking = 0);
 
-
+// The static members of ShareBase in the classes derived from BASE (which depends on the Field).
+#define USING_SHARE_BASE(BASE)                                                                  \
+    using BASE::threshold; using BASE::n_players; using BASE::P; using BASE::Pking;             \
+    using BASE::in; using BASE::Phase; using BASE::weights; using BASE::PRNG_agreed;            \
+    using BASE::send_buffers; using BASE::receive_buffers;                                      \
+    using BASE::shares_buffers_PRG; using BASE::send_buffers_PRG; using BASE::receive_buffers_PRG; \
+    using BASE::vandermonde_t; using BASE::vandermonde_2t; using BASE::vandermonde_n_t;         \
+    using BASE::reconstruction_vector_t; using BASE::reconstruction_vector_2t;                 \
+    using BASE::reconstruction_vectors; using BASE::reconstruction_with_secret_2t;             \
+    using BASE::reconstruction_with_secret_t; using BASE::bits_coeff;                          \
+    using BASE::is_in_reconstruction_set; using BASE::is_responder;                            \
+    using BASE::get_reconstruction_vector; using BASE::get_reconstruction_vector_with_secret;
+
+
+template<class Field>
 class ShareBase
 {
 public:
+    // The channel, phase, agreed PRNG and buffers are per thread (bound by PhaseConfig::bind_thread),
+    // such that a PreprocessingProducer runs the protocols over its own channel.
     /** Metadata **/
     static int threshold;
     static int n_players;
-    static ThreadPlayer *P;
+    static thread_local ThreadPlayer *P;
     static int Pking;
     static ifstream in;
-    static PhaseConfig *Phase;// Control handsoff between offline and online phase.
+    static thread_local PhaseConfig<Field> *Phase;// Control handsoff between offline and online phase.
+    static vector<double> weights;// Agreed weights of the parties in the dispersed operations (empty for equal blocks).
 
-    static PRNG PRNG_agreed; 
+    static thread_local PRNG PRNG_agreed;
     static int start_party_PRG(){return threshold+1;}// t+1
     static int n_party_PRG(){return n_players - threshold;}//t+1
 
     // Buffers for multi-thread communication
-    static octetStreams send_buffers;
-    static octetStreams receive_buffers;
+    static thread_local octetStreams send_buffers;
+    static thread_local octetStreams receive_buffers;
     // Buffers for multi-thread communication (with help of PRG)
-    static gfpMatrix shares_buffers_PRG;
-    static octetStreams send_buffers_PRG;
-    static octetStreams receive_buffers_PRG;
+    static thread_local gfpMatrix<Field> shares_buffers_PRG;
+    static thread_local octetStreams send_buffers_PRG;
+    static thread_local octetStreams receive_buffers_PRG;
 
     // Some fixed vandermond matrix.
-    static gfpMatrix vandermonde_t; // Van(n, t)
-    static gfpMatrix vandermonde_2t; // Van(n, 2t)
-    static gfpMatrix vandermonde_n_t; // Van(n, n-t)
+    static gfpMatrix<Field> vandermonde_t; // Van(n, t)
+    static gfpMatrix<Field> vandermonde_2t; // Van(n, 2t)
+    static gfpMatrix<Field> vandermonde_n_t; // Van(n, n-t)
 
     // Some fixed reconstruction vector of f(0) conditioned on Pking (default=0)
-    static gfpVector reconstruction_vector_t; // reconstruction t-sharing
-    static gfpVector reconstruction_vector_2t; // reconstruction 2t-sharing
+    static gfpVector<Field> reconstruction_vector_t; // reconstruction t-sharing
+    static gfpVector<Field> reconstruction_vector_2t; // reconstruction 2t-sharing
+    static thread_local map<vector<int>, gfpVector<Field>> reconstruction_vectors; // reconstruction from each set of responders
 
     // For 2t-degree, the share that is missed from Pi is variable, which can make the communication is 0.
     // For t-degree, we stipulate that the missing share is from P0.
-    static gfpMatrix reconstruction_with_secret_2t; // This is to reconstruct Pi's share from the secret and known 2t shares.
-    static gfpMatrix reconstruction_with_secret_t; // This is to reconstruct P0's share and P{t+1-2t} shares from the secret and known t shares.
+    static gfpMatrix<Field> reconstruction_with_secret_2t; // This is to reconstruct Pi's share from the secret and known 2t shares.
+    static gfpMatrix<Field> reconstruction_with_secret_t; // This is to reconstruct P0's share and P{t+1-2t} shares from the secret and known t shares.
 
     // Bits setting
-    static gfpVector bits_coeff; // [1, 2, ..., 2^60]
+    static gfpVector<Field> bits_coeff; // [1, 2, ..., 2^60]
     static void init_bits_coeff();
     
 
@@ -72,38 +93,49 @@ public:
 
     // Vandermonde
     static void init_vandermondes();
-    static gfpMatrix get_vandermonde(const size_t &xSize,const size_t &ySize);
+    static gfpMatrix<Field> get_vandermonde(const size_t &xSize,const size_t &ySize);
 
     // Reconstruction Vector
     // The reconstruction is done by collecting degree+1 sharings from the set C.
     // The default set C is P0, P1, ..., P_{degree}, starting from the P0, which can be decided before executing.
     static bool is_in_reconstruction_set(const int &degree);
+    static bool is_responder(const int &degree);// Whether to send the shares to the reconstructor.
     static void init_reconstruction_vectors();
-    static gfpScalar get_reconstruction_factor(const gfpScalar &point,const int &player_i,const int &degree);
-    static gfpScalar get_reconstruction_factor(const int &player_i, const int &degree);// Point = 0
-    static gfpVector get_reconstruction_vector(const gfpScalar &point, const int &degree);
-    static gfpVector get_reconstruction_vector(const int &degree);// Point = 0
+    static gfpScalar<Field> get_reconstruction_factor(const gfpScalar<Field> &point,const int &player_i,const int &degree);
+    static gfpScalar<Field> get_reconstruction_factor(const int &player_i, const int &degree);// Point = 0
+    static gfpVector<Field> get_reconstruction_vector(const gfpScalar<Field> &point, const int &degree);
+    static gfpVector<Field> get_reconstruction_vector(const int &degree);// Point = 0
+    static const gfpVector<Field>& get_reconstruction_vector(const vector<int> &players);// Point = 0, from the shares of the players
 
     // Having the secret as f(0). Assume this is the share of P{-1}
     // P-1 P0 P1 ... Pt Pt+1 ... P2t (This is the case that except_player=P0)
     //  y  n  y      y   y        y  : From these 2t+1 shares to reconstruct the share of P0
     //  y  n  y  ... y   n        n  : From these t+1 shares to reconstruct the share of Pt+1...P2t
-    static gfpScalar get_reconstruction_factor_with_secret(const int &except_player, const gfpScalar &point, const int &player_i,const int &degree);
-    static gfpVector get_reconstruction_vector_with_secret(const int &except_player, const gfpScalar &point, const int &degree);
+    static gfpScalar<Field> get_reconstruction_factor_with_secret(const int &except_player, const gfpScalar<Field> &point, const int &player_i,const int &degree);
+    static gfpVector<Field> get_reconstruction_vector_with_secret(const int &except_player, const gfpScalar<Field> &point, const int &degree);
 };
 
-class Share:public ShareBase
+// Defined here rather than in Share.cpp: a translation unit that does not see the definition
+// calls the TLS init function of the member, which does not exist for a constant initializer.
+template<class Field> thread_local ThreadPlayer * ShareBase<Field>::P;
+template<class Field> thread_local PhaseConfig<Field> * ShareBase<Field>::Phase;
+
+template<class Field>
+class Share:public ShareBase<Field>
 {
-    friend class sint;
+    friend class sint<Field>;
+public:
+    USING_SHARE_BASE(ShareBase<Field>)
+    using ShareBase<Field>::start_party_PRG; using ShareBase<Field>::n_party_PRG;
 protected:
-    gfpScalar secret;
+    gfpScalar<Field> secret;
     int degree;
 
     /** Basic operations about Share and DoubleShare **/
     // Notice that we use 'share' to represent one specific share.
     // And we use 'sharing' to represent a set of shares. [x]_t = {x_1, x_2, ..., x_n} /
-    void calculate_sharing(const gfpScalar &secret, const int &degree, gfpScalar &share, octetStreams &os);
-    void calculate_secret(gfpScalar &secret, const int &degree, const gfpScalar &share, octetStreams &os);
+    void calculate_sharing(const gfpScalar<Field> &secret, const int &degree, gfpScalar<Field> &share, octetStreams &os);
+    void calculate_secret(gfpScalar<Field> &secret, const int &degree, const gfpScalar<Field> &share, octetStreams &os);
 
     /** Basic Operation about sharing **/
     void distribute_sharing(); // Calculate and distribute the sharing
@@ -112,34 +144,34 @@ protected:
     void receive_share(int player_no);
 
     // With PRG
-    void distrbute_sharing_PRG(const gfpScalar &_secret, gfpScalar &_share);
-    void distribute_2t_sharing_PRG(const gfpScalar &_secret, gfpScalar &_share);
-    void distribute_t_sharint_PRG(const gfpScalar &_secret, gfpScalar &_share);
-    void get_sharing_PRG(int player_no, gfpScalar &_share);
-    void get_2t_sharing_PRG(int player_no, gfpScalar &_share);
-    void get_t_sharing_PRG(int player_no, gfpScalar &_share);
+    void distrbute_sharing_PRG(const gfpScalar<Field> &_secret, gfpScalar<Field> &_share);
+    void distribute_2t_sharing_PRG(const gfpScalar<Field> &_secret, gfpScalar<Field> &_share);
+    void distribute_t_sharint_PRG(const gfpScalar<Field> &_secret, gfpScalar<Field> &_share);
+    void get_sharing_PRG(int player_no, gfpScalar<Field> &_share);
+    void get_2t_sharing_PRG(int player_no, gfpScalar<Field> &_share);
+    void get_t_sharing_PRG(int player_no, gfpScalar<Field> &_share);
 
 
 public:
-    gfpScalar share;
+    gfpScalar<Field> share;
 
     Share():degree(threshold){}
-    Share(const gfpScalar &_secret):secret(_secret), degree(threshold){}
-    Share(const gfpScalar &_secret, const gfpScalar &_share): secret(_secret), degree(threshold), share(_share){}
+    Share(const gfpScalar<Field> &_secret):secret(_secret), degree(threshold){}
+    Share(const gfpScalar<Field> &_secret, const gfpScalar<Field> &_share): secret(_secret), degree(threshold), share(_share){}
     
     // Get
     int get_degree()const{return degree;}
     void set_degree(const int &_degree){degree = _degree;}
-    gfpScalar get_secret()const{return secret;}
+    gfpScalar<Field> get_secret()const{return secret;}
 
     // Set
     void double_degree(){degree = degree<<1;}
-    void set_secret(const gfpScalar &_secret){secret = _secret;}
+    void set_secret(const gfpScalar<Field> &_secret){secret = _secret;}
 
-    Share& reduce_degree();
-    Share& truncate();
-    Share& reduce_truncate();
-    Share& reduce_truncate(size_t precision);
+    Share<Field>& reduce_degree();
+    Share<Field>& truncate();
+    Share<Field>& reduce_truncate();
+    Share<Field>& reduce_truncate(size_t precision);
     
     // Input
     void input_from_file(int player_no);
@@ -153,33 +185,42 @@ public:
     // Reveal
     void reveal_to_party(int player_no); 
     void reveal_to_pking();
-    gfpScalar reveal();
+    gfpScalar<Field> reveal();
 
     // Random
-    Share& random();
+    Share<Field>& random();
 };
 
-class DoubleShare: public Share
+template<class Field>
+class DoubleShare: public Share<Field>
 { 
+protected:
+    using Share<Field>::secret; using Share<Field>::degree;
+    using Share<Field>::calculate_sharing; using Share<Field>::distribute_t_sharint_PRG; using Share<Field>::distribute_2t_sharing_PRG;
+    using Share<Field>::get_t_sharing_PRG; using Share<Field>::get_2t_sharing_PRG;
 public:
-    gfpScalar aux_share;
-    DoubleShare():Share(){}
-    DoubleShare(const gfpScalar &_secret):Share(_secret){}
+    USING_SHARE_BASE(Share<Field>)
+    using Share<Field>::start_party_PRG; using Share<Field>::n_party_PRG;
+    using Share<Field>::share;
+
+    gfpScalar<Field> aux_share;
+    DoubleShare():Share<Field>(){}
+    DoubleShare(const gfpScalar<Field> &_secret):Share<Field>(_secret){}
 
     void input_from_random(int player_no);
-    void input_from_ath_random(int player_no, TYPE a);
+    void input_from_ath_random(int player_no, typename Field::TYPE a);
 
     // With PRG
     void input_from_random_PRG(int player_no);
 
     // Random
-    DoubleShare& reduced_random(); // Randomize to the reduced sharing ([r]_t, [r]_2t)
-    DoubleShare& truncated_random(Share &r_msb); // Randomize to the truncated sharing ([r/2^d]_t, [r]_t, [r_msb]_t)
-    DoubleShare& reduced_truncated_random(Share &r_msb); // Randomize to the reduced and truncated sharing ([r/2^d]_t, [r]_2t, [r_msb]_t)
-    DoubleShare& reduced_truncated_random(size_t precision);
+    DoubleShare<Field>& reduced_random(); // Randomize to the reduced sharing ([r]_t, [r]_2t)
+    DoubleShare<Field>& truncated_random(Share<Field> &r_msb); // Randomize to the truncated sharing ([r/2^d]_t, [r]_t, [r_msb]_t)
+    DoubleShare<Field>& reduced_truncated_random(Share<Field> &r_msb); // Randomize to the reduced and truncated sharing ([r/2^d]_t, [r]_2t, [r_msb]_t)
+    DoubleShare<Field>& reduced_truncated_random(size_t precision);
 
     // Reveal the aux_sharing-sharing
-    gfpScalar reveal_aux(int degree);
+    gfpScalar<Field> reveal_aux(int degree);
 };
 
 
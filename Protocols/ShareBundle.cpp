@@ -3,8 +3,11 @@
 #include "Protocols/Bit.h"
 #include "Math/constMatrix.h"
 #include "Protocols/BeaverTriper.h"
+#include "Math/gfpGemm.h"
+#include "Math/gfpKernels.h"
 using Eigen::RowMajor;
 using Eigen::seq, Eigen::seqN, Eigen::last;
+using Eigen::Map;
 namespace hmmpc
 {
 
@@ -32,17 +35,18 @@ namespace hmmpc
  * @param shares [out]
  * @param os [out]
  */
-void ShareBundle::calculate_sharings(const gfpMatrix &secrets, const int &degree, gfpMatrix &shares, octetStreams &os)
+template<class Field>
+void ShareBundle<Field>::calculate_sharings(const gfpMatrix<Field> &secrets, const int &degree, gfpMatrix<Field> &shares, octetStreams &os)
 {
-    gfpMatrix &vandermonde = (degree==threshold)? vandermonde_t : vandermonde_2t;
-    gfpMatrix random_coeffs(degree, secrets.size());// Each column corresponds to the coefficients of one random polynomial of such degree. (Except the constant term)
-    random_matrix(random_coeffs); 
-    gfpMatrix sharings = vandermonde * random_coeffs;// Each column corresponds to one sharing of the secret
+    gfpMatrix<Field> &vandermonde = (degree==threshold)? vandermonde_t : vandermonde_2t;
+    gfpMatrix<Field> random_coeffs(degree, secrets.size());// Each column corresponds to the coefficients of one random polynomial of such degree. (Except the constant term)
+    fill_uniform(random_coeffs); 
+    gfpMatrix<Field> sharings = gfp_matmul(vandermonde, random_coeffs);// Each column corresponds to one sharing of the secret
     for(size_t i = 0; i < secrets.size(); i++){
         sharings.col(i).array() += secrets(i);
     }
     // Extract my own shares and store them.
-    shares = sharings.row( P->my_num()).reshaped<Eigen::AutoOrder>(shares.rows(), shares.cols());
+    shares = sharings.row( P->my_num()).template reshaped<Eigen::AutoOrder>(shares.rows(), shares.cols());
     // TODO pack_row: add another functionality that not pack os[P->my_num()]
     pack_row(sharings, os);
 }
@@ -56,28 +60,71 @@ void ShareBundle::calculate_sharings(const gfpMatrix &secrets, const int &degree
  * @param shares 
  * @param os 
  */
-void ShareBundle::calculate_secrets(gfpMatrix &secrets, const int &degree, const gfpMatrix &shares, octetStreams &os)
+template<class Field>
+void ShareBundle<Field>::calculate_secrets(gfpMatrix<Field> &secrets, const int &degree, const gfpMatrix<Field> &shares, octetStreams &os)
 {
-    gfpVector &reconstruction = (degree==threshold)?reconstruction_vector_t:reconstruction_vector_2t;
-    gfpMatrix sharings(degree+1, secrets.size());
+    gfpVector<Field> &reconstruction = (degree==threshold)?reconstruction_vector_t:reconstruction_vector_2t;
+    gfpMatrix<Field> sharings(degree+1, secrets.size());
     unpack_row(sharings, os);
     // If P is in the reconstruction set, the shares of P is not in os because we avoid the loopback.
     // Hence, we need to fill our own shares into the sharings.row(num)
     if(is_in_reconstruction_set(degree)){
-        sharings.row(P->my_num()) = shares.reshaped<Eigen::RowMajor>().transpose();
+        sharings.row(P->my_num()) = shares.template reshaped<Eigen::RowMajor>().transpose();
     }
-    secrets = (reconstruction.transpose() * sharings).reshaped<Eigen::RowMajor>(secrets.rows(), secrets.cols());
+    secrets = (reconstruction.transpose() * sharings).template reshaped<Eigen::RowMajor>(secrets.rows(), secrets.cols());
 }
 
-void ShareBundle::distribute_sharings()
+/**
+ * @brief Receive the sharings from the first 'degree' other parties to respond (see ThreadPlayer::receive_first),
+ * and fill them into the rows of sharings along with my own shares, in the order of the party IDs.
+ * 
+ * @param degree 
+ * @param my_shares my own shares, of sharings.cols() elements
+ * @param sharings [out] (degree+1) rows
+ * @return const gfpVector& the reconstruction vector of these parties
+ */
+template<class Field>
+const gfpVector<Field>& ShareBundle<Field>::receive_first_sharings(const int &degree, const gfpScalar<Field> *my_shares, gfpMatrix<Field> &sharings)
+{
+    vector<int> others;
+    for(int i = 0; i < n_players; i++){
+        if(i != P->my_num()){
+            others.push_back(i);
+        }
+    }
+    octetStreams os(n_players);
+    vector<int> responders = P->receive_first(others, degree, os);
+    responders.push_back(P->my_num());
+    sort(responders.begin(), responders.end());
+
+    // os[P] is empty, which is skipped in unpack_row.
+    octetStreams ordered(degree+1);
+    for(int k = 0; k <= degree; k++){
+        ordered[k].swap(os[responders[k]]);
+    }
+    assert(sharings.rows() == degree+1);
+    unpack_row(sharings, ordered);
+    size_t me = find(responders.begin(), responders.end(), P->my_num()) - responders.begin();
+    sharings.row(me) = Map<const gfpVector<Field>>(my_shares, sharings.cols()).transpose();
+    return get_reconstruction_vector(responders);
+}
+
+template<class Field>
+void ShareBundle<Field>::distribute_sharings()
 {
     octetStreams os(n_players);
     calculate_sharings(secrets, degree, shares, os);
     P->send_respective(os);
 }
 
-void ShareBundle::reconstruct_secrets()
+template<class Field>
+void ShareBundle<Field>::reconstruct_secrets()
 {
+#ifdef FIRST_RESPONDERS
+    gfpMatrix<Field> sharings(degree+1, secrets.size());
+    const gfpVector<Field> &reconstruction = receive_first_sharings(degree, shares.data(), sharings);
+    secrets = (reconstruction.transpose() * sharings).template reshaped<Eigen::RowMajor>(secrets.rows(), secrets.cols());
+#else
     octetStreams os(degree+1);
     for(size_t player_no = 0; player_no < degree+1; player_no++)
     if(P->my_num()!=player_no){
@@ -91,30 +138,35 @@ void ShareBundle::reconstruct_secrets()
     }
 
     calculate_secrets(secrets, degree, shares, os);
+#endif
 }
 
-void ShareBundle::send_shares(int player_no)
+template<class Field>
+void ShareBundle<Field>::send_shares(int player_no)
 {
     octetStream o;
     pack_matrix(shares, o);
     P->send_to(player_no, o);
 }
 
-void ShareBundle::receive_shares(int player_no)
+template<class Field>
+void ShareBundle<Field>::receive_shares(int player_no)
 {
     octetStream o;
     P->receive_player(player_no, o);
     unpack_matrix(shares, o);
 }
 
-void ShareBundle::send_secrets()
+template<class Field>
+void ShareBundle<Field>::send_secrets()
 {
     octetStream o;
     pack_matrix(secrets, o);
     P->send_all(o);
 }
 
-void ShareBundle::receive_secrets(int player_no)
+template<class Field>
+void ShareBundle<Field>::receive_secrets(int player_no)
 {
     octetStream o;
     P->receive_player(player_no, o);
@@ -123,46 +175,51 @@ void ShareBundle::receive_secrets(int player_no)
 
 /**
  * @brief Calculate the block of secrets from the received octetStream.
- * The block starts from start_row, containing n_rows.
+ * The block starts from the element start (in row-major order), containing n elements.
  * (block version of 'calculate_secrets')
  * 
  * @param degree 
- * @param start_row The sharings corresponds to the block of the matrix.
- * @param n_rows 
- * @param os The relevalent shares stored in the octetStreams. (size = degree + 1)
+ * @param start The sharings corresponds to the block of the matrix.
+ * @param n 
+ * @param sharings The relevalent shares, received straight into its rows. (rows = degree + 1)
  */
-void ShareBundle::calculate_block_secrets(const int &degree, const int &start_row, const int &n_rows, octetStreams &os)
+template<class Field>
+void ShareBundle<Field>::calculate_block_secrets(const int &degree, const size_t &start, const size_t &n, const gfpMatrix<Field> &sharings)
 {
-    gfpVector &reconstruction = (degree==threshold)?reconstruction_vector_t:reconstruction_vector_2t;
-    gfpMatrix sharings(degree+1, n_rows * cols());
-    unpack_row(sharings, os);
-    // Block starts from 'start_row', containing 'n_rows' rows.
-    secrets(seqN(start_row, n_rows), seq(0, last)) = (reconstruction.transpose() * sharings).reshaped<RowMajor>(n_rows, cols()); 
+    calculate_block_secrets((degree==threshold)?reconstruction_vector_t:reconstruction_vector_2t, start, n, sharings);
+}
+
+// The sharings from the parties of the reconstruction vector.
+template<class Field>
+void ShareBundle<Field>::calculate_block_secrets(const gfpVector<Field> &reconstruction, const size_t &start, const size_t &n, const gfpMatrix<Field> &sharings)
+{
+    // Block starts from the element 'start', containing 'n' elements.
+    Map<gfpVector<Field>>(secrets.data() + start, n) = (reconstruction.transpose() * sharings).transpose();
 }
 
 /**
- * @brief Caculate the block of sharings, which starts from 'start_row' containing 'n_rows'.
+ * @brief Caculate the block of sharings, which starts from the element 'start' containing 'n' elements.
  * (block version of 'calculate_sharings')
  * @param degree 
- * @param start_row 
- * @param n_rows 
+ * @param start 
+ * @param n 
  * @param os 
  */
-void ShareBundle::calculate_block_sharings(const int &degree, const int &start_row, const int &n_rows, octetStreams &os)
+template<class Field>
+void ShareBundle<Field>::calculate_block_sharings(const int &degree, const size_t &start, const size_t &n, octetStreams &os)
 {
-    const gfpMatrix &vandermonde = (degree==threshold) ? vandermonde_t : vandermonde_2t;
-    size_t n_secrets = n_rows * cols();
-    gfpMatrix random_coeffs(degree, n_secrets);
-    random_matrix(random_coeffs);
-    gfpMatrix sharings = vandermonde * random_coeffs;
+    const gfpMatrix<Field> &vandermonde = (degree==threshold) ? vandermonde_t : vandermonde_2t;
+    gfpMatrix<Field> random_coeffs(degree, n);
+    fill_uniform(random_coeffs);
+    gfpMatrix<Field> sharings = gfp_matmul(vandermonde, random_coeffs);
     
     // Secret ID in secrets matrix.
-    size_t s_idx = start_row * cols();
-    for(size_t i = 0; i < n_secrets; i++, s_idx++){
-        sharings.col(i).array() += secrets(s_idx);
+    const gfpScalar<Field> *secret = secrets.data() + start;
+    for(size_t i = 0; i < n; i++){
+        sharings.col(i).array() += secret[i];
     }
-    // Extract my own shares and store them into the block, which start from start_row containing n_rows.
-    shares(seqN(start_row, n_rows), seq(0, last)) = sharings.row(P->my_num()).reshaped<RowMajor>(n_rows, cols());
+    // Extract my own shares and store them into the block.
+    Map<gfpVector<Field>>(shares.data() + start, n) = sharings.row(P->my_num()).transpose();
     pack_row(sharings, os);
 }
 
@@ -177,18 +234,19 @@ void ShareBundle::calculate_block_sharings(const int &degree, const int &start_r
  * @param _secrets 
  * @param _shares 
  */
-void ShareBundle::calculate_2t_sharings_PRG(const gfpMatrix&_secrets, gfpMatrix &_shares)
+template<class Field>
+void ShareBundle<Field>::calculate_2t_sharings_PRG(const gfpMatrix<Field>&_secrets, gfpMatrix<Field> &_shares)
 {
     int _degree = threshold<<1;
-    gfpMatrix shares_prng(_degree, _secrets.size());
-    random_matrix(shares_prng, PRNG_agreed);
+    gfpMatrix<Field> shares_prng(_degree, _secrets.size());
+    fill_uniform(shares_prng, PRNG_agreed);
 
-    gfpMatrix material(_degree+1, _secrets.size());
-    material.row(0) = _secrets.reshaped<Eigen::RowMajor>().transpose();
+    gfpMatrix<Field> material(_degree+1, _secrets.size());
+    material.row(0) = _secrets.template reshaped<Eigen::RowMajor>().transpose();
     material.bottomRows(_degree) = shares_prng;
 
     _shares = ( reconstruction_with_secret_2t.row(P->my_num()) * material).
-                reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
+                template reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
 }
 
 /**
@@ -203,7 +261,8 @@ void ShareBundle::calculate_2t_sharings_PRG(const gfpMatrix&_secrets, gfpMatrix
  * @param _shares 
  * @param os stores the shares of Pt+1, ..., P2t, and P0.
  */
-void ShareBundle::calculate_t_sharings_PRG(const gfpMatrix&_secrets, gfpMatrix &_shares, octetStreams &os)
+template<class Field>
+void ShareBundle<Field>::calculate_t_sharings_PRG(const gfpMatrix<Field>&_secrets, gfpMatrix<Field> &_shares, octetStreams &os)
 {
     assert(degree==threshold);
 
@@ -211,27 +270,27 @@ void ShareBundle::calculate_t_sharings_PRG(const gfpMatrix&_secrets, gfpMatrix &
     // P0 P1 ... Pt Pt+1
 
     // shares from prng: P2 ... Pt+1
-    gfpMatrix shares_prng(degree, _secrets.size());
-    random_matrix(shares_prng, PRNG_agreed);
+    gfpMatrix<Field> shares_prng(degree, _secrets.size());
+    fill_uniform(shares_prng, PRNG_agreed);
 
     // material: P0 P2 ... Pt+1
     // True idx is P1 ... Pt
-    gfpMatrix material(n_party_PRG(), _secrets.size());
-    material.row(0) = _secrets.reshaped<Eigen::RowMajor>().transpose();
+    gfpMatrix<Field> material(n_party_PRG(), _secrets.size());
+    material.row(0) = _secrets.template reshaped<Eigen::RowMajor>().transpose();
     material.bottomRows(degree) = shares_prng;
 
     // sharing(t+1, size()): Calculate shares for P_t+2 ... P_2t+1 P1
     // True idx is P_{t+1} ... P_{2t} P0
-    gfpMatrix sharings = reconstruction_with_secret_t * material;
+    gfpMatrix<Field> sharings = reconstruction_with_secret_t * material;
 
     if(P->my_num()>=1 && P->my_num()<=degree){
         // Obtain shares directly from PRG
-        _shares = shares_prng.row(P->my_num()-1).reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
+        _shares = shares_prng.row(P->my_num()-1).template reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
     }else if(P->my_num()==0){
         // P0 can get from the sharings that calculated.
-        _shares = sharings.row(degree).reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
+        _shares = sharings.row(degree).template reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
     }else{
-        _shares = sharings.row(P->my_num() - degree - 1).reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
+        _shares = sharings.row(P->my_num() - degree - 1).template reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
     }
 
     // Pack the sharings that contains shares of P_{t+1} ... P_{2t} P0.
@@ -239,25 +298,27 @@ void ShareBundle::calculate_t_sharings_PRG(const gfpMatrix&_secrets, gfpMatrix &
     pack_rows(sharings, os);
 }
 
-void ShareBundle::get_2t_sharings_PRG(int player_no, gfpMatrix &_shares)
+template<class Field>
+void ShareBundle<Field>::get_2t_sharings_PRG(int player_no, gfpMatrix<Field> &_shares)
 {
-    gfpMatrix shares_prng(threshold<<1, _shares.size());
-    random_matrix(shares_prng, PRNG_agreed);
+    gfpMatrix<Field> shares_prng(threshold<<1, _shares.size());
+    fill_uniform(shares_prng, PRNG_agreed);
 
     if(P->my_num()>player_no){
-        _shares = shares_prng.row(P->my_num() - 1).reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
+        _shares = shares_prng.row(P->my_num() - 1).template reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
     }else{
-        _shares = shares_prng.row(P->my_num()).reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
+        _shares = shares_prng.row(P->my_num()).template reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
     }
 }
 
-void ShareBundle::get_t_sharings_PRG(int player_no, gfpMatrix &_shares)
+template<class Field>
+void ShareBundle<Field>::get_t_sharings_PRG(int player_no, gfpMatrix<Field> &_shares)
 {
-    gfpMatrix shares_prng(degree, _shares.size());
-    random_matrix(shares_prng, PRNG_agreed);
+    gfpMatrix<Field> shares_prng(degree, _shares.size());
+    fill_uniform(shares_prng, PRNG_agreed);
 
     if(P->my_num()>=1 && P->my_num()<=degree){
-        _shares = shares_prng.row(P->my_num()-1).reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
+        _shares = shares_prng.row(P->my_num()-1).template reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
     }else{
         octetStream o;
         P->receive_player(player_no, o);
@@ -266,7 +327,8 @@ void ShareBundle::get_t_sharings_PRG(int player_no, gfpMatrix &_shares)
     return;
 }
 
-void ShareBundle::distribute_sharings_PRG(const gfpMatrix &_secrets, gfpMatrix &_shares)
+template<class Field>
+void ShareBundle<Field>::distribute_sharings_PRG(const gfpMatrix<Field> &_secrets, gfpMatrix<Field> &_shares)
 {
     if(degree==threshold){
         octetStreams os(degree+1);
@@ -277,18 +339,20 @@ void ShareBundle::distribute_sharings_PRG(const gfpMatrix &_secrets, gfpMatrix &
     }
 }
 
-void ShareBundle::get_sharings_PRG(int player_no, gfpMatrix &_shares)
+template<class Field>
+void ShareBundle<Field>::get_sharings_PRG(int player_no, gfpMatrix<Field> &_shares)
 {
     if(degree==threshold){get_t_sharings_PRG(player_no, _shares);}
     else{get_2t_sharings_PRG(player_no, _shares);}
 }
 
 // We divide get_t_sharings_PRG into two phase: the request phase and the wait phase.
-void ShareBundle::get_t_sharings_PRG_request(int player_no, gfpMatrix &shares_prng, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::get_t_sharings_PRG_request(int player_no, gfpMatrix<Field> &shares_prng, octetStream &o_receive)
 {
     assert(shares_prng.rows()==degree);
     assert(shares_prng.cols()==size());
-    random_matrix(shares_prng, PRNG_agreed);
+    fill_uniform(shares_prng, PRNG_agreed);
 
     if(P->my_num()>=1 && P->my_num()<=degree){
         return;
@@ -298,10 +362,11 @@ void ShareBundle::get_t_sharings_PRG_request(int player_no, gfpMatrix &shares_pr
     return;
 }
 
-void ShareBundle::get_t_sharings_PRG_wait(int player_no, const gfpMatrix &shares_prng, gfpMatrix &_shares, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::get_t_sharings_PRG_wait(int player_no, const gfpMatrix<Field> &shares_prng, gfpMatrix<Field> &_shares, octetStream &o_receive)
 {
     if(P->my_num()>=1 && P->my_num()<=degree){
-        _shares = shares_prng.row(P->my_num()-1).reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
+        _shares = shares_prng.row(P->my_num()-1).template reshaped<Eigen::RowMajor>(_shares.rows(), _shares.cols());
         return;
     }else{
         P->wait_receive(player_no, o_receive);
@@ -310,62 +375,65 @@ void ShareBundle::get_t_sharings_PRG_wait(int player_no, const gfpMatrix &shares
     return;
 }
 
-// Row-grained of calculate_t_sharings_PRG
-void ShareBundle::calculate_block_t_sharings_PRG(const int &start_row, const int &n_rows, octetStreams &os_send)
+// Element-grained of calculate_t_sharings_PRG. The sharings are viewed by os_send, so they must stay alive until the send is waited.
+template<class Field>
+void ShareBundle<Field>::calculate_block_t_sharings_PRG(const size_t &start, const size_t &n, gfpMatrix<Field> &sharings, vector<octetViews> &os_send)
 {
     assert(degree==threshold);
 
-    size_t n_secrets = n_rows * cols();
-    gfpMatrix shares_prng(degree, n_secrets);
-    random_matrix(shares_prng, PRNG_agreed);
+    gfpMatrix<Field> shares_prng(degree, n);
+    fill_uniform(shares_prng, PRNG_agreed);
 
-    gfpMatrix material(n_party_PRG(), n_secrets);
-    material.row(0) = secrets.middleRows(start_row, n_rows).reshaped<Eigen::RowMajor>().transpose();
+    gfpMatrix<Field> material(n_party_PRG(), n);
+    material.row(0) = Map<const gfpVector<Field>>(secrets.data() + start, n).transpose();
     material.bottomRows(degree) = shares_prng;
 
-    gfpMatrix sharings = reconstruction_with_secret_t * material;
+    sharings.noalias() = reconstruction_with_secret_t * material;
 
+    Map<gfpVector<Field>> block(shares.data() + start, n);
     if(P->my_num()>=1 && P->my_num()<=degree){
         // Obtain shares directly from PRG
-        shares.middleRows(start_row, n_rows) = shares_prng.row(P->my_num()-1).reshaped<Eigen::RowMajor>(n_rows, cols());
+        block = shares_prng.row(P->my_num()-1).transpose();
     }else if(P->my_num()==0){
         // P0 can get from the sharings that calculated.
-        shares.middleRows(start_row, n_rows) = sharings.row(degree).reshaped<Eigen::RowMajor>(n_rows, cols());
+        block = sharings.row(degree).transpose();
     }else{
-        shares.middleRows(start_row, n_rows) = sharings.row(P->my_num() - degree - 1).reshaped<Eigen::RowMajor>(n_rows, cols());
+        block = sharings.row(P->my_num() - degree - 1).transpose();
     }
 
-    // Pack the sharings that contains shares of P_{t+1} ... P_{2t} P0.
+    // View the sharings that contains shares of P_{t+1} ... P_{2t} P0.
     assert(sharings.rows()==os_send.size());
-    pack_rows(sharings, os_send);
+    view_rows(sharings, os_send);
 }
 
-// Row-grained of get_t_sharings_PRG_request
-void ShareBundle::get_block_t_sharings_PRG_request(int player_no, const int &start_row, const int &n_rows, gfpMatrix &shares_prng, octetStream &o_receive)
+// Element-grained of get_t_sharings_PRG_request
+template<class Field>
+void ShareBundle<Field>::get_block_t_sharings_PRG_request(int player_no, const size_t &start, const size_t &n, gfpMatrix<Field> &shares_prng, octetViews &o_receive)
 {
-    size_t n_secrets = n_rows * cols();
-
     assert(shares_prng.rows()==degree);
-    assert(shares_prng.cols()==n_secrets);
-    random_matrix(shares_prng, PRNG_agreed);
+    assert(shares_prng.cols()==(Eigen::Index)n);
+    fill_uniform(shares_prng, PRNG_agreed);
 
     if(P->my_num()>=1 && P->my_num()<=degree){
         return;
     }else{
+        // Receive straight into the block of shares.
+        o_receive.clear();
+        view_elements(shares, start, n, o_receive);
         P->request_receive(player_no, o_receive);
     }
     return;
 }
 
-// Row-grained of get_t_sharings_PRG_wait
-void ShareBundle::get_block_t_sharings_PRG_wait(int player_no, const int &start_row, const int &n_rows, const gfpMatrix &shares_prng, octetStream &o_receive)
+// Element-grained of get_t_sharings_PRG_wait
+template<class Field>
+void ShareBundle<Field>::get_block_t_sharings_PRG_wait(int player_no, const size_t &start, const size_t &n, const gfpMatrix<Field> &shares_prng, octetViews &o_receive)
 {
     if(P->my_num()>=1 && P->my_num()<=degree){
-        shares.middleRows(start_row, n_rows) = shares_prng.row(P->my_num()-1).reshaped<Eigen::RowMajor>(n_rows, cols());
+        Map<gfpVector<Field>>(shares.data() + start, n) = shares_prng.row(P->my_num()-1).transpose();
         return;
     }else{
         P->wait_receive(player_no, o_receive);
-        unpack_rows(shares, start_row, n_rows, o_receive);
     }
     return;
 }
@@ -384,15 +452,16 @@ void ShareBundle::get_block_t_sharings_PRG_wait(int player_no, const int &start_
  * 
  * @return ShareBundle& 
  */
-ShareBundle& ShareBundle::reduce_degree()
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::reduce_degree()
 {
     // Normal
     double_degree();
     assert(degree == threshold<<1);
 
-    DoubleShareBundle R(rows(), cols());
+    DoubleShareBundle<Field> R(rows(), cols());
     R.reduced_random(); // Get a bundle of reduced random sharings.
-    shares += R.aux_shares;
+    cwise_add(shares, R.aux_shares, shares);
 
     // * Original DN Protocol
     // reveal();
@@ -404,7 +473,7 @@ ShareBundle& ShareBundle::reduce_degree()
     degree >>= 1;
     input_blocks_dispersed_PRG();
 
-    shares = shares - R.shares;
+    cwise_sub(shares, R.shares, shares);
     return *this;
 }
 
@@ -414,37 +483,56 @@ ShareBundle& ShareBundle::reduce_degree()
  * 
  * @return ShareBundle& 
  */
-ShareBundle& ShareBundle::truncate()
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::truncate()
 {
     assert(degree == threshold);
-    DoubleShareBundle R(rows(), cols());
-    ShareBundle r_msb(rows(), cols());
+    DoubleShareBundle<Field> R(rows(), cols());
+    ShareBundle<Field> r_msb(rows(), cols());
     R.truncated_random(r_msb);
 
     // Encode to make sure MSB(a)=0
-    shares.array() += R.aux_shares.array() + ConstEncode;
-    
-    reveal_truncate(FIXED_PRECISION);
+    cwise_add(shares, R.aux_shares, shares);
+    cwise_add_const(shares, Field::ConstEncode, shares);
     
-    ShareBundle is_overflow(rows(), cols());
+    reveal_truncate(Field::FIXED_PRECISION);
+    fix_truncation(R, r_msb);
+    return *this;
+}
+
+/**
+ * @brief Unmask the revealed truncation of x+r (encoded so that MSB(x)=0), fix its overflow by MSB(r), and decode it.
+ * It is shared by truncate() and reduce_truncate() after the reveal (see also DeferredRound).
+ * 
+ * @param R ( [r/2^d]_t, [r] )
+ * @param r_msb [MSB(r)]_t, overwritten.
+ */
+template<class Field>
+void ShareBundle<Field>::fix_truncation(const DoubleShareBundle<Field> &R, ShareBundle<Field> &r_msb)
+{
+    ShareBundle<Field> is_overflow(rows(), cols());
     getMSB_matrix(secrets, is_overflow.shares);
-    is_overflow.shares = ((gfpScalar)1 - r_msb.shares.array()) * is_overflow.shares.array();
+    cwise_sub(1, r_msb.shares, r_msb.shares);
+    cwise_mul(r_msb.shares, is_overflow.shares, is_overflow.shares);
 
     // Fix the truncation result and decode it.
-    shares = secrets.array() - R.shares.array() + ConstGapInTruncation * is_overflow.shares.array() - ConstDecode;
-    return *this;
+    cwise_mul_const(is_overflow.shares, Field::ConstGapInTruncation, is_overflow.shares);
+    cwise_sub(secrets, R.shares, shares);
+    cwise_add(shares, is_overflow.shares, shares);
+    cwise_add_const(shares, -gfpScalar<Field>(Field::ConstDecode), shares);
 }
 
 // TODO: Truncate any precision with MSB(a)=0 (Need to modify)
-ShareBundle& ShareBundle::truncate(size_t precision)
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::truncate(size_t precision)
 {
     assert(degree == threshold);
-    DoubleShareBundle R(rows(), cols());
+    DoubleShareBundle<Field> R(rows(), cols());
     R.truncated_random(precision);
-    shares += R.aux_shares;
+    cwise_add(shares, R.aux_shares, shares);
     
     reveal_truncate(precision);
-    shares = secrets - R.shares;
+    cwise_sub(secrets, R.shares, shares);
     return *this;
 }
 
@@ -454,67 +542,65 @@ ShareBundle& ShareBundle::truncate(size_t precision)
  * 
  * @return ShareBundle& 
  */
-ShareBundle& ShareBundle::reduce_truncate()
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::reduce_truncate()
 {
     // Normal
     double_degree();
     assert(degree == threshold<<1);
-    DoubleShareBundle R(rows(), cols());
-    ShareBundle r_msb(rows(), cols());
+    DoubleShareBundle<Field> R(rows(), cols());
+    ShareBundle<Field> r_msb(rows(), cols());
     R.reduced_truncated_random(r_msb);
 
-    shares.array() += R.aux_shares.array() + ConstEncode;
+    cwise_add(shares, R.aux_shares, shares);
+    cwise_add_const(shares, Field::ConstEncode, shares);
 
-    reveal_truncate(FIXED_PRECISION);
+    reveal_truncate(Field::FIXED_PRECISION);
     degree>>=1;
-
-
-    ShareBundle is_overflow(rows(), cols());
-    getMSB_matrix(secrets, is_overflow.shares);
-    is_overflow.shares = (1 - r_msb.shares.array()) * is_overflow.shares.array();
-
-    // Fix the truncation result.
-    shares = secrets.array() - R.shares.array() + ConstGapInTruncation * is_overflow.shares.array() - ConstDecode;
+    fix_truncation(R, r_msb);
     return *this;
 }
 
 // TODO: Need to modify it
-ShareBundle& ShareBundle::reduce_truncate(size_t precision)
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::reduce_truncate(size_t precision)
 {
     double_degree();
     assert(degree == threshold<<1);
-    DoubleShareBundle R(rows(), cols());
+    DoubleShareBundle<Field> R(rows(), cols());
     R.reduced_truncated_random(precision);
 
-    shares += R.aux_shares;
+    cwise_add(shares, R.aux_shares, shares);
     reveal_truncate(precision);
     degree>>=1;
-    shares = secrets - R.shares;
+    cwise_sub(secrets, R.shares, shares);
     return *this;
 }
 
 // TODO: Need to modify it
 // Note precision is as the same size with sharebundles.
-ShareBundle& ShareBundle::reduce_truncate(vector<size_t> &precision)
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::reduce_truncate(vector<size_t> &precision)
 {
     double_degree();
     assert(degree == threshold<<1);
-    DoubleShareBundle R(rows(), cols());
+    DoubleShareBundle<Field> R(rows(), cols());
     R.reduced_truncated_random(precision);
 
-    shares += R.aux_shares;
+    cwise_add(shares, R.aux_shares, shares);
     reveal_truncate(precision);
     degree>>=1;
-    shares = secrets - R.shares;
+    cwise_sub(secrets, R.shares, shares);
     return *this;
 }
 
 // Test: Two layer multiplication to compute [x]_2t * [y]_t
 // First layer: compute ?*? = [x]_2t -> reduce degree [x]_t
 // Second layer: compute [x]_t * [y]_t
-ShareBundle& ShareBundle::reduce_degree_1stLayer(const ShareBundle &y, BeaverTriple &triple)
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::reduce_degree_1stLayer(const ShareBundle<Field> &y, BeaverTriple<Field> &triple)
 {
-    ShareBundle* x = this;
+    ShareBundle<Field>* x = this;
 
     assert(rows()==y.rows());
     assert(cols()==y.cols());
@@ -522,17 +608,21 @@ ShareBundle& ShareBundle::reduce_degree_1stLayer(const ShareBundle &y, BeaverTri
     assert(cols()==triple.cols());
 
     // [rX] for [x]_2t and [rY] for [r]_t*[y]_t  
-    DoubleShareBundle R(rows()<<1, cols()); //
+    DoubleShareBundle<Field> R(rows()<<1, cols()); //
     R.reduced_random();
 
     triple.a_share() = R.shares.topRows(rows()); // [a] = [rX] s.t. [x] = u - [rX]_t 
     triple.b_share() = - y.shares;               // [b] = [-y] s.t. [y] = 0 - (-[y]_t)  and v = 0
     triple.v_value().setConstant(0);
 
-    ShareBundle combine(rows()<<1, cols());
-    combine.shares.topRows(rows()) = shares + R.aux_shares.topRows(rows()); // [x]_2t + [rX]_2t
-    combine.shares.bottomRows(rows()) = triple.a_share().array() * triple.b_share().array() // [rX] * [-y] = [- rX * y]_2t
-                                        + R.aux_shares.bottomRows(rows()).array(); // + random of degree-2t
+    ShareBundle<Field> combine(rows()<<1, cols());
+    // The row blocks of the row-major matrices are contiguous.
+    const gfpKernels<Field> &kernels = gfp_kernels<Field>();
+    typename Field::TYPE *combine_top = gfp_data(combine.shares), *combine_bottom = combine_top + size();
+    const typename Field::TYPE *aux_top = gfp_data(R.aux_shares), *aux_bottom = aux_top + size();
+    kernels.add(combine_top, gfp_data(shares), aux_top, size()); // [x]_2t + [rX]_2t
+    kernels.mul(combine_bottom, gfp_data(triple.a_share()), gfp_data(triple.b_share()), size()); // [rX] * [-y] = [- rX * y]_2t
+    kernels.add(combine_bottom, combine_bottom, aux_bottom, size()); // + random of degree-2t
     
     
     combine.double_degree();//BUG LOG: The degree is 2t.
@@ -561,7 +651,8 @@ ShareBundle& ShareBundle::reduce_degree_1stLayer(const ShareBundle &y, BeaverTri
  * @param triples 
  * @return ShareBundle& 
  */
-ShareBundle& ShareBundle::reduce_degree_1stLayer(const vector<ShareBundle>&y, vector<BeaverTriple>&triples)
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::reduce_degree_1stLayer(const vector<ShareBundle<Field>>&y, vector<BeaverTriple<Field>>&triples)
 {
     // ShareBundle* x = this;
     size_t len = y.size();
@@ -569,14 +660,16 @@ ShareBundle& ShareBundle::reduce_degree_1stLayer(const vector<ShareBundle>&y, ve
 
     // The first 'rows()' double shares for [x]_2t, and the remaining for the evaluation of BeaverTriples.
     // [rX] = R.shares.topRows(rows());
-    DoubleShareBundle R(rows()+rows()*len, cols());
+    DoubleShareBundle<Field> R(rows()+rows()*len, cols());
     R.reduced_random();
 
     // Combine [x]_2t and [rX]*[-y_i]
-    ShareBundle combine(rows()+rows()*len, cols());
+    ShareBundle<Field> combine(rows()+rows()*len, cols());
 
     // [x+r]_2t = [x]_2t + [r]_2t
-    combine.shares.topRows(rows()) = shares + R.aux_shares.topRows(rows());
+    // The row blocks of the row-major matrices are contiguous.
+    const gfpKernels<Field> &kernels = gfp_kernels<Field>();
+    kernels.add(gfp_data(combine.shares), gfp_data(shares), gfp_data(R.aux_shares), size());
 
     for(size_t i = 0, idxRow = rows(); i < len; i++, idxRow+=rows()){
         assert(rows()==y[i].rows());
@@ -587,8 +680,9 @@ ShareBundle& ShareBundle::reduce_degree_1stLayer(const vector<ShareBundle>&y, ve
         triples[i].b_share() = -y[i].shares; // [y_i]_t = 0 - (-[y_i]) where v = 0 and [b] = -[y_i]
         triples[i].v_value().setConstant(0);
 
-        combine.shares.middleRows(idxRow, rows()) = triples[i].a_share().array() * triples[i].b_share().array()
-                                                    + R.aux_shares.middleRows(idxRow, rows()).array();
+        typename Field::TYPE *combine_i = gfp_data(combine.shares) + idxRow*cols();
+        kernels.mul(combine_i, gfp_data(triples[i].a_share()), gfp_data(triples[i].b_share()), size());
+        kernels.add(combine_i, combine_i, gfp_data(R.aux_shares) + idxRow*cols(), size());
     }
 
     combine.double_degree();//BUG LOG: The degree is 2t.
@@ -609,17 +703,18 @@ ShareBundle& ShareBundle::reduce_degree_1stLayer(const vector<ShareBundle>&y, ve
 // TODO: Need to modify it
 // It is used to update the parameters in ML.
 // w = w - lr*X*delta/batch_size -> w - X*delta* (lr/batch_size)
-ShareBundle& ShareBundle::reduce_truncate(size_t logLearningRate, size_t logMiniBatch)
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::reduce_truncate(size_t logLearningRate, size_t logMiniBatch)
 {
     double_degree();
     assert(degree == threshold<<1);
-    DoubleShareBundle R(rows(), cols());
+    DoubleShareBundle<Field> R(rows(), cols());
     R.reduced_truncated_random(logLearningRate, logMiniBatch);
 
-    shares += R.aux_shares;
-    reveal_truncate(FIXED_PRECISION+logLearningRate+logMiniBatch);
+    cwise_add(shares, R.aux_shares, shares);
+    reveal_truncate(Field::FIXED_PRECISION+logLearningRate+logMiniBatch);
     degree>>=1;
-    shares = secrets - R.shares;
+    cwise_sub(secrets, R.shares, shares);
     return *this;
 }
 
@@ -637,7 +732,8 @@ ShareBundle& ShareBundle::reduce_truncate(size_t logLearningRate, size_t logMini
  * 
  * *******************************************************************/
 
-void ShareBundle::input_from_file(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_file(int player_no)
 {
     if(player_no == P->my_num()){
         for(size_t i = 0; i < secrets.size(); i++){
@@ -647,21 +743,24 @@ void ShareBundle::input_from_file(int player_no)
     }else{receive_shares(player_no);}
 }
 
-void ShareBundle::input_from_party(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_party(int player_no)
 {
     if(player_no == P->my_num()){distribute_sharings();}
     else { receive_shares(player_no);}
 }
 
-void ShareBundle::input_from_pking()
+template<class Field>
+void ShareBundle<Field>::input_from_pking()
 {
     input_from_party(Pking);
 }
 
-void ShareBundle::input_from_random(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_random(int player_no)
 {
     if(player_no == P->my_num()){
-        random_matrix(secrets);
+        fill_uniform(secrets);
         distribute_sharings();
     }else {receive_shares(player_no);}
 }
@@ -680,7 +779,8 @@ void ShareBundle::input_from_random(int player_no)
  * 4. input_from_random_request: request to input secrets from the PRNG
  * 
  * *******************************************************************/
-void ShareBundle::input_from_file_request(int player_no, octetStreams &os_send, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::input_from_file_request(int player_no, octetStreams &os_send, octetStream &o_receive)
 {
     if(player_no == P->my_num()){
         for(size_t i = 0; i < secrets.size(); i++){
@@ -693,7 +793,8 @@ void ShareBundle::input_from_file_request(int player_no, octetStreams &os_send,
 
 // We use the send_buffers to distribute the sharings.
 // We use to receive_buffers to receive the shares.
-void ShareBundle::input_from_file_request(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_file_request(int player_no)
 {
     // Clear the buffer.
     if(player_no == P->my_num()){send_buffers.clear();}
@@ -710,10 +811,11 @@ void ShareBundle::input_from_file_request(int player_no)
  * @param os_send 
  * @param o_receive 
  */
-void ShareBundle::input_from_random_request(int player_no, octetStreams &os_send, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::input_from_random_request(int player_no, octetStreams &os_send, octetStream &o_receive)
 {
     if(player_no == P->my_num()){
-        random_matrix(secrets);
+        fill_uniform(secrets);
         calculate_sharings(secrets, degree, shares, os_send);
         P->request_send_respective(os_send);
     }else{P->request_receive(player_no, o_receive);}
@@ -721,14 +823,16 @@ void ShareBundle::input_from_random_request(int player_no, octetStreams &os_send
 
 // We use the send_buffers to distribute the sharings.
 // We use to receive_buffers to receive the shares.
-void ShareBundle::input_from_random_request(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_random_request(int player_no)
 {
     if(player_no == P->my_num()){send_buffers.clear();}
     else{receive_buffers[player_no].clear();}
     input_from_random_request(player_no, send_buffers, receive_buffers[player_no]);
 }
 
-void ShareBundle::input_from_party_request(int player_no, octetStreams &os_send, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::input_from_party_request(int player_no, octetStreams &os_send, octetStream &o_receive)
 {
     if(player_no == P->my_num()){
         calculate_sharings(secrets, degree, shares, os_send);
@@ -736,7 +840,8 @@ void ShareBundle::input_from_party_request(int player_no, octetStreams &os_send,
     }else{P->request_receive(player_no, o_receive);}
 }
 
-void ShareBundle::input_from_party_request(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_party_request(int player_no)
 {
     // Clear the buffer.
     if(player_no == P->my_num()){send_buffers.clear();}
@@ -748,7 +853,8 @@ void ShareBundle::input_from_party_request(int player_no)
 // When inputting from Pking,
 // We use the send_buffers to distribute the sharings.
 // We use to receive_buffers to receive the shares.
-void ShareBundle::input_from_pking_request()
+template<class Field>
+void ShareBundle<Field>::input_from_pking_request()
 {
     // Clear the buffer.
     if(Pking == P->my_num()){send_buffers.clear();}
@@ -765,7 +871,8 @@ void ShareBundle::input_from_pking_request()
  * @param os_send 
  * @param o_receive 
  */
-void ShareBundle::finish_input_from(int player_no, octetStreams &os_send, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::finish_input_from(int player_no, octetStreams &os_send, octetStream &o_receive)
 {
     if(player_no == P->my_num()){
         P->wait_send_respective(os_send);
@@ -778,7 +885,8 @@ void ShareBundle::finish_input_from(int player_no, octetStreams &os_send, octetS
 // The wait part when inputting sharings,
 // We use the send_buffers to distribute the sharings.
 // We use to receive_buffers to receive the shares.
-void ShareBundle::finish_input_from(int player_no)
+template<class Field>
+void ShareBundle<Field>::finish_input_from(int player_no)
 {
     finish_input_from(player_no, send_buffers, receive_buffers[player_no]);
 }
@@ -786,29 +894,33 @@ void ShareBundle::finish_input_from(int player_no)
 // The wait part when inputting from Pking,
 // We use the send_buffers to distribute the sharings.
 // We use to receive_buffers to receive the shares.
-void ShareBundle::finish_input_from_pking()
+template<class Field>
+void ShareBundle<Field>::finish_input_from_pking()
 {
     finish_input_from(Pking, send_buffers, receive_buffers[Pking]);
 }
 
 // With PRG
-void ShareBundle::input_from_party_PRG(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_party_PRG(int player_no)
 {
     if(player_no == P->my_num()){distribute_sharings_PRG(secrets, shares);}
     else{get_sharings_PRG(player_no, shares);}
 }
 
-void ShareBundle::input_from_random_PRG(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_random_PRG(int player_no)
 {
     if(player_no == P->my_num()){
-        random_matrix(secrets);
+        fill_uniform(secrets);
         distribute_sharings_PRG(secrets, shares);
     }else{
         get_sharings_PRG(player_no, shares);
     }
 }
 
-void ShareBundle::input_from_party_request_PRG(int player_no, octetStreams &os_send, gfpMatrix &shares_prng, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::input_from_party_request_PRG(int player_no, octetStreams &os_send, gfpMatrix<Field> &shares_prng, octetStream &o_receive)
 {
     assert(degree==threshold);
     if(player_no == P->my_num()){
@@ -823,11 +935,12 @@ void ShareBundle::input_from_party_request_PRG(int player_no, octetStreams &os_s
     }
 }
 
-void ShareBundle::input_from_random_request_PRG(int player_no, octetStreams &os_send, gfpMatrix &shares_prng, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::input_from_random_request_PRG(int player_no, octetStreams &os_send, gfpMatrix<Field> &shares_prng, octetStream &o_receive)
 {
     assert(degree==threshold);
     if(player_no==P->my_num()){
-        random_matrix(secrets);
+        fill_uniform(secrets);
         os_send.reset(n_party_PRG());
         // shares_prng.resize(degree, size());
 
@@ -839,7 +952,8 @@ void ShareBundle::input_from_random_request_PRG(int player_no, octetStreams &os_
     }
 }
 
-void ShareBundle::finish_input_from_PRG(int player_no, octetStreams &os_send, const gfpMatrix &shares_prng, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::finish_input_from_PRG(int player_no, octetStreams &os_send, const gfpMatrix<Field> &shares_prng, octetStream &o_receive)
 {
     assert(degree==threshold);
     if(player_no==P->my_num()){
@@ -850,7 +964,8 @@ void ShareBundle::finish_input_from_PRG(int player_no, octetStreams &os_send, co
     }
 }
 
-void ShareBundle::input_from_party_request_PRG(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_party_request_PRG(int player_no)
 {
     assert(degree==threshold);
     if(player_no==P->my_num()){send_buffers_PRG.clear();}
@@ -862,7 +977,8 @@ void ShareBundle::input_from_party_request_PRG(int player_no)
     input_from_party_request_PRG(player_no, send_buffers_PRG, shares_buffers_PRG, receive_buffers_PRG[player_no]);
 }
 
-void ShareBundle::input_from_random_request_PRG(int player_no)
+template<class Field>
+void ShareBundle<Field>::input_from_random_request_PRG(int player_no)
 {
     assert(degree==threshold);
     if(player_no==P->my_num()){send_buffers_PRG.clear();}
@@ -874,56 +990,84 @@ void ShareBundle::input_from_random_request_PRG(int player_no)
     input_from_random_request_PRG(player_no, send_buffers_PRG, shares_buffers_PRG, receive_buffers_PRG[player_no]);
 }
 
-void ShareBundle::finish_input_from_PRG(int player_no)
+template<class Field>
+void ShareBundle<Field>::finish_input_from_PRG(int player_no)
 {
     finish_input_from_PRG(player_no, send_buffers_PRG, shares_buffers_PRG, receive_buffers_PRG[player_no]);
 }
 
-// Row-grained of input_from_party_request_PRG
-void ShareBundle::input_block_from_party_request_PRG(int player_no, const int &startRow, const int &nRows, octetStreams &os_send, gfpMatrix &shares_prng, octetStream &o_receive)
+// Element-grained of input_from_party_request_PRG
+template<class Field>
+void ShareBundle<Field>::input_block_from_party_request_PRG(int player_no, const size_t &start, const size_t &n, vector<octetViews> &os_send, gfpMatrix<Field> &sharings, gfpMatrix<Field> &shares_prng, octetViews &o_receive)
 {
     assert(degree==threshold);
     if(player_no==P->my_num()){
-        os_send.reset(n_party_PRG());
+        os_send.assign(n_party_PRG(), octetViews());
 
-        calculate_block_t_sharings_PRG(startRow, nRows, os_send);
+        calculate_block_t_sharings_PRG(start, n, sharings, os_send);
         P->request_send_respective(start_party_PRG(), n_party_PRG(), os_send);
     }else{
-        shares_prng.resize(degree, nRows*cols());
-        get_block_t_sharings_PRG_request(player_no, startRow, nRows, shares_prng, o_receive);
+        shares_prng.resize(degree, n);
+        get_block_t_sharings_PRG_request(player_no, start, n, shares_prng, o_receive);
     }
 }
 
-void ShareBundle::finish_input_block_from_party_PRG(int player_no, const int &startRow, const int &nRows, octetStreams &os_send, const gfpMatrix &shares_prng, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::finish_input_block_from_party_PRG(int player_no, const size_t &start, const size_t &n, vector<octetViews> &os_send, const gfpMatrix<Field> &shares_prng, octetViews &o_receive)
 {
     assert(degree==threshold);
     if(player_no==P->my_num()){
         P->wait_send_respective(start_party_PRG(), n_party_PRG(), os_send);
     }
     else{
-        get_block_t_sharings_PRG_wait(player_no, startRow, nRows, shares_prng, o_receive);
+        get_block_t_sharings_PRG_wait(player_no, start, n, shares_prng, o_receive);
     }
 }
 
-// PRG Version of input_blocks_dispersed.
-void ShareBundle::input_blocks_dispersed_PRG()
+// Elements of the chunks of a block of n elements in the dispersed input and reveal.
+// The chunks of a large block are enlarged to at most DISPERSED_MAX_CHUNKS chunks, as the requests outstanding with a party are bounded (see SPSC_CAPACITY).
+static size_t dispersed_chunk(size_t n)
 {
-    size_t blk_rows = rows() / n_players;
-    size_t first_blk_rows = rows() - blk_rows * (n_players - 1);
+    if(DISPERSED_CHUNK == 0){return 0;}
+    return max((size_t)DISPERSED_CHUNK, (n + DISPERSED_MAX_CHUNKS - 1) / DISPERSED_MAX_CHUNKS);
+}
 
-    octetStreams os_send(n_party_PRG()), os_receive(n_players);
-    vector<gfpMatrix> shares_prng(n_players);
+// PRG Version of input_blocks_dispersed.
+// The PRG is drawn chunk by chunk in the same order at every party.
+template<class Field>
+void ShareBundle<Field>::input_blocks_dispersed_PRG()
+{
+    size_t start, n, cs, cn;
+    partition_elements(P->my_num(), start, n);
+    // My chunks of sharings, sent without packing.
+    vector<vector<octetViews>> os_send(n_chunks(n, dispersed_chunk(n)));
+    vector<gfpMatrix<Field>> sharings(n_chunks(n, dispersed_chunk(n)));
+    vector<octetViews> os_receive;
+    vector<gfpMatrix<Field>> shares_prng;
+    for(int i = 0; i < n_players; i++){
+        partition_elements(i, start, n);
+        os_receive.resize(os_receive.size() + n_chunks(n, dispersed_chunk(n)));
+    }
+    shares_prng.resize(os_receive.size());
 
     // Request part of input.
-    input_block_from_party_request_PRG(0, 0, first_blk_rows, os_send, shares_prng[0], os_receive[0]);
-    for(int i = 1, startRow = first_blk_rows; i < n_players; i++, startRow += blk_rows){
-        input_block_from_party_request_PRG(i, startRow, blk_rows, os_send, shares_prng[i], os_receive[i]);
+    for(int i = 0, k = 0; i < n_players; i++){
+        partition_elements(i, start, n);
+        for(size_t c = 0; c < n_chunks(n, dispersed_chunk(n)); c++, k++){
+            chunk_elements(start, n, dispersed_chunk(n), c, cs, cn);
+            size_t mine = (i == P->my_num()) ? c : 0;
+            input_block_from_party_request_PRG(i, cs, cn, os_send[mine], sharings[mine], shares_prng[k], os_receive[k]);
+        }
     }
 
     // Wait part of input.
-    finish_input_block_from_party_PRG(0, 0, first_blk_rows, os_send, shares_prng[0], os_receive[0]);
-    for(size_t i = 1, startRow = first_blk_rows; i < n_players; i++, startRow += blk_rows){
-        finish_input_block_from_party_PRG(i, startRow, blk_rows, os_send, shares_prng[i], os_receive[i]);
+    for(int i = 0, k = 0; i < n_players; i++){
+        partition_elements(i, start, n);
+        for(size_t c = 0; c < n_chunks(n, dispersed_chunk(n)); c++, k++){
+            chunk_elements(start, n, dispersed_chunk(n), c, cs, cn);
+            size_t mine = (i == P->my_num()) ? c : 0;
+            finish_input_block_from_party_PRG(i, cs, cn, os_send[mine], shares_prng[k], os_receive[k]);
+        }
     }
 }
 /*********************************************************************************************
@@ -939,9 +1083,10 @@ void ShareBundle::input_blocks_dispersed_PRG()
  * 
  * 
  * *******************************************************************************************/
-void ShareBundle::reveal_to_party(int player_no)
+template<class Field>
+void ShareBundle<Field>::reveal_to_party(int player_no)
 {
-    if(P->my_num()!=player_no && is_in_reconstruction_set(degree)){
+    if(P->my_num()!=player_no && is_responder(degree)){
         send_shares(player_no);
     }
 
@@ -950,12 +1095,14 @@ void ShareBundle::reveal_to_party(int player_no)
     }
 }
 
-void ShareBundle::reveal_to_pking()
+template<class Field>
+void ShareBundle<Field>::reveal_to_pking()
 {
     reveal_to_party(Pking);
 }
 
-gfpMatrix ShareBundle::reveal()
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::reveal()
 {
 #ifdef DISPERSE_PKING
     // Dispersed version.
@@ -973,7 +1120,8 @@ gfpMatrix ShareBundle::reveal()
 }
 
 // Reveal to Pking and Pking truncate some bits, and send to other parties.
-gfpMatrix ShareBundle::reveal_truncate(size_t precision)
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::reveal_truncate(size_t precision)
 {
 #ifdef DISPERSE_PKING
     // Dispersed version.
@@ -993,7 +1141,8 @@ gfpMatrix ShareBundle::reveal_truncate(size_t precision)
 }
 
 // Different precision
-gfpMatrix ShareBundle::reveal_truncate(vector<size_t> &precision)
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::reveal_truncate(vector<size_t> &precision)
 {
 #ifdef DISPERSE_PKING
     // Dispersed version.
@@ -1015,75 +1164,83 @@ gfpMatrix ShareBundle::reveal_truncate(vector<size_t> &precision)
 }
 
 // We disperse the Pking role to every party.
-gfpMatrix ShareBundle::reveal_dispersed()
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::reveal_dispersed()
 {
-    reveal_blocks_dispersed();
-    octetStream os_send;
-    octetStreams os_recev(n_players);
-    
-    size_t startRow, nRows;
-    partition_rows(startRow, nRows);
-    // Send the corresponding block of secrets to other parties.
-    pack_rows(secrets, startRow, nRows, os_send);
-    P->request_send_all(os_send); //* BUG LOG  We cannot use P->send_all(os_send). Otherwise, each party will be waiting to send. Hence, the receivers need to request to receive after the senders request to send.
-    
-    P->request_receive_respective(os_recev);
-    
-    P->wait_send_all(os_send);
-    // Receive other block of secrets from other parties.
-    P->wait_receive_respective(os_recev);
-    unpack_rows(secrets, os_recev);
-    return secrets;
+    return reveal_forward_dispersed([](const size_t&, const size_t&){});
 }
 
 // Compared to the above functionality, it truncates the secrets before sending to other paties.
-gfpMatrix ShareBundle::reveal_truncate_dispersed(size_t precision)
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::reveal_truncate_dispersed(size_t precision)
 {
-    reveal_blocks_dispersed();
-    size_t startRow, nRows;
-    partition_rows(startRow, nRows);
-    
-    // Truncate the secrets.
-    for(size_t i = startRow; i < startRow + nRows; i++)
-        for(size_t j = 0; j < cols(); j++)
-            secrets(i, j).truncate(precision);
-    
-    // Send the truncated secrets to other parties.
-    octetStream os_send;
-    octetStreams os_recev(n_players);
-    pack_rows(secrets, startRow, nRows, os_send);
-    P->request_send_all(os_send);
-
-    P->request_receive_respective(os_recev);
-    
-    P->wait_send_all(os_send);
-    P->wait_receive_respective(os_recev);
-    unpack_rows(secrets, os_recev);
-    return secrets;
+    gfpScalar<Field> *secret = secrets.data();
+    return reveal_forward_dispersed([&](const size_t &start, const size_t &n){
+        for(size_t k = start; k < start + n; k++)
+            secret[k].truncate(precision);
+    });
 }
 
-gfpMatrix ShareBundle::reveal_truncate_dispersed(vector<size_t> &precision)
+// Truncate the secrets with differen precision.
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::reveal_truncate_dispersed(vector<size_t> &precision)
 {
-    reveal_blocks_dispersed();
-    size_t startRow, nRows;
-    partition_rows(startRow, nRows);
-    
-    // Truncate the secrets with differen precision.
-    for(size_t i = startRow; i < startRow + nRows; i++)
-        for(size_t j = 0; j < cols(); j++)
-            secrets(i, j).truncate(precision[i*cols()+j]);
-    
-    // Send the truncated secrets to other parties.
-    octetStream os_send;
-    octetStreams os_recev(n_players);
-    pack_rows(secrets, startRow, nRows, os_send);
-    P->request_send_all(os_send);
+    gfpScalar<Field> *secret = secrets.data();
+    return reveal_forward_dispersed([&](const size_t &start, const size_t &n){
+        for(size_t k = start; k < start + n; k++)
+            secret[k].truncate(precision[k]);
+    });
+}
 
-    P->request_receive_respective(os_recev);
-    
-    P->wait_send_all(os_send);
-    P->wait_receive_respective(os_recev);
-    unpack_rows(secrets, os_recev);
+/**
+ * @brief Reveal my block of secrets chunk by chunk, and forward each chunk to other parties as soon as it is reconstructed,
+ * so that the reconstruction of the next chunks overlaps with sending the previous ones.
+ * 
+ * @param process Processes the chunk of secrets before sending it (e.g. truncation).
+ * @return gfpMatrix 
+ */
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::reveal_forward_dispersed(const function<void(const size_t&, const size_t&)> &process)
+{
+    size_t start, n;
+    partition_elements(P->my_num(), start, n);
+
+    // Other blocks of secrets are received straight into the matrix, chunk by chunk.
+    vector<octetViews> os_recev;
+    vector<int> recev_from;
+    for(int i = 0; i < n_players; i++)
+    if(i != P->my_num()){
+        size_t start_i, n_i, cs, cn;
+        partition_elements(i, start_i, n_i);
+        for(size_t c = 0; c < n_chunks(n_i, dispersed_chunk(n_i)); c++){
+            chunk_elements(start_i, n_i, dispersed_chunk(n_i), c, cs, cn);
+            os_recev.emplace_back();
+            view_elements(secrets, cs, cn, os_recev.back());
+            recev_from.push_back(i);
+        }
+    }
+
+    // The views are the ids of the sends, so they must not be moved until waited.
+    vector<octetViews> os_send;
+    os_send.reserve(n_chunks(n, dispersed_chunk(n)));
+    reveal_chunks_dispersed(
+        [&](){
+            // Requested after the receives of the shares, which arrive first.
+            for(size_t k = 0; k < os_recev.size(); k++)
+                P->request_receive(recev_from[k], os_recev[k]);
+        },
+        [&](const size_t &cs, const size_t &cn){
+            process(cs, cn);
+            os_send.emplace_back();
+            view_elements(secrets, cs, cn, os_send.back());
+            P->request_send_all(os_send.back()); //* BUG LOG  We cannot use P->send_all(os_send). Otherwise, each party will be waiting to send. Hence, the receivers need to request to receive after the senders request to send.
+        });
+
+    for(auto &views: os_send)
+        P->wait_send_all(views);
+    // Receive other block of secrets from other parties.
+    for(size_t k = 0; k < os_recev.size(); k++)
+        P->wait_receive(recev_from[k], os_recev[k]);
     return secrets;
 }
 
@@ -1095,16 +1252,20 @@ gfpMatrix ShareBundle::reveal_truncate_dispersed(vector<size_t> &precision)
  * which always apperas in pairs in 'reduce_degree', 'truncate', and 'reduce_truncate'.
  * To ease the load of Pking, we dispersed the Pking role to every party.
  * 
- * We partition the matrix to '#players' blocks, each of which contains consecutive rows.
- * We implement the partition rule in 'partition_rows(startRow, nRows)'.
+ * We partition the matrix to '#players' blocks, each of which contains consecutive elements (in row-major order),
+ * so that the load is balanced even if the matrix has fewer rows than the players (e.g. 1x10).
+ * We implement the partition rule in 'partition_elements(player_no, start, n)'.
  * 
  * We implement two main functionality to disperse the operations of input and reveal.
  * One is input_blocks_dispersed(), the other is reveal_blocks_dispersed().
- * Each of them contains the request part and wait part.
+ * 
+ * Each block is sent in chunks of DISPERSED_CHUNK elements, as one package per chunk,
+ * so that a large block is processed as a pipeline rather than store-and-forward:
+ * the reveal reconstructs each chunk once its shares arrive (while the next chunks are still on the way),
+ * and reveal_dispersed() forwards it at once; the input sends each chunk of sharings once it is calculated.
  * 
  * - reveal_blocks_dispersed()
- *   - reveal_block_from_party_request()
- *   - finish_reveal_block_from_party()
+ *   - reveal_chunks_dispersed()
  * - input_blocks_dispersed()
  *   - input_block_from_party_request()
  *   - finish_input_block_from_party()
@@ -1112,119 +1273,163 @@ gfpMatrix ShareBundle::reveal_truncate_dispersed(vector<size_t> &precision)
  * ****************************************************************************************/
 
 /**
- * @brief Partition rule: Partition the matrix to '#players' parts.
- * P0 takes charges of the first # rows.
- * P1 takes charges of the next # rows.
+ * @brief Partition rule: Partition the flattened matrix to '#players' parts.
+ * P0 takes charges of the first # elements.
+ * P1 takes charges of the next # elements.
  * ...
- * The total number of rows could not be divided exactly by the '#players'.
- * We assign slightly more rows to P0.
+ * The total number of elements could not be divided exactly by the '#players'.
+ * We assign one more element to each of the first parties.
+ * If the parties agreed on their weights (see PhaseConfig::agree_weights), the blocks are proportional to the weights instead.
  * 
- * @param startRow [out]
- * @param nRows [out]
+ * @param player_no
+ * @param start [out]
+ * @param n [out]
  */
-void ShareBundle::partition_rows(size_t &startRow, size_t &nRows)
+template<class Field>
+void ShareBundle<Field>::partition_elements(int player_no, size_t &start, size_t &n)
 {
-    size_t n_rows = rows() / n_players;
-    size_t first_n_rows = rows() - n_rows * (n_players - 1);
-    if(P->my_num()==0){
-        startRow = 0;
-        nRows = first_n_rows;
-    }else{
-        startRow = first_n_rows + n_rows * (P->my_num()-1);
-        nRows = n_rows;
-    }
+    hmmpc::partition_elements(size(), n_players, player_no, start, n, weights);
+}
+
+// Reveal my block of secrets.
+template<class Field>
+void ShareBundle<Field>::reveal_blocks_dispersed()
+{
+    reveal_chunks_dispersed([](){}, [](const size_t&, const size_t&){});
 }
 
 /**
- * @brief 
+ * @brief Reveal my block of secrets chunk by chunk.
+ * The relevant parties (the reconstruction set P0, P1, ... P_{degree}) send every chunk of the blocks of shares to the corresponding party.
+ * The chunk of secrets is reconstructed as soon as its degree+1 shares arrive.
+ * With FIRST_RESPONDERS, the block is reconstructed at once from the first degree+1 blocks of shares to arrive,
+ * which are sent as whole blocks.
  * 
+ * @param request_more Requests the receives (if any) to follow the receives of the shares.
+ * @param on_chunk Called with each reconstructed chunk of secrets (start, n), in order.
  */
-void ShareBundle::reveal_blocks_dispersed()
+template<class Field>
+void ShareBundle<Field>::reveal_chunks_dispersed(const function<void()> &request_more, const function<void(const size_t&, const size_t&)> &on_chunk)
 {
     // The reconstrunction only consists of degree+1 players, starting from P0.
-    size_t n_relevant_players = degree + 1; 
-    
-    // Relevant players is the reconstruction set, containing P0, P1, ... P_{degree+1}.
-    // They send corresponding block of shares to other parties.
-    octetStreams os_send(n_players); // *BUG LOG: the size of octetStream should be n_players rather n_relevant_players.
-    octetStreams os_receive(n_relevant_players); // *BUG LOG: the size of octetStream should be n_relevant_players.
-    for(size_t i = 0; i < n_relevant_players; i++){
-        reveal_block_from_party_request(i, os_send, os_receive[i]);
-    }
+    int n_relevant_players = degree + 1; 
     
-    for(size_t i = 0; i < n_relevant_players; i++){
-        finish_reveal_block_from_party(i, os_send, os_receive[i]);
-    }
+    size_t start, n, cs, cn;
+    partition_elements(P->my_num(), start, n);
+#ifdef FIRST_RESPONDERS
+    // The first responders are taken on whole blocks of shares.
+    const bool chunked = false;
+#else
+    const bool chunked = true;
+#endif
 
-    // If P is in the reconstruction set, the shares of P are not sent to P because we avoid the loopback.
-    // Hence, we need to fill our own shares in os_send into the os_receive.
-    if(is_in_reconstruction_set(degree)){
-        os_receive[P->my_num()] = os_send[P->my_num()];
+    // Views of the chunks of other blocks of shares to send. The views are the ids of the sends.
+    vector<octetViews> os_send;
+    vector<int> send_to;
+    if(is_responder(degree)){
+        for(int i = 0; i < n_players; i++)
+        if(i != P->my_num()){
+            size_t start_i, n_i;
+            partition_elements(i, start_i, n_i);
+            size_t chunk = chunked ? dispersed_chunk(n_i) : 0;
+            for(size_t c = 0; c < n_chunks(n_i, chunk); c++){
+                chunk_elements(start_i, n_i, chunk, c, cs, cn);
+                os_send.emplace_back();
+                view_elements(shares, cs, cn, os_send.back());
+                send_to.push_back(i);
+            }
+        }
+        for(size_t k = 0; k < os_send.size(); k++)
+            P->request_send(send_to[k], os_send[k]);
     }
-    
-    // Each party calculate the corresponding block of secrets.
-    size_t startRow, nRows;
-    partition_rows(startRow, nRows);
-    calculate_block_secrets(degree, startRow, nRows, os_receive);
-    
-}
-
-
 
-/**
- * @brief Partition the matrix and reveal each block to corresponding party.
- * This is the request part of the above functionality.
- * Every party request to send blocks of shares to different party.
- * The receiver request to receive the corresponding block of shares.
- * It is the similar process with the input as every party distribute different block of shares to different party.
- * 
- * @param player_no Player ID who sends blocks of shares to different parties.
- * @param os_send Stores the different blocks of shares.
- * @param o_receive 
- */
-void ShareBundle::reveal_block_from_party_request(int player_no, octetStreams &os_send, octetStream &o_receive)
-{
-    if(P->my_num() == player_no){
-        pack_rows(shares, os_send);
-        P->request_send_respective(os_send);
-    }else{P->request_receive(player_no, o_receive);}
-}
+#ifdef FIRST_RESPONDERS
+    // Each party reconstructs its block from the first blocks of shares to arrive, and then passes it on in chunks.
+    gfpMatrix<Field> first_sharings(n_relevant_players, n);
+    const gfpVector<Field> &reconstruction = receive_first_sharings(degree, shares.data() + start, first_sharings);
+    request_more();
+    calculate_block_secrets(reconstruction, start, n, first_sharings);
+    for(size_t c = 0; c < n_chunks(n, dispersed_chunk(n)); c++){
+        chunk_elements(start, n, dispersed_chunk(n), c, cs, cn);
+        on_chunk(cs, cn);
+    }
+#else
+    // The chunk of shares from the i-th relevant party is received straight into its segment of sharings.row(i).
+    size_t chunk = dispersed_chunk(n), chunks = n_chunks(n, chunk);
+    gfpMatrix<Field> sharings(n_relevant_players, n);
+    vector<octetViews> os_receive(chunks * n_relevant_players);
+    for(size_t c = 0; c < chunks; c++){
+        chunk_elements(start, n, chunk, c, cs, cn);
+        for(int i = 0; i < n_relevant_players; i++)
+        if(i != P->my_num()){
+            view_elements(sharings, i * n + cs - start, cn, os_receive[c * n_relevant_players + i]);
+            P->request_receive(i, os_receive[c * n_relevant_players + i]);
+        }
+    }
+    request_more();
 
-// The wait part of the above functionality.
-void ShareBundle::finish_reveal_block_from_party(int player_no, octetStreams &os_send, octetStream &o_receive)
-{
-    if(P->my_num() == player_no){
-        P->wait_send_respective(os_send);
-    }else{
-        P->wait_receive(player_no, o_receive);
+    const gfpVector<Field> &reconstruction = (degree==threshold) ? reconstruction_vector_t : reconstruction_vector_2t;
+    for(size_t c = 0; c < chunks; c++){
+        chunk_elements(start, n, chunk, c, cs, cn);
+        for(int i = 0; i < n_relevant_players; i++)
+        if(i != P->my_num()){
+            P->wait_receive(i, os_receive[c * n_relevant_players + i]);
+        }
+        // If P is in the reconstruction set, the shares of P are not sent to P because we avoid the loopback.
+        // Hence, we need to fill our own chunk of shares into the sharings.
+        if(is_in_reconstruction_set(degree)){
+            sharings.row(P->my_num()).segment(cs - start, cn) = Map<const gfpVector<Field>>(shares.data() + cs, cn).transpose();
+        }
+        // Calculate the chunk of secrets.
+        Map<gfpVector<Field>>(secrets.data() + cs, cn) = (reconstruction.transpose() * sharings.middleCols(cs - start, cn)).transpose();
+        on_chunk(cs, cn);
     }
+#endif
+
+    for(size_t k = 0; k < os_send.size(); k++)
+        P->wait_send(send_to[k], os_send[k]);
 }
 
 /**
- * @brief Patition the matrix on row-grained.
+ * @brief Patition the matrix on element-grained.
  * Each party is responsible for one block.
- * The party sends the corresponding block of shares.
- * The receiver waits for the corresponding block of shares. 
+ * The party sends the corresponding block of sharings chunk by chunk, each as soon as it is calculated.
+ * The receiver waits for the corresponding chunks of shares. 
  * 
  */
-void ShareBundle::input_blocks_dispersed()
+template<class Field>
+void ShareBundle<Field>::input_blocks_dispersed()
 {
-    size_t blk_rows = rows() / n_players;
-    size_t first_blk_rows = rows() - blk_rows * (n_players - 1);
-    octetStreams os_send(n_players), os_receive(n_players);
+    size_t start, n, cs, cn;
+    partition_elements(P->my_num(), start, n);
+    // Each chunk of my block is sent from its own buffers, which stay alive until the sends are waited.
+    vector<octetStreams> os_send(n_chunks(n, dispersed_chunk(n)));
+    for(auto &os: os_send)
+        os.reset(n_players);
+    vector<octetViews> os_receive; // The chunks of shares are received straight into the matrix.
+    for(int i = 0; i < n_players; i++){
+        partition_elements(i, start, n);
+        os_receive.resize(os_receive.size() + n_chunks(n, dispersed_chunk(n)));
+    }
 
     // Request part of input.
-    // P0 input d (=first_blk_rows) rows of the secrets, starting from row(0);
-    input_block_from_party_request(0, 0, first_blk_rows, os_send, os_receive[0]);
-    // Other parties input the next consecutive d'(=blk_rows) rows of the secrets.
-    for(size_t i = 1, startRow = first_blk_rows; i < n_players; i++, startRow += blk_rows){
-        input_block_from_party_request(i, startRow, blk_rows, os_send, os_receive[i]);
+    // Pi inputs the i-th block of consecutive elements of the secrets.
+    for(int i = 0, k = 0; i < n_players; i++){
+        partition_elements(i, start, n);
+        for(size_t c = 0; c < n_chunks(n, dispersed_chunk(n)); c++, k++){
+            chunk_elements(start, n, dispersed_chunk(n), c, cs, cn);
+            size_t mine = (i == P->my_num()) ? c : 0;
+            input_block_from_party_request(i, cs, cn, os_send[mine], os_receive[k]);
+        }
     }
 
     // Wait part of input.
-    finish_input_block_from_party(0, 0, first_blk_rows, os_send, os_receive[0]);
-    for(size_t i = 1, startRow = first_blk_rows; i < n_players; i++, startRow += blk_rows){
-        finish_input_block_from_party(i, startRow, blk_rows, os_send, os_receive[i]);
+    for(int i = 0, k = 0; i < n_players; i++){
+        partition_elements(i, start, n);
+        for(size_t c = 0; c < n_chunks(n, dispersed_chunk(n)); c++, k++){
+            size_t mine = (i == P->my_num()) ? c : 0;
+            finish_input_block_from_party(i, os_send[mine], os_receive[k]);
+        }
     }
 }
 
@@ -1232,27 +1437,32 @@ void ShareBundle::input_blocks_dispersed()
  * @brief Request part of the dispersed input.
  * 
  * @param player_no 
- * @param startRow start row of the block.
- * @param nRows number of rows in the block.
+ * @param start start element of the block.
+ * @param n number of elements in the block.
  * @param os_send octetStream to store the calculated sharings.
- * @param o_receive octetStream to receive the shares
+ * @param o_receive views of the block of shares to receive
  */
-void ShareBundle::input_block_from_party_request(int player_no, const int &startRow, const int &nRows, octetStreams &os_send, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::input_block_from_party_request(int player_no, const size_t &start, const size_t &n, octetStreams &os_send, octetViews &o_receive)
 {
     if(player_no == P->my_num()){
-        calculate_block_sharings(degree, startRow, nRows, os_send);
+        calculate_block_sharings(degree, start, n, os_send);
         P->request_send_respective(os_send);
-    }else{P->request_receive(player_no, o_receive);}
+    }else{
+        o_receive.clear();
+        view_elements(shares, start, n, o_receive);
+        P->request_receive(player_no, o_receive);
+    }
 }
 
 // Wait part of the dispersed input.
-void ShareBundle::finish_input_block_from_party(int player_no, const int &startRow, const int &nRows, octetStreams &os_send, octetStream &o_receive)
+template<class Field>
+void ShareBundle<Field>::finish_input_block_from_party(int player_no, octetStreams &os_send, octetViews &o_receive)
 {
     if(player_no == P->my_num()){
         P->wait_send_respective(os_send);
     }else{
         P->wait_receive(player_no, o_receive);
-        unpack_rows(shares, startRow, nRows, o_receive);
     }
 }
 
@@ -1261,14 +1471,18 @@ void ShareBundle::finish_input_block_from_party(int player_no, const int &startR
  *       Random Methods
  * 
  * *******************************************************************/
-ShareBundle& ShareBundle::random()
+template<class Field>
+ShareBundle<Field>& ShareBundle<Field>::random()
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(0);
     return *this;
 #endif
 
-    if(!Phase->is_true_offline()){
+    if(Phase->is_producing()){
+        Phase->request_random_sharings(size());
+    }
+    else if(!Phase->is_true_offline()){
         if(Phase->is_Offline()){
             Phase->generate_random_sharings(size());
         }
@@ -1278,7 +1492,7 @@ ShareBundle& ShareBundle::random()
             Phase->switch_to_online();
         }
     }
-    RandomShare::get_randoms(RandomShare::queueRandom, shares);
+    RandomShare<Field>::get_randoms(RandomShare<Field>::queueRandom, shares);
     return *this;
 }
 
@@ -1296,13 +1510,14 @@ ShareBundle& ShareBundle::random()
  * 
  * @return ShareBundle 
  */
-ShareBundle ShareBundle::unbounded_prefix_mult()
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::unbounded_prefix_mult()
 {
-    DoubleShareBundle R(rows(), cols());
+    DoubleShareBundle<Field> R(rows(), cols());
     R.unbounded_prefix_mult_random();
 
-    ShareBundle res(rows(), cols());
-    res.shares = shares.array() * R.aux_shares.array();
+    ShareBundle<Field> res(rows(), cols());
+    cwise_mul(shares, R.aux_shares, res.shares);
 
     // TODO: Use PRZS
     // res.reduce_degree();
@@ -1314,15 +1529,16 @@ ShareBundle ShareBundle::unbounded_prefix_mult()
         res.secrets.col(i) = res.secrets.col(i).array() * res.secrets.col(i-1).array();
     }
 
-    res.shares = res.secrets.array() * R.shares.array();
+    cwise_mul(res.secrets, R.shares, res.shares);
     return res;
 }
 
-ShareBundle ShareBundle::unbounded_postfix_mult()
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::unbounded_postfix_mult()
 {
-    ShareBundle reverseShareBundle(rows(), cols());
+    ShareBundle<Field> reverseShareBundle(rows(), cols());
     reverseShareBundle.shares = shares.rowwise().reverse();
-    ShareBundle res = reverseShareBundle.unbounded_prefix_mult();
+    ShareBundle<Field> res = reverseShareBundle.unbounded_prefix_mult();
     res.shares.rowwise().reverseInPlace();
     return res;
 }
@@ -1334,21 +1550,22 @@ ShareBundle ShareBundle::unbounded_postfix_mult()
  * 
  * @return ShareBundle 
  */
-ShareBundle ShareBundle::unbounded_mult()
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::unbounded_mult()
 {
-    DoubleShareBundle R(rows(), cols());
+    DoubleShareBundle<Field> R(rows(), cols());
     R.unbounded_prefix_mult_random();
     
 
-    ShareBundle res(rows(), cols());
-    res.shares = shares.array() * R.aux_shares.array();
+    ShareBundle<Field> res(rows(), cols());
+    cwise_mul(shares, R.aux_shares, res.shares);
     // res.reduce_degree();// TODO: Use PRZS
 
     res.double_degree();
     res.reveal();
 
     // * The following is different compared to the above functionality. 
-    ShareBundle prod(rows(), 1);
+    ShareBundle<Field> prod(rows(), 1);
     prod.shares = R.shares.rightCols(1);
     for(size_t i = 0; i < cols(); i++){
         prod.shares = prod.shares.array() * res.secrets.col(i).array();
@@ -1364,49 +1581,51 @@ ShareBundle ShareBundle::unbounded_mult()
  * @param degree 
  * @return ShareBundle 
  */
-ShareBundle ShareBundle::evalFunc(string fn, size_t degree)
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::evalFunc(string fn, size_t degree)
 {
-    gfpVector funcConsts = getFuncConsts(fn, degree);
-    ShareBundle expandMatrix(size(), degree); // Each row corresponds to one entry.
+    gfpVector<Field> funcConsts = getFuncConsts<Field>(fn, degree);
+    ShareBundle<Field> expandMatrix(size(), degree); // Each row corresponds to one entry.
     for(size_t i = 0; i < size(); i++){
         expandMatrix.shares.row(i).setConstant(shares(i));
     }
-    ShareBundle powMatrix = expandMatrix.unbounded_prefix_mult();// Calculate pow of each entry.
+    ShareBundle<Field> powMatrix = expandMatrix.unbounded_prefix_mult();// Calculate pow of each entry.
 
-    gfpMatrix powMatrixPrime(size(), degree+1);
+    gfpMatrix<Field> powMatrixPrime(size(), degree+1);
     powMatrixPrime.col(0).setConstant(1); // Pad 1 for the free coefficient.
     powMatrixPrime.middleCols(1, degree) = powMatrix.shares;
     
-    ShareBundle res(rows(), cols());
-    res.shares = (powMatrixPrime * funcConsts).reshaped<RowMajor>(rows(), cols()); // Evaluate the function given the coefficients.
+    ShareBundle<Field> res(rows(), cols());
+    res.shares = (powMatrixPrime * funcConsts).template reshaped<RowMajor>(rows(), cols()); // Evaluate the function given the coefficients.
     return res;
 }
 
 
 // Get the least significant bit.
-BitBundle ShareBundle::get_LSB()const
+template<class Field>
+BitBundle<Field> ShareBundle<Field>::get_LSB()const
 {
-    BitBundle rBits(size());// size() by BITS_LENGTH
-    ShareBundle rField(rows(), cols());
+    BitBundle<Field> rBits(size());// size() by BITS_LENGTH
+    ShareBundle<Field> rField(rows(), cols());
     rBits.solved_random(rField);
 
-    BitBundle rLSB(rows(), cols());
-    rLSB.shares = rBits.shares.col(0).reshaped<RowMajor>(rows(), cols());
+    BitBundle<Field> rLSB(rows(), cols());
+    rLSB.shares = rBits.shares.col(0).template reshaped<RowMajor>(rows(), cols());
 
-    ShareBundle mask(rows(), cols());
-    mask.shares = shares + rField.shares;
+    ShareBundle<Field> mask(rows(), cols());
+    cwise_add(shares, rField.shares, mask.shares);
     mask.reveal();
 
-    gfpMatrix maskLSB(rows(), cols());
+    gfpMatrix<Field> maskLSB(rows(), cols());
     for(size_t i = 0; i < size(); i++){
         maskLSB(i) = mask.secret()(i) & 1;
     }
 
-    BitBundle lsb = bitwise_xor(rLSB, maskLSB);
+    BitBundle<Field> lsb = bitwise_xor(rLSB, maskLSB);
 
     mask.resize(rows()*cols(), 1);// ->vector.
 
-    gfpMatrix maskBits(rows()*cols(), BITS_LENGTH);
+    gfpMatrix<Field> maskBits(rows()*cols(), Field::BITS_LENGTH);
     
     // decompose_bits(mask.secret(), BITS_LENGTH, maskBits);
     
@@ -1420,65 +1639,70 @@ BitBundle ShareBundle::get_LSB()const
     // is_wrap.shares = 1 - is_wrap.shares.array();
 
     // A Third way: compute LT(p-rBits, p-masked)
-    decompose_bits(-mask.secret(), BITS_LENGTH, maskBits);
-    rBits.shares = 1 - rBits.shares.array();
-    BitBundle is_wrap = less_than_unsigned(rBits, maskBits);
+    decompose_bits(-mask.secret(), Field::BITS_LENGTH, maskBits);
+    cwise_sub(1, rBits.shares, rBits.shares);
+    BitBundle<Field> is_wrap = less_than_unsigned(rBits, maskBits);
 
     is_wrap.resize(rows(), cols());
     
     return bitwise_xor(lsb, is_wrap);
 }
 
-BitBundle ShareBundle::get_MSB()const
+template<class Field>
+BitBundle<Field> ShareBundle<Field>::get_MSB()const
 {
-    ShareBundle res(rows(), cols());
-    res.shares = 2 * shares.array();
+    ShareBundle<Field> res(rows(), cols());
+    cwise_add(shares, shares, res.shares);
     return res.get_LSB();
 }
 
-BitBundle ShareBundle::deltaReLU()const
+template<class Field>
+BitBundle<Field> ShareBundle<Field>::deltaReLU()const
 {
-    BitBundle res(rows(), cols());
+    BitBundle<Field> res(rows(), cols());
     res.shares.setConstant(1);
     res.shares -= get_MSB().shares;
     return res;
 }
 
-ShareBundle ShareBundle::ReLU()const
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::ReLU()const
 {
-    ShareBundle res(rows(), cols());
-    res.shares = shares.array() * deltaReLU().shares.array();
+    ShareBundle<Field> res(rows(), cols());
+    cwise_mul(shares, deltaReLU().shares, res.shares);
     res.reduce_degree();
     return res;
 }
 
 // Get ReLUPrime and ReLU
-void ShareBundle::ReLU(ShareBundle &reluPrime, ShareBundle &relu)const
+template<class Field>
+void ShareBundle<Field>::ReLU(ShareBundle<Field> &reluPrime, ShareBundle<Field> &relu)const
 {
     reluPrime = deltaReLU();
-    relu.shares = shares.array() * reluPrime.shares.array();
+    cwise_mul(shares, reluPrime.shares, relu.shares);
     relu.reduce_degree();
     return;
 }
 
 // * Test for two rounds ReLU.
 // More elegant implementation is referred to ReLU_opt
-void ShareBundle::ReLU_opt_test(ShareBundle &deltaReLU, ShareBundle &relu)const
+template<class Field>
+void ShareBundle<Field>::ReLU_opt_test(ShareBundle<Field> &deltaReLU, ShareBundle<Field> &relu)const
 {
-    ShareBundle x(rows(), cols());
-    x.shares = 2 * shares.array();
+    ShareBundle<Field> x(rows(), cols());
+    cwise_add(shares, shares, x.shares);
 
     // x0 (LSB) = x0_prime * x0_prime
-    ShareBundle x0_prime = x.get_LSB_impared();
+    ShareBundle<Field> x0_prime = x.get_LSB_impared();
 
     // Two layer multiplication:
     // 1. The first layer: compute the last layer of mult in LSB circuit
     // 2. The second layer: only the first input wire is from the output of the first layer.
-    ShareBundle x0(rows(), cols());
-    x0.shares = x0_prime.shares.array() * x0_prime.shares.array();
+    ShareBundle<Field> x0(rows(), cols());
+    cwise_mul(x0_prime.shares, x0_prime.shares, x0.shares);
 
     // This triple is to compute [x0]_t * [y]_t where [x0]_t = u - [a]_t
-    BeaverTriple triple(rows(), cols());
+    BeaverTriple<Field> triple(rows(), cols());
     x0.reduce_degree_1stLayer(*this, triple);
 
     // deltaReLU = 1 - MSB(x') = 1 - LSB(x) where x = 2x' and MSB(x')=LSB(2x')
@@ -1486,8 +1710,8 @@ void ShareBundle::ReLU_opt_test(ShareBundle &deltaReLU, ShareBundle &relu)const
 
     // 2. The second layer:
     // The first input wire changes from [x0] to (-[x0]) + 1.
-    deltaReLU.shares = 1 - x0.shares.array();
-    triple.x_times(-gfpScalar(1)).x_plus(1); // (-x) + 1
+    cwise_sub(1, x0.shares, deltaReLU.shares);
+    triple.x_times(-gfpScalar<Field>(1)).x_plus(1); // (-x) + 1
     
     relu = triple.mult();
     return;
@@ -1496,33 +1720,34 @@ void ShareBundle::ReLU_opt_test(ShareBundle &deltaReLU, ShareBundle &relu)const
 // Get the least significant bit without the last xor step.
 // We remove the last layer of multiplication in LSB circuit.
 // We want to compose a two-layer multiplication, which can be computed in one round, rather than two rounds.
-ShareBundle ShareBundle::get_LSB_impared()const
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::get_LSB_impared()const
 {
-    BitBundle rBits(size());// size() by BITS_LENGTH
-    ShareBundle rField(rows(), cols());
+    BitBundle<Field> rBits(size());// size() by BITS_LENGTH
+    ShareBundle<Field> rField(rows(), cols());
     rBits.solved_random(rField);
 
-    BitBundle rLSB(rows(), cols());
-    rLSB.shares = rBits.shares.col(0).reshaped<RowMajor>(rows(), cols());
+    BitBundle<Field> rLSB(rows(), cols());
+    rLSB.shares = rBits.shares.col(0).template reshaped<RowMajor>(rows(), cols());
 
-    ShareBundle mask(rows(), cols());
-    mask.shares = shares + rField.shares;
+    ShareBundle<Field> mask(rows(), cols());
+    cwise_add(shares, rField.shares, mask.shares);
     mask.reveal();
 
-    gfpMatrix maskLSB(rows(), cols());
+    gfpMatrix<Field> maskLSB(rows(), cols());
     for(size_t i = 0; i < size(); i++){
         maskLSB(i) = mask.secret()(i) & 1;
     }
 
-    BitBundle lsb = bitwise_xor(rLSB, maskLSB);
+    BitBundle<Field> lsb = bitwise_xor(rLSB, maskLSB);
 
     mask.resize(rows()*cols(), 1);// ->vector.
-    gfpMatrix maskBits(rows()*cols(), BITS_LENGTH);
+    gfpMatrix<Field> maskBits(rows()*cols(), Field::BITS_LENGTH);
     
-    decompose_bits(-mask.secret(), BITS_LENGTH, maskBits);
-    rBits.shares = 1 - rBits.shares.array();
+    decompose_bits(-mask.secret(), Field::BITS_LENGTH, maskBits);
+    cwise_sub(1, rBits.shares, rBits.shares);
 
-    BitBundle is_wrap = less_than_unsigned(rBits, maskBits);
+    BitBundle<Field> is_wrap = less_than_unsigned(rBits, maskBits);
 
 
     is_wrap.resize(rows(), cols());
@@ -1531,47 +1756,51 @@ ShareBundle ShareBundle::get_LSB_impared()const
     // return bitwise_xor(lsb, is_wrap);
 
     // New return which eliminates the last multiplication.
-    ShareBundle ret_diff(rows(), cols());
-    ret_diff.shares = lsb.shares - is_wrap.shares;
+    ShareBundle<Field> ret_diff(rows(), cols());
+    cwise_sub(lsb.shares, is_wrap.shares, ret_diff.shares);
     return ret_diff;
 }
 
-BitBundle ShareBundle::get_LSB_opt(vector<ShareBundle> &y, vector<BeaverTriple> &triples)const
+template<class Field>
+BitBundle<Field> ShareBundle<Field>::get_LSB_opt(vector<ShareBundle<Field>> &y, vector<BeaverTriple<Field>> &triples)const
 {
-    ShareBundle x0_prime = get_LSB_impared();
+    ShareBundle<Field> x0_prime = get_LSB_impared();
 
     // 1. The first layer of mult.
-    BitBundle x0(rows(), cols());
-    x0.shares = x0_prime.shares.array() * x0_prime.shares.array(); // reduce the degree
+    BitBundle<Field> x0(rows(), cols());
+    cwise_mul(x0_prime.shares, x0_prime.shares, x0.shares); // reduce the degree
     x0.reduce_degree_1stLayer(y, triples); // compute the BeaverTriple for the second layer of mult
     return x0;
 }
 
-BitBundle ShareBundle::get_MSB_opt(vector<ShareBundle> &y, vector<BeaverTriple> &triples)const
+template<class Field>
+BitBundle<Field> ShareBundle<Field>::get_MSB_opt(vector<ShareBundle<Field>> &y, vector<BeaverTriple<Field>> &triples)const
 {
     // MSB(x) = LSB(2x)
-    ShareBundle res(rows(), cols());
-    res.shares = 2 * shares.array();
+    ShareBundle<Field> res(rows(), cols());
+    cwise_add(shares, shares, res.shares);
     return res.get_LSB_opt(y, triples);
 }
 
-BitBundle ShareBundle::deltaReLU_opt(vector<ShareBundle> &y, vector<BeaverTriple> &triples)const
+template<class Field>
+BitBundle<Field> ShareBundle<Field>::deltaReLU_opt(vector<ShareBundle<Field>> &y, vector<BeaverTriple<Field>> &triples)const
 {
-    BitBundle res = get_MSB_opt(y, triples);
+    BitBundle<Field> res = get_MSB_opt(y, triples);
     // res = 1 - res
-    res.shares = 1 - res.shares.array();
+    cwise_sub(1, res.shares, res.shares);
     for(size_t i = 0; i < triples.size(); i++){
-        triples[i].x_times(-gfpScalar(1)).x_plus(1);
+        triples[i].x_times(-gfpScalar<Field>(1)).x_plus(1);
     }
     return res;
 }
 
 // Optimize ReLU with 2-layer DN multiplication;
-void ShareBundle::ReLU_opt(ShareBundle &deltaReLU, ShareBundle &relu)const
+template<class Field>
+void ShareBundle<Field>::ReLU_opt(ShareBundle<Field> &deltaReLU, ShareBundle<Field> &relu)const
 {
-    vector<ShareBundle> y{*this};
+    vector<ShareBundle<Field>> y{*this};
 
-    vector<BeaverTriple> triples{BeaverTriple(rows(), cols())};
+    vector<BeaverTriple<Field>> triples{BeaverTriple<Field>(rows(), cols())};
     
     deltaReLU.shares = deltaReLU_opt(y, triples).shares;
     relu.shares = triples[0].mult().shares;
@@ -1579,9 +1808,10 @@ void ShareBundle::ReLU_opt(ShareBundle &deltaReLU, ShareBundle &relu)const
 }
 
 // Only return ReLU
-ShareBundle ShareBundle::ReLU_opt()const
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::ReLU_opt()const
 {
-    ShareBundle reluPrime(rows(), cols()), relu(rows(), cols());
+    ShareBundle<Field> reluPrime(rows(), cols()), relu(rows(), cols());
     ReLU_opt(reluPrime, relu);
     return relu;
 }
@@ -1590,27 +1820,28 @@ ShareBundle ShareBundle::ReLU_opt()const
 
 // The sequential method to get MaxPool and MaxPoolPrime.
 // Time is propotional to length of max.
-void ShareBundle::seqMaxpoolRowwise(ShareBundle &maxRes, ShareBundle &maxIdx)const
+template<class Field>
+void ShareBundle<Field>::seqMaxpoolRowwise(ShareBundle<Field> &maxRes, ShareBundle<Field> &maxIdx)const
 {
     assert(maxRes.cols()==1);
     // maxRes.shares = shares.col(0);
     // maxIdx.shares.setConstant(0);
     // maxIdx.shares.col(0).setConstant(1);
 
-    ShareBundle maxTmp(rows(), cols()+1);
+    ShareBundle<Field> maxTmp(rows(), cols()+1);
     maxTmp.shares.col(0) = shares.col(0); //It stores the max value of each row.
     maxTmp.shares.rightCols(cols()).setConstant(0);// It stores the max idx vector.
     maxTmp.shares.col(1).setConstant(1);
 
     for(size_t i = 1; i < cols(); i++){
-        ShareBundle deltaMax(rows(), 1);
+        ShareBundle<Field> deltaMax(rows(), 1);
         deltaMax.shares = maxTmp.shares.col(0) - shares.col(i);
         
-        gfpMatrix currentIdx(1, cols());
+        gfpMatrix<Field> currentIdx(1, cols());
         currentIdx.setConstant(0);
         currentIdx(0, i) = 1;
 
-        ShareBundle cond = deltaMax.deltaReLU(); // cond = 0 : need to update
+        ShareBundle<Field> cond = deltaMax.deltaReLU(); // cond = 0 : need to update
         // Update the max value
         maxTmp.shares.col(0) = (1 - cond.shares.array()) * shares.col(i).array() + cond.shares.array() * maxTmp.shares.col(0).array();
 
@@ -1635,20 +1866,21 @@ void ShareBundle::seqMaxpoolRowwise(ShareBundle &maxRes, ShareBundle &maxIdx)con
  * @param maxIdx [out] The one-hot index. Note: the maxIdx must initialized with all ones vector.
  * @return ShareBundle [out] The max value of each row.
  */
-ShareBundle ShareBundle::hierMaxpoolRowwise(int depth, size_t nCols, const ShareBundle &origin, ShareBundle &maxIdx)const
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::hierMaxpoolRowwise(int depth, size_t nCols, const ShareBundle<Field> &origin, ShareBundle<Field> &maxIdx)const
 {
     size_t ySize = nCols/2;
     if(nCols%2==1){ySize++;}
     int blkSize = 1<<depth;// depth starts from 1
 
-    ShareBundle blkBundle(rows(), nCols/2);
+    ShareBundle<Field> blkBundle(rows(), nCols/2);
     for(size_t i = 0; i < nCols/2; i++){
         blkBundle.shares.col(i) = shares.col(i*2) - shares.col(i*2+1);
     }
-    ShareBundle cond = blkBundle.deltaReLU(); // cond = 1, left > right -> max = (i*2)
+    ShareBundle<Field> cond = blkBundle.deltaReLU(); // cond = 1, left > right -> max = (i*2)
     // cout<<cond.reveal()<<endl;
 
-    ShareBundle maxBundle(rows(), ySize);
+    ShareBundle<Field> maxBundle(rows(), ySize);
     for(size_t i = 0; i < nCols/2; i++){
         // max(a_{i*2}, a_{i*2+1}) = cond_i * a_{i*2} + (1-cond_i) * a_{i*2+1}
         maxBundle.shares.col(i) = cond.shares.col(i).array() * shares.col(i*2).array() + (1 - cond.shares.col(i).array()) * shares.col(i*2+1).array();
@@ -1658,15 +1890,15 @@ ShareBundle ShareBundle::hierMaxpoolRowwise(int depth, size_t nCols, const Share
         // cout<<leftBlkSize<<" "<<rightBlkSize<<endl;
         // gfpMatrix(col.rowwise().replicate(N)): replicate N cols
         // maxIdx.shares.middleCols(start, leftBlkSize) = cond.shares.col(i).array() * maxIdx.shares.middleCols(start, leftBlkSize).array();
-        maxIdx.shares.middleCols(start, leftBlkSize) = gfpMatrix(cond.shares.col(i).rowwise().replicate(leftBlkSize)).array() * maxIdx.shares.middleCols(start, leftBlkSize).array();
+        maxIdx.shares.middleCols(start, leftBlkSize) = gfpMatrix<Field>(cond.shares.col(i).rowwise().replicate(leftBlkSize)).array() * maxIdx.shares.middleCols(start, leftBlkSize).array();
         // maxIdx.shares.middleCols(start+leftBlkSize, rightBlkSize) = (1 - cond.shares.col(i).array()) * maxIdx.shares.middleCols(start+leftBlkSize, rightBlkSize).array();
-        maxIdx.shares.middleCols(start+leftBlkSize, rightBlkSize) = gfpMatrix((1 - cond.shares.col(i).array()).rowwise().replicate(rightBlkSize)).array() * maxIdx.shares.middleCols(start+leftBlkSize, rightBlkSize).array();
+        maxIdx.shares.middleCols(start+leftBlkSize, rightBlkSize) = gfpMatrix<Field>((1 - cond.shares.col(i).array()).rowwise().replicate(rightBlkSize)).array() * maxIdx.shares.middleCols(start+leftBlkSize, rightBlkSize).array();
     }
     // maxBundle.reduce_degree();
     // maxIdx.reduce_degree();
 
     // Reduce degree at the same time.
-    ShareBundle tmpMatrix(rows(), maxBundle.cols()+maxIdx.cols());
+    ShareBundle<Field> tmpMatrix(rows(), maxBundle.cols()+maxIdx.cols());
     tmpMatrix.shares<<maxBundle.shares, maxIdx.shares;
     tmpMatrix.reduce_degree();
     maxBundle.shares = tmpMatrix.shares.leftCols(maxBundle.cols());
@@ -1699,26 +1931,27 @@ ShareBundle ShareBundle::hierMaxpoolRowwise(int depth, size_t nCols, const Share
  * @param maxIdx 
  * @return ShareBundle 
  */
-ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const ShareBundle &origin, ShareBundle &maxIdx)const
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::hierMaxpoolRowwise_opt(int depth, size_t nCols, const ShareBundle<Field> &origin, ShareBundle<Field> &maxIdx)const
 {
     size_t ySize = nCols/2;
     if(nCols%2==1){ySize++;}
     int blkSize = 1<<depth;// depth starts from 1
 
-    ShareBundle tmp(rows(), cols());
+    ShareBundle<Field> tmp(rows(), cols());
     tmp.shares = shares;
-    ShareBundle blkBundle(rows(), nCols/2);// cond = 1, left > right -> max = (i*2)
+    ShareBundle<Field> blkBundle(rows(), nCols/2);// cond = 1, left > right -> max = (i*2)
     for(size_t i = 0; i < nCols/2; i++){
         blkBundle.shares.col(i) = shares.col(i*2) - shares.col(i*2+1);
     }
 
-    ShareBundle cond(rows(), nCols/2);
+    ShareBundle<Field> cond(rows(), nCols/2);
 
-    vector<ShareBundle>y;
-    vector<BeaverTriple>triples;
+    vector<ShareBundle<Field>>y;
+    vector<BeaverTriple<Field>>triples;
 
     // This triple is for the max value.
-    ShareBundle y0(rows(), nCols/2); //y0 = (a_{i*2} - a_{i*2+1})
+    ShareBundle<Field> y0(rows(), nCols/2); //y0 = (a_{i*2} - a_{i*2+1})
     for(size_t i = 0; i < nCols/2; i++){
         // max(a_{i*2}, a_{i*2+1}) = cond_i * a_{i*2} + (1-cond_i) * a_{i*2+1}
         //                         = cond_i * (a_{i*2} - a_{i*2+1}) + a_{i*2+1}
@@ -1727,39 +1960,39 @@ ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const S
         y0.shares.col(i) = shares.col(i*2) - shares.col(i*2+1);
     }
     y.push_back(y0);
-    triples.push_back(BeaverTriple(rows(), nCols/2));
+    triples.push_back(BeaverTriple<Field>(rows(), nCols/2));
 
     // These triples are for the max idx
     size_t leftBlkSize = blkSize/2;
     size_t rightBlkSize = (leftBlkSize*2 > origin.cols()) ? origin.cols() - leftBlkSize : leftBlkSize;
     if(rightBlkSize == leftBlkSize){// not the last layer
         for(size_t i = 0; i < leftBlkSize; i++){// store the leftBlk
-            ShareBundle yi(rows(), nCols/2);
+            ShareBundle<Field> yi(rows(), nCols/2);
             for(size_t j = 0, k = i; j < nCols/2; j++, k+=blkSize){
                 yi.shares.col(j) = maxIdx.shares.col(k);
             }
             y.push_back(yi);
-            triples.push_back(BeaverTriple(rows(), nCols/2));
+            triples.push_back(BeaverTriple<Field>(rows(), nCols/2));
         }
 
         for(size_t i = 0; i < rightBlkSize; i++){// store the rightBlk
-            ShareBundle yi(rows(), nCols/2);
+            ShareBundle<Field> yi(rows(), nCols/2);
             for(size_t j = 0, k = i+leftBlkSize; j < nCols/2; j++, k+=blkSize){
                 yi.shares.col(j) = maxIdx.shares.col(k);
             }
             y.push_back(yi);
-            triples.push_back(BeaverTriple(rows(), nCols/2));
+            triples.push_back(BeaverTriple<Field>(rows(), nCols/2));
         }
     }else{
         // In the last layer, for example size = 20. The leftBlkSize is 16 while the rightBlkSize is 4.
         // Then the size of cols of cond is only 1.
         assert(cond.shares.cols()==1);
         for(size_t i = 0; i < origin.cols(); i++){
-            ShareBundle yi(rows(), 1);
+            ShareBundle<Field> yi(rows(), 1);
             yi.shares = maxIdx.shares.col(i);
 
             y.push_back(yi);
-            triples.push_back(BeaverTriple(rows(), 1));
+            triples.push_back(BeaverTriple<Field>(rows(), 1));
         }
     }
 
@@ -1768,7 +2001,7 @@ ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const S
     // Then decouple these triples to get the desired multiplication results.
 
     // First is the max value.
-    ShareBundle maxBundle(rows(), ySize);
+    ShareBundle<Field> maxBundle(rows(), ySize);
     maxBundle.shares.leftCols(nCols/2) = triples[0].mult().shares;
     for(size_t i = 0; i < nCols/2; i++){// Remember to add this value.
         maxBundle.shares.col(i) = maxBundle.shares.col(i) + shares.col(i*2+1);
@@ -1780,7 +2013,7 @@ ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const S
     size_t ttidx = 1;// triple idx
     if(rightBlkSize == leftBlkSize){// not the last layer
         for(size_t i = 0; i < leftBlkSize; i++){
-            ShareBundle cond_idx = triples[ttidx].mult();//cond*y
+            ShareBundle<Field> cond_idx = triples[ttidx].mult();//cond*y
             for(size_t j = 0, k = i; j < nCols/2; j++, k+=blkSize){
                 maxIdx.shares.col(k) = cond_idx.shares.col(j);
             }
@@ -1788,7 +2021,7 @@ ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const S
         }
 
         for(size_t i = 0; i < rightBlkSize; i++){// store the rightBlk
-            ShareBundle cond_idx = triples[ttidx].x_times(-gfpScalar(1)).x_plus(1).mult();// (1-cond)*y
+            ShareBundle<Field> cond_idx = triples[ttidx].x_times(-gfpScalar<Field>(1)).x_plus(1).mult();// (1-cond)*y
             for(size_t j = 0, k = i+leftBlkSize; j < nCols/2; j++, k+=blkSize){
                 maxIdx.shares.col(k) = cond_idx.shares.col(j);
             }
@@ -1797,13 +2030,13 @@ ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const S
     }else{
         assert(cond.shares.cols()==1);
         for(size_t i = 0; i < leftBlkSize; i++){
-            ShareBundle cond_idx = triples[ttidx].mult();//cond*y
+            ShareBundle<Field> cond_idx = triples[ttidx].mult();//cond*y
             maxIdx.shares.col(i) = cond_idx.shares;
             ttidx++;
         }
 
         for(size_t j = leftBlkSize; j < origin.cols(); j++){
-            ShareBundle cond_idx = triples[ttidx].x_times(-gfpScalar(1)).x_plus(1).mult();// (1-cond)*y
+            ShareBundle<Field> cond_idx = triples[ttidx].x_times(-gfpScalar<Field>(1)).x_plus(1).mult();// (1-cond)*y
             maxIdx.shares.col(j) = cond_idx.shares;
             ttidx++;
         }
@@ -1818,20 +2051,21 @@ ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const S
 }
 
 // Only evaluate the maximum value on each row.
-ShareBundle ShareBundle::hierMaxpoolRowwise(int depth, size_t nCols, const ShareBundle &origin)const
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::hierMaxpoolRowwise(int depth, size_t nCols, const ShareBundle<Field> &origin)const
 {
     size_t ySize = nCols/2;
     if(nCols%2==1){ySize++;}
     int blkSize = 1<<depth;// depth starts from 1
 
-    ShareBundle blkBundle(rows(), nCols/2);
+    ShareBundle<Field> blkBundle(rows(), nCols/2);
     for(size_t i = 0; i < nCols/2; i++){
         blkBundle.shares.col(i) = shares.col(i*2) - shares.col(i*2+1);
     }
-    ShareBundle cond = blkBundle.deltaReLU(); // cond = 1, left > right -> max = (i*2)
+    ShareBundle<Field> cond = blkBundle.deltaReLU(); // cond = 1, left > right -> max = (i*2)
     // cout<<cond.reveal()<<endl;
 
-    ShareBundle maxBundle(rows(), ySize);
+    ShareBundle<Field> maxBundle(rows(), ySize);
     for(size_t i = 0; i < nCols/2; i++){
         maxBundle.shares.col(i) = cond.shares.col(i).array() * shares.col(i*2).array() + (1 - cond.shares.col(i).array()) * shares.col(i*2+1).array();
     }
@@ -1849,25 +2083,26 @@ ShareBundle ShareBundle::hierMaxpoolRowwise(int depth, size_t nCols, const Share
 }
 
 // Only evaluates the maximum values.
-ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const ShareBundle &origin)const
+template<class Field>
+ShareBundle<Field> ShareBundle<Field>::hierMaxpoolRowwise_opt(int depth, size_t nCols, const ShareBundle<Field> &origin)const
 {
     size_t ySize = nCols/2;
     if(nCols%2==1){ySize++;}
     int blkSize = 1<<depth;// depth starts from 1
 
 
-    ShareBundle blkBundle(rows(), nCols/2);// cond = 1, left > right -> max = (i*2)
+    ShareBundle<Field> blkBundle(rows(), nCols/2);// cond = 1, left > right -> max = (i*2)
     for(size_t i = 0; i < nCols/2; i++){
         blkBundle.shares.col(i) = shares.col(i*2) - shares.col(i*2+1);
     }
 
-    ShareBundle cond(rows(), nCols/2);
+    ShareBundle<Field> cond(rows(), nCols/2);
 
-    vector<ShareBundle>y;
-    vector<BeaverTriple>triples;
+    vector<ShareBundle<Field>>y;
+    vector<BeaverTriple<Field>>triples;
 
     // This triple is for the max value.
-    ShareBundle y0(rows(), nCols/2); //y0 = (a_{i*2} - a_{i*2+1})
+    ShareBundle<Field> y0(rows(), nCols/2); //y0 = (a_{i*2} - a_{i*2+1})
     for(size_t i = 0; i < nCols/2; i++){
         // TODO: max(a_{i*2}, a_{i*2+1})=ReLU(a_{i*2+1}-a_{i*2}) + a_{i*2}
         // max(a_{i*2}, a_{i*2+1}) = cond_i * a_{i*2} + (1-cond_i) * a_{i*2+1}
@@ -1877,7 +2112,7 @@ ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const S
         y0.shares.col(i) = shares.col(i*2) - shares.col(i*2+1);
     }
     y.push_back(y0);
-    triples.push_back(BeaverTriple(rows(), nCols/2));
+    triples.push_back(BeaverTriple<Field>(rows(), nCols/2));
 
     // Just delete the part for calculating the maxIdx
 
@@ -1886,7 +2121,7 @@ ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const S
     // Then decouple these triples to get the desired multiplication results.
 
     // First is the max value.
-    ShareBundle maxBundle(rows(), ySize);
+    ShareBundle<Field> maxBundle(rows(), ySize);
     maxBundle.shares.leftCols(nCols/2) = triples[0].mult().shares;
     for(size_t i = 0; i < nCols/2; i++){// Remember to add this value.
         maxBundle.shares.col(i) = maxBundle.shares.col(i) + shares.col(i*2+1);
@@ -1906,7 +2141,8 @@ ShareBundle ShareBundle::hierMaxpoolRowwise_opt(int depth, size_t nCols, const S
 }
 
 // Wrapper for Max Prime rowwise.
-void ShareBundle::MaxPrimeRowwise(ShareBundle &maxIdx)const
+template<class Field>
+void ShareBundle<Field>::MaxPrimeRowwise(ShareBundle<Field> &maxIdx)const
 {
     // *Sequential way: O(l)
     // ShareBundle maxRes(rows(), 1);
@@ -1916,33 +2152,37 @@ void ShareBundle::MaxPrimeRowwise(ShareBundle &maxIdx)const
     // *Hierachical way: O(logl)
     // Remember to initalize.
     maxIdx.shares.setConstant(1);
-    ShareBundle maxRes(rows(), 1);
+    ShareBundle<Field> maxRes(rows(), 1);
     hierMaxpoolRowwise(1, cols(), *this, maxIdx);
     return;
 }
 
 // Wrapper for Max rowwise.
-void ShareBundle::MaxRowwise(ShareBundle &maxRes)const
+template<class Field>
+void ShareBundle<Field>::MaxRowwise(ShareBundle<Field> &maxRes)const
 {
     maxRes = hierMaxpoolRowwise(1, cols(), *this);
     return;
 }
 
 // Wrapper for Max and Maxprime rowwise.
-void ShareBundle::MaxRowwise(ShareBundle &maxRes, ShareBundle &maxIdx)const
+template<class Field>
+void ShareBundle<Field>::MaxRowwise(ShareBundle<Field> &maxRes, ShareBundle<Field> &maxIdx)const
 {
     maxIdx.shares.setConstant(1);
     maxRes = hierMaxpoolRowwise(1, cols(), *this, maxIdx);
     return;
 }
 
-void ShareBundle::MaxRowwise_opt(ShareBundle &maxRes)const
+template<class Field>
+void ShareBundle<Field>::MaxRowwise_opt(ShareBundle<Field> &maxRes)const
 {
     maxRes = hierMaxpoolRowwise_opt(1, cols(), *this);
     return;
 }
 
-void ShareBundle::MaxRowwise_opt(ShareBundle &maxRes, ShareBundle &maxIdx)const
+template<class Field>
+void ShareBundle<Field>::MaxRowwise_opt(ShareBundle<Field> &maxRes, ShareBundle<Field> &maxIdx)const
 {
     maxIdx.shares.setConstant(1);
     maxRes = hierMaxpoolRowwise_opt(1, cols(), *this, maxIdx);
@@ -1951,17 +2191,20 @@ void ShareBundle::MaxRowwise_opt(ShareBundle &maxRes, ShareBundle &maxIdx)const
 
 // Bounding Power in FALCON.
 // Bound power on each entry x to get alpha where 2^alpha <= x < 2^alpha+1 
-gfpMatrix ShareBundle::bound_power()const
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::bound_power()const
 {
     // Not Used
 }
 
-gfpMatrix ShareBundle::bound_power_paralle() const
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::bound_power_paralle() const
 {
     // Not Used
 }
 
-gfpMatrix ShareBundle::bound_power_with_bits()const
+template<class Field>
+gfpMatrix<Field> ShareBundle<Field>::bound_power_with_bits()const
 {
     // Not Used
 }
@@ -1971,11 +2214,12 @@ gfpMatrix ShareBundle::bound_power_with_bits()const
  * 
  * ******************************************************************************/
 
-void DoubleShareBundle::input_from_random(int player_no)
+template<class Field>
+void DoubleShareBundle<Field>::input_from_random(int player_no)
 {
     assert(degree==threshold);
     if(player_no == P->my_num()){
-        random_matrix(secrets);
+        fill_uniform(secrets);
         octetStreams os(n_players);
         calculate_sharings(secrets, degree, shares,os);
         calculate_sharings(secrets, degree<<1, aux_shares, os);
@@ -1997,10 +2241,11 @@ void DoubleShareBundle::input_from_random(int player_no)
  * @param os_send 
  * @param o_receive 
  */
-void DoubleShareBundle::input_from_random_request(int player_no, octetStreams & os_send, octetStream & o_receive)
+template<class Field>
+void DoubleShareBundle<Field>::input_from_random_request(int player_no, octetStreams & os_send, octetStream & o_receive)
 {
     if(player_no == P->my_num()){
-        random_matrix(secrets);
+        fill_uniform(secrets);
         os_send.reset(n_players);
         calculate_sharings(secrets, degree, shares, os_send);
         calculate_sharings(secrets, degree<<1, aux_shares, os_send);
@@ -2016,7 +2261,8 @@ void DoubleShareBundle::input_from_random_request(int player_no, octetStreams &
  * @param os_send 
  * @param o_receive 
  */
-void DoubleShareBundle::finish_input_from(int player_no, octetStreams &os_send, octetStream &o_receive)
+template<class Field>
+void DoubleShareBundle<Field>::finish_input_from(int player_no, octetStreams &os_send, octetStream &o_receive)
 {
     if(player_no == P->my_num()){
         P->wait_send_respective(os_send);
@@ -2028,11 +2274,12 @@ void DoubleShareBundle::finish_input_from(int player_no, octetStreams &os_send,
 }
 
 // * With PRG
-void DoubleShareBundle::input_from_random_PRG(int player_no)
+template<class Field>
+void DoubleShareBundle<Field>::input_from_random_PRG(int player_no)
 {
     assert(degree==threshold);
     if(player_no==P->my_num()){
-        random_matrix(secrets);
+        fill_uniform(secrets);
         octetStreams os(n_party_PRG());
         calculate_t_sharings_PRG(secrets, shares, os);
         P->send_respective(start_party_PRG(), n_party_PRG(), os);
@@ -2048,7 +2295,7 @@ void DoubleShareBundle::input_from_random_PRG(int player_no)
 // {
 //     assert(degree==threshold);
 //     if(player_no == P->my_num()){
-//         random_matrix(secrets);
+//         fill_uniform(secrets);
 //         os_send.reset(n_party_PRG());
 //         shares_prng.resize(degree, size());
 
@@ -2061,7 +2308,8 @@ void DoubleShareBundle::input_from_random_PRG(int player_no)
 // }
 
 // 2. Calculate the 2t-sharings without communication. 
-void DoubleShareBundle::input_aux_from_random_PRG(int player_no)
+template<class Field>
+void DoubleShareBundle<Field>::input_aux_from_random_PRG(int player_no)
 {
     if(player_no == P->my_num()){
         calculate_2t_sharings_PRG(secrets, aux_shares);
@@ -2080,15 +2328,17 @@ void DoubleShareBundle::input_aux_from_random_PRG(int player_no)
 //     }
 // }
 
-gfpMatrix DoubleShareBundle::reveal_aux(int degree)
+template<class Field>
+gfpMatrix<Field> DoubleShareBundle<Field>::reveal_aux(int degree)
 {
-    ShareBundle aux(aux_shares.rows(), aux_shares.cols());
+    ShareBundle<Field> aux(aux_shares.rows(), aux_shares.cols());
     aux.shares = aux_shares;
     aux.set_degree(degree);
     return aux.reveal();
 }
 
-DoubleShareBundle& DoubleShareBundle::reduced_random()
+template<class Field>
+DoubleShareBundle<Field>& DoubleShareBundle<Field>::reduced_random()
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(0);
@@ -2096,7 +2346,10 @@ DoubleShareBundle& DoubleShareBundle::reduced_random()
     return *this;
 #endif
 
-    if(!Phase->is_true_offline()){
+    if(Phase->is_producing()){
+        Phase->request_reduced_random_sharings(size());
+    }
+    else if(!Phase->is_true_offline()){
         if(Phase->is_Offline()){
             Phase->generate_reduced_random_sharings(size());
         }
@@ -2107,11 +2360,12 @@ DoubleShareBundle& DoubleShareBundle::reduced_random()
         }
     }
     // ( [r]_t, [r]_2t )
-    DoubleRandom::get_random_pairs(DoubleRandom::queueReducedRandom, shares, aux_shares);
+    DoubleRandom<Field>::get_random_pairs(DoubleRandom<Field>::queueReducedRandom, shares, aux_shares);
     return *this;
 }
 
-DoubleShareBundle& DoubleShareBundle::truncated_random(ShareBundle &msb)
+template<class Field>
+DoubleShareBundle<Field>& DoubleShareBundle<Field>::truncated_random(ShareBundle<Field> &msb)
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(0);
@@ -2119,7 +2373,10 @@ DoubleShareBundle& DoubleShareBundle::truncated_random(ShareBundle &msb)
     msb.shares.setConstant(0);
     return *this;
 #endif
-    if(!Phase->is_true_offline()){
+    if(Phase->is_producing()){
+        Phase->request_truncated_random_sharings(size());
+    }
+    else if(!Phase->is_true_offline()){
         if(Phase->is_Offline())
             Phase->generate_truncated_random_sharings(size());
         else{
@@ -2130,11 +2387,12 @@ DoubleShareBundle& DoubleShareBundle::truncated_random(ShareBundle &msb)
     }
     // ( [r/2^d]_t, [r]_t )
     // DoubleRandom::get_random_pairs(DoubleRandom::queueTruncatedRandom, shares, aux_shares);
-    DoubleRandom::get_random_triples(DoubleRandom::queueTruncatedRandom, shares, aux_shares, msb.shares);
+    DoubleRandom<Field>::get_random_triples(DoubleRandom<Field>::queueTruncatedRandom, shares, aux_shares, msb.shares);
     return *this;
 }
 
-DoubleShareBundle& DoubleShareBundle::truncated_random(size_t precision)
+template<class Field>
+DoubleShareBundle<Field>& DoubleShareBundle<Field>::truncated_random(size_t precision)
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(0);
@@ -2152,11 +2410,12 @@ DoubleShareBundle& DoubleShareBundle::truncated_random(size_t precision)
         }
     }
     // ( [r/2^p]_t, [r]_t )
-    DoubleRandom::get_random_pairs(DoubleRandom::queueTruncatedRandomInML, shares, aux_shares);
+    DoubleRandom<Field>::get_random_pairs(DoubleRandom<Field>::queueTruncatedRandomInML, shares, aux_shares);
     return *this;
 }
 
-DoubleShareBundle& DoubleShareBundle::reduced_truncated_random(ShareBundle &msb)
+template<class Field>
+DoubleShareBundle<Field>& DoubleShareBundle<Field>::reduced_truncated_random(ShareBundle<Field> &msb)
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(0);
@@ -2165,7 +2424,10 @@ DoubleShareBundle& DoubleShareBundle::reduced_truncated_random(ShareBundle &msb)
     return *this;
 #endif
 
-    if(!Phase->is_true_offline()){
+    if(Phase->is_producing()){
+        Phase->request_reduced_truncated_sharings(size());
+    }
+    else if(!Phase->is_true_offline()){
         if(Phase->is_Offline())
             Phase->generate_reduced_truncated_sharings(size());
         else{
@@ -2176,11 +2438,12 @@ DoubleShareBundle& DoubleShareBundle::reduced_truncated_random(ShareBundle &msb)
     }
     // ( [r/2^d]_t, [r]_2t, [r_msb] )
     // DoubleRandom::get_random_pairs(DoubleRandom::queueReducedTruncatedRandom, shares, aux_shares);
-    DoubleRandom::get_random_triples(DoubleRandom::queueReducedTruncatedRandom, shares, aux_shares, msb.shares);
+    DoubleRandom<Field>::get_random_triples(DoubleRandom<Field>::queueReducedTruncatedRandom, shares, aux_shares, msb.shares);
     return *this;
 }
 
-DoubleShareBundle& DoubleShareBundle::reduced_truncated_random(size_t logLearningRate, size_t logMiniBatch)
+template<class Field>
+DoubleShareBundle<Field>& DoubleShareBundle<Field>::reduced_truncated_random(size_t logLearningRate, size_t logMiniBatch)
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(0);
@@ -2198,11 +2461,12 @@ DoubleShareBundle& DoubleShareBundle::reduced_truncated_random(size_t logLearnin
         }
     }
     // ( [r/2^d]_2t, [r]_t )
-    DoubleRandom::get_random_pairs(DoubleRandom::queueReducedTruncatedInML, shares, aux_shares);
+    DoubleRandom<Field>::get_random_pairs(DoubleRandom<Field>::queueReducedTruncatedInML, shares, aux_shares);
     return *this;
 }
 
-DoubleShareBundle& DoubleShareBundle::reduced_truncated_random(size_t precision)
+template<class Field>
+DoubleShareBundle<Field>& DoubleShareBundle<Field>::reduced_truncated_random(size_t precision)
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(0);
@@ -2221,11 +2485,12 @@ DoubleShareBundle& DoubleShareBundle::reduced_truncated_random(size_t precision)
     //     }
     // }
     // ( [r/2^precision]_2t, [r]_t )
-    DoubleRandom::get_random_pairs(DoubleRandom::queueReducedTruncatedWithPrecisionRandom, shares, aux_shares);
+    DoubleRandom<Field>::get_random_pairs(DoubleRandom<Field>::queueReducedTruncatedWithPrecisionRandom, shares, aux_shares);
     return *this;
 }
 
-DoubleShareBundle& DoubleShareBundle::reduced_truncated_random(vector<size_t> &precision)
+template<class Field>
+DoubleShareBundle<Field>& DoubleShareBundle<Field>::reduced_truncated_random(vector<size_t> &precision)
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(0);
@@ -2234,11 +2499,12 @@ DoubleShareBundle& DoubleShareBundle::reduced_truncated_random(vector<size_t> &p
 #endif
 
     // * We explicitly generate the reduced and truncated random sharings in the functionality (switch to offline).
-    DoubleRandom::get_random_pairs(DoubleRandom::queueReducedTruncatedWithPrecisionRandom, shares, aux_shares);
+    DoubleRandom<Field>::get_random_pairs(DoubleRandom<Field>::queueReducedTruncatedWithPrecisionRandom, shares, aux_shares);
     return *this;
 }
 
-DoubleShareBundle& DoubleShareBundle::unbounded_prefix_mult_random()
+template<class Field>
+DoubleShareBundle<Field>& DoubleShareBundle<Field>::unbounded_prefix_mult_random()
 {
 #ifdef ZERO_OFFLINE
     shares.setConstant(1);
@@ -2261,9 +2527,14 @@ DoubleShareBundle& DoubleShareBundle::unbounded_prefix_mult_random()
     //  ( [b3]_t , [b2 * b3^-1]_t)
     //  ...
     //  ( [bi]_t , [bi-1 * bi^-1]_t) for i = 2, ..., l
-    DoubleRandom::get_random_pairs(DoubleRandom::queueUnboundedMultRandom, shares, aux_shares);
+    DoubleRandom<Field>::get_random_pairs(DoubleRandom<Field>::queueUnboundedMultRandom, shares, aux_shares);
     return *this;
 }
 
+template class ShareBundle<PR31>;
+template class DoubleShareBundle<PR31>;
+
+template class ShareBundle<PR61>;
+template class DoubleShareBundle<PR61>;
 
 }
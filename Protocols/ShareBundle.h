@@ -1,24 +1,42 @@
 #ifndef PROTOCOLS_SHAREVECTOR_H_
 #define PROTOCOLS_SHAREVECTOR_H_
 
+#include <functional>
 #include "Protocols/Share.h"
 #include "Protocols/PhaseConfig.h"
 
+// Elements of each chunk, in which the dispersed reveal and input pipeline their blocks (0 sends each block at once)
+#ifndef DISPERSED_CHUNK
+#define DISPERSED_CHUNK (1 << 16)
+#endif
+// Chunks of each block at most, beyond which the chunks are enlarged
+#ifndef DISPERSED_MAX_CHUNKS
+#define DISPERSED_MAX_CHUNKS 64
+#endif
+
 namespace hmmpc
 {
-class BitBundle;
-class BeaverTriple;
-
-class ShareBundle:public ShareBase
+template<class Field> class BitBundle;
+template<class Field> class BeaverTriple;
+template<class Field> class DoubleShareBundle;
+template<class Field> class DeferredRound;
+template<class Field> class sintMatrix;
+
+template<class Field>
+class ShareBundle:public ShareBase<Field>
 {
-    friend class sintMatrix;
+public:
+    USING_SHARE_BASE(ShareBase<Field>)
+    friend class sintMatrix<Field>;
+    friend class DeferredRound<Field>;
 protected:
-    gfpMatrix secrets;
+    gfpMatrix<Field> secrets;
     int degree;
 
     // Matrix-grained Operations to sharings
-    void calculate_sharings(const gfpMatrix &secrets, const int &degree, gfpMatrix &shares, octetStreams &os);
-    void calculate_secrets(gfpMatrix &secrets, const int &degree, const gfpMatrix &shares, octetStreams &os);
+    void calculate_sharings(const gfpMatrix<Field> &secrets, const int &degree, gfpMatrix<Field> &shares, octetStreams &os);
+    void calculate_secrets(gfpMatrix<Field> &secrets, const int &degree, const gfpMatrix<Field> &shares, octetStreams &os);
+    const gfpVector<Field>& receive_first_sharings(const int &degree, const gfpScalar<Field> *my_shares, gfpMatrix<Field> &sharings);
     
     void distribute_sharings();
     void reconstruct_secrets();
@@ -28,37 +46,41 @@ protected:
     void receive_secrets(int player_no);// recv from
 
 
-    // Row-grained Operations to sharings
-    void calculate_block_sharings(const int &degree, const int &start_row, const int &n_rows, octetStreams &os);
-    void calculate_block_secrets(const int &degree, const int &start_row, const int &n_rows, octetStreams &os);
+    // Element-grained Operations to sharings
+    void calculate_block_sharings(const int &degree, const size_t &start, const size_t &n, octetStreams &os);
+    void calculate_block_secrets(const int &degree, const size_t &start, const size_t &n, const gfpMatrix<Field> &sharings);
+    void calculate_block_secrets(const gfpVector<Field> &reconstruction, const size_t &start, const size_t &n, const gfpMatrix<Field> &sharings);
 
     // * With PRG
-    void calculate_2t_sharings_PRG(const gfpMatrix&_secrets, gfpMatrix &_shares);
-    void calculate_t_sharings_PRG(const gfpMatrix&_secrets, gfpMatrix &_shares, octetStreams &os);
-    void get_2t_sharings_PRG(int player_no, gfpMatrix &_shares);
-    void get_t_sharings_PRG(int player_no, gfpMatrix &_shares);
+    void calculate_2t_sharings_PRG(const gfpMatrix<Field>&_secrets, gfpMatrix<Field> &_shares);
+    void calculate_t_sharings_PRG(const gfpMatrix<Field>&_secrets, gfpMatrix<Field> &_shares, octetStreams &os);
+    void get_2t_sharings_PRG(int player_no, gfpMatrix<Field> &_shares);
+    void get_t_sharings_PRG(int player_no, gfpMatrix<Field> &_shares);
 
-    void distribute_sharings_PRG(const gfpMatrix &_secrets, gfpMatrix &_shares);
-    void get_sharings_PRG(int player_no, gfpMatrix &_share);
+    void distribute_sharings_PRG(const gfpMatrix<Field> &_secrets, gfpMatrix<Field> &_shares);
+    void get_sharings_PRG(int player_no, gfpMatrix<Field> &_share);
 
-    void get_t_sharings_PRG_request(int player_no, gfpMatrix &shares_prng, octetStream &o_receive);
-    void get_t_sharings_PRG_wait(int player_no, const gfpMatrix &shares_prng, gfpMatrix &_shares, octetStream &o_receive);
+    void get_t_sharings_PRG_request(int player_no, gfpMatrix<Field> &shares_prng, octetStream &o_receive);
+    void get_t_sharings_PRG_wait(int player_no, const gfpMatrix<Field> &shares_prng, gfpMatrix<Field> &_shares, octetStream &o_receive);
 
-    void calculate_block_t_sharings_PRG(const int &start_row, const int &n_rows, octetStreams &os_send);
-    void get_block_t_sharings_PRG_request(int player_no, const int &start_row, const int &n_rows, gfpMatrix &shares_prng, octetStream &o_receive);
-    void get_block_t_sharings_PRG_wait(int player_no, const int &start_row, const int &n_rows, const gfpMatrix &shares_prng, octetStream &o_receive);
+    void calculate_block_t_sharings_PRG(const size_t &start, const size_t &n, gfpMatrix<Field> &sharings, vector<octetViews> &os_send);
+    void get_block_t_sharings_PRG_request(int player_no, const size_t &start, const size_t &n, gfpMatrix<Field> &shares_prng, octetViews &o_receive);
+    void get_block_t_sharings_PRG_wait(int player_no, const size_t &start, const size_t &n, const gfpMatrix<Field> &shares_prng, octetViews &o_receive);
     
+    // Fix the truncation after revealing the masked sharings in truncate() and reduce_truncate().
+    void fix_truncation(const DoubleShareBundle<Field> &R, ShareBundle<Field> &r_msb);
+
     // Complicated functions: Maxpool
-    void seqMaxpoolRowwise(ShareBundle &maxRes, ShareBundle &maxIdx)const;
-    ShareBundle hierMaxpoolRowwise(int depth, size_t num, const ShareBundle &origin, ShareBundle &maxPrime)const;
-    ShareBundle hierMaxpoolRowwise(int depth, size_t num, const ShareBundle &origin)const; // without maxpoolPrime
+    void seqMaxpoolRowwise(ShareBundle<Field> &maxRes, ShareBundle<Field> &maxIdx)const;
+    ShareBundle<Field> hierMaxpoolRowwise(int depth, size_t num, const ShareBundle<Field> &origin, ShareBundle<Field> &maxPrime)const;
+    ShareBundle<Field> hierMaxpoolRowwise(int depth, size_t num, const ShareBundle<Field> &origin)const; // without maxpoolPrime
 
     // Use the two-layer multiplication in one round technique.
-    ShareBundle hierMaxpoolRowwise_opt(int depth, size_t num, const ShareBundle &origin, ShareBundle &maxPrime)const;
-    ShareBundle hierMaxpoolRowwise_opt(int depth, size_t num, const ShareBundle &origin)const; // without maxpoolPrime
+    ShareBundle<Field> hierMaxpoolRowwise_opt(int depth, size_t num, const ShareBundle<Field> &origin, ShareBundle<Field> &maxPrime)const;
+    ShareBundle<Field> hierMaxpoolRowwise_opt(int depth, size_t num, const ShareBundle<Field> &origin)const; // without maxpoolPrime
     
 public:
-    gfpMatrix shares;
+    gfpMatrix<Field> shares;
     ShareBundle():degree(threshold){}
     // BUG LOG: Need to setConsts(0). resize() dose not initalize to 0.
     ShareBundle(const size_t &len):ShareBundle(){resize(len,1); initializeZero();}
@@ -68,12 +90,12 @@ public:
     void resize(const size_t &xSize, const size_t &ySize)
     {secrets.resize(xSize, ySize); shares.resize(xSize, ySize); }
 
-    gfpMatrix& secret(){gfpMatrix& ref = secrets; return ref;}
-    const gfpMatrix& secret()const{const gfpMatrix &ref = secrets; return ref;}
+    gfpMatrix<Field>& secret(){gfpMatrix<Field>& ref = secrets; return ref;}
+    const gfpMatrix<Field>& secret()const{const gfpMatrix<Field> &ref = secrets; return ref;}
 
     // Get
     int get_degree()const{return degree;}
-    gfpMatrix get_secrets()const{return secrets;}
+    gfpMatrix<Field> get_secrets()const{return secrets;}
     size_t size()const{return shares.size();}
     size_t rows()const{return shares.rows();}
     size_t cols()const{return shares.cols();}
@@ -81,27 +103,27 @@ public:
     // Set in matrix-grained
     void double_degree(){degree = degree<<1;}
     void set_degree(const int &_d){degree = _d;}
-    void set_secret(const size_t &idx, const gfpScalar &_secret){secrets(idx) = _secret;}
-    void set_secret(const gfpScalar &_secret){secrets.setConstant(_secret);}
-    void set_secrets(const gfpMatrix &_secrets){secrets = _secrets;}
+    void set_secret(const size_t &idx, const gfpScalar<Field> &_secret){secrets(idx) = _secret;}
+    void set_secret(const gfpScalar<Field> &_secret){secrets.setConstant(_secret);}
+    void set_secrets(const gfpMatrix<Field> &_secrets){secrets = _secrets;}
 
     // Set in row-grained
-    void set_row(const size_t &row_no, const ShareBundle&other)
+    void set_row(const size_t &row_no, const ShareBundle<Field>&other)
     {shares.row(row_no)<<other.shares;}
     
     // * Main Operations 
-    ShareBundle& reduce_degree(); // reduce [x]_2t -> [x]_t
-    ShareBundle& truncate(); // truncate [x]_t -> [x/2^d]_t
-    ShareBundle& truncate(size_t precision); // truncate [x]_t -> [x/2^p]_t
-    ShareBundle& reduce_truncate(); // reduce [x]_2t -> [x/2^d]_t
-    ShareBundle& reduce_truncate(size_t logLearningRate, size_t logMiniBatch);
-    ShareBundle& reduce_truncate(size_t precision);//reduce [x]_2t -> [x/2^p]_t
-    ShareBundle& reduce_truncate(vector<size_t> &precision);
+    ShareBundle<Field>& reduce_degree(); // reduce [x]_2t -> [x]_t
+    ShareBundle<Field>& truncate(); // truncate [x]_t -> [x/2^d]_t
+    ShareBundle<Field>& truncate(size_t precision); // truncate [x]_t -> [x/2^p]_t
+    ShareBundle<Field>& reduce_truncate(); // reduce [x]_2t -> [x/2^d]_t
+    ShareBundle<Field>& reduce_truncate(size_t logLearningRate, size_t logMiniBatch);
+    ShareBundle<Field>& reduce_truncate(size_t precision);//reduce [x]_2t -> [x/2^p]_t
+    ShareBundle<Field>& reduce_truncate(vector<size_t> &precision);
 
     // Two layer multiplication: compute [xy] from input [x]_2t and [y] (input wire)
-    ShareBundle& reduce_degree_1stLayer(const ShareBundle &y, BeaverTriple &triple);
+    ShareBundle<Field>& reduce_degree_1stLayer(const ShareBundle<Field> &y, BeaverTriple<Field> &triple);
     // Generalize two layer-mult: compute ([xy1], [xy2], ...) from input [x]_2t and ([y1], [y2], ...)
-    ShareBundle& reduce_degree_1stLayer(const vector<ShareBundle>&y, vector<BeaverTriple>&triples);
+    ShareBundle<Field>& reduce_degree_1stLayer(const vector<ShareBundle<Field>>&y, vector<BeaverTriple<Field>>&triples);
 
     // * Input methods
     // The normal version.
@@ -129,17 +151,17 @@ public:
     // * With PRG (Assme n = 2t+1)
     // Distributing a 2t-sharing is easy without communication.
     // Distributing a t-sharing requires communication from Pi to {Pt+1, ..., P2t, P0}.
-    int start_party_PRG()const{return ShareBase::threshold+1;}// t+1
-    int n_party_PRG()const{return ShareBase::n_players - ShareBase::threshold;}//t+1
+    int start_party_PRG()const{return threshold+1;}// t+1
+    int n_party_PRG()const{return n_players - threshold;}//t+1
     // Normal version
     void input_from_party_PRG(int player_no);
     void input_from_random_PRG(int player_no);
 
     // Only for t-sharing since 2t-sharing can be shared without communication
     // (You can use the normal version to input a 2t-sharing) 
-    void input_from_party_request_PRG(int player_no, octetStreams &os_send, gfpMatrix &shares_prng, octetStream &o_receive);
-    void input_from_random_request_PRG(int player_no, octetStreams &os_send, gfpMatrix &shares_prng, octetStream &o_receive);
-    void finish_input_from_PRG(int player_no, octetStreams &os_send, const gfpMatrix &shares_prng, octetStream &o_receive);
+    void input_from_party_request_PRG(int player_no, octetStreams &os_send, gfpMatrix<Field> &shares_prng, octetStream &o_receive);
+    void input_from_random_request_PRG(int player_no, octetStreams &os_send, gfpMatrix<Field> &shares_prng, octetStream &o_receive);
+    void finish_input_from_PRG(int player_no, octetStreams &os_send, const gfpMatrix<Field> &shares_prng, octetStream &o_receive);
 
     // Use the static buffers to input.
     void input_from_party_request_PRG(int player_no);
@@ -149,87 +171,96 @@ public:
     // Reveal
     void reveal_to_party(int player_no);
     void reveal_to_pking();
-    gfpMatrix reveal();
-    gfpMatrix reveal_truncate(size_t precision);
-    gfpMatrix reveal_truncate(vector<size_t> &precision);
+    gfpMatrix<Field> reveal();
+    gfpMatrix<Field> reveal_truncate(size_t precision);
+    gfpMatrix<Field> reveal_truncate(vector<size_t> &precision);
 
-    // * Partition the matrix on row-grained and disperse the operations to every party rather only Pking.
-    void partition_rows(size_t &startRow, size_t &nRows); // The rule of partition on matrix.
+    // * Partition the flattened matrix on element-grained and disperse the operations to every party rather only Pking.
+    void partition_elements(int player_no, size_t &start, size_t &n); // The rule of partition on matrix.
 
     // Dispersed version of reveal_to_Pking.
     void reveal_blocks_dispersed();
-    void reveal_block_from_party_request(int player_no, octetStreams &os_send, octetStream &o_receive);
-    void finish_reveal_block_from_party(int player_no, octetStreams &os_send, octetStream &o_receive);
+    void reveal_chunks_dispersed(const function<void()> &request_more, const function<void(const size_t&, const size_t&)> &on_chunk);
 
     // Dispersed version of input_from_Pking.
     void input_blocks_dispersed();
-    void input_block_from_party_request(int player_no, const int &startRow, const int &nRows, octetStreams &os_send, octetStream &o_receive);
-    void finish_input_block_from_party(int player_no, const int &startRow, const int &nRows, octetStreams &os_send, octetStream &o_receive);
+    void input_block_from_party_request(int player_no, const size_t &start, const size_t &n, octetStreams &os_send, octetViews &o_receive);
+    void finish_input_block_from_party(int player_no, octetStreams &os_send, octetViews &o_receive);
     // Dispersed version of input_from_Pking. (With help of PRG)
     void input_blocks_dispersed_PRG();
-    void input_block_from_party_request_PRG(int player_no, const int &startRow, const int &nRows, octetStreams &os_send, gfpMatrix &shares_prng, octetStream &o_receive);
-    void finish_input_block_from_party_PRG(int player_no, const int &startRow, const int &nRows, octetStreams &os_send, const gfpMatrix &shares_prng, octetStream &o_receive);
+    void input_block_from_party_request_PRG(int player_no, const size_t &start, const size_t &n, vector<octetViews> &os_send, gfpMatrix<Field> &sharings, gfpMatrix<Field> &shares_prng, octetViews &o_receive);
+    void finish_input_block_from_party_PRG(int player_no, const size_t &start, const size_t &n, vector<octetViews> &os_send, const gfpMatrix<Field> &shares_prng, octetViews &o_receive);
 
 
     // Dispersed version of reveal
-    gfpMatrix reveal_dispersed();
-    gfpMatrix reveal_truncate_dispersed(size_t precision);// reconstruct the secret and truncate
-    gfpMatrix reveal_truncate_dispersed(vector<size_t> &precision);
+    gfpMatrix<Field> reveal_dispersed();
+    gfpMatrix<Field> reveal_truncate_dispersed(size_t precision);// reconstruct the secret and truncate
+    gfpMatrix<Field> reveal_truncate_dispersed(vector<size_t> &precision);
+    gfpMatrix<Field> reveal_forward_dispersed(const function<void(const size_t&, const size_t&)> &process);
 
     // Random
-    ShareBundle& random();
+    ShareBundle<Field>& random();
 
     // *Complicated Operations
-    ShareBundle unbounded_mult();
-    ShareBundle unbounded_prefix_mult();
-    ShareBundle unbounded_postfix_mult();
-    ShareBundle evalFunc(string fn, size_t degree);// Evaluate the function result of each entry given input X and degree.
+    ShareBundle<Field> unbounded_mult();
+    ShareBundle<Field> unbounded_prefix_mult();
+    ShareBundle<Field> unbounded_postfix_mult();
+    ShareBundle<Field> evalFunc(string fn, size_t degree);// Evaluate the function result of each entry given input X and degree.
 
     // *
-    BitBundle get_LSB()const; // 2 layer circuit to compute LSB in 2 rounds.
-    BitBundle get_MSB()const;
+    BitBundle<Field> get_LSB()const; // 2 layer circuit to compute LSB in 2 rounds.
+    BitBundle<Field> get_MSB()const;
 
-    ShareBundle ReLU()const;
-    BitBundle deltaReLU()const;
-    void ReLU(ShareBundle &deltaReLU, ShareBundle &relu)const; // 3 rounds to compute ReLU
+    ShareBundle<Field> ReLU()const;
+    BitBundle<Field> deltaReLU()const;
+    void ReLU(ShareBundle<Field> &deltaReLU, ShareBundle<Field> &relu)const; // 3 rounds to compute ReLU
 
-    ShareBundle get_LSB_impared()const;// Remove the last layer of multiplication in LSB circuit.
+    ShareBundle<Field> get_LSB_impared()const;// Remove the last layer of multiplication in LSB circuit.
     
     // Calculate along with the Beaver triples for the second layer.
     // BUG LOG: Note that the derivative class can be cast to the base class but the base class cannot be cast to the derivative class
-    BitBundle get_LSB_opt(vector<ShareBundle> &y, vector<BeaverTriple> &triples)const;
-    BitBundle get_MSB_opt(vector<ShareBundle> &y, vector<BeaverTriple> &triples)const;
-    BitBundle deltaReLU_opt(vector<ShareBundle> &y, vector<BeaverTriple> &triples)const;
-    void ReLU_opt(ShareBundle &deltaReLU, ShareBundle &relu)const;
-    ShareBundle ReLU_opt()const;
+    BitBundle<Field> get_LSB_opt(vector<ShareBundle<Field>> &y, vector<BeaverTriple<Field>> &triples)const;
+    BitBundle<Field> get_MSB_opt(vector<ShareBundle<Field>> &y, vector<BeaverTriple<Field>> &triples)const;
+    BitBundle<Field> deltaReLU_opt(vector<ShareBundle<Field>> &y, vector<BeaverTriple<Field>> &triples)const;
+    void ReLU_opt(ShareBundle<Field> &deltaReLU, ShareBundle<Field> &relu)const;
+    ShareBundle<Field> ReLU_opt()const;
     
 
-    void MaxPrimeRowwise(ShareBundle &maxIdx)const;
-    void MaxRowwise(ShareBundle &maxRes)const;
-    void MaxRowwise(ShareBundle &maxRes, ShareBundle &maxIdx)const;
+    void MaxPrimeRowwise(ShareBundle<Field> &maxIdx)const;
+    void MaxRowwise(ShareBundle<Field> &maxRes)const;
+    void MaxRowwise(ShareBundle<Field> &maxRes, ShareBundle<Field> &maxIdx)const;
 
-    void MaxRowwise_opt(ShareBundle &maxRes)const;
-    void MaxRowwise_opt(ShareBundle &maxRes, ShareBundle &maxIdx)const;
+    void MaxRowwise_opt(ShareBundle<Field> &maxRes)const;
+    void MaxRowwise_opt(ShareBundle<Field> &maxRes, ShareBundle<Field> &maxIdx)const;
 
-    gfpMatrix bound_power()const;// Bound power on each entry x to get alpha where 2^alpha <= x < 2^alpha+1 
-    gfpMatrix bound_power_paralle()const;
-    gfpMatrix bound_power_with_bits()const;
+    gfpMatrix<Field> bound_power()const;// Bound power on each entry x to get alpha where 2^alpha <= x < 2^alpha+1 
+    gfpMatrix<Field> bound_power_paralle()const;
+    gfpMatrix<Field> bound_power_with_bits()const;
 
     // Just for Tests
-    void ReLU_opt_test(ShareBundle &deltaReLU, ShareBundle &relu)const; // Use the two-layer mult  techniqueto compute ReLU in 2 rounds
+    void ReLU_opt_test(ShareBundle<Field> &deltaReLU, ShareBundle<Field> &relu)const; // Use the two-layer mult  techniqueto compute ReLU in 2 rounds
 };
 
-class DoubleShareBundle:public ShareBundle
+template<class Field>
+class DoubleShareBundle:public ShareBundle<Field>
 {
+protected:
+    using ShareBundle<Field>::secrets; using ShareBundle<Field>::degree;
+    using ShareBundle<Field>::calculate_sharings; using ShareBundle<Field>::calculate_t_sharings_PRG; using ShareBundle<Field>::calculate_2t_sharings_PRG;
+    using ShareBundle<Field>::get_t_sharings_PRG; using ShareBundle<Field>::get_2t_sharings_PRG;
 public:
-    gfpMatrix aux_shares;
-    DoubleShareBundle():ShareBundle(){}
+    USING_SHARE_BASE(ShareBundle<Field>)
+    using ShareBundle<Field>::start_party_PRG; using ShareBundle<Field>::n_party_PRG;
+    using ShareBundle<Field>::shares; using ShareBundle<Field>::size; using ShareBundle<Field>::rows; using ShareBundle<Field>::cols;
+
+    gfpMatrix<Field> aux_shares;
+    DoubleShareBundle():ShareBundle<Field>(){}
     DoubleShareBundle(const size_t &len):DoubleShareBundle(){resize(len, 1);}
     DoubleShareBundle(const size_t &xSize, const size_t &ySize):DoubleShareBundle(){resize(xSize, ySize);}
     void resize(const size_t &xSize, const size_t ySize){secrets.resize(xSize, ySize); shares.resize(xSize, ySize); aux_shares.resize(xSize, ySize);}
 
     // Set in row-grained
-    void set_row(const size_t &row_no, const DoubleShareBundle&other)
+    void set_row(const size_t &row_no, const DoubleShareBundle<Field>&other)
     {shares.row(row_no)<<other.shares; aux_shares.row(row_no)<<other.aux_shares;}
 
     void input_from_random(int player_no);
@@ -250,18 +281,18 @@ public:
     // void finish_input_from_PRG(int player_no, octetStreams &os_send, const gfpMatrix &shares_prng, octetStream &o_receive);
 
     // Reveal the aux_sharing-sharing
-    gfpMatrix reveal_aux(int degree);
+    gfpMatrix<Field> reveal_aux(int degree);
 
     // Random
-    DoubleShareBundle& reduced_random(); // Randomized to the reduced sharings ([r]_t, [r]_2t)
-    DoubleShareBundle& truncated_random(ShareBundle &msb);
-    DoubleShareBundle& truncated_random(size_t precision);
-    DoubleShareBundle& reduced_truncated_random(ShareBundle &msb);
-    DoubleShareBundle& reduced_truncated_random(size_t logLearningRate, size_t logMiniBatch);// used in ML
-    DoubleShareBundle& reduced_truncated_random(size_t precision);
-    DoubleShareBundle& reduced_truncated_random(vector<size_t>& precision);
-
-    DoubleShareBundle& unbounded_prefix_mult_random();
+    DoubleShareBundle<Field>& reduced_random(); // Randomized to the reduced sharings ([r]_t, [r]_2t)
+    DoubleShareBundle<Field>& truncated_random(ShareBundle<Field> &msb);
+    DoubleShareBundle<Field>& truncated_random(size_t precision);
+    DoubleShareBundle<Field>& reduced_truncated_random(ShareBundle<Field> &msb);
+    DoubleShareBundle<Field>& reduced_truncated_random(size_t logLearningRate, size_t logMiniBatch);// used in ML
+    DoubleShareBundle<Field>& reduced_truncated_random(size_t precision);
+    DoubleShareBundle<Field>& reduced_truncated_random(vector<size_t>& precision);
+
+    DoubleShareBundle<Field>& unbounded_prefix_mult_random();
 };
 
 
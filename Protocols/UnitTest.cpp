@@ -3,13 +3,14 @@
 namespace hmmpc
 {
 // Debug for Share generated with help of PRG.
-void debugSharePRG(PhaseConfig *phase)
+template<class Field>
+void debugSharePRG(PhaseConfig<Field> *phase)
 {
-    Share a;
+    Share<Field> a;
     a.set_secret(3);
     a.double_degree();
 
-    DoubleShare b;
+    DoubleShare<Field> b;
 
     phase->start_online();
     a.input_from_party_PRG(0);
@@ -23,15 +24,16 @@ void debugSharePRG(PhaseConfig *phase)
 
     cout<<"a: "<<a.reveal()<<endl;
     cout<<"b: "<<b.reveal()<<endl;
-    cout<<"b: "<<b.reveal_aux(ShareBase::threshold<<1)<<endl;
+    cout<<"b: "<<b.reveal_aux(ShareBase<Field>::threshold<<1)<<endl;
 }
 
-void debugShareBundlePRG(PhaseConfig *phase)
+template<class Field>
+void debugShareBundlePRG(PhaseConfig<Field> *phase)
 {
-    ShareBundle A(3, 3);
+    ShareBundle<Field> A(3, 3);
     A.secret()<<1,2,3,4,5,6,7,8,9;
 
-    DoubleShareBundle B(3, 3);
+    DoubleShareBundle<Field> B(3, 3);
 
     phase->start_offline();
     phase->generate_random_sharings(1000);
@@ -42,7 +44,7 @@ void debugShareBundlePRG(PhaseConfig *phase)
     // A.input_from_party_PRG(0);
 
     octetStreams os_send;
-    gfpMatrix shares_prng;
+    gfpMatrix<Field> shares_prng;
     octetStream o_rec;
     B.input_from_random_request_PRG(0, os_send, shares_prng, o_rec);
     B.input_aux_from_random_PRG(0);
@@ -56,28 +58,64 @@ void debugShareBundlePRG(PhaseConfig *phase)
     phase->end_online();
     // cout<<"A:"<<endl<<A.reveal()<<endl;
     cout<<"B:"<<endl<<B.reveal()<<endl;
-    cout<<"B:"<<endl<<B.reveal_aux(ShareBase::threshold<<1)<<endl;
+    cout<<"B:"<<endl<<B.reveal_aux(ShareBase<Field>::threshold<<1)<<endl;
     
 }
 
-void debugRandomSharePRG(PhaseConfig *phase)
+// Debug for the dispersed input and reveal, with fewer rows than the players, and then with the blocks weighted 1:2:3:...
+template<class Field>
+void debugShareBundleDispersed(PhaseConfig<Field> *phase)
+{
+    phase->start_offline();
+    phase->generate_random_sharings(1000);
+    phase->end_offline();
+
+    for(int weighted = 0; weighted < 2; weighted++){
+        if(weighted){
+            ShareBase<Field>::weights.resize(ShareBase<Field>::n_players);
+            for(int i = 0; i < ShareBase<Field>::n_players; i++)
+                ShareBase<Field>::weights[i] = i + 1;
+        }
+        ShareBundle<Field> A(1, 10), B(1, 10);
+        A.secret()<<1,2,3,4,5,6,7,8,9,10;
+        B.secret() = A.secret() * gfpScalar<Field>(4);
+        size_t start, n;
+        A.partition_elements(ShareBase<Field>::P->my_num(), start, n);
+        cout<<"Block: "<<start<<" + "<<n<<endl;
+
+        phase->start_online();
+        A.input_blocks_dispersed();
+        B.input_blocks_dispersed_PRG();
+        A.reveal_blocks_dispersed();
+        phase->end_online();
+
+        cout<<"A:"<<endl<<A.secret()<<endl;
+        cout<<"A:"<<endl<<A.reveal_dispersed()<<endl;
+        cout<<"B/4:"<<endl<<B.reveal_truncate_dispersed(2)<<endl;
+    }
+    ShareBase<Field>::weights.clear();
+}
+
+template<class Field>
+void debugRandomSharePRG(PhaseConfig<Field> *phase)
 {
     phase->start_offline();
     phase->generate_reduced_random_sharings(10);
     phase->end_offline();
 
     phase->start_online();
-    DoubleShareBundle A(3,3);
+    DoubleShareBundle<Field> A(3,3);
     A.reduced_random();
     cout<<"A:"<<A.reveal()<<endl;
-    cout<<"A:"<<A.reveal_aux(ShareBase::threshold<<1)<<endl;
+    cout<<"A:"<<A.reveal_aux(ShareBase<Field>::threshold<<1)<<endl;
     phase->end_online();
 }
 
 // Debug for ShareBundle
-void debugUnboundedPrefixMult(PhaseConfig *phase)
+template<class Field>
+void debugUnboundedPrefixMult(PhaseConfig<Field> *phase)
 {
-    ShareBundle A(3, 4);
+    ShareBundle<Field> A(3, 4);
     A.secret()<<1,2,3,4,
                 2,2,2,2,
                 5,5,5,5;
@@ -85,69 +123,72 @@ void debugUnboundedPrefixMult(PhaseConfig *phase)
     A.input_from_party(0);
 
     phase->start_online();
-    ShareBundle B = A.unbounded_prefix_mult();
+    ShareBundle<Field> B = A.unbounded_prefix_mult();
     cout<<B.reveal()<<endl;
     phase->end_online();
 
-    ShareBundle a(1, 4);
+    ShareBundle<Field> a(1, 4);
     a.secret()<<3,3,3,3;
     a.input_from_party(0);
 
     phase->start_online();
-    ShareBundle b = a.unbounded_prefix_mult();
+    ShareBundle<Field> b = a.unbounded_prefix_mult();
     cout<<b.reveal()<<endl;
     phase->end_online();
 }
 
-void debugGetLSB(PhaseConfig *phase)
+template<class Field>
+void debugGetLSB(PhaseConfig<Field> *phase)
 {
     cout<<"[UnitTest]:"<<endl;
     cout<<">>Get LST"<<endl<<endl;
 
     cout<<"Input: (in bitwise)"<<endl;
-    ShareBundle A(3,3);
+    ShareBundle<Field> A(3,3);
     A.secret()<<1,2,3,4,5,6,7,8,9;
     
     cout<<"A:"<<endl<<A.secret()<<endl;
     A.input_from_party(0);
 
     phase->start_online();
-    BitBundle lsb = A.get_LSB();
+    BitBundle<Field> lsb = A.get_LSB();
     cout<<"LSB:"<<endl<<lsb.reveal()<<endl;
     phase->end_online();
 }
 
-void debugGetMSB(PhaseConfig *phase)
+template<class Field>
+void debugGetMSB(PhaseConfig<Field> *phase)
 {
     cout<<"[UnitTest]:"<<endl;
     cout<<">>Protocol 5.1: DReLU, i.e. getting MSB"<<endl<<endl;
 
     cout<<"Input: "<<endl;
-    ShareBundle A(3,3);
-    A.secret()<<0,2,PR-1,PR-2,5,PR-6,7,8,PR-1;
+    ShareBundle<Field> A(3,3);
+    A.secret()<<0,2,Field::PR-1,Field::PR-2,5,Field::PR-6,7,8,Field::PR-1;
     
     cout<<"A:"<<endl<<A.secret()<<endl;
     A.input_from_party(0);
 
     phase->start_online();
-    BitBundle msb = A.get_MSB();
+    BitBundle<Field> msb = A.get_MSB();
     cout<<"MSB(sign bit):"<<endl<<msb.reveal()<<endl;
     phase->end_online();
 }
 
-void debugReLU(PhaseConfig *phase)
+template<class Field>
+void debugReLU(PhaseConfig<Field> *phase)
 {
     cout<<"[UnitTest]:"<<endl;
     cout<<">>Protocol 5.3: ReLU"<<endl<<endl;
 
     cout<<"Input:"<<endl;
-    ShareBundle A(3,3);
-    A.secret()<<0,2,PR-1,PR-2,5,PR-6,7,0,((TYPE)1<<30)-1;
+    ShareBundle<Field> A(3,3);
+    A.secret()<<0,2,Field::PR-1,Field::PR-2,5,Field::PR-6,7,0,((typename Field::TYPE)1<<30)-1;
 
 
     cout<<"A:"<<endl<<A.secret()<<endl;
     A.input_from_party(0);
-    ShareBundle reluPrime(3, 3), relu(3, 3);
+    ShareBundle<Field> reluPrime(3, 3), relu(3, 3);
     
     phase->start_online();
     
@@ -167,18 +208,20 @@ void debugReLU(PhaseConfig *phase)
     phase->end_online();
 }
 
-void debugBoundPower(PhaseConfig *phase)
+template<class Field>
+void debugBoundPower(PhaseConfig<Field> *phase)
 {
     // Not Used
 }
 
-void debugMaxPool(PhaseConfig *phase)
+template<class Field>
+void debugMaxPool(PhaseConfig<Field> *phase)
 {
     cout<<"[UnitTest]:"<<endl;
     cout<<">>Protocol 5.4: Maxpool in rowwise"<<endl<<endl;
 
     cout<<"Input: "<<endl;
-    ShareBundle A(3, 10);
+    ShareBundle<Field> A(3, 10);
     A.secret()<<1,2,3,1,2,3,1,2,3,1,
                 0,4,1,1,2,3,1,2,3,1,
                 6,2,3,1,2,3,9,2,3,1;
@@ -187,7 +230,7 @@ void debugMaxPool(PhaseConfig *phase)
     A.input_from_party(0);
 
     phase->start_online();
-    ShareBundle maxValue(3, 1), maxIdx(3, 10);
+    ShareBundle<Field> maxValue(3, 1), maxIdx(3, 10);
 
     // 10 rounds for one max
 
@@ -212,12 +255,13 @@ void debugMaxPool(PhaseConfig *phase)
 }
 
 // *Debug for bits
-void debugBitOp(PhaseConfig *phase)
+template<class Field>
+void debugBitOp(PhaseConfig<Field> *phase)
 {
     cout<<"Bit-wise XOR:"<<endl;
-    BitBundle A(3, 6), B(3, 7);
-    gfpVector a(3), b(3), c(3);
-    gfpMatrix c_bits(3, 6);
+    BitBundle<Field> A(3, 6), B(3, 7);
+    gfpVector<Field> a(3), b(3), c(3);
+    gfpMatrix<Field> c_bits(3, 6);
     a<<7,7,7;
     b<<15,15,15;
     c<<18,18,18;
@@ -237,49 +281,52 @@ void debugBitOp(PhaseConfig *phase)
 
     phase->start_online();
     cout<<"a^b: "<<(7^15)<<endl;
-    BitBundle res_xor1 = bitwise_xor(A, B);
+    BitBundle<Field> res_xor1 = bitwise_xor(A, B);
     cout<<res_xor1.reveal()<<endl;
 
     cout<<"a^c: "<<(7^18)<<endl;
-    BitBundle res_xor2 = bitwise_xor(A, c_bits);
+    BitBundle<Field> res_xor2 = bitwise_xor(A, c_bits);
     cout<<res_xor2.reveal()<<endl;
 
     cout<<"c^a: "<<(7^18)<<endl;
-    BitBundle res_xor3 = bitwise_xor(c_bits, A);
+    BitBundle<Field> res_xor3 = bitwise_xor(c_bits, A);
     cout<<res_xor3.reveal()<<endl;
 
     cout<<"a&b: "<<(7&15)<<endl;
-    BitBundle res_and1 = bitwise_and(A, B);
+    BitBundle<Field> res_and1 = bitwise_and(A, B);
     cout<<res_and1.reveal()<<endl;
 
     cout<<"a&c: "<<(7&18)<<endl;
-    BitBundle res_and2 = bitwise_and(A, c_bits);
+    BitBundle<Field> res_and2 = bitwise_and(A, c_bits);
     cout<<res_and2.reveal()<<endl;
 
     cout<<"c&a: "<<(7&18)<<endl;
-    BitBundle res_and3 = bitwise_and(c_bits, A);
+    BitBundle<Field> res_and3 = bitwise_and(c_bits, A);
     cout<<res_and3.reveal()<<endl;
     phase->end_online();
 }
 
-void debugUnboundedOp(PhaseConfig *phase)
+template<class Field>
+void debugUnboundedOp(PhaseConfig<Field> *phase)
 {
     // !Depricated
 }
 
-void debugPrefixBlkOp(PhaseConfig *phase)
+template<class Field>
+void debugPrefixBlkOp(PhaseConfig<Field> *phase)
 {
     // !Depricated
 }
 
-void debugPrefixOp(PhaseConfig *phase)
+template<class Field>
+void debugPrefixOp(PhaseConfig<Field> *phase)
 {
     cout<<"[UnitTest]:"<<endl;
     cout<<">>Protocol 4.1: Prefix/Postfix - OR/AND."<<endl<<endl;
     // Prefix op on each row.
     cout<<"Input Bits: "<<endl;
     
-    BitBundle A(4, 8);
+    BitBundle<Field> A(4, 8);
     A.secret()<< 0,0,0,0,0,0,0,0,
                  1,1,0,0,0,0,0,0,
                  0,0,1,1,0,1,1,0,
@@ -295,19 +342,20 @@ void debugPrefixOp(PhaseConfig *phase)
     phase->end_online();
 }
 
-void debugLessThanUnsigned(PhaseConfig *phase)
+template<class Field>
+void debugLessThanUnsigned(PhaseConfig<Field> *phase)
 {
     cout<<"[UnitTest]:"<<endl;
     cout<<">>Protocol 4.2: Bitwise-Less Than"<<endl<<endl;
 
     cout<<"Input: (in bitwise)"<<endl;
-    BitBundle A(3), B(3);
-    gfpVector a(3), b(3);
+    BitBundle<Field> A(3), B(3);
+    gfpVector<Field> a(3), b(3);
     a<<4,6,2;
     b<<1,7,2;
     
-    decompose_bits(a, BITS_LENGTH, A.secret());
-    decompose_bits(b, BITS_LENGTH, B.secret());
+    decompose_bits(a, Field::BITS_LENGTH, A.secret());
+    decompose_bits(b, Field::BITS_LENGTH, B.secret());
 
     cout<<"a: "<<endl<<a<<endl;
     cout<<"b: "<<endl<<b<<endl;
@@ -324,19 +372,60 @@ void debugLessThanUnsigned(PhaseConfig *phase)
     phase->end_online();
 }
 
-void debugBitAdd(PhaseConfig *phase)
+template<class Field>
+void debugBitAdd(PhaseConfig<Field> *phase)
 {
     // Not Used
 }
 
-void debugCarrayPropagation(PhaseConfig *phase)
+template<class Field>
+void debugCarrayPropagation(PhaseConfig<Field> *phase)
 {
     // Not Used
 }
 
-void debugBitsDecomposition(PhaseConfig *phase)
+template<class Field>
+void debugBitsDecomposition(PhaseConfig<Field> *phase)
 {
     // Not Used
 }
 
+template void debugSharePRG<PR31>(PhaseConfig<PR31> *phase);
+template void debugShareBundlePRG<PR31>(PhaseConfig<PR31> *phase);
+template void debugShareBundleDispersed<PR31>(PhaseConfig<PR31> *phase);
+template void debugRandomSharePRG<PR31>(PhaseConfig<PR31> *phase);
+template void debugUnboundedPrefixMult<PR31>(PhaseConfig<PR31> *phase);
+template void debugGetLSB<PR31>(PhaseConfig<PR31> *phase);
+template void debugGetMSB<PR31>(PhaseConfig<PR31> *phase);
+template void debugReLU<PR31>(PhaseConfig<PR31> *phase);
+template void debugBoundPower<PR31>(PhaseConfig<PR31> *phase);
+template void debugMaxPool<PR31>(PhaseConfig<PR31> *phase);
+template void debugBitOp<PR31>(PhaseConfig<PR31> *phase);
+template void debugUnboundedOp<PR31>(PhaseConfig<PR31> *phase);
+template void debugPrefixBlkOp<PR31>(PhaseConfig<PR31> *phase);
+template void debugPrefixOp<PR31>(PhaseConfig<PR31> *phase);
+template void debugLessThanUnsigned<PR31>(PhaseConfig<PR31> *phase);
+template void debugBitAdd<PR31>(PhaseConfig<PR31> *phase);
+template void debugCarrayPropagation<PR31>(PhaseConfig<PR31> *phase);
+template void debugBitsDecomposition<PR31>(PhaseConfig<PR31> *phase);
+
+template void debugSharePRG<PR61>(PhaseConfig<PR61> *phase);
+template void debugShareBundlePRG<PR61>(PhaseConfig<PR61> *phase);
+template void debugShareBundleDispersed<PR61>(PhaseConfig<PR61> *phase);
+template void debugRandomSharePRG<PR61>(PhaseConfig<PR61> *phase);
+template void debugUnboundedPrefixMult<PR61>(PhaseConfig<PR61> *phase);
+template void debugGetLSB<PR61>(PhaseConfig<PR61> *phase);
+template void debugGetMSB<PR61>(PhaseConfig<PR61> *phase);
+template void debugReLU<PR61>(PhaseConfig<PR61> *phase);
+template void debugBoundPower<PR61>(PhaseConfig<PR61> *phase);
+template void debugMaxPool<PR61>(PhaseConfig<PR61> *phase);
+template void debugBitOp<PR61>(PhaseConfig<PR61> *phase);
+template void debugUnboundedOp<PR61>(PhaseConfig<PR61> *phase);
+template void debugPrefixBlkOp<PR61>(PhaseConfig<PR61> *phase);
+template void debugPrefixOp<PR61>(PhaseConfig<PR61> *phase);
+template void debugLessThanUnsigned<PR61>(PhaseConfig<PR61> *phase);
+template void debugBitAdd<PR61>(PhaseConfig<PR61> *phase);
+template void debugCarrayPropagation<PR61>(PhaseConfig<PR61> *phase);
+template void debugBitsDecomposition<PR61>(PhaseConfig<PR61> *phase);
+
 }
@@ -5,29 +5,48 @@ using namespace std;
 namespace hmmpc
 {
 // Share with PRG
-void debugSharePRG(PhaseConfig *phase);
-void debugShareBundlePRG(PhaseConfig *phase);
-void debugRandomSharePRG(PhaseConfig *phase);
+template<class Field>
+void debugSharePRG(PhaseConfig<Field> *phase);
+template<class Field>
+void debugShareBundlePRG(PhaseConfig<Field> *phase);
+template<class Field>
+void debugShareBundleDispersed(PhaseConfig<Field> *phase);
+template<class Field>
+void debugRandomSharePRG(PhaseConfig<Field> *phase);
 
 // ShareBundle
-void debugUnboundedPrefixMult(PhaseConfig *phase);
-void debugGetLSB(PhaseConfig *phase);
-void debugGetMSB(PhaseConfig *phase);
-void debugReLU(PhaseConfig *phase);
-void debugBoundPower(PhaseConfig *phase);
-void debugMaxPool(PhaseConfig *phase);
+template<class Field>
+void debugUnboundedPrefixMult(PhaseConfig<Field> *phase);
+template<class Field>
+void debugGetLSB(PhaseConfig<Field> *phase);
+template<class Field>
+void debugGetMSB(PhaseConfig<Field> *phase);
+template<class Field>
+void debugReLU(PhaseConfig<Field> *phase);
+template<class Field>
+void debugBoundPower(PhaseConfig<Field> *phase);
+template<class Field>
+void debugMaxPool(PhaseConfig<Field> *phase);
 
 // Bit
-void debugBitOp(PhaseConfig *phase);
-void debugUnboundedOp(PhaseConfig *phase);
-void debugPrefixBlkOp(PhaseConfig *phase);
-void debugPrefixOp(PhaseConfig *phase);
+template<class Field>
+void debugBitOp(PhaseConfig<Field> *phase);
+template<class Field>
+void debugUnboundedOp(PhaseConfig<Field> *phase);
+template<class Field>
+void debugPrefixBlkOp(PhaseConfig<Field> *phase);
+template<class Field>
+void debugPrefixOp(PhaseConfig<Field> *phase);
 
-void debugLessThanUnsigned(PhaseConfig *phase);
-void debugBitAdd(PhaseConfig *phase);
-void debugBitsDecomposition(PhaseConfig *phase);
+template<class Field>
+void debugLessThanUnsigned(PhaseConfig<Field> *phase);
+template<class Field>
+void debugBitAdd(PhaseConfig<Field> *phase);
+template<class Field>
+void debugBitsDecomposition(PhaseConfig<Field> *phase);
 
-void debugCarrayPropagation(PhaseConfig *phase);
+template<class Field>
+void debugCarrayPropagation(PhaseConfig<Field> *phase);
 }
 
 #endif
\ No newline at end of file
@@ -52,9 +52,9 @@ done
 function exec_once () {
     # kill_ports
     if test $PlayerID = "0"; then
-        ./$EXECUTION $PlayerID $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES >> $Output_file
+        ./$EXECUTION $PlayerID $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME >> $Output_file
     else
-        ./$EXECUTION $PlayerID $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES >> /dev/null
+        ./$EXECUTION $PlayerID $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME >> /dev/null
     fi
 
     # kill_ports
@@ -54,13 +54,13 @@ function exec_once () {
     id1=$(( 2*$PlayerID ))
     id2=$(( 1+$id1 ))
     if test $PlayerID = "0"; then
-        ./$EXECUTION $id1 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES >> $Output_file &
-        ./$EXECUTION $id2 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES >> /dev/null
+        ./$EXECUTION $id1 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME >> $Output_file &
+        ./$EXECUTION $id2 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME >> /dev/null
     elif test $PlayerID = "10"; then
-        ./$EXECUTION $id1 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES >> /dev/null
+        ./$EXECUTION $id1 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME >> /dev/null
     else 
-        ./$EXECUTION $id1 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES >> /dev/null &
-        ./$EXECUTION $id2 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES >> /dev/null
+        ./$EXECUTION $id1 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME >> /dev/null &
+        ./$EXECUTION $id2 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME >> /dev/null
     fi
 }
 
@@ -10,7 +10,7 @@ PRIME=PR31
 NETWORK=SecureML
 # Dataset = {MNIST}
 DATASET=MNIST
-# True Offline: 
+# True Offline: {0: on demand, 1: separate offline phase, 2: offline job into Preprocessing/, 3: online from Preprocessing/, 4: background producer, 5: plan the randomness into OFFLINE_ARG}
 TRUE_OFFLINE=1
 CORES=4
 
@@ -41,11 +41,12 @@ function clear_file()
 
 function kill_ports() {
     for ((i=0; i<=$1; i=i+1)); do
-        port=$(( 6000+$i ))
-        id=$(lsof -ti:$port)
-        # echo $id
-        for j in ${id[@]}; do
-            kill -9 $j
+        for port in $(( 6000+$i )) $(( 7000+$i )); do
+            id=$(lsof -ti:$port)
+            # echo $id
+            for j in ${id[@]}; do
+                kill -9 $j
+            done
         done
     done
 }
@@ -59,17 +60,17 @@ function exec_once () {
 
     for ((i=1; i<$n; i=i+1)); do 
         if test $TRUE_OFFLINE = "0"; then
-            ./$EXECUTION $i $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES>> /dev/null &
+            ./$EXECUTION $i $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME>> /dev/null &
         else
-            ./$EXECUTION $i $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES>> /dev/null &
+            ./$EXECUTION $i $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME>> /dev/null &
         fi
     done
 
     # For P0
     if test $TRUE_OFFLINE = "0"; then
-        ./$EXECUTION 0 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES 
+        ./$EXECUTION 0 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME 
     else
-        ./$EXECUTION 0 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES
+        ./$EXECUTION 0 $IP_FILE $THRESHOLD $NETWORK $DATASET $TEST_DATA_SIZE $TRUE_OFFLINE $OFFLINE_ARG $CORES $PRIME
     fi
 }
 
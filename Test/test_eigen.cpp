@@ -20,10 +20,16 @@ int main()
     cout<<"#threads: "<<Eigen::nbThreads()<<endl;
     
     // debugGfpDivision();
-    // debugCNNExtend();
-    // debugMaxpoolExtend();
+    // debugGfpMatMul<PR31>();
+    // debugGfpKernels<PR31>();
+    // debugGfpPow<PR31>();
+    // debugFillUniform<PR31>();
+    // debugSeekablePRNG();
+    // debugCNNExtend<PR31>();
+    // debugMaxpoolExtend<PR31>();
 
-    testGfp();
+    testGfp<PR31>();
+    testGfp<PR61>();
     
     return 0;
 }
\ No newline at end of file
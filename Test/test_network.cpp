@@ -1,4 +1,6 @@
 #include <cstdlib>
+#include <sstream>
+#include <thread>
 
 #include "Networking/Player.h"
 #include "Tools/octetStream.h"
@@ -7,32 +9,157 @@
 
 
 using namespace std;
+
+void test(ThreadPlayer &P, IOBackend backend, ostream &out)
+{
+    int player_no = P.my_num();
+    string msg = "The msg is from P" + to_string(player_no);
+    octetStream os_to_send(msg);
+    P.send_all(os_to_send);
+
+    octetStreams os(P.num_players());
+    P.receive_all_no_stats(os);
+    for(int i = 0; i < P.num_players(); i++){
+        if(i!=P.my_num()){
+            out<<os[i].str()<<endl;
+        }
+    }
+
+    // Packages larger than the socket buffers, sent and received concurrently.
+    size_t len = 1<<22;
+    octetStream big;
+    octet *data = big.append(len);
+    for(size_t k = 0; k < len; k++){data[k] = k + P.my_num();}
+    P.request_send_all(big);
+    P.receive_respective(os);
+    P.wait_send_all(big);
+    for(int i = 0; i < P.num_players(); i++){
+        if(i!=P.my_num()){
+            bool ok = os[i].get_length() == len;
+            for(size_t k = 0; ok && k < len; k++){ok = os[i].get_data()[k] == (octet)(k + i);}
+            out<<"Large package from P"<<i<<": "<<ok<<endl;
+        }
+    }
+
+    // The rounds after the first ones reuse the pooled buffers, instead of allocating a buffer per package.
+    size_t heap_allocations = 0;
+    int rounds = 10;
+    for(int round = 0; round < rounds; round++){
+        if(round == 2){heap_allocations = BufferPool::get().heap_allocations;}
+        octetStreams os_round(P.num_players());
+        octetStream os_send(len / 4, data);
+        P.request_send_all(os_send);
+        P.receive_respective(os_round);
+        P.wait_send_all(os_send);
+    }
+    out<<"Buffers reused in the steady state: "<<(BufferPool::get().heap_allocations - heap_allocations < (size_t)rounds - 2)<<endl;
+
+    // Latency of a round of small packages with all parties.
+    Timer timer;
+    timer.start();
+    int latency_rounds = 1000;
+    octetStream os_small("ping");
+    for(int round = 0; round < latency_rounds; round++){
+        P.send_all(os_small);
+        P.receive_all_no_stats(os);
+    }
+    out<<"Round latency: "<<timer.elapsed() * 1e6 / latency_rounds<<" us"<<endl;
+
+    // P0 takes the first package to arrive from the others, and the late ones are dropped before the next round.
+    if(P.num_players() > 2){
+        octetStream os_first("First from P" + to_string(player_no)), os_next("Next from P" + to_string(player_no));
+        if(player_no == 0){
+            vector<int> others;
+            for(int i = 1; i < P.num_players(); i++){others.push_back(i);}
+            octetStreams os_receive(P.num_players());
+            vector<int> first = P.receive_first(others, 1, os_receive);
+            bool ok = first.size() == 1 and os_receive[first[0]].str() == "First from P" + to_string(first[0]);
+            P.receive_respective(os_receive);
+            for(int i = 1; i < P.num_players(); i++){ok &= os_receive[i].str() == "Next from P" + to_string(i);}
+            out<<"First responder and late packages: "<<ok<<endl;
+        }
+        else{
+            P.send_to(0, os_first);
+            P.send_to(0, os_next);
+        }
+    }
+
+    // A second channel over the same connections, waited before the first one.
+    if(backend == MULTIPLEXED){
+        ThreadPlayer Q(P, 1);
+        octetStream os_P("Channel 0 from P" + to_string(player_no)), os_Q("Channel 1 from P" + to_string(player_no));
+        octetStreams os_receive_P(P.num_players()), os_receive_Q(P.num_players());
+        P.request_send_all(os_P);
+        P.request_receive_respective(os_receive_P);
+        Q.request_send_all(os_Q);
+        Q.request_receive_respective(os_receive_Q);
+        Q.wait_receive_respective(os_receive_Q);
+        P.wait_receive_respective(os_receive_P);
+        Q.wait_send_all(os_Q);
+        P.wait_send_all(os_P);
+        for(int i = 0; i < P.num_players(); i++){
+            if(i!=P.my_num()){
+                out<<os_receive_P[i].str()<<"; "<<os_receive_Q[i].str()<<endl;
+            }
+        }
+    }
+
+}
+
+/**
+ * @brief Run the parties as threads over the in-process network,
+ * with the links of 10ms latency, 100MB/s bandwidth and 1ms jitter.
+ *
+ * @param n number of parties
+ */
+void test_loopback(int n)
+{
+    LinkModel model(0.01, 1e8, 0.001);
+    LoopbackNetwork network(n, model);
+    vector<ostringstream> outputs(n);
+    vector<thread> threads;
+    Timer timer;
+    timer.start();
+    for(int i = 0; i < n; i++){
+        threads.push_back(thread([&, i](){
+            ThreadPlayer P(network, i);
+            test(P, THREAD_PER_PLAYER, outputs[i]);
+        }));
+    }
+    for(auto &t: threads){
+        t.join();
+    }
+    for(auto &output: outputs){
+        cout<<output.str();
+    }
+    // Two rounds of the latency, and the large package serialized at the bandwidth.
+    double bound = 2 * model.latency + (1<<22) / model.bandwidth;
+    cout<<"Emulated time above the link model: "<<(timer.elapsed() >= bound)<<endl;
+}
+
 int main(int argc, char** argv)
 {
-    if (argc != 2){
+    if (argc != 2 && argc != 3){
         cerr<<"Call using\n\t";
-        cerr<<"./test_float.x ID ";
+        cerr<<"./test_network.x ID [BACKEND]\n\t";
+        cerr<<"./test_network.x L N";
         cerr<<"\t\t ID          = Number of machines"<<endl;
+        cerr<<"\t\t BACKEND     = I/O backend {0: a Sender and a Receiver per party, 1: epoll, 2: io_uring, 3: multiplexed}"<<endl;
+        cerr<<"\t\t L N         = Run N parties as threads of this process over emulated links"<<endl;
         exit(1);
     }
 
+    if (string(argv[1]) == "L"){
+        test_loopback(argc > 2 ? atoi(argv[2]) : 3);
+        return 0;
+    }
+
     int player_no = atoi(argv[1]);
     int portnum_base = 6000;
 
     string filename = "Test/HOSTS.example";
     Names player_name = Names(player_no, portnum_base, filename);
-    ThreadPlayer P(player_name, "");
-
-    string msg = "The msg is from P" + to_string(player_no);
-    octetStream os_to_send(msg);
-    P.send_all(os_to_send);
-
-    octetStreams os(3);
-    P.receive_all_no_stats(os);
-    for(int i = 0; i < P.num_players(); i++){
-        if(i!=P.my_num()){
-            cout<<os[i].str()<<endl;
-        }
-    }
-
+    IOBackend backend = argc > 2 ? (IOBackend)atoi(argv[2]) : IO_BACKEND;
+    ThreadPlayer P(player_name, "", backend);
+    test(P, backend, cout);
 }
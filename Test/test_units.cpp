@@ -10,7 +10,8 @@
 
 using namespace std;
 using namespace hmmpc;
-int main(int argc, char** argv)
+template<class Field>
+int run(char** argv)
 {
 
     int player_no = atoi(argv[1]);
@@ -20,7 +21,7 @@ int main(int argc, char** argv)
     ThreadPlayer P(player_name, "");
     int threshold = 1;
 
-    PhaseConfig phase;
+    PhaseConfig<Field> phase;
     phase.init(P.num_players(), threshold, &P);
 
     string which_test = argv[2];
@@ -59,6 +60,16 @@ int main(int argc, char** argv)
         // Prot 5.4: ReLU
         debugMaxPool(&phase);
     }
+    else if (which_test.compare("Dispersed")==0)
+    {
+        // Input and reveal dispersed to all parties
+        debugShareBundleDispersed(&phase);
+    }
+    else if (which_test.compare("Deferred")==0)
+    {
+        // Independent multiplications sharing one round
+        debugSfixDeferred(&phase);
+    }
     else
     {
         // *Other unit tests;
@@ -83,3 +94,15 @@ int main(int argc, char** argv)
 
     return 0;
 }
+
+// which_test = argv[2], prime = argv[3] (optional) {PR31, PR61}, PR31 by default
+int main(int argc, char** argv)
+{
+    string prime = argc > 3 ? argv[3] : PR31::NAME;
+    if(prime == PR31::NAME)
+        return run<PR31>(argv);
+    if(prime == PR61::NAME)
+        return run<PR61>(argv);
+    cerr<<"Unknown field "<<prime<<", expected "<<PR31::NAME<<" or "<<PR61::NAME<<"."<<endl;
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "Tools/BufferPool.h"
+
+BufferPool::BufferPool(): heap_allocations(0)
+{
+    for(auto &c: classes){
+        pthread_mutex_init(&c.mutex, 0);
+    }
+}
+
+BufferPool& BufferPool::get()
+{
+    static BufferPool *pool = new BufferPool;
+    return *pool;
+}
+
+// Index of the smallest class of at least size bytes, or -1 for the sizes beyond the pool.
+int BufferPool::size_class(size_t size)
+{
+    if(size <= ((size_t)1 << MIN_BITS)){
+        return 0;
+    }
+    int bits = 64 - __builtin_clzll(size - 1);
+    return bits > MAX_BITS ? -1 : bits - MIN_BITS;
+}
+
+octet* BufferPool::allocate(size_t &size)
+{
+    int c = size_class(size);
+    if(c < 0 or POOL_CLASS_BYTES == 0){
+        heap_allocations++;
+        return new octet[size];
+    }
+    size = (size_t)1 << (c + MIN_BITS);
+    SizeClass &sc = classes[c];
+    octet *res = 0;
+    pthread_mutex_lock(&sc.mutex);
+    if(!sc.free.empty()){
+        res = sc.free.back();
+        sc.free.pop_back();
+    }
+    pthread_mutex_unlock(&sc.mutex);
+    if(!res){
+        heap_allocations++;
+        res = new octet[size];
+    }
+    return res;
+}
+
+void BufferPool::release(octet *buffer, size_t size)
+{
+    int c = size_class(size);
+    if(c >= 0 and POOL_CLASS_BYTES > 0){
+        SizeClass &sc = classes[c];
+        pthread_mutex_lock(&sc.mutex);
+        bool keep = (sc.free.size() + 1) * size <= POOL_CLASS_BYTES;
+        if(keep){
+            sc.free.push_back(buffer);
+        }
+        pthread_mutex_unlock(&sc.mutex);
+        if(keep){return;}
+    }
+    delete[] buffer;
+}
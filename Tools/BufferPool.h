@@ -0,0 +1,56 @@
+/*
+ * BufferPool.h
+ *
+ */
+
+#ifndef TOOLS_BUFFERPOOL_H_
+#define TOOLS_BUFFERPOOL_H_
+
+#include <pthread.h>
+#include <atomic>
+#include <vector>
+
+#include "Tools/int.h"
+
+using namespace std;
+
+// Bytes of the free buffers kept in each size class of the pool (0 disables the pool).
+#ifndef POOL_CLASS_BYTES
+#define POOL_CLASS_BYTES (1 << 28)
+#endif
+
+/**
+ * @brief Free lists of the octetStream buffers in power-of-two size classes, shared by all threads.
+ * A released buffer is kept for the next allocation of its class,
+ * so that each round reuses the buffers of the previous ones (often released by another thread, e.g. a Receiver)
+ * instead of allocating from the heap.
+ */
+class BufferPool
+{
+    // Classes of 2^MIN_BITS to 2^MAX_BITS bytes, larger buffers bypass the pool.
+    static const int MIN_BITS = 6, MAX_BITS = 30;
+
+    struct SizeClass
+    {
+        pthread_mutex_t mutex;
+        vector<octet*> free;
+    };
+    SizeClass classes[MAX_BITS - MIN_BITS + 1];
+
+    static int size_class(size_t size);
+
+    BufferPool();
+
+public:
+    atomic<size_t> heap_allocations;
+
+    // The pool is never destroyed, as the static and thread_local octetStreams may be destroyed after it.
+    static BufferPool& get();
+
+    // Allocate a buffer of at least size bytes, and round up size to its capacity.
+    octet* allocate(size_t &size);
+    // Release a buffer of the capacity returned by allocate().
+    void release(octet *buffer, size_t size);
+};
+
+#endif /* TOOLS_BUFFERPOOL_H_ */
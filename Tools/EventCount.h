@@ -0,0 +1,103 @@
+/*
+ * EventCount.h
+ *
+ */
+
+#ifndef TOOLS_EVENTCOUNT_H_
+#define TOOLS_EVENTCOUNT_H_
+
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#include <sched.h>
+#include <atomic>
+
+using namespace std;
+
+// Polls of a lock-free wait before sleeping by futex
+#ifndef SPIN_COUNT
+#define SPIN_COUNT 256
+#endif
+
+static inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+/**
+ * @brief Wakeup of a single waiter for a lock-free condition, by futex.
+ * The waiter reads the count by prepare() before checking its condition, and then sleeps by wait() only if no notify() came since.
+ * notify() only enters the kernel if the waiter announced its sleep.
+ * It works across processes in shared memory as well.
+ * With BUSY_POLL, wait() only yields the CPU, so that the waiter polls its condition without sleeping.
+ */
+class EventCount
+{
+    atomic<uint32_t> count;
+    atomic<uint32_t> waiting;
+
+public:
+    EventCount(): count(0), waiting(0) {}
+
+    uint32_t prepare()
+    {
+        return count.load();
+    }
+
+    void wait(uint32_t key)
+    {
+#ifdef BUSY_POLL
+        (void)key;
+        sched_yield();
+#else
+        waiting.store(1);
+        if (count.load() == key)
+            syscall(SYS_futex, (uint32_t*)&count, FUTEX_WAIT, key, 0, 0, 0);
+        waiting.store(0, memory_order_relaxed);
+#endif
+    }
+
+    void notify()
+    {
+        count.fetch_add(1);
+#ifndef BUSY_POLL
+        if (waiting.load())
+            syscall(SYS_futex, (uint32_t*)&count, FUTEX_WAKE, 1, 0, 0, 0);
+#endif
+    }
+};
+
+// Polls before sleeping, which only pay off if the other side runs on another CPU.
+inline int spin_count()
+{
+    static int res = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? SPIN_COUNT : 0;
+    return res;
+}
+
+/**
+ * @brief Wait until ready() holds: poll it spin_count() times, and then sleep between the notifications of event.
+ *
+ * @param event notified after each change of the condition
+ * @param ready
+ */
+template<class T>
+inline void wait_until(EventCount &event, T ready)
+{
+    for (int k = 0; k < spin_count(); k++)
+    {
+        if (ready())
+            return;
+        cpu_relax();
+    }
+    while (true)
+    {
+        uint32_t key = event.prepare();
+        if (ready())
+            return;
+        event.wait(key);
+    }
+}
+
+#endif /* TOOLS_EVENTCOUNT_H_ */
@@ -0,0 +1,108 @@
+/*
+ * SpscQueue.h
+ *
+ */
+
+#ifndef TOOLS_SPSCQUEUE_H_
+#define TOOLS_SPSCQUEUE_H_
+
+#include <vector>
+#include <cassert>
+
+#include "Tools/EventCount.h"
+
+// Slots of an SpscQueue, bounding the requests outstanding with a party
+#ifndef SPSC_CAPACITY
+#define SPSC_CAPACITY 1024
+#endif
+
+// Requests that a Sender or Receiver thread holds at most: its full in and out queues, and the one it is serving.
+// The next request would block the protocol thread forever, as the out queue is popped only by its waits.
+#define SPSC_MAX_OUTSTANDING (2 * SPSC_CAPACITY + 1)
+
+// Separates the indices of the producer and the consumer by a cache line,
+// without the over-aligned allocation that alignas(64) would need under C++11.
+#define SPSC_PADDING 64
+
+/**
+ * @brief Bounded lock-free queue between a single producer thread and a single consumer thread,
+ * in place of WaitQueue between the protocol thread and a Sender or Receiver thread.
+ * The blocked side spins shortly before sleeping by futex (see EventCount).
+ */
+template<class T>
+class SpscQueue
+{
+    vector<T> slots;
+    size_t mask;
+
+    char padding_head[SPSC_PADDING];
+    atomic<size_t> head; // pushed, written by the producer
+    EventCount pushed;
+    char padding_tail[SPSC_PADDING];
+    atomic<size_t> tail; // popped, written by the consumer
+    EventCount popped;
+    char padding_end[SPSC_PADDING];
+    atomic<bool> running;
+    EventCount *event;
+
+    // prevent copying
+    SpscQueue(const SpscQueue& other);
+
+public:
+    SpscQueue(size_t capacity = SPSC_CAPACITY) : slots(capacity), mask(capacity - 1), head(0), tail(0), running(true), event(0)
+    {
+        assert((capacity & mask) == 0);
+    }
+
+    // Push the value, blocking while the queue is full.
+    void push(const T& value)
+    {
+        size_t h = head.load(memory_order_relaxed);
+        if (h - tail.load(memory_order_acquire) == slots.size())
+            wait_until(popped, [&](){return h - tail.load(memory_order_acquire) < slots.size();});
+        slots[h & mask] = value;
+        head.store(h + 1, memory_order_release);
+        pushed.notify();
+        if (event)
+            event->notify();
+    }
+
+    // Notify the event after each push, to wait for several queues at once by try_pop().
+    void set_event(EventCount *e)
+    {
+        event = e;
+    }
+
+    // Pop the next value if any, without waiting.
+    bool try_pop(T& value)
+    {
+        size_t t = tail.load(memory_order_relaxed);
+        if (head.load(memory_order_acquire) == t)
+            return false;
+        value = slots[t & mask];
+        tail.store(t + 1, memory_order_release);
+        popped.notify();
+        return true;
+    }
+
+    // Pop the next value, blocking while the queue is empty. Return false once stopped.
+    bool pop(T& value)
+    {
+        size_t t = tail.load(memory_order_relaxed);
+        wait_until(pushed, [&](){return head.load(memory_order_acquire) != t or !running.load();});
+        if (!running.load())
+            return false;
+        value = slots[t & mask];
+        tail.store(t + 1, memory_order_release);
+        popped.notify();
+        return true;
+    }
+
+    void stop()
+    {
+        running.store(false);
+        pushed.notify();
+    }
+};
+
+#endif /* TOOLS_SPSCQUEUE_H_ */
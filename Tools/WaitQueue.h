@@ -8,6 +8,9 @@
 
 #include <pthread.h>
 #include <deque>
+
+#include "Tools/EventCount.h"
+
 using namespace std;
 
 template<class T>
@@ -18,12 +21,13 @@ class WaitQueue
 
     deque<T> queue;
     bool running;
+    EventCount *event;
 
     // prevent copying
     WaitQueue(const WaitQueue& other);
 
 public:
-    WaitQueue() : running(true)
+    WaitQueue() : running(true), event(0)
     {
         pthread_mutex_init(&mutex, 0);
         pthread_cond_init(&cond, 0);
@@ -55,12 +59,45 @@ public:
         pthread_cond_signal(&cond);
     }
 
+    // Notify the event after each push, to wait for several queues at once by try_pop().
+    void set_event(EventCount *e)
+    {
+        event = e;
+    }
+
     void push(const T& value)
     {
         lock();
         queue.push_back(value);
         signal();
         unlock();
+        if (event)
+            event->notify();
+    }
+
+    // Pop the front value if any, without waiting.
+    bool try_pop(T& value)
+    {
+        lock();
+        bool something_for_you = queue.size() > 0;
+        if (something_for_you)
+        {
+            value = queue.front();
+            queue.pop_front();
+        }
+        unlock();
+        return something_for_you;
+    }
+
+    // Copy the front value if any, without popping it.
+    bool try_front(T& value)
+    {
+        lock();
+        bool something_for_you = queue.size() > 0;
+        if (something_for_you)
+            value = queue.front();
+        unlock();
+        return something_for_you;
     }
 
     bool pop(T& value)
@@ -99,6 +136,21 @@ public:
         return something_for_you;
     }
 
+    // Wait for at least one value, and move all the values out.
+    bool pop_all(deque<T>& values)
+    {
+        lock();
+        if (running and queue.size() == 0)
+            wait();
+        if (running)
+        {
+            values.insert(values.end(), queue.begin(), queue.end());
+            queue.clear();
+        }
+        unlock();
+        return running;
+    }
+
     void stop()
     {
         lock();
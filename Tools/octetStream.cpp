@@ -1,4 +1,6 @@
 #include <string>
+#include <climits>
+#include <poll.h>
 
 #include "Tools/octetStream.h"
 #include "Networking/Player.h"
@@ -10,10 +12,9 @@
  */
 octetStream::octetStream(const string& other)
 {
-    mxlen = other.size();
-    len = mxlen;
+    allocate(other.size());
+    len = other.size();
     ptr = 0;
-    data = new octet[mxlen];
     avx_memcpy(data, (const octet*)other.data(), len*sizeof(octet));
 }
 
@@ -24,10 +25,9 @@ octetStream::octetStream(const string& other)
  */
 octetStream::octetStream(size_t maxlen)
 {
-    mxlen = maxlen;
+    allocate(maxlen);
     len = 0;
     ptr = 0;
-    data = new octet[mxlen];
 }
 
 octetStream::octetStream(size_t len, const octet* source):
@@ -39,22 +39,16 @@ octetStream::octetStream(size_t len, const octet* source):
 // Free the memory
 void octetStream::clear()
 {
-    if(data){
-        delete[] data;
-    }
-    data = 0;
-    len = mxlen = ptr = 0;
+    release();
+    reset();
 }
 
 // Assign with other octetStream
 void octetStream::assign(const octetStream &os)
 {
     if(os.len>mxlen){
-        if(data){
-            delete[] data;
-        }
-        mxlen = os.mxlen;
-        data = new octet[mxlen];
+        release();
+        allocate(os.mxlen);
     }
     len = os.len;
     memcpy(data, os.data, len*sizeof(octet));
@@ -86,3 +80,226 @@ void octetStreams::clear()
         o.clear();
     }
 }
+
+void octetViews::append(const void *x, size_t l)
+{
+    if(l == 0){return;}
+    views.push_back({(void*)x, l});
+    len += l;
+}
+
+/**
+ * @brief Fill the gather list of the package [len||views] from the offset 'done'.
+ * 
+ * @param header encoded length field
+ * @param done bytes of the package already sent
+ * @param iov [out]
+ * @param max_iov 
+ * @return size_t number of entries of iov
+ */
+size_t octetViews::get_iov(const octet *header, size_t done, iovec *iov, size_t max_iov)const
+{
+    size_t n = 0;
+    if(done < LENGTH_SIZE){
+        iov[n++] = {(void*)(header + done), LENGTH_SIZE - done};
+        done = 0;
+    }
+    else{
+        done -= LENGTH_SIZE;
+    }
+    for(size_t k = 0; k < views.size() && n < max_iov; k++){
+        if(done >= views[k].iov_len){
+            done -= views[k].iov_len;
+            continue;
+        }
+        iov[n++] = {(octet*)views[k].iov_base + done, views[k].iov_len - done};
+        done = 0;
+    }
+    return n;
+}
+
+/**
+ * @brief Send the package via the socket, without copying the views into a buffer.
+ * With MSG_ZEROCOPY, it returns after the kernel releases the memory.
+ * 
+ * @param socket_num connection socket number
+ */
+void octetViews::Send(int socket_num)const
+{
+    octet header[LENGTH_SIZE];
+    encode_length(header, len, LENGTH_SIZE);
+    int flags = 0;
+#if ZEROCOPY_THRESHOLD > 0
+    if(len >= ZEROCOPY_THRESHOLD && zerocopy_enabled(socket_num)){
+        flags = MSG_ZEROCOPY;
+    }
+#endif
+
+    iovec iov[IOV_MAX];
+    size_t n_zerocopy = 0;
+    for(size_t done = 0; done < LENGTH_SIZE + len;){
+        size_t n = get_iov(header, done, iov, IOV_MAX);
+        size_t sent = send_non_blocking(socket_num, iov, n, flags);
+        if(sent && flags){n_zerocopy++;}
+        if(!sent && flags && errno == ENOBUFS){flags = 0;} // Out of the pinned memory: copy the rest
+        done += sent;
+    }
+    if(n_zerocopy){
+        wait_zerocopy(socket_num, n_zerocopy);
+    }
+}
+
+/**
+ * @brief Receive the package via the socket into the viewed memory, without a buffer.
+ * The length of the package must be known by the receiver.
+ * 
+ * @param socket_num connection socket number
+ */
+void octetViews::Receive(int socket_num)const
+{
+    octet header[LENGTH_SIZE];
+    receive(socket_num, header, LENGTH_SIZE);
+    check_length(header);
+    receive_data(socket_num);
+}
+
+void octetViews::receive_data(int socket_num)const
+{
+    for(auto &view: views){
+        receive(socket_num, (octet*)view.iov_base, view.iov_len);
+    }
+}
+
+void octetViews::check_length(const octet *header)const
+{
+    size_t l = decode_length((octet*)header, LENGTH_SIZE);
+    if(l != len){
+        throw invalid_length("received " + to_string(l) + " bytes, expected " + to_string(len));
+    }
+}
+
+void octetViews::unpack(octetStream &os)const
+{
+    if(os.get_length() != len){
+        throw invalid_length("received " + to_string(os.get_length()) + " bytes, expected " + to_string(len));
+    }
+    for(auto &view: views){
+        os.consume((octet*)view.iov_base, view.iov_len);
+    }
+}
+
+octetViews octetViews::slice(size_t begin, size_t end)const
+{
+    octetViews res;
+    size_t offset = 0;
+    for(auto &view: views){
+        size_t b = max(begin, offset), e = min(end, offset + view.iov_len);
+        if(b < e){
+            res.append((octet*)view.iov_base + (b - offset), e - b);
+        }
+        offset += view.iov_len;
+    }
+    return res;
+}
+
+/**
+ * @brief Stripe rule: the small packages are carried by the stripe 0 only,
+ * and the large packages are split into n consecutive parts of (almost) equal size.
+ * 
+ * @param l length of the data
+ * @param j stripe
+ * @param n number of stripes
+ * @param begin [out]
+ * @param end [out]
+ */
+void octetViews::stripe_range(size_t l, size_t j, size_t n, size_t &begin, size_t &end)
+{
+    if(n == 1 || l < STRIPE_THRESHOLD){
+        begin = j ? l : 0;
+        end = l;
+        return;
+    }
+    begin = l / n * j;
+    end = j + 1 == n ? l : l / n * (j + 1);
+}
+
+/**
+ * @brief Send the package over the parallel connections, so that a large package is not limited by one congestion window.
+ * The stripe 0 carries the length field with its part of the data, and the other stripes carry their parts only.
+ * The stripes are written in turn without blocking, and the thread polls when none of them can progress.
+ * 
+ * @param sockets connections to the same party
+ */
+void octetViews::Send(const vector<int> &sockets)const
+{
+    size_t n = sockets.size();
+    if(n == 1){
+        Send(sockets[0]);
+        return;
+    }
+    octet header[LENGTH_SIZE];
+    encode_length(header, len, LENGTH_SIZE);
+    vector<octetViews> parts(n);
+    vector<size_t> done(n, 0), total(n);
+    for(size_t j = 0; j < n; j++){
+        size_t begin, end;
+        stripe_range(len, j, n, begin, end);
+        parts[j] = slice(begin, end);
+        total[j] = (j ? 0 : LENGTH_SIZE) + parts[j].get_length();
+    }
+
+    iovec iov[IOV_MAX];
+    vector<pollfd> fds;
+    while(true){
+        bool progress = false;
+        fds.clear();
+        for(size_t j = 0; j < n; j++){
+            if(done[j] == total[j]){continue;}
+            // The offset of the other stripes skips the length field.
+            size_t k = parts[j].get_iov(header, j ? done[j] + LENGTH_SIZE : done[j], iov, IOV_MAX);
+            size_t sent = send_non_blocking(sockets[j], iov, k);
+            done[j] += sent;
+            progress |= sent > 0;
+            if(done[j] < total[j]){fds.push_back({sockets[j], POLLOUT, 0});}
+        }
+        if(fds.empty()){break;}
+        if(!progress && poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR){
+            error("octetViews: poll");
+        }
+    }
+}
+
+void octetViews::receive_data(const vector<int> &sockets)const
+{
+    size_t n = sockets.size();
+    if(n == 1){
+        receive_data(sockets[0]);
+        return;
+    }
+    vector<octetViews> parts(n);
+    vector<size_t> done(n, 0);
+    for(size_t j = 0; j < n; j++){
+        size_t begin, end;
+        stripe_range(len, j, n, begin, end);
+        parts[j] = slice(begin, end);
+    }
+
+    iovec iov[IOV_MAX];
+    vector<pollfd> fds;
+    while(true){
+        bool progress = false;
+        fds.clear();
+        for(size_t j = 0; j < n; j++){
+            if(done[j] == parts[j].get_length()){continue;}
+            size_t k = parts[j].get_iov(0, done[j] + LENGTH_SIZE, iov, IOV_MAX);
+            size_t received = receive_non_blocking(sockets[j], iov, k);
+            done[j] += received;
+            progress |= received > 0;
+            if(done[j] < parts[j].get_length()){fds.push_back({sockets[j], POLLIN, 0});}
+        }
+        if(fds.empty()){break;}
+        if(!progress && poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR){
+            error("octetViews: poll");
+        }
+    }
+}
@@ -15,6 +15,7 @@
 #include "Networking/sockets.h"
 #include "Tools/int.h"
 #include "Tools/avx_memcpy.h"
+#include "Tools/BufferPool.h"
 
 using namespace std;
 // static int latency_cnt = 0;
@@ -27,10 +28,13 @@ class octetStream
     octet *data;
 
     void reset() {mxlen = len = ptr = 0; data = 0;}
+    // Take the buffers from the BufferPool.
+    void allocate(size_t l) {mxlen = l; data = BufferPool::get().allocate(mxlen);}
+    void release() {if(data){BufferPool::get().release(data, mxlen);}}
 
 public:
     octetStream(): len(0), mxlen(0), ptr(0), data(0) {}
-    ~octetStream() {if(data){delete[] data;}}
+    ~octetStream() {release();}
 
     // Construct a new octet Stream from a string
     octetStream(const string& other);
@@ -38,10 +42,14 @@ public:
     octetStream(size_t maxlen);
     // inital buffer
     octetStream(size_t len, const octet* source);
-    octetStream& operator=(const octetStream& os)
-    { if (this!=&os) { assign(os); }
-      return *this;
-    }
+    // Move-only, so that the buffers are only copied by an explicit assign()
+    octetStream(const octetStream& os) = delete;
+    octetStream& operator=(const octetStream& os) = delete;
+    octetStream(octetStream&& os) noexcept: octetStream() {swap(os);}
+    octetStream& operator=(octetStream&& os) noexcept {swap(os); return *this;}
+    // Exchange the data without copying
+    void swap(octetStream& os)
+    { std::swap(len, os.len); std::swap(mxlen, os.mxlen); std::swap(ptr, os.ptr); std::swap(data, os.data); }
 
     // Free memory
     void clear();
@@ -104,6 +112,63 @@ public:
     void clear();
 };
 
+// Sends of at least this size use MSG_ZEROCOPY if the socket enables it (0 disables it).
+#ifndef ZEROCOPY_THRESHOLD
+#define ZEROCOPY_THRESHOLD 0
+#endif
+
+// Packages of at least this size are striped over the parallel connections to a party.
+#ifndef STRIPE_THRESHOLD
+#define STRIPE_THRESHOLD (1<<16)
+#endif
+
+/**
+ * @brief Views of the memory sent as one package, without copying it into an octetStream.
+ * The package is the same as octetStream::Send(), i.e. [len||data],
+ * so it is received by octetStream::Receive().
+ * The viewed memory must stay valid and unchanged until the send is waited.
+ * Conversely, a package of known length can be received straight into the (writable) viewed memory.
+ */
+class octetViews
+{
+    vector<iovec> views;
+    size_t len;
+
+public:
+    octetViews(): len(0){}
+    // View the data of the octetStream.
+    octetViews(const octetStream &os): len(0){append(os.get_data(), os.get_length());}
+
+    // Append the view of 'l' bytes from 'x'
+    void append(const void *x, size_t l);
+    void clear(){views.clear(); len = 0;}
+    size_t get_length()const{return len;}
+    size_t size()const{return views.size();}
+
+    // Gather list of the package from the offset 'done', with the length field in header.
+    size_t get_iov(const octet *header, size_t done, iovec *iov, size_t max_iov)const;
+
+    // Send the package by sendmsg, with MSG_ZEROCOPY for ZEROCOPY_THRESHOLD bytes or more.
+    void Send(int socket_num)const;
+    // Receive a package of length get_length() into the viewed memory.
+    void Receive(int socket_num)const;
+    // Receive the data of a package whose length field is already read.
+    void receive_data(int socket_num)const;
+    // Check the received length field.
+    void check_length(const octet *header)const;
+    // Copy a package received into an octetStream to the viewed memory.
+    void unpack(octetStream &os)const;
+
+    // Views of the bytes [begin, end) of the data.
+    octetViews slice(size_t begin, size_t end)const;
+    // Bytes [begin, end) of the data of a package of length l carried by the stripe j out of n.
+    static void stripe_range(size_t l, size_t j, size_t n, size_t &begin, size_t &end);
+    // Send the package striped over the parallel connections to a party.
+    void Send(const vector<int> &sockets)const;
+    // Receive the striped data of a package whose length field is already read from sockets[0].
+    void receive_data(const vector<int> &sockets)const;
+};
+
 /**
  * @brief Resize the data allocation to size l
  * 
@@ -115,15 +180,15 @@ inline void octetStream::resize_precise(size_t l)
         return;
     }
     // New allocation
-    octet *nd = new octet[l];
-    if (data)
+    octet *old = data;
+    size_t old_mxlen = mxlen;
+    allocate(l);
+    if (old)
     {
         // copy the origin data to new memory
-        memcpy(nd, data, min(len, l)*sizeof(octet));
-        delete [] data;
+        memcpy(data, old, min(len, l)*sizeof(octet));
+        BufferPool::get().release(old, old_mxlen);
     }
-    data = nd;
-    mxlen = l;
 }
 
 /**
@@ -203,7 +268,7 @@ inline void octetStream::consume(octet* x, const size_t l)
 
 inline void octetStream::store_int(size_t l, int n_bytes)
 {
-    resize(len+l);
+    resize(len+n_bytes);
     encode_length(data+len, l, n_bytes);
     len+=n_bytes;
 }
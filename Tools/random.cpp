@@ -4,7 +4,7 @@
 using namespace std;
 
 PRNG::PRNG():
-    cnt(0)
+    cnt(0), next_stream(1)
 {
 
 }
@@ -55,6 +55,7 @@ void PRNG::InitSeed()
 #else
     memcpy(state, seed, SEED_SIZE*sizeof(octet));
 #endif
+    next_stream = 1;
     hash();
 #ifdef DEBUG_RANDOM
     cout<<"[SetSeed]:";
@@ -146,3 +147,148 @@ void PRNG::print_state() const
     cout << "Cnt: " << dec << cnt <<endl;
 }
 
+
+/*************************************************
+ *
+ *       Counter-addressed access
+ * Block b of stream s is AES_k(b || s), i.e. the lower 64 bits of the counter are b
+ * and the higher 64 bits are s. Stream 0 is exactly the sequential output of the PRNG,
+ * so any (stream_id, offset) can be generated independently, e.g. by several threads,
+ * and it is the same bit-for-bit across parties sharing the seed.
+ * 
+ * ***********************************************/
+typedef void (*aes_ctr_func)(octet* out, size_t n_blocks, word stream_id, word first_block, const octet* key);
+
+/**
+ * @brief AES-CTR with the AES-NI instructions (PIPELINES blocks at a time).
+ * 
+ * @param out [out] n_blocks*AES_BLK_SIZE octets, need not be aligned
+ * @param n_blocks 
+ * @param stream_id 
+ * @param first_block 
+ * @param key round keys
+ */
+static void aes_ctr_aesni(octet* out, size_t n_blocks, word stream_id, word first_block, const octet* key)
+{
+    __m128i in[PIPELINES], tmp[PIPELINES];
+    size_t i = 0;
+    for(; i + PIPELINES <= n_blocks; i += PIPELINES){
+        for(int j = 0; j < PIPELINES; j++){
+            in[j] = _mm_set_epi64x(stream_id, first_block + i + j);
+        }
+        ecb_aes_128_encrypt<PIPELINES>(tmp, in, key);
+        for(int j = 0; j < PIPELINES; j++){
+            _mm_storeu_si128((__m128i*)out + i + j, tmp[j]);
+        }
+    }
+    for(; i < n_blocks; i++){
+        in[0] = _mm_set_epi64x(stream_id, first_block + i);
+        ecb_aes_128_encrypt<1>(tmp, in, key);
+        _mm_storeu_si128((__m128i*)out + i, tmp[0]);
+    }
+}
+
+#ifdef __x86_64__
+/**
+ * @brief AES-CTR with the VAES instructions, 4 AES blocks in each 512-bit register
+ * and 4 registers in flight (16 blocks at a time). The tail falls back to AES-NI.
+ */
+__attribute__((target("aes,vaes,avx512f")))
+static void aes_ctr_vaes(octet* out, size_t n_blocks, word stream_id, word first_block, const octet* key)
+{
+    const int N = 4;
+    __m512i round_keys[11];
+    for(int r = 0; r < 11; r++){
+        // set4 instead of _mm512_broadcast_i32x4/_mm512_shuffle_i32x4, which read an undefined register under GCC
+        __m128i k = _mm_loadu_si128((const __m128i*)key + r);
+        word lo = _mm_cvtsi128_si64(k), hi = _mm_extract_epi64(k, 1);
+        round_keys[r] = _mm512_set4_epi64(hi, lo, hi, lo);
+    }
+    const __m512i step = _mm512_set_epi64(0, 4, 0, 4, 0, 4, 0, 4);
+    __m512i ctr = _mm512_set_epi64(stream_id, first_block+3, stream_id, first_block+2,
+                                stream_id, first_block+1, stream_id, first_block);
+    size_t i = 0;
+    for(; i + 4*N <= n_blocks; i += 4*N){
+        __m512i tmp[N];
+        for(int j = 0; j < N; j++){
+            tmp[j] = _mm512_xor_si512(ctr, round_keys[0]);
+            ctr = _mm512_add_epi64(ctr, step);
+        }
+        for(int r = 1; r < 10; r++)
+            for(int j = 0; j < N; j++){
+                tmp[j] = _mm512_aesenc_epi128(tmp[j], round_keys[r]);
+            }
+        for(int j = 0; j < N; j++){
+            _mm512_storeu_si512(out + (i + 4*j)*AES_BLK_SIZE, _mm512_aesenclast_epi128(tmp[j], round_keys[10]));
+        }
+    }
+    if(i < n_blocks){
+        aes_ctr_aesni(out + i*AES_BLK_SIZE, n_blocks - i, stream_id, first_block + i, key);
+    }
+}
+#endif
+
+struct AesCtrImpl
+{
+    const char* name;
+    aes_ctr_func func;
+};
+
+/**
+ * @brief Select the AES-CTR implementation once according to the CPU.
+ * Define NO_VAES to always use AES-NI.
+ */
+static const AesCtrImpl& aes_ctr_impl()
+{
+    static const AesCtrImpl impl = []() -> AesCtrImpl {
+#if defined(__x86_64__) && !defined(NO_VAES)
+        if(__builtin_cpu_supports("vaes") && __builtin_cpu_supports("avx512f")){
+            return {"vaes", aes_ctr_vaes};
+        }
+#endif
+        return {"aesni", aes_ctr_aesni};
+    }();
+    return impl;
+}
+
+const char* PRNG::ctr_name()
+{
+    return aes_ctr_impl().name;
+}
+
+/**
+ * @brief Get len random octets of the stream stream_id, starting from the octet offset.
+ * It does not change the sequential state, so it could be called concurrently.
+ * 
+ * @param ans [out]
+ * @param len 
+ * @param stream_id 
+ * @param offset in octets
+ */
+void PRNG::get_octets_at(octet* ans, size_t len, word stream_id, word offset) const
+{
+    aes_ctr_func func = aes_ctr_impl().func;
+    word block_id = offset / AES_BLK_SIZE;
+    size_t skip = offset % AES_BLK_SIZE;
+    octet tmp[AES_BLK_SIZE];
+    // Unaligned head
+    if(skip && len){
+        func(tmp, 1, stream_id, block_id, KeySchedule);
+        size_t step = min(len, AES_BLK_SIZE - skip);
+        memcpy(ans, tmp + skip, step);
+        ans += step;
+        len -= step;
+        block_id++;
+    }
+    // Full blocks straight into ans
+    size_t n_blocks = len / AES_BLK_SIZE;
+    func(ans, n_blocks, stream_id, block_id, KeySchedule);
+    ans += n_blocks * AES_BLK_SIZE;
+    len -= n_blocks * AES_BLK_SIZE;
+    block_id += n_blocks;
+    // Partial tail
+    if(len){
+        func(tmp, 1, stream_id, block_id, KeySchedule);
+        memcpy(ans, tmp, len);
+    }
+}
@@ -44,6 +44,9 @@ class PRNG
     int n_cached_bits;
     word cached_bits;
 
+    // Next unused stream for the counter-addressed access (stream 0 is the sequential one).
+    word next_stream;
+
     void hash();// Hashes state to random and sets cnt=0
     void next();// Increse the State
 
@@ -74,6 +77,11 @@ public:
     void get_octets(octet* ans, int len);
     template<int L>
     void get_octets(octet* ans);
+
+    // Counter-addressed access
+    word new_streams(word n=1);
+    void get_octets_at(octet* ans, size_t len, word stream_id, word offset) const;
+    static const char* ctr_name();
 };
 
 class SeededPRNG: public PRNG
@@ -116,4 +124,17 @@ inline void PRNG::get_octets(octet* ans)
         get_octets(ans, L);
     }
 }
-#endif
\ No newline at end of file
+
+/**
+ * @brief Reserve n fresh streams, and return the id of the first one.
+ * Streams are handed out in the order of the calls, so parties sharing the seed
+ * obtain the same ids as long as they call it in the same order (like the sequential access).
+ * InitSeed() resets the streams.
+ */
+inline word PRNG::new_streams(word n)
+{
+    word first = next_stream;
+    next_stream += n;
+    return first;
+}
+#endif
@@ -1,24 +1,27 @@
 #include "Types/UnitTest.h"
 #include "Types/sfixMatrix.h"
+#include "Types/wrapper.h"
 #include "Protocols/PhaseConfig.h"
 using namespace std;
 
 namespace hmmpc
 {
 
-void testCint(PhaseConfig*phase)
+template<class Field>
+void testCint(PhaseConfig<Field> *phase)
 {
-    cint a(-2), b(-3);
+    cint<Field> a(-2), b(-3);
     cout<<a+b<<endl;
     cout<<a-b<<endl;
     cout<<a*b<<endl;
     cout<<(-a)<<endl;
 }
 
-void testSfix(PhaseConfig*phase)
+template<class Field>
+void testSfix(PhaseConfig<Field> *phase)
 {
-    sfix a(-4.6), b(2);
-    cfix c(2.2), d(-1);
+    sfix<Field> a(-4.6), b(2);
+    cfix<Field> c(2.2), d(-1);
     
     a.input_from_party(0);
     b.input_from_party(1);
@@ -42,17 +45,19 @@ void testSfix(PhaseConfig*phase)
     phase->end_online();
 }
 
-void debugSfixDivide(PhaseConfig*phase)
+template<class Field>
+void debugSfixDivide(PhaseConfig<Field> *phase)
 {
     // !Depricated
 }
 
 // UnitTests
-void debugSintMatMul(PhaseConfig *phase)
+template<class Field>
+void debugSintMatMul(PhaseConfig<Field> *phase)
 {
-    sintMatrix A(3, 3), B(3, 3);
-    A.secret().setConstant(map_int_to_gfp(3));
-    B.secret().setConstant(map_int_to_gfp(-2));
+    sintMatrix<Field> A(3, 3), B(3, 3);
+    A.secret().setConstant(map_int_to_gfp<Field>(3));
+    B.secret().setConstant(map_int_to_gfp<Field>(-2));
 
     // phase->generate_reduced_random_sharings(9+9);
     
@@ -67,12 +72,13 @@ void debugSintMatMul(PhaseConfig *phase)
 }
 
 // Test for efficiency on sint multiplication
-void testSintMul(PhaseConfig *phase)
+template<class Field>
+void testSintMul(PhaseConfig<Field> *phase)
 {
     const size_t N = 1000000;
-    sintMatrix A(N, 1), B(N, 1);
-    A.secret().setConstant(map_int_to_gfp(3));
-    B.secret().setConstant(map_int_to_gfp(-2));
+    sintMatrix<Field> A(N, 1), B(N, 1);
+    A.secret().setConstant(map_int_to_gfp<Field>(3));
+    B.secret().setConstant(map_int_to_gfp<Field>(-2));
 
     phase->start_offline();
     phase->generate_reduced_random_sharings(N);
@@ -87,11 +93,12 @@ void testSintMul(PhaseConfig *phase)
 }
 
 // UnitTest for sfix matrix multiplication
-void debugSfixMatMul(PhaseConfig *phase)
+template<class Field>
+void debugSfixMatMul(PhaseConfig<Field> *phase)
 {
     cout<<"[UnitTest]:"<<endl;
     cout<<">>Mult between secret fixed-point numbers."<<endl<<endl;
-    sfixMatrix A(2, 2), B(2, 2);
+    sfixMatrix<Field> A(2, 2), B(2, 2);
     RowMatrixXd a(2, 2);
     RowMatrixXd b(2, 2);
     a<<0.3, -0.004, 
@@ -116,13 +123,53 @@ void debugSfixMatMul(PhaseConfig *phase)
     phase->end_online();
 }
 
+// UnitTest for the independent multiplications and truncation, whose openings share one round.
+template<class Field>
+void debugSfixDeferred(PhaseConfig<Field> *phase)
+{
+    cout<<"[UnitTest]:"<<endl;
+    cout<<">>Independent mults and truncation in one deferred round."<<endl<<endl;
+    sfixMatrix<Field> A(2, 2), B(2, 2);
+    RowMatrixXd a(2, 2);
+    RowMatrixXd b(2, 2);
+    a<<0.3, -0.004, 
+       0.14, 0.05;
+    b<<0.2, -1.2,
+      -0.12, 0.06;
+
+    cout<<"A:"<<endl<<a<<endl;
+    cout<<"B:"<<endl<<b<<endl;
+
+    map_float_to_gfp_matrix(a, A.secret());
+    map_float_to_gfp_matrix(b, B.secret());
+    
+    A.input_from_party(0);
+    B.input_from_party(1);
+
+    phase->start_online();
+
+    sfixMatrix<Field> AB(2, 2), AxB(2, 2), A4 = A;
+    DeferredRound<Field> round;
+    funcDeferredMatMul(A, B, AB, 0, 0, Field::FIXED_PRECISION, round);
+    AxB.share() = A.share().array() * B.share().array();
+    AxB.reduce_truncate(round);
+    funcDeferredTrunc(A4, 2, round);
+    round.flush();
+
+    cout<<"A*B:(Matrix Mult)"<<endl<<AB.reveal()<<endl;
+    cout<<"AxB:(Element-wise Mult)"<<endl<<AxB.reveal()<<endl;
+    cout<<"A/4:"<<endl<<A4.reveal()<<endl;
+    phase->end_online();
+}
+
 // UnitTest for multiplication between sfix and cfix (pure truncation)
-void debugSfixMatMulCfix(PhaseConfig *phase)
+template<class Field>
+void debugSfixMatMulCfix(PhaseConfig<Field> *phase)
 {
     cout<<"[UnitTest]:"<<endl;
     cout<<">>Mult between secret fixed-point and public fixed-point, i.e. pure truncation."<<endl<<endl;
-    sfixMatrix A(2, 2);
-    cfixMatrix B(2, 2);
+    sfixMatrix<Field> A(2, 2);
+    cfixMatrix<Field> B(2, 2);
     RowMatrixXd a(2, 2);
     RowMatrixXd b(2, 2);
     a<<0.3, 0.1, 
@@ -143,12 +190,13 @@ void debugSfixMatMulCfix(PhaseConfig *phase)
 }
 
 // Test for efficiency on sfix multiplication
-void testSfixMul(PhaseConfig *phase)
+template<class Field>
+void testSfixMul(PhaseConfig<Field> *phase)
 {
     const size_t N = 1000000;
-    sfixMatrix A(N, 1), B(N, 1);
-    A.secret().setConstant(map_float_to_gfp(1.2));
-    B.secret().setConstant(map_float_to_gfp(-2.4));
+    sfixMatrix<Field> A(N, 1), B(N, 1);
+    A.secret().setConstant(map_float_to_gfp<Field>(1.2));
+    B.secret().setConstant(map_float_to_gfp<Field>(-2.4));
 
     phase->start_offline();
     phase->generate_reduced_truncated_sharings(N);
@@ -161,4 +209,25 @@ void testSfixMul(PhaseConfig *phase)
     A.mult_cwise(B);
     phase->end_online();
 }
-}
+
+template void testCint<PR31>(PhaseConfig<PR31> *phase);
+template void testSfix<PR31>(PhaseConfig<PR31> *phase);
+template void testSintMul<PR31>(PhaseConfig<PR31> *phase);
+template void testSfixMul<PR31>(PhaseConfig<PR31> *phase);
+template void debugSfixMatMul<PR31>(PhaseConfig<PR31> *phase);
+template void debugSintMatMul<PR31>(PhaseConfig<PR31> *phase);
+template void debugSfixMatMulCfix<PR31>(PhaseConfig<PR31> *phase);
+template void debugSfixDeferred<PR31>(PhaseConfig<PR31> *phase);
+template void debugSfixDivide<PR31>(PhaseConfig<PR31> *phase);
+
+template void testCint<PR61>(PhaseConfig<PR61> *phase);
+template void testSfix<PR61>(PhaseConfig<PR61> *phase);
+template void testSintMul<PR61>(PhaseConfig<PR61> *phase);
+template void testSfixMul<PR61>(PhaseConfig<PR61> *phase);
+template void debugSfixMatMul<PR61>(PhaseConfig<PR61> *phase);
+template void debugSintMatMul<PR61>(PhaseConfig<PR61> *phase);
+template void debugSfixMatMulCfix<PR61>(PhaseConfig<PR61> *phase);
+template void debugSfixDeferred<PR61>(PhaseConfig<PR61> *phase);
+template void debugSfixDivide<PR61>(PhaseConfig<PR61> *phase);
+
+}
\ No newline at end of file
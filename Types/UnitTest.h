@@ -3,14 +3,24 @@
 #include "Protocols/PhaseConfig.h"
 namespace hmmpc
 {
-void testCint(PhaseConfig *phase);
-void testSfix(PhaseConfig *phase);
-void testSintMul(PhaseConfig *phase);
-void testSfixMul(PhaseConfig *phase);
-void debugSfixMatMul(PhaseConfig *phase);
-void debugSintMatMul(PhaseConfig *phase);
-void debugSfixMatMulCfix(PhaseConfig *phase);
+template<class Field>
+void testCint(PhaseConfig<Field> *phase);
+template<class Field>
+void testSfix(PhaseConfig<Field> *phase);
+template<class Field>
+void testSintMul(PhaseConfig<Field> *phase);
+template<class Field>
+void testSfixMul(PhaseConfig<Field> *phase);
+template<class Field>
+void debugSfixMatMul(PhaseConfig<Field> *phase);
+template<class Field>
+void debugSintMatMul(PhaseConfig<Field> *phase);
+template<class Field>
+void debugSfixMatMulCfix(PhaseConfig<Field> *phase);
+template<class Field>
+void debugSfixDeferred(PhaseConfig<Field> *phase);
 
-void debugSfixDivide(PhaseConfig*phase);
+template<class Field>
+void debugSfixDivide(PhaseConfig<Field> *phase);
 }
 #endif
\ No newline at end of file
@@ -8,77 +8,68 @@
 namespace hmmpc
 {
 
-class sfix;
-class cfix:public cint
+template<class Field> class sfix;
+template<class Field>
+class cfix:public cint<Field>
 {
-    friend istream& operator>>(istream &is, cfix &it);
-    friend ostream& operator<<(ostream &os, const cfix &it);
-    friend cfix operator+(const cfix &a, const cfix &b);
-    friend cfix operator-(const cfix &a, const cfix &b);
-    friend cfix operator*(const cfix &a, const cfix &b);
-    friend cfix operator/(const cfix &a, const cfix &b);
-
-    friend sfix operator+(const sfix &a, const cfix &b);
-    friend sfix operator+(const cfix &a, const sfix &b);
-    friend sfix operator-(const sfix &a, const cfix &b);
-    friend sfix operator-(const cfix &a, const sfix &b);
-    friend sfix operator*(const sfix &a, const cfix &b);
-    friend sfix operator*(const cfix &a, const sfix &b);
+    friend istream& operator>>(istream &is, cfix &it)
+    {
+        double x;
+        is>>x;
+        it.value = map_float_to_gfp<Field>(x);
+        return is;
+    }
+
+    friend ostream& operator<<(ostream &os, const cfix &it)
+    {
+        os<<map_gfp_to_float(it.value);
+        return os;
+    }
+
+    friend cfix operator+(const cfix &a, const cfix &b) {return cfix(a.value + b.value);}
+    friend cfix operator-(const cfix &a, const cfix &b) {return cfix(a.value - b.value);}
+
+    friend cfix operator*(const cfix &a, const cfix &b)
+    {
+        return cfix(a.value * b.value).truncate();
+    }
+
+    friend cfix operator/(const cfix &a, const cfix &b){
+        return cfix(a.value / b.value).magnify();
+    }
 public:
+    using cint<Field>::value;
     cfix(){}
-    cfix(const double &x):cfix(map_float_to_gfp(x)){}
-    cfix(const cint &x):cfix(x.value){magnify();}
-    cfix(const gfpScalar &_v):cint(_v){}
+    cfix(const double &x):cfix(map_float_to_gfp<Field>(x)){}
+    cfix(const cint<Field> &x):cfix(x.value){magnify();}
+    cfix(const gfpScalar<Field> &_v):cint<Field>(_v){}
     cfix& truncate();
     cfix& magnify();
 };
 
-inline void test_fix(const double &obj, const cfix &res)
+template<class Field>
+inline void test_fix(const double &obj, const cfix<Field> &res)
 {
     cout<<"expected "<<obj<<", got "<<res<<endl;
 }
 
-inline istream& operator>>(istream &is, cfix &it)
-{
-    double x;
-    is>>x;
-    it.value = map_float_to_gfp(x);
-    return is;
-}
-
-inline ostream& operator<<(ostream &os, const cfix &it)
-{
-    os<<map_gfp_to_float(it.value);
-    return os;
-}
-
 // Truncate the last d bits.
-inline cfix& cfix::truncate()
+template<class Field>
+inline cfix<Field>& cfix<Field>::truncate()
 {
     value.truncate();
     return *this;
 }
 
-inline cfix& cfix::magnify()
+template<class Field>
+inline cfix<Field>& cfix<Field>::magnify()
 {
     value.magnify();
     return *this;
 }
 
-inline cfix operator+(const cfix &a, const cfix &b) {return cfix(a.value + b.value);}
-inline cfix operator-(const cfix &a, const cfix &b) {return cfix(a.value - b.value);}
-
-inline cfix operator*(const cfix &a, const cfix &b)
-{
-    return cfix(a.value * b.value).truncate();
-}
-
-inline cfix operator/(const cfix &a, const cfix &b){
-    return cfix(a.value / b.value).magnify();
-}
-
 
 }
 
 
-#endif
\ No newline at end of file
+#endif
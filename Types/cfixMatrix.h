@@ -10,17 +10,41 @@ using std::vector;
 namespace hmmpc
 {
 
-class cfixMatrix:public cintMatrix
+template<class Field>
+class cfixMatrix:public cintMatrix<Field>
 {
-    friend istream& operator>>(istream&is, cfixMatrix &it);
-    friend ostream& operator<<(ostream&os, const cfixMatrix &it);
-    friend cfixMatrix operator+(const cfixMatrix&a, const cfixMatrix &b);
-    friend cfixMatrix operator-(const cfixMatrix&a, const cfixMatrix &b);
-    friend cfixMatrix operator*(const cfixMatrix&a, const cfixMatrix &b);
+    friend istream& operator>>(istream &is, cfixMatrix &it)
+    {
+        for(size_t i = 0; i < it.values.size(); i++)
+        {
+            cfix<Field> tmp;
+            is>>tmp;
+            it.values(i) = tmp.value;
+        }
+        return is;
+    }
+
+    friend ostream& operator<<(ostream &os, const cfixMatrix &it)
+    {
+        eMatrix<double> res(it.values.rows(), it.values.cols());
+        for(size_t i = 0; i < it.values.size(); i++){
+            res(i) = map_gfp_to_float(it.values(i));
+        }
+        os<<res;
+        return os;
+    }
+
+    friend cfixMatrix operator+(const cfixMatrix &a, const cfixMatrix &b) { return cfixMatrix(a.values+b.values);}
+    friend cfixMatrix operator-(const cfixMatrix &a, const cfixMatrix &b) { return cfixMatrix(a.values-b.values);}
+    friend cfixMatrix operator*(const cfixMatrix &a, const cfixMatrix &b)
+    {
+        return cfixMatrix(a.values * b.values).truncate();
+    }
 public:
+    using cintMatrix<Field>::values; using cintMatrix<Field>::rows; using cintMatrix<Field>::cols;
     cfixMatrix(){}
-    cfixMatrix(const size_t &xSize, const size_t &ySize):cintMatrix(xSize, ySize){}
-    cfixMatrix(const gfpMatrix &_v):cintMatrix(_v){}
+    cfixMatrix(const size_t &xSize, const size_t &ySize):cintMatrix<Field>(xSize, ySize){}
+    cfixMatrix(const gfpMatrix<Field> &_v):cintMatrix<Field>(_v){}
     cfixMatrix& truncate();
     cfixMatrix& magnify();
 
@@ -29,28 +53,8 @@ public:
     eMatrix<double> get_double();
 };
 
-inline istream& operator>>(istream &is, cfixMatrix &it)
-{
-    for(size_t i = 0; i < it.values.size(); i++)
-    {
-        cfix tmp;
-        is>>tmp;
-        it.values(i) = tmp.value;
-    }
-    return is;
-}
-
-inline ostream& operator<<(ostream &os, const cfixMatrix &it)
-{
-    eMatrix<double> res(it.values.rows(), it.values.cols());
-    for(size_t i = 0; i < it.values.size(); i++){
-        res(i) = map_gfp_to_float(it.values(i));
-    }
-    os<<res;
-    return os;
-}
-
-inline cfixMatrix& cfixMatrix::truncate()
+template<class Field>
+inline cfixMatrix<Field>& cfixMatrix<Field>::truncate()
 {
     for(size_t i = 0; i < values.size(); i++){
         values(i).truncate();
@@ -58,7 +62,8 @@ inline cfixMatrix& cfixMatrix::truncate()
     return *this;
 }
 
-inline cfixMatrix& cfixMatrix::magnify()
+template<class Field>
+inline cfixMatrix<Field>& cfixMatrix<Field>::magnify()
 {
     for(size_t i = 0; i < values.size(); i++){
         values(i).magnify();
@@ -66,25 +71,20 @@ inline cfixMatrix& cfixMatrix::magnify()
     return *this;
 }
 
-inline cfixMatrix operator+(const cfixMatrix &a, const cfixMatrix &b) { return cfixMatrix(a.values+b.values);}
-inline cfixMatrix operator-(const cfixMatrix &a, const cfixMatrix &b) { return cfixMatrix(a.values-b.values);}
-inline cfixMatrix operator*(const cfixMatrix &a, const cfixMatrix &b)
-{
-    return cfixMatrix(a.values * b.values).truncate();
-}
-
-inline void cfixMatrix::input_rows(int startRow, int nRow)
+template<class Field>
+inline void cfixMatrix<Field>::input_rows(int startRow, int nRow)
 {
-    cfix tmp;
+    cfix<Field> tmp;
     for(size_t i = startRow; i < startRow + nRow; i++){
         for(size_t j = 0; j < cols(); j++){
-            ShareBase::in>>tmp;
+            ShareBase<Field>::in>>tmp;
             values(i, j) = tmp.value;
         }
     }
 }
 
-inline eMatrix<double> cfixMatrix::get_double()
+template<class Field>
+inline eMatrix<double> cfixMatrix<Field>::get_double()
 {
     eMatrix<double> res(rows(), cols());
     for(size_t i = 0; i < values.size(); i++){
@@ -94,4 +94,4 @@ inline eMatrix<double> cfixMatrix::get_double()
 }
 
 }
-#endif
\ No newline at end of file
+#endif
@@ -6,34 +6,47 @@ namespace hmmpc
 {
 
 
-class sint;
+template<class Field> class sint;
+template<class Field>
 class cint
 {
-
-    friend sint operator+(const sint &a, const cint&b);
-    friend sint operator+(const cint &a, const sint&b);
-    friend sint operator-(const sint &a, const cint&b);
-    friend sint operator-(const cint &a, const sint&b);
-    friend sint operator*(const sint &a, const cint&b);
-    friend sint operator*(const cint &a, const sint&b);
-    friend sint operator/(const sint &a, const cint&b);
-    friend sint operator/(const cint &a, const sint&b);
-
-    friend istream& operator>>(istream &is, cint &it);
-    friend ostream& operator<<(ostream &os, const cint &it);
-    friend cint operator+(const cint &a, const cint &b);
-    friend cint operator-(const cint &a, const cint &b);
-    friend cint operator*(const cint &a, const cint &b);
-    friend cint operator/(const cint &a, const cint &b);
-    friend cint operator<(const cint &a, const cint &b);
-    friend cint operator==(const cint&a, const cint &b);
+    typedef typename Field::TYPE TYPE;
+    typedef typename Field::STYPE STYPE;
+
+    friend istream& operator>>(istream &is, cint &it)
+    {
+        STYPE tmp;
+        is>>tmp;
+        it.value = map_int_to_gfp<Field>(tmp);
+        return is;
+    }
+
+    friend ostream& operator<<(ostream &os, const cint &it)
+    {
+        os<<map_gfp_to_int(it.value);
+        return os;
+    }
+
+    friend cint operator+(const cint &a, const cint &b) {return cint(a.value+b.value);}
+    friend cint operator-(const cint &a, const cint &b) {return cint(a.value-b.value);} 
+    friend cint operator*(const cint &a, const cint &b) {return cint(a.value*b.value);} 
+    friend cint operator/(const cint &a, const cint &b) {return cint(a.value/b.value);} 
+
+    friend cint operator<(const cint &a, const cint &b)
+    {
+        // Need to negate the result if the sign bit is different
+        bool flag = (a.is_negative() && b.is_negative()) || (a.not_negative() && b.not_negative());
+        return cint((!flag) && (a.value < b.value));
+    }
+
+    friend cint operator==(const cint &a, const cint &b){return cint(a.value==b.value);}
     
 public:
-    gfpScalar value;
+    gfpScalar<Field> value;
     cint(){}
-    cint(const TYPE &x):value(map_int_to_gfp(x)){}
-    cint(const gfpScalar &_v):value(_v){}
-    bool is_negative()const{return value.get_value()>MAX_POSITIVE;}
+    cint(const TYPE &x):value(map_int_to_gfp<Field>(x)){}
+    cint(const gfpScalar<Field> &_v):value(_v){}
+    bool is_negative()const{return value.get_value()>Field::MAX_POSITIVE;}
     bool not_negative()const{return !is_negative();}
 
     cint operator-()const{return cint(-value);}
@@ -46,39 +59,12 @@ public:
  * 
  * **********************************************************************/
 
-inline void test_int(const STYPE &obj, const cint &res)
+template<class Field>
+inline void test_int(const typename Field::STYPE &obj, const cint<Field> &res)
 {
     cout<<"expected "<<obj<<", got "<<res<<endl;
 }
 
-inline istream& operator>>(istream &is, cint &it)
-{
-    STYPE tmp;
-    is>>tmp;
-    it.value = map_int_to_gfp(tmp);
-    return is;
-}
-
-inline ostream& operator<<(ostream &os, const cint &it)
-{
-    os<<map_gfp_to_int(it.value);
-    return os;
-}
-
-inline cint operator+(const cint &a, const cint &b) {return cint(a.value+b.value);}
-inline cint operator-(const cint &a, const cint &b) {return cint(a.value-b.value);} 
-inline cint operator*(const cint &a, const cint &b) {return cint(a.value*b.value);} 
-inline cint operator/(const cint &a, const cint &b) {return cint(a.value/b.value);} 
-
-inline cint operator<(const cint &a, const cint &b)
-{
-    // Need to negate the result if the sign bit is different
-    bool flag = (a.is_negative() && b.is_negative()) || (a.not_negative() && b.not_negative());
-    return cint((!flag) && (a.value < b.value));
-}
-
-inline cint operator==(const cint &a, const cint &b){return cint(a.value==b.value);}
-
 
 }
-#endif
\ No newline at end of file
+#endif
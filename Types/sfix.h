@@ -7,25 +7,48 @@
 namespace hmmpc
 {
 
-class sfix:public sint
+template<class Field>
+class sfix:public sint<Field>
 {
-    friend sfix operator+(const sfix &a, const sfix &b);
-    friend sfix operator-(const sfix &a, const sfix &b);
-    friend sfix operator*(const sfix &a, const sfix &b);
-    friend sfix operator/(const sfix &a, const sfix &b);
-    friend sfix mult(const sfix&a, const sfix&b, size_t precision);
-
-    friend sfix operator+(const sfix &a, const cfix &b);
-    friend sfix operator+(const cfix &a, const sfix &b);
-    friend sfix operator-(const sfix &a, const cfix &b);
-    friend sfix operator-(const cfix &a, const sfix &b);
-    friend sfix operator*(const sfix &a, const cfix &b);
-    friend sfix operator*(const cfix &a, const sfix &b);
-
-    sfix(const gfpScalar &_v):sint(_v){}
+    friend sfix operator+(const sfix&a, const sfix &b) {return sfix(a.share() + b.share());}
+    friend sfix operator-(const sfix&a, const sfix &b) {return sfix(a.share() - b.share());}
+
+    friend sfix operator+(const sfix&a, const cfix<Field> &b) {return sfix(a.share() + b.value);}
+    friend sfix operator+(const cfix<Field>&a, const sfix &b) {return sfix(a.value + b.share());}
+    friend sfix operator-(const sfix&a, const cfix<Field> &b) {return sfix(a.share() * b.value);}
+    friend sfix operator-(const cfix<Field>&a, const sfix &b) {return sfix(a.value * b.share());}
+
+    friend sfix operator*(const sfix&a, const sfix &b)
+    {
+        Share<Field> res;
+        res.share = a.share() * b.share();
+        res.reduce_truncate();
+        return sfix(res.share);
+    }
+
+    friend sfix operator*(const sfix&a, const cfix<Field> &b)
+    {
+        Share<Field> res;
+        res.share = a.share() * b.value;
+        res.truncate();
+        return sfix(res.share);
+    }
+
+    friend sfix operator*(const cfix<Field>&a, const sfix&b) {return b*a;}
+
+    friend sfix mult(const sfix&a, const sfix&b, size_t precision)
+    {
+        sfix res;
+        res.share() = a.share() * b.share();
+        res.reduce_truncate(precision);
+        return res;
+    }
+
+    sfix(const gfpScalar<Field> &_v):sint<Field>(_v){}
 public:
+    using sint<Field>::share; using sint<Field>::secret;
     sfix(){}
-    sfix(const double &x){secret() = map_float_to_gfp(x);}
+    sfix(const double &x){secret() = map_float_to_gfp<Field>(x);}
 
     // Input
     void input_from_file(int player_no);
@@ -33,10 +56,12 @@ public:
 
     // Reveal
     void reveal_to_party(int player_no);
-    cfix reveal();
+    cfix<Field> reveal();
 
     void reduce_truncate(){sharing.reduce_truncate();}
     void reduce_truncate(size_t precision){sharing.reduce_truncate(precision);}
+protected:
+    using sint<Field>::sharing;
 };
 
 // void test_fix(const double &obj, const sfix &res)
@@ -44,53 +69,21 @@ public:
 //     cout<<"expected "<<obj<<", got "<<res.reveal()<<endl;
 // }
 
-inline sfix operator+(const sfix&a, const sfix &b) {return sfix(a.share() + b.share());}
-inline sfix operator-(const sfix&a, const sfix &b) {return sfix(a.share() - b.share());}
-
-inline sfix operator+(const sfix&a, const cfix &b) {return sfix(a.share() + b.value);}
-inline sfix operator+(const cfix&a, const sfix &b) {return sfix(a.value + b.share());}
-inline sfix operator-(const sfix&a, const cfix &b) {return sfix(a.share() * b.value);}
-inline sfix operator-(const cfix&a, const sfix &b) {return sfix(a.value * b.share());}
-
-inline sfix operator*(const sfix&a, const sfix &b)
-{
-    Share res;
-    res.share = a.share() * b.share();
-    res.reduce_truncate();
-    return sfix(res.share);
-}
-
-inline sfix operator*(const sfix&a, const cfix &b)
-{
-    Share res;
-    res.share = a.share() * b.value;
-    res.truncate();
-    return sfix(res.share);
-}
-
-inline sfix operator*(const cfix&a, const sfix&b) {return b*a;}
-
-inline sfix mult(const sfix&a, const sfix&b, size_t precision)
-{
-    sfix res;
-    res.share() = a.share() * b.share();
-    res.reduce_truncate(precision);
-    return res;
-}
-
 /*********************************************
  *       Input Methods
  * *******************************************/
-inline void sfix::input_from_party(int player_no)
+template<class Field>
+inline void sfix<Field>::input_from_party(int player_no)
 {
     sharing.input_from_party(player_no);
 }
 
-inline void sfix::input_from_file(int player_no)
+template<class Field>
+inline void sfix<Field>::input_from_file(int player_no)
 {
-    if(ShareBase::P->my_num()==player_no){
-        cfix secret;
-        ShareBase::in>>secret;
+    if(ShareBase<Field>::P->my_num()==player_no){
+        cfix<Field> secret;
+        ShareBase<Field>::in>>secret;
         sharing.set_secret(secret.value);
     }
     sharing.input_from_party(player_no);
@@ -99,17 +92,19 @@ inline void sfix::input_from_file(int player_no)
 /*********************************************
  *       Reveal Methods
  * *******************************************/
-inline void sfix::reveal_to_party(int player_no)
+template<class Field>
+inline void sfix<Field>::reveal_to_party(int player_no)
 {
     sharing.reveal_to_party(player_no);
-    if(ShareBase::P->my_num()==player_no){
+    if(ShareBase<Field>::P->my_num()==player_no){
         cout<<"Ouput: "<<map_gfp_to_float(secret())<<endl;
     }
 }
 
-inline cfix sfix::reveal()
+template<class Field>
+inline cfix<Field> sfix<Field>::reveal()
 {
-    return cfix(sharing.reveal());
+    return cfix<Field>(sharing.reveal());
 }
 }
 
@@ -3,7 +3,9 @@
 #include "Types/sintMatrix.h"
 #include "Types/cfixMatrix.h"
 #include "Protocols/PhaseConfig.h"
+#include "Protocols/DeferredRound.h"
 #include "Types/sfix.h"
+#include "Math/gfpGemm.h"
 
 namespace hmmpc
 {
@@ -14,28 +16,61 @@ void map_float_to_gfp_matrix(RowMatrixXd &X, Eigen::MatrixBase<Derived> &res)
     assert(X.rows()==res.rows());
     assert(X.cols()==res.cols());
     for(size_t i = 0; i < X.size(); i++){
-        res(i) = map_float_to_gfp(X(i));
+        res(i) = map_float_to_gfp<typename Derived::Scalar::field_type>(X(i));
     }
 }
 
-class sfixMatrix:public sintMatrix
+template<class Field>
+class sfixMatrix:public sintMatrix<Field>
 {
-    friend sfixMatrix operator*(const sfixMatrix &a, const sfixMatrix &b);
+    friend sfixMatrix operator+(const sfixMatrix&a, const sfixMatrix &b) {return sfixMatrix(a.share() + b.share());}
+    friend sfixMatrix operator-(const sfixMatrix&a, const sfixMatrix &b) {return sfixMatrix(a.share() - b.share());}
+    friend sfixMatrix operator*(const sfixMatrix &a, const sfixMatrix &b)
+    {
+        sfixMatrix res(a.rows(), b.cols());
+        gfp_matmul(a.share(), b.share(), res.share());
+        res.sharings.reduce_truncate();
+        return res;
+    }
 
-    friend void cwiseMul(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix &res);
-    friend void cwiseMul(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix &res, size_t precision);
+    friend sfixMatrix mult(const sfixMatrix &a, const sfixMatrix &b, size_t precision)
+    {
+        sfixMatrix res(a.rows(), b.cols());
+        gfp_matmul(a.share(), b.share(), res.share());
+        res.sharings.reduce_truncate(precision);
+        return res;
+    }
 
-    friend sfixMatrix mult(const sfixMatrix &a, const sfixMatrix &b, size_t precision);
-    friend sfixMatrix mult_cwise(const sfixMatrix &a, const sfixMatrix &b);
-    friend sfixMatrix mult_cwise(const sfixMatrix &a, const sfixMatrix &b, size_t precision);
+    friend sfixMatrix mult_cwise(const sfixMatrix &a, const sfixMatrix &b)
+    {
+        sfixMatrix res(a.rows(), a.cols());
+        res.share() = a.share().array() * b.share().array();
+        res.sharings.reduce_truncate();
+        return res;
+    }
+
+    friend sfixMatrix mult_cwise(const sfixMatrix &a, const sfixMatrix &b, size_t precision)
+    {
+        sfixMatrix res(a.rows(), a.cols());
+        res.share() = a.share().array() * b.share().array();
+        res.sharings.reduce_truncate(precision);
+        return res; 
+    }
+
+    friend void cwiseMul(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix&res){res.share() = a.share().array() * b.share().array(); res.reduce_truncate();}
+    friend void cwiseMul(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix&res, size_t precision){res.share() = a.share().array()*b.share().array(); res.reduce_truncate(precision);}
     
+protected:
+    using sintMatrix<Field>::sharings;
 public:
-    sfixMatrix():sintMatrix(){}
-    sfixMatrix(const size_t &xSize, const size_t &ySize):sintMatrix(xSize, ySize){}
+    using sintMatrix<Field>::share; using sintMatrix<Field>::secret;
+    using sintMatrix<Field>::rows; using sintMatrix<Field>::cols; using sintMatrix<Field>::size;
+    sfixMatrix():sintMatrix<Field>(){}
+    sfixMatrix(const size_t &xSize, const size_t &ySize):sintMatrix<Field>(xSize, ySize){}
     sfixMatrix(const size_t &xSize, const size_t &ySize, const double &x);
-    sfixMatrix(const gfpMatrix &_shares):sintMatrix(_shares){}
-    sfixMatrix(const ShareBundle &_sharings):sintMatrix(_sharings){}
-    void resize(const size_t &xSize, const size_t &ySize){sharings.resize(xSize, ySize); sharings.set_degree(ShareBase::threshold);}
+    sfixMatrix(const gfpMatrix<Field> &_shares):sintMatrix<Field>(_shares){}
+    sfixMatrix(const ShareBundle<Field> &_sharings):sintMatrix<Field>(_sharings){}
+    void resize(const size_t &xSize, const size_t &ySize){sharings.resize(xSize, ySize); sharings.set_degree(ShareBase<Field>::threshold);}
     // Input
     // void input_secret
     void input_from_file(int player_no);
@@ -47,13 +82,13 @@ public:
 
     // Reveal
     void reveal_to_party(int player_no);
-    cfixMatrix reveal();
-    cintMatrix reveal_quotient();
-    cfixMatrix reveal(size_t num);
-    cintMatrix reveal_quotient(size_t num);
+    cfixMatrix<Field> reveal();
+    cintMatrix<Field> reveal_quotient();
+    cfixMatrix<Field> reveal(size_t num);
+    cintMatrix<Field> reveal_quotient(size_t num);
     
     sfixMatrix& mult_cwise(const sfixMatrix &other);
-    sfixMatrix& mult_cwise_cfix(const cfixMatrix &other);
+    sfixMatrix& mult_cwise_cfix(const cfixMatrix<Field> &other);
 
     void reduce_degree(){sharings.reduce_degree();}
     void truncate(){sharings.truncate();}
@@ -63,183 +98,168 @@ public:
     void reduce_truncate(size_t precision){sharings.reduce_truncate(precision);}
     void reduce_truncate(vector<size_t> &precision){sharings.reduce_truncate(precision);}
     void reduce_truncate(size_t logLearningRate, size_t logMiniBatch){sharings.reduce_truncate(logLearningRate, logMiniBatch);}
+    // Deferred to the flush of the round
+    void truncate(DeferredRound<Field> &round, size_t precision){round.truncate(sharings, precision);}
+    void reduce_truncate(DeferredRound<Field> &round){round.reduce_truncate(sharings);}
+    void reduce_truncate(DeferredRound<Field> &round, size_t precision){round.reduce_truncate(sharings, precision);}
 
-    void partition_rows(size_t &startRow, size_t &nRow){sharings.partition_rows(startRow, nRow);}
+    void partition_elements(int player_no, size_t &start, size_t &n){sharings.partition_elements(player_no, start, n);}
     sfixMatrix& operator+=(const sfixMatrix &other){share()+=other.share(); return *this;}
     sfixMatrix& operator-=(const sfixMatrix &other){share()-=other.share(); return *this;}
 
-    void ReLU(sintMatrix &deltaRelu, sfixMatrix &relu)const{sharings.ReLU(deltaRelu.sharings, relu.sharings);}
+    void ReLU(sintMatrix<Field> &deltaRelu, sfixMatrix &relu)const{sharings.ReLU(deltaRelu.sharings, relu.sharings);}
     void ReLU(sfixMatrix &relu)const{relu.sharings = sharings.ReLU();}
-    void MaxpoolPrime(sintMatrix &maxPoolPrime)const{sharings.MaxPrimeRowwise(maxPoolPrime.sharings);}
-    void Maxpool(sintMatrix &maxPrime, sfixMatrix &maxpool)const{sharings.MaxRowwise(maxpool.sharings, maxPrime.sharings);}
+    void MaxpoolPrime(sintMatrix<Field> &maxPoolPrime)const{sharings.MaxPrimeRowwise(maxPoolPrime.sharings);}
+    void Maxpool(sintMatrix<Field> &maxPrime, sfixMatrix &maxpool)const{sharings.MaxRowwise(maxpool.sharings, maxPrime.sharings);}
     void Maxpool(sfixMatrix &maxpool)const{sharings.MaxRowwise(maxpool.sharings);}// BUG LOG: Write MaxRowwise as Typo
 
     // Optimize by 2-layer mult
-    void ReLU_opt(sintMatrix &deltaRelu, sfixMatrix &relu)const{sharings.ReLU_opt(deltaRelu.sharings, relu.sharings);}
+    void ReLU_opt(sintMatrix<Field> &deltaRelu, sfixMatrix &relu)const{sharings.ReLU_opt(deltaRelu.sharings, relu.sharings);}
     void ReLU_opt(sfixMatrix &relu)const{relu.sharings = sharings.ReLU_opt();}
     void Maxpool_opt(sfixMatrix &maxpool)const{sharings.MaxRowwise_opt(maxpool.sharings);}
-    void Maxpool_opt(sintMatrix &maxPrime, sfixMatrix &maxpool)const{sharings.MaxRowwise_opt(maxpool.sharings, maxPrime.sharings);}
+    void Maxpool_opt(sintMatrix<Field> &maxPrime, sfixMatrix &maxpool)const{sharings.MaxRowwise_opt(maxpool.sharings, maxPrime.sharings);}
 };
 
-inline sfixMatrix::sfixMatrix(const size_t &xSize, const size_t &ySize, const double &x)
-:sintMatrix(xSize, ySize)
+template<class Field>
+inline sfixMatrix<Field>::sfixMatrix(const size_t &xSize, const size_t &ySize, const double &x)
+:sintMatrix<Field>(xSize, ySize)
 {
-    gfpScalar tmp = map_float_to_gfp(x);
+    gfpScalar<Field> tmp = map_float_to_gfp<Field>(x);
     sharings.set_secret(tmp);
 }
 
-inline sfixMatrix operator+(const sfixMatrix&a, const sfixMatrix &b) {return sfixMatrix(a.share() + b.share());}
-inline sfixMatrix operator-(const sfixMatrix&a, const sfixMatrix &b) {return sfixMatrix(a.share() - b.share());}
-inline sfixMatrix operator*(const sfixMatrix &a, const sfixMatrix &b)
-{
-    sfixMatrix res(a.rows(), b.cols());
-    res.share() = a.share() * b.share();
-    res.sharings.reduce_truncate();
-    return res;
-}
-
-inline sfixMatrix mult(const sfixMatrix &a, const sfixMatrix &b, size_t precision)
-{
-    sfixMatrix res(a.rows(), b.cols());
-    res.share() = a.share() * b.share();
-    res.sharings.reduce_truncate(precision);
-    return res;
-}
-
-inline sfixMatrix mult_cwise(const sfixMatrix &a, const sfixMatrix &b)
-{
-    sfixMatrix res(a.rows(), a.cols());
-    res.share() = a.share().array() * b.share().array();
-    res.sharings.reduce_truncate();
-    return res;
-}
-
-inline sfixMatrix mult_cwise(const sfixMatrix &a, const sfixMatrix &b, size_t precision)
-{
-    sfixMatrix res(a.rows(), a.cols());
-    res.share() = a.share().array() * b.share().array();
-    res.sharings.reduce_truncate(precision);
-    return res; 
-}
-
-inline sfixMatrix divide(const sfixMatrix&a, const sfix&b)
+template<class Field>
+inline sfixMatrix<Field> divide(const sfixMatrix<Field>&a, const sfix<Field>&b)
 {
     // VOID
 }
 
 // Each entry in b is the divider of each row in a.
-inline sfixMatrix divideRowwise(const sfixMatrix &a, const sfixMatrix &b)
+template<class Field>
+inline sfixMatrix<Field> divideRowwise(const sfixMatrix<Field> &a, const sfixMatrix<Field> &b)
 {
     // VOID
 }   
 
-inline void add(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix&res){res.share() = a.share() + b.share();}
-inline void substract(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix&res){res.share() = a.share() - b.share();}
-inline void cwiseMul(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix&res){res.share() = a.share().array() * b.share().array(); res.reduce_truncate();}
-inline void cwiseMul(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix&res, size_t precision){res.share() = a.share().array()*b.share().array(); res.reduce_truncate(precision);}
+template<class Field>
+inline void add(const sfixMatrix<Field>&a, const sfixMatrix<Field>&b, sfixMatrix<Field>&res){res.share() = a.share() + b.share();}
+template<class Field>
+inline void substract(const sfixMatrix<Field>&a, const sfixMatrix<Field>&b, sfixMatrix<Field>&res){res.share() = a.share() - b.share();}
 
 /*********************************************
  *       Input Methods
  * *******************************************/
-inline void sfixMatrix::input_from_file(int player_no)
+template<class Field>
+inline void sfixMatrix<Field>::input_from_file(int player_no)
 {
-    if(ShareBase::P->my_num()==player_no){
-        cfixMatrix secrets(rows(), cols());
-        ShareBase::in>>secrets;
+    if(ShareBase<Field>::P->my_num()==player_no){
+        cfixMatrix<Field> secrets(rows(), cols());
+        ShareBase<Field>::in>>secrets;
         sharings.set_secrets(secrets.values);
     }
     sharings.input_from_party(player_no);
 }
 
 // Only input secrets without secret sharing.
-inline void sfixMatrix::input_secrets_from(string filename, int startRow, int nRow, double norm)
+template<class Field>
+inline void sfixMatrix<Field>::input_secrets_from(string filename, int startRow, int nRow, double norm)
 {
     ifstream in(filename);
     for(int i = startRow; i < startRow+nRow; i++){
         for(int j = 0; j < cols(); j++){
             double tmp;
             in>>tmp;
-            secret()(i, j) = map_float_to_gfp(tmp/norm);
+            secret()(i, j) = map_float_to_gfp<Field>(tmp/norm);
         }
     }
     in.close();
 }
 
 // Input by column
-inline void sfixMatrix::input_secrets_from_ColMajor(string filename, int startRow, int nRow, double norm)
+template<class Field>
+inline void sfixMatrix<Field>::input_secrets_from_ColMajor(string filename, int startRow, int nRow, double norm)
 {
     ifstream in(filename);
     for(int j = 0; j < cols(); j++){
         for(int i = startRow; i < startRow+nRow; i++){
             double tmp;
             in>>tmp;
-            secret()(i, j) = map_float_to_gfp(tmp/norm);
+            secret()(i, j) = map_float_to_gfp<Field>(tmp/norm);
         }
     }
     in.close();
 }
 
-inline void sfixMatrix::distribute_shares()
+template<class Field>
+inline void sfixMatrix<Field>::distribute_shares()
 {
     // sharings.input_blocks_dispersed();
     sharings.input_blocks_dispersed_PRG();
 }
 
+template<class Field>
 template<typename Derived>
-inline void sfixMatrix::fill_rows_from(int player_no, Eigen::MatrixBase<Derived> &matrix, size_t startRow, size_t nRow)
+inline void sfixMatrix<Field>::fill_rows_from(int player_no, Eigen::MatrixBase<Derived> &matrix, size_t startRow, size_t nRow)
 {
-    if(ShareBase::P->my_num()==player_no){
+    if(ShareBase<Field>::P->my_num()==player_no){
         assert(matrix.rows() == nRow);
         assert(matrix.cols() == cols());
         for(size_t i = startRow, k = 0; i < startRow+nRow; i++, k++)
             for(size_t j = 0; j < cols(); j++){
-                secret()(i, j) = map_float_to_gfp(matrix(k, j));
+                secret()(i, j) = map_float_to_gfp<Field>(matrix(k, j));
             }
     }
 }
 
-inline void sfixMatrix::reveal_to_party(int player_no)
+template<class Field>
+inline void sfixMatrix<Field>::reveal_to_party(int player_no)
 {
     sharings.reveal_to_party(player_no);
-    if(ShareBase::P->my_num()==player_no){
-        cfixMatrix res = secret();
+    if(ShareBase<Field>::P->my_num()==player_no){
+        cfixMatrix<Field> res = secret();
         cout<<"Output:"<<endl;
         cout<<res<<endl;
     }
 }
 
-inline cfixMatrix sfixMatrix::reveal()
+template<class Field>
+inline cfixMatrix<Field> sfixMatrix<Field>::reveal()
 {
-    return cfixMatrix(sharings.reveal());
+    return cfixMatrix<Field>(sharings.reveal());
 }
 
-inline cfixMatrix sfixMatrix::reveal(size_t num)
+template<class Field>
+inline cfixMatrix<Field> sfixMatrix<Field>::reveal(size_t num)
 {
     sfixMatrix tmp(1, num);
-    tmp.share() = share().reshaped<Eigen::RowMajor>().head(num).transpose();
+    tmp.share() = share().template reshaped<Eigen::RowMajor>().head(num).transpose();
     return tmp.reveal();
 }
 
-inline cintMatrix sfixMatrix::reveal_quotient()
+template<class Field>
+inline cintMatrix<Field> sfixMatrix<Field>::reveal_quotient()
 {
-    return cintMatrix(sharings.reveal());
+    return cintMatrix<Field>(sharings.reveal());
 }
 
-inline cintMatrix sfixMatrix::reveal_quotient(size_t num)
+template<class Field>
+inline cintMatrix<Field> sfixMatrix<Field>::reveal_quotient(size_t num)
 {
     sfixMatrix tmp(1, num);
-    tmp.share() = share().reshaped<Eigen::RowMajor>().head(num).transpose();
+    tmp.share() = share().template reshaped<Eigen::RowMajor>().head(num).transpose();
     return tmp.reveal_quotient();
 }
 
-inline sfixMatrix& sfixMatrix::mult_cwise(const sfixMatrix&other)
+template<class Field>
+inline sfixMatrix<Field>& sfixMatrix<Field>::mult_cwise(const sfixMatrix&other)
 {
     share() = share().array() * other.share().array();
     sharings.reduce_truncate();
     return *this;
 }
 
-inline sfixMatrix& sfixMatrix::mult_cwise_cfix(const cfixMatrix&other)
+template<class Field>
+inline sfixMatrix<Field>& sfixMatrix<Field>::mult_cwise_cfix(const cfixMatrix<Field>&other)
 {
     share() = share().array() * other.values.array();
     sharings.truncate();
@@ -8,35 +8,40 @@
 namespace hmmpc
 {
 
+template<class Field>
 class sint
 {
-    friend sint operator+(const sint &a, const sint &b);
-    friend sint operator-(const sint &a, const sint &b);
-    friend sint operator*(const sint &a, const sint &b);
-    friend sint operator/(const sint &a, const sint &b);
-    friend sint operator<(const sint &a, const sint &b);
-    friend sint operator==(const sint&a, const sint &b);
-
-    friend sint operator+(const sint &a, const cint&b);
-    friend sint operator+(const cint &a, const sint&b);
-    friend sint operator-(const sint &a, const cint&b);
-    friend sint operator-(const cint &a, const sint&b);
-    friend sint operator*(const sint &a, const cint&b);
-    friend sint operator*(const cint &a, const sint&b);
-    friend sint operator/(const sint &a, const cint&b);
-    friend sint operator/(const cint &a, const sint&b);
+    friend sint operator+(const sint&a, const sint&b){return sint(a.share()+b.share());}
+    friend sint operator-(const sint&a, const sint&b){return sint(a.share()-b.share());}
+
+    friend sint operator+(const sint&a, const cint<Field> &b){return sint(a.share() + b.value);}
+    friend sint operator+(const cint<Field>&a, const sint &b){return sint(a.value + b.share());}
+    friend sint operator-(const sint&a, const cint<Field> &b){return sint(a.share() - b.value);}
+    friend sint operator-(const cint<Field>&a, const sint &b){return sint(a.value - b.share());}
+    friend sint operator*(const sint&a, const cint<Field> &b){return sint(a.share() * b.value);}
+    friend sint operator*(const cint<Field>&a, const sint &b){return sint(a.value * b.share());}
+    friend sint operator/(const sint&a, const cint<Field> &b){return sint(a.share() / b.value);}
+    friend sint operator/(const cint<Field>&a, const sint &b){return sint(a.value / b.share());}
+
+    friend sint operator*(const sint&a, const sint&b)
+    {
+        Share<Field> res;
+        res.share = a.share() * b.share();
+        res.reduce_degree();
+        return sint(res.share);
+    }
 protected:
-    Share sharing;
+    Share<Field> sharing;
 
 public: 
     sint(){}
-    sint(const STYPE &x){share() = map_int_to_gfp(x);}
-    sint(const gfpScalar &_v){share() = _v;}
+    sint(const typename Field::STYPE &x){share() = map_int_to_gfp<Field>(x);}
+    sint(const gfpScalar<Field> &_v){share() = _v;}
 
-    gfpScalar& share(){gfpScalar &ref = sharing.share; return ref;}
-    const gfpScalar& share()const{const gfpScalar &ref = sharing.share; return ref;}
-    gfpScalar& secret(){gfpScalar &ref = sharing.secret; return ref;}
-    const gfpScalar& secret()const{const gfpScalar &ref = sharing.secret; return ref;}
+    gfpScalar<Field>& share(){gfpScalar<Field> &ref = sharing.share; return ref;}
+    const gfpScalar<Field>& share()const{const gfpScalar<Field> &ref = sharing.share; return ref;}
+    gfpScalar<Field>& secret(){gfpScalar<Field> &ref = sharing.secret; return ref;}
+    const gfpScalar<Field>& secret()const{const gfpScalar<Field> &ref = sharing.secret; return ref;}
 
     // Input
     void input_from_file(int player_no);
@@ -45,56 +50,35 @@ public:
 
     // Reveal
     void reveal_to_party(int player_no);
-    cint reveal();
+    cint<Field> reveal();
 
     sint get_LSB();
     sint get_MSB();
 };
 
 
-/*********************************************
- *       Basic Operations
- * *******************************************/
-
-inline sint operator+(const sint&a, const sint&b){return sint(a.share()+b.share());}
-inline sint operator-(const sint&a, const sint&b){return sint(a.share()-b.share());}
-
-inline sint operator+(const sint&a, const cint &b){return sint(a.share() + b.value);}
-inline sint operator+(const cint&a, const sint &b){return sint(a.value + b.share());}
-inline sint operator-(const sint&a, const cint &b){return sint(a.share() - b.value);}
-inline sint operator-(const cint&a, const sint &b){return sint(a.value - b.share());}
-inline sint operator*(const sint&a, const cint &b){return sint(a.share() * b.value);}
-inline sint operator*(const cint&a, const sint &b){return sint(a.value * b.share());}
-inline sint operator/(const sint&a, const cint &b){return sint(a.share() / b.value);}
-inline sint operator/(const cint&a, const sint &b){return sint(a.value / b.share());}
-
-inline sint operator*(const sint&a, const sint&b)
-{
-    Share res;
-    res.share = a.share() * b.share();
-    res.reduce_degree();
-    return sint(res.share);
-}
-
 /*********************************************
  *       Input Methods
  * *******************************************/
-inline void sint::input_from_file(int player_no)
+template<class Field>
+inline void sint<Field>::input_from_file(int player_no)
 {
-    if(ShareBase::P->my_num()==player_no){
-        cint secret;
-        ShareBase::in>>secret;
+    if(ShareBase<Field>::P->my_num()==player_no){
+        cint<Field> secret;
+        ShareBase<Field>::in>>secret;
         sharing.set_secret(secret.value);
     }
     sharing.input_from_party(player_no);
 }
 
-inline void sint::input_from_party(int player_no)
+template<class Field>
+inline void sint<Field>::input_from_party(int player_no)
 {
     sharing.input_from_party(player_no);
 }
 
-inline void sint::input_from_random(int player_no)
+template<class Field>
+inline void sint<Field>::input_from_random(int player_no)
 {
     sharing.input_from_random(player_no);
 }
@@ -102,18 +86,20 @@ inline void sint::input_from_random(int player_no)
 /*********************************************
  *       Reveal Methods
  * *******************************************/
-inline void sint::reveal_to_party(int player_no)
+template<class Field>
+inline void sint<Field>::reveal_to_party(int player_no)
 {
     sharing.reveal_to_party(player_no);
-    if(ShareBase::P->my_num()==player_no){
+    if(ShareBase<Field>::P->my_num()==player_no){
         cout<<"Ouput: "<<map_gfp_to_int(secret())<<endl;
     }
 }
 
-inline cint sint::reveal()
+template<class Field>
+inline cint<Field> sint<Field>::reveal()
 {
-    return cint(sharing.reveal());
+    return cint<Field>(sharing.reveal());
 }
 
 }
-#endif
\ No newline at end of file
+#endif
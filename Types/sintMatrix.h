@@ -8,28 +8,43 @@
 namespace hmmpc
 {
 
+template<class Field> class sfixMatrix;
+template<class Field>
 class sintMatrix
 {
-    friend class sfixMatrix;
-    friend sintMatrix operator+(const sintMatrix &a, const sintMatrix &b);
-    friend sintMatrix operator-(const sintMatrix &a, const sintMatrix &b);
-    friend sintMatrix operator*(const sintMatrix &a, const sintMatrix &b);
-    friend sintMatrix mult_cwise(const sintMatrix &a, const sintMatrix &b);
+    friend class sfixMatrix<Field>;
+    friend sintMatrix operator+(const sintMatrix&a, const sintMatrix &b) { return sintMatrix(a.share() + b.share());}
+    friend sintMatrix operator-(const sintMatrix&a, const sintMatrix &b) { return sintMatrix(a.share() - b.share());}
+    friend sintMatrix operator*(const sintMatrix&a, const sintMatrix&b)
+    {
+        sintMatrix res(a.rows(), b.cols());
+        res.share() = a.share() * b.share();
+        res.sharings.reduce_degree();
+        return res;
+    }
+
+    friend sintMatrix mult_cwise(const sintMatrix &a, const sintMatrix &b)
+    {
+        sintMatrix res(a.rows(), a.cols());
+        res.share() = a.share().array() * b.share().array();
+        res.sharings.reduce_degree();
+        return res;
+    }
     
 protected:
-    ShareBundle sharings;
+    ShareBundle<Field> sharings;
 public:
     sintMatrix(){}
     sintMatrix(const size_t &xSize, const size_t &ySize):sharings(xSize, ySize){}
-    sintMatrix(const size_t &xSize, const size_t &ySize, const STYPE &x);
-    sintMatrix(const gfpMatrix &_shares);
-    sintMatrix(const ShareBundle &_sharings):sharings(_sharings){}
+    sintMatrix(const size_t &xSize, const size_t &ySize, const typename Field::STYPE &x);
+    sintMatrix(const gfpMatrix<Field> &_shares);
+    sintMatrix(const ShareBundle<Field> &_sharings):sharings(_sharings){}
 
     // The reference to the shares.
-    gfpMatrix& share(){gfpMatrix& ref = sharings.shares; return ref;}
-    const gfpMatrix& share()const{const gfpMatrix &ref = sharings.shares; return ref;}
-    gfpMatrix& secret(){gfpMatrix& ref = sharings.secrets; return ref;}
-    const gfpMatrix& secret()const{const gfpMatrix &ref = sharings.secrets; return ref;}
+    gfpMatrix<Field>& share(){gfpMatrix<Field>& ref = sharings.shares; return ref;}
+    const gfpMatrix<Field>& share()const{const gfpMatrix<Field> &ref = sharings.shares; return ref;}
+    gfpMatrix<Field>& secret(){gfpMatrix<Field>& ref = sharings.secrets; return ref;}
+    const gfpMatrix<Field>& secret()const{const gfpMatrix<Field> &ref = sharings.secrets; return ref;}
 
     size_t rows()const{return share().rows();}
     size_t cols()const{return share().cols();}
@@ -48,8 +63,8 @@ public:
 
     // Reveal
     void reveal_to_party(int player_no);
-    cintMatrix reveal();
-    cintMatrix reveal(size_t num);
+    cintMatrix<Field> reveal();
+    cintMatrix<Field> reveal(size_t num);
 
     sintMatrix& mult_cwise(const sintMatrix &other);
 
@@ -58,53 +73,41 @@ public:
 
 };
 
-inline sintMatrix::sintMatrix(const size_t &xSize, const size_t &ySize, const STYPE &x):sharings(xSize, ySize)
+template<class Field>
+inline sintMatrix<Field>::sintMatrix(const size_t &xSize, const size_t &ySize, const typename Field::STYPE &x):sharings(xSize, ySize)
 {
-    gfpScalar tmp = map_int_to_gfp(x);
+    gfpScalar<Field> tmp = map_int_to_gfp<Field>(x);
     sharings.set_secret(tmp);
 }
 
-inline sintMatrix::sintMatrix(const gfpMatrix &_shares):sharings(_shares.rows(), _shares.cols())
+template<class Field>
+inline sintMatrix<Field>::sintMatrix(const gfpMatrix<Field> &_shares):sharings(_shares.rows(), _shares.cols())
 {
     share() = _shares;
 }
 
-inline sintMatrix operator+(const sintMatrix&a, const sintMatrix &b) { return sintMatrix(a.share() + b.share());}
-inline sintMatrix operator-(const sintMatrix&a, const sintMatrix &b) { return sintMatrix(a.share() - b.share());}
-inline sintMatrix operator*(const sintMatrix&a, const sintMatrix&b)
-{
-    sintMatrix res(a.rows(), b.cols());
-    res.share() = a.share() * b.share();
-    res.sharings.reduce_degree();
-    return res;
-}
-
-inline sintMatrix mult_cwise(const sintMatrix &a, const sintMatrix &b)
-{
-    sintMatrix res(a.rows(), a.cols());
-    res.share() = a.share().array() * b.share().array();
-    res.sharings.reduce_degree();
-    return res;
-}
 /*********************************************
  *       Input Methods
  * *******************************************/
-inline void sintMatrix::input_from_file(int player_no)
+template<class Field>
+inline void sintMatrix<Field>::input_from_file(int player_no)
 {
-    if(ShareBase::P->my_num() == player_no){
-        cintMatrix secrets(rows(), cols());
-        ShareBase::in>>secrets;
+    if(ShareBase<Field>::P->my_num() == player_no){
+        cintMatrix<Field> secrets(rows(), cols());
+        ShareBase<Field>::in>>secrets;
         sharings.set_secrets(secrets.values);
     }
     sharings.input_from_party(player_no);
 }
 
-inline void sintMatrix::input_from_party(int player_no)
+template<class Field>
+inline void sintMatrix<Field>::input_from_party(int player_no)
 {
     sharings.input_from_party(player_no);
 }
 
-inline void sintMatrix::input_from_random(int player_no)
+template<class Field>
+inline void sintMatrix<Field>::input_from_random(int player_no)
 {
     sharings.input_from_random(player_no);
 }
@@ -113,27 +116,31 @@ inline void sintMatrix::input_from_random(int player_no)
  *       Input Methods of multi-thread version
  * *******************************************/
 
-inline void sintMatrix::input_from_file_request(int player_no)
+template<class Field>
+inline void sintMatrix<Field>::input_from_file_request(int player_no)
 {
-    if(ShareBase::P->my_num() == player_no){
-        cintMatrix secrets(rows(), cols());
-        ShareBase::in>>secrets;
+    if(ShareBase<Field>::P->my_num() == player_no){
+        cintMatrix<Field> secrets(rows(), cols());
+        ShareBase<Field>::in>>secrets;
         sharings.set_secrets(secrets.values);
     }
     sharings.input_from_party_request(player_no);
 }
 
-inline void sintMatrix::input_from_party_request(int player_no)
+template<class Field>
+inline void sintMatrix<Field>::input_from_party_request(int player_no)
 {
     sharings.input_from_party_request(player_no);
 }
 
-inline void sintMatrix::input_from_random_request(int player_no)
+template<class Field>
+inline void sintMatrix<Field>::input_from_random_request(int player_no)
 {
     sharings.input_from_random_request(player_no);
 }
 
-inline void sintMatrix::finish_input_from(int player_no)
+template<class Field>
+inline void sintMatrix<Field>::finish_input_from(int player_no)
 {
     sharings.finish_input_from(player_no);
 }
@@ -141,29 +148,33 @@ inline void sintMatrix::finish_input_from(int player_no)
 /*********************************************
  *       Reveal Methods
  * *******************************************/
-inline void sintMatrix::reveal_to_party(int player_no)
+template<class Field>
+inline void sintMatrix<Field>::reveal_to_party(int player_no)
 {
     sharings.reveal_to_party(player_no);
-    if(ShareBase::P->my_num()==player_no){
-        cintMatrix res = sharings.get_secrets();
+    if(ShareBase<Field>::P->my_num()==player_no){
+        cintMatrix<Field> res = sharings.get_secrets();
         cout<<"Output: "<<endl;
         cout<<res<<endl;
     }
 }
 
-inline cintMatrix sintMatrix::reveal()
+template<class Field>
+inline cintMatrix<Field> sintMatrix<Field>::reveal()
 {
-    return cintMatrix(sharings.reveal());
+    return cintMatrix<Field>(sharings.reveal());
 }
 
-inline cintMatrix sintMatrix::reveal(size_t num)
+template<class Field>
+inline cintMatrix<Field> sintMatrix<Field>::reveal(size_t num)
 {
     sintMatrix tmp(1, num);
-    tmp.share() = share().reshaped<Eigen::RowMajor>().head(num).transpose();
+    tmp.share() = share().template reshaped<Eigen::RowMajor>().head(num).transpose();
     return tmp.reveal();
 }
 
-inline sintMatrix& sintMatrix::mult_cwise(const sintMatrix &other)
+template<class Field>
+inline sintMatrix<Field>& sintMatrix<Field>::mult_cwise(const sintMatrix &other)
 {
     share() = share().array() * other.share().array();
     sharings.reduce_degree();
@@ -3,54 +3,75 @@
 
 namespace hmmpc
 {
-void funcMatMul(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix &res, bool a_transpose, bool b_transpose, size_t precision)
+template<class Field>
+void funcMatMul(const sfixMatrix<Field>&a, const sfixMatrix<Field>&b, sfixMatrix<Field> &res, bool a_transpose, bool b_transpose, size_t precision)
 {
-    if(!a_transpose && !b_transpose){res.share() = a.share() * b.share();}
-    else if(!a_transpose && b_transpose){res.share() = a.share() * b.share().transpose();}
-    else if(a_transpose && !b_transpose){res.share() = a.share().transpose() * b.share();}
-    else {res.share() = a.share().transpose() * b.share().transpose();}
-    if(precision==FIXED_PRECISION)
+    gfp_matmul(a.share(), b.share(), res.share(), a_transpose, b_transpose);
+    if(precision==Field::FIXED_PRECISION)
         res.reduce_truncate();
     else
         res.reduce_truncate(precision);
 }
 
-void funcCwiseMul(const sfixMatrix&a, const sintMatrix &b, sfixMatrix &res)
+template<class Field>
+void funcCwiseMul(const sfixMatrix<Field>&a, const sintMatrix<Field> &b, sfixMatrix<Field> &res)
 {
     res.share() = a.share().array() * b.share().array();
     res.reduce_degree();
 }
 
-void funcDivision(const sfixMatrix&a, const sfixMatrix &b, sfixMatrix &res)
+template<class Field>
+void funcDivision(const sfixMatrix<Field>&a, const sfixMatrix<Field> &b, sfixMatrix<Field> &res)
 {
     res = divideRowwise(a, b);
 }
 
-void funcTrunc(sfixMatrix &res, size_t precision)
+template<class Field>
+void funcTrunc(sfixMatrix<Field> &res, size_t precision)
 {
     res.truncate(precision);
 }
 
-void funcReLU(const sfixMatrix &input, sintMatrix &reluPrime, sfixMatrix &activations)
+template<class Field>
+void funcDeferredMatMul(const sfixMatrix<Field>&a, const sfixMatrix<Field>&b, sfixMatrix<Field> &res, bool a_transpose, bool b_transpose, size_t precision, DeferredRound<Field> &round)
+{
+    gfp_matmul(a.share(), b.share(), res.share(), a_transpose, b_transpose);
+    if(precision==Field::FIXED_PRECISION)
+        res.reduce_truncate(round);
+    else
+        res.reduce_truncate(round, precision);
+}
+
+template<class Field>
+void funcDeferredTrunc(sfixMatrix<Field> &res, size_t precision, DeferredRound<Field> &round)
+{
+    res.truncate(round, precision);
+}
+
+template<class Field>
+void funcReLU(const sfixMatrix<Field> &input, sintMatrix<Field> &reluPrime, sfixMatrix<Field> &activations)
 {
     // input.ReLU(reluPrime, activations);
     input.ReLU_opt(reluPrime, activations);
 }
 
-void funcOnlyReLU(const sfixMatrix &input, sfixMatrix &activations)
+template<class Field>
+void funcOnlyReLU(const sfixMatrix<Field> &input, sfixMatrix<Field> &activations)
 {
     // input.ReLU(activations);
     input.ReLU_opt(activations);
 }
 
-void funcConvMatMul(const sfixMatrix &a, const sfixMatrix &b, const sfixMatrix &biases, sfixMatrix &res,
+template<class Field>
+void funcConvMatMul(const sfixMatrix<Field> &a, const sfixMatrix<Field> &b, const sfixMatrix<Field> &biases, sfixMatrix<Field> &res,
                      size_t B, size_t oh, size_t ow, size_t Dout)
 {
     // a: (B*ow*oh, f*f*Din)
     // b: (f*f*Din, Dout)
 
     // tmp = B*ow*oh, Dout
-    gfpMatrix tmp = (a.share() * b.share()).array() + gfpMatrix(biases.share().colwise().replicate(a.rows())).array();
+    gfpMatrix<Field> tmp = gfp_matmul(a.share(), b.share());
+    tmp.rowwise() += biases.share().row(0);
     // res = B, ow*oh*Dout
     size_t nRow=ow*oh;
     for(size_t i = 0; i < B; i++){
@@ -62,30 +83,57 @@ void funcConvMatMul(const sfixMatrix &a, const sfixMatrix &b, const sfixMatrix &
     res.reduce_truncate();
 }
 
-void funcMaxpool(const sfixMatrix &input, sintMatrix &maxPrime, sfixMatrix &activations, 
+template<class Field>
+void funcMaxpool(const sfixMatrix<Field> &input, sintMatrix<Field> &maxPrime, sfixMatrix<Field> &activations, 
                 size_t B, size_t Din, size_t oh, size_t ow, size_t f)
 {
     // input: (B*ow*oh*Din, f*f)
     // activations: (B, ow*oh*Din)
     // maxPrime: (B, ow*oh*Din*f*f)
 
-    sfixMatrix tmpActivations(B*ow*oh*Din, 1);
-    sintMatrix tmpPrime(B*ow*oh*Din, f*f);
+    sfixMatrix<Field> tmpActivations(B*ow*oh*Din, 1);
+    sintMatrix<Field> tmpPrime(B*ow*oh*Din, f*f);
     tmpPrime.share().setConstant(1);
     // input.Maxpool(tmpPrime, tmpActivations);
     input.Maxpool_opt(tmpPrime, tmpActivations);
     activations.share() = tmpActivations.share().reshaped(B, ow*oh*Din);
-    maxPrime.share() = tmpPrime.share().reshaped<RowMajor>(B, ow*oh*Din*f*f);
+    maxPrime.share() = tmpPrime.share().template reshaped<RowMajor>(B, ow*oh*Din*f*f);
 }
 
-void funcOnlyMaxpool(const sfixMatrix &input, sfixMatrix &activations,
+template<class Field>
+void funcOnlyMaxpool(const sfixMatrix<Field> &input, sfixMatrix<Field> &activations,
                  size_t B, size_t Din, size_t oh, size_t ow)
 {
     // input: (B*ow*oh*Din, f*f)
     // activations: (B, ow*oh*Din)
-    sfixMatrix tmpActivations(B*ow*oh*Din, 1);
+    sfixMatrix<Field> tmpActivations(B*ow*oh*Din, 1);
     // input.Maxpool(tmpActivations);
     input.Maxpool_opt(tmpActivations);
     activations.share() = tmpActivations.share().reshaped(B, ow*oh*Din);
 }
+
+template void funcMatMul<PR31>(const sfixMatrix<PR31>&a, const sfixMatrix<PR31>&b, sfixMatrix<PR31> &res, bool a_transpose, bool b_transpose, size_t precision);
+template void funcCwiseMul<PR31>(const sfixMatrix<PR31>&a, const sintMatrix<PR31> &b, sfixMatrix<PR31> &res);
+template void funcDivision<PR31>(const sfixMatrix<PR31>&a, const sfixMatrix<PR31> &b, sfixMatrix<PR31> &res);
+template void funcTrunc<PR31>(sfixMatrix<PR31> &res, size_t precision);
+template void funcDeferredMatMul<PR31>(const sfixMatrix<PR31>&a, const sfixMatrix<PR31>&b, sfixMatrix<PR31> &res, bool a_transpose, bool b_transpose, size_t precision, DeferredRound<PR31> &round);
+template void funcDeferredTrunc<PR31>(sfixMatrix<PR31> &res, size_t precision, DeferredRound<PR31> &round);
+template void funcReLU<PR31>(const sfixMatrix<PR31> &input, sintMatrix<PR31> &reluPrime, sfixMatrix<PR31> &activations);
+template void funcOnlyReLU<PR31>(const sfixMatrix<PR31> &input, sfixMatrix<PR31> &activations);
+template void funcConvMatMul<PR31>(const sfixMatrix<PR31> &a, const sfixMatrix<PR31> &b, const sfixMatrix<PR31> &biases, sfixMatrix<PR31> &res, size_t B, size_t oh, size_t ow, size_t Dout);
+template void funcMaxpool<PR31>(const sfixMatrix<PR31> &input, sintMatrix<PR31> &maxPrime, sfixMatrix<PR31> &activations, size_t B, size_t Din, size_t oh, size_t ow, size_t f);
+template void funcOnlyMaxpool<PR31>(const sfixMatrix<PR31> &input, sfixMatrix<PR31> &activations, size_t B, size_t Din, size_t oh, size_t ow);
+
+template void funcMatMul<PR61>(const sfixMatrix<PR61>&a, const sfixMatrix<PR61>&b, sfixMatrix<PR61> &res, bool a_transpose, bool b_transpose, size_t precision);
+template void funcCwiseMul<PR61>(const sfixMatrix<PR61>&a, const sintMatrix<PR61> &b, sfixMatrix<PR61> &res);
+template void funcDivision<PR61>(const sfixMatrix<PR61>&a, const sfixMatrix<PR61> &b, sfixMatrix<PR61> &res);
+template void funcTrunc<PR61>(sfixMatrix<PR61> &res, size_t precision);
+template void funcDeferredMatMul<PR61>(const sfixMatrix<PR61>&a, const sfixMatrix<PR61>&b, sfixMatrix<PR61> &res, bool a_transpose, bool b_transpose, size_t precision, DeferredRound<PR61> &round);
+template void funcDeferredTrunc<PR61>(sfixMatrix<PR61> &res, size_t precision, DeferredRound<PR61> &round);
+template void funcReLU<PR61>(const sfixMatrix<PR61> &input, sintMatrix<PR61> &reluPrime, sfixMatrix<PR61> &activations);
+template void funcOnlyReLU<PR61>(const sfixMatrix<PR61> &input, sfixMatrix<PR61> &activations);
+template void funcConvMatMul<PR61>(const sfixMatrix<PR61> &a, const sfixMatrix<PR61> &b, const sfixMatrix<PR61> &biases, sfixMatrix<PR61> &res, size_t B, size_t oh, size_t ow, size_t Dout);
+template void funcMaxpool<PR61>(const sfixMatrix<PR61> &input, sintMatrix<PR61> &maxPrime, sfixMatrix<PR61> &activations, size_t B, size_t Din, size_t oh, size_t ow, size_t f);
+template void funcOnlyMaxpool<PR61>(const sfixMatrix<PR61> &input, sfixMatrix<PR61> &activations, size_t B, size_t Din, size_t oh, size_t ow);
+
 }
\ No newline at end of file
@@ -1,24 +1,40 @@
 #pragma once
 #include "Types/sfixMatrix.h"
 #include "Types/sintMatrix.h"
+#include "Math/gfpGemm.h"
 
 namespace hmmpc
 {
 
-void funcMatMul(const sfixMatrix&a, const sfixMatrix&b, sfixMatrix &res, 
-                            bool a_transpose, bool b_transpose, size_t precision=FIXED_PRECISION);
-void funcCwiseMul(const sfixMatrix&a, const sintMatrix &b, sfixMatrix &res);
-void funcDivision(const sfixMatrix&a, const sfixMatrix &b, sfixMatrix &res);
-void funcTrunc(sfixMatrix &res, size_t precision);
+template<class Field>
+void funcMatMul(const sfixMatrix<Field>&a, const sfixMatrix<Field>&b, sfixMatrix<Field> &res, 
+                            bool a_transpose, bool b_transpose, size_t precision=Field::FIXED_PRECISION);
+template<class Field>
+void funcCwiseMul(const sfixMatrix<Field>&a, const sintMatrix<Field> &b, sfixMatrix<Field> &res);
+template<class Field>
+void funcDivision(const sfixMatrix<Field>&a, const sfixMatrix<Field> &b, sfixMatrix<Field> &res);
+template<class Field>
+void funcTrunc(sfixMatrix<Field> &res, size_t precision);
+// Deferred versions, whose openings share the round (see DeferredRound).
+template<class Field>
+void funcDeferredMatMul(const sfixMatrix<Field>&a, const sfixMatrix<Field>&b, sfixMatrix<Field> &res, 
+                            bool a_transpose, bool b_transpose, size_t precision, DeferredRound<Field> &round);
+template<class Field>
+void funcDeferredTrunc(sfixMatrix<Field> &res, size_t precision, DeferredRound<Field> &round);
 
-void funcReLU(const sfixMatrix &input, sintMatrix &reluPrime, sfixMatrix &activations);
-void funcOnlyReLU(const sfixMatrix &input, sfixMatrix &activations);
+template<class Field>
+void funcReLU(const sfixMatrix<Field> &input, sintMatrix<Field> &reluPrime, sfixMatrix<Field> &activations);
+template<class Field>
+void funcOnlyReLU(const sfixMatrix<Field> &input, sfixMatrix<Field> &activations);
 
-void funcConvMatMul(const sfixMatrix &a, const sfixMatrix &b, const sfixMatrix &biases, sfixMatrix &res,
+template<class Field>
+void funcConvMatMul(const sfixMatrix<Field> &a, const sfixMatrix<Field> &b, const sfixMatrix<Field> &biases, sfixMatrix<Field> &res,
                      size_t B, size_t oh, size_t ow, size_t Dout);
 
-void funcMaxpool(const sfixMatrix &input, sintMatrix &maxPrime, sfixMatrix &activations, 
+template<class Field>
+void funcMaxpool(const sfixMatrix<Field> &input, sintMatrix<Field> &maxPrime, sfixMatrix<Field> &activations, 
                 size_t B, size_t Din, size_t oh, size_t ow, size_t f);
-void funcOnlyMaxpool(const sfixMatrix &input, sfixMatrix &activations,
+template<class Field>
+void funcOnlyMaxpool(const sfixMatrix<Field> &input, sfixMatrix<Field> &activations,
                  size_t B, size_t Din, size_t oh, size_t ow);
 }
\ No newline at end of file